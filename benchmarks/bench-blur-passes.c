@@ -0,0 +1,112 @@
+/* bench-blur-passes.c - Gaussian pass timings, float and fixed-point
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "src/lib/blur-kernels.h"
+#include "src/lib/blur-processor.h"
+
+#define BENCH_WIDTH 3840
+#define BENCH_HEIGHT 2160
+#define BENCH_CHANNELS 4
+#define BENCH_ITERATIONS 5
+
+typedef enum {
+    PASS_HORIZONTAL,
+    PASS_VERTICAL,
+    PASS_HORIZONTAL_FIXED,
+    PASS_VERTICAL_FIXED
+} PassKind;
+
+static const gchar *pass_names[] = { "horizontal", "vertical", "horizontal-fixed", "vertical-fixed" };
+
+/* Best of several runs, in milliseconds */
+static gdouble time_pass(const BlurKernelOps *ops, PassKind kind,
+                         const guchar *src, guchar *dst,
+                         const gfloat *kernel, const gint16 *kernel_fixed,
+                         gint kernel_size) {
+    gint rowstride = BENCH_WIDTH * BENCH_CHANNELS;
+    gdouble best = G_MAXDOUBLE;
+
+    for (gint i = 0; i < BENCH_ITERATIONS; i++) {
+        gint64 start = g_get_monotonic_time();
+
+        switch (kind) {
+        case PASS_HORIZONTAL:
+            ops->horizontal_pass(src, dst, BENCH_WIDTH, rowstride, BENCH_CHANNELS,
+                                kernel, kernel_size, 0, BENCH_HEIGHT);
+            break;
+        case PASS_VERTICAL:
+            ops->vertical_pass(src, dst, BENCH_HEIGHT, rowstride, BENCH_CHANNELS,
+                              kernel, kernel_size, 0, BENCH_WIDTH);
+            break;
+        case PASS_HORIZONTAL_FIXED:
+            ops->horizontal_pass_fixed(src, dst, BENCH_WIDTH, rowstride, BENCH_CHANNELS,
+                                      kernel_fixed, kernel_size, 0, BENCH_HEIGHT);
+            break;
+        case PASS_VERTICAL_FIXED:
+            ops->vertical_pass_fixed(src, dst, BENCH_HEIGHT, rowstride, BENCH_CHANNELS,
+                                    kernel_fixed, kernel_size, 0, BENCH_WIDTH);
+            break;
+        }
+
+        best = MIN(best, (g_get_monotonic_time() - start) / 1000.0);
+    }
+
+    return best;
+}
+
+int main(void) {
+    const gchar *variants[] = { "scalar", "sse4.1", "avx2", "neon" };
+    const gdouble sigmas[] = { 1.0, 2.9 };
+    gsize image_size = (gsize)BENCH_WIDTH * BENCH_HEIGHT * BENCH_CHANNELS;
+
+    guchar *src = g_malloc(image_size);
+    guchar *dst = g_malloc(image_size);
+
+    for (gsize i = 0; i < image_size; i++) {
+        src[i] = (guchar)g_random_int();
+    }
+
+    g_print("%dx%d RGBA, best of %d runs\n", BENCH_WIDTH, BENCH_HEIGHT, BENCH_ITERATIONS);
+    g_print("%-8s %-6s %-20s %10s %8s\n", "kernels", "sigma", "pass", "ms", "ratio");
+
+    for (gsize v = 0; v < G_N_ELEMENTS(variants); v++) {
+        const BlurKernelOps *ops = blur_kernels_select(variants[v]);
+        if (g_strcmp0(ops->name, variants[v]) != 0) {
+            continue; // Not available on this CPU
+        }
+
+        for (gsize s = 0; s < G_N_ELEMENTS(sigmas); s++) {
+            gint kernel_size = blur_calculate_kernel_size(sigmas[s]);
+            gfloat *kernel = blur_generate_kernel(sigmas[s], kernel_size);
+            gint16 *kernel_fixed = blur_generate_kernel_fixed(sigmas[s], kernel_size);
+            gdouble horizontal_ms = 0.0;
+
+            // Ratios are relative to the float horizontal pass
+            for (gint kind = PASS_HORIZONTAL; kind <= PASS_VERTICAL_FIXED; kind++) {
+                gdouble ms = time_pass(ops, kind, src, dst, kernel, kernel_fixed, kernel_size);
+                if (kind == PASS_HORIZONTAL) {
+                    horizontal_ms = ms;
+                }
+                g_print("%-8s %-6.1f %-20s %10.2f %7.2fx\n", ops->name, sigmas[s],
+                        pass_names[kind], ms, ms / horizontal_ms);
+            }
+
+            g_free(kernel);
+            g_free(kernel_fixed);
+        }
+    }
+
+    g_free(dst);
+    g_free(src);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+/* bench-blur.c - Gaussian blur timings through BlurProcessor
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+#include "bench-report.h"
+#include "src/lib/blur-processor.h"
+
+#define BENCH_DEFAULT_ITERATIONS 5
+
+typedef struct {
+    const gchar *name;
+    gint width;
+    gint height;
+} BenchSize;
+
+static const BenchSize sizes[] = {
+    { "vga", 640, 480 },
+    { "hd", 1920, 1080 },
+    { "4k", 3840, 2160 },
+    { "8k", 7680, 4320 },
+};
+
+static const gdouble sigmas[] = { 0.5, 1.0, 2.0, 5.0, 10.0, 20.0 };
+
+// Thread sweep and progressive runs use one representative blur
+#define SWEEP_SIGMA 5.0
+
+static void on_blur_done(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data) {
+    gboolean *done = user_data;
+
+    if (error) {
+        g_error("Blur failed: %s", error->message);
+    }
+
+    // The processor drops its reference after this returns, recycling the buffer
+    *done = TRUE;
+}
+
+static GdkPixbuf* create_source(gint width, gint height, gboolean has_alpha) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, has_alpha, 8, width, height);
+    gint rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    GRand *rand = g_rand_new_with_seed(0x5eed);
+
+    // Noise defeats the gray detection of the single plane path
+    for (gint y = 0; y < height; y++) {
+        guchar *row = pixels + (gsize)y * rowstride;
+        for (gint x = 0; x < rowstride; x++) {
+            row[x] = (guchar)g_rand_int(rand);
+        }
+    }
+
+    g_rand_free(rand);
+    return pixbuf;
+}
+
+// One blocking blur on the main loop, in milliseconds
+static gdouble time_blur(BlurProcessor *processor, GdkPixbuf *source, gdouble sigma,
+                         gboolean is_progressive) {
+    gboolean done = FALSE;
+    gint64 start = g_get_monotonic_time();
+
+    blur_processor_apply_async(processor, source, sigma / 2.0, is_progressive,
+                               on_blur_done, &done);
+    while (!done) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+
+    return bench_elapsed_ms(start);
+}
+
+static void measure(BenchReport *report, const BenchOptions *options,
+                    BlurProcessor *processor, GdkPixbuf *source, const gchar *size_name,
+                    gdouble sigma, gint threads, gboolean is_progressive) {
+    gint width = gdk_pixbuf_get_width(source);
+    gint height = gdk_pixbuf_get_height(source);
+    gdouble *samples = g_new(gdouble, options->iterations);
+
+    // The warm-up run sizes the scratch arenas and the result pool
+    time_blur(processor, source, sigma, is_progressive);
+    for (gint i = 0; i < options->iterations; i++) {
+        samples[i] = time_blur(processor, source, sigma, is_progressive);
+    }
+
+    bench_report_begin(report, is_progressive ? "gaussian-progressive" : "gaussian");
+    bench_report_param_string(report, "size", size_name);
+    bench_report_param_int(report, "width", width);
+    bench_report_param_int(report, "height", height);
+    bench_report_param_string(report, "format", gdk_pixbuf_get_has_alpha(source) ? "rgba" : "rgb");
+    bench_report_param_double(report, "sigma", sigma);
+    bench_report_param_string(report, "engine", sigma >= BLUR_BOX_SIGMA_THRESHOLD ? "box" : "kernel");
+    bench_report_param_int(report, "threads", threads);
+    bench_report_end(report, samples, options->iterations,
+                     (gdouble)width * height / 1e6, "Mpixel/s");
+
+    g_free(samples);
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options = { FALSE, BENCH_DEFAULT_ITERATIONS, NULL };
+    GError *error = NULL;
+    BenchReport *report;
+    gint max_threads = (gint)g_get_num_processors();
+    gsize n_sizes = G_N_ELEMENTS(sizes);
+
+    if (!bench_options_parse(&options, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    if (options.quick) {
+        n_sizes = 2; // VGA and HD
+    }
+
+    report = bench_report_new("blur");
+
+    for (gsize s = 0; s < n_sizes; s++) {
+        // Sized for the image, so no run falls back to tiles
+        BlurProcessor *processor = blur_processor_create(sizes[s].width, sizes[s].height, 0);
+
+        for (gint alpha = 0; alpha <= 1; alpha++) {
+            GdkPixbuf *source = create_source(sizes[s].width, sizes[s].height, alpha);
+
+            for (gsize i = 0; i < G_N_ELEMENTS(sigmas); i++) {
+                if (options.quick && sigmas[i] != 1.0 && sigmas[i] != SWEEP_SIGMA) {
+                    continue;
+                }
+                measure(report, &options, processor, source, sizes[s].name,
+                        sigmas[i], max_threads, FALSE);
+            }
+
+            // The preview path the slider follows; after the warm-up the
+            // downsample is reused, as it is while the slider is dragged
+            measure(report, &options, processor, source, sizes[s].name,
+                    SWEEP_SIGMA, max_threads, TRUE);
+
+            g_object_unref(source);
+        }
+
+        blur_processor_destroy(processor);
+    }
+
+    // Scaling with the worker count, on 4K or the largest size of a quick run
+    const BenchSize *sweep_size = &sizes[MIN(n_sizes - 1, 2)];
+    GdkPixbuf *sweep_source = create_source(sweep_size->width, sweep_size->height, TRUE);
+
+    for (gint threads = 1; ; threads = MIN(threads * 2, max_threads)) {
+        BlurProcessor *processor = blur_processor_create(sweep_size->width, sweep_size->height,
+                                                         threads);
+        measure(report, &options, processor, sweep_source, sweep_size->name,
+                SWEEP_SIGMA, threads, FALSE);
+        blur_processor_destroy(processor);
+
+        if (threads == max_threads) {
+            break;
+        }
+    }
+    g_object_unref(sweep_source);
+
+    if (!bench_report_write(report, options.output, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        bench_report_free(report);
+        return EXIT_FAILURE;
+    }
+
+    bench_report_free(report);
+    g_free(options.output);
+    return EXIT_SUCCESS;
+}
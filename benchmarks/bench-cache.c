@@ -0,0 +1,180 @@
+/* bench-cache.c - BlurCache put and get timings
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+#include "bench-report.h"
+#include "src/lib/blur-cache.h"
+
+#define BENCH_DEFAULT_ITERATIONS 5
+
+// 64 images with every intensity step of the slider
+#define BENCH_IMAGES 64
+#define BENCH_STEPS 100
+#define BENCH_KEYS (BENCH_IMAGES * BENCH_STEPS)
+#define BENCH_MEMORY_LIMIT (512 * 1024 * 1024)
+
+static const guint shard_counts[] = { 1, 16 };
+
+typedef struct {
+    gchar *hashes[BENCH_IMAGES];
+    gchar *missing_hashes[BENCH_IMAGES];
+    GdkPixbuf *pixbuf;      // Shared by every entry; the cache only counts its size
+} BenchKeys;
+
+typedef struct {
+    BlurCache *cache;
+    const BenchKeys *keys;
+} GetThreadData;
+
+static gdouble step_intensity(gint step) {
+    return (step + 1) / 10.0;
+}
+
+static void fill_cache(BlurCache *cache, const BenchKeys *keys) {
+    for (gint i = 0; i < BENCH_IMAGES; i++) {
+        for (gint step = 0; step < BENCH_STEPS; step++) {
+            blur_cache_put(cache, keys->hashes[i], step_intensity(step), keys->pixbuf);
+        }
+    }
+}
+
+static void get_all(BlurCache *cache, gchar *const *hashes) {
+    for (gint step = 0; step < BENCH_STEPS; step++) {
+        for (gint i = 0; i < BENCH_IMAGES; i++) {
+            GdkPixbuf *result = blur_cache_get(cache, hashes[i], step_intensity(step));
+            if (result) {
+                g_object_unref(result);
+            }
+        }
+    }
+}
+
+static gpointer get_thread(gpointer user_data) {
+    GetThreadData *data = user_data;
+
+    get_all(data->cache, data->keys->hashes);
+    return NULL;
+}
+
+typedef enum {
+    OP_PUT,
+    OP_PUT_EVICT,
+    OP_GET_HIT,
+    OP_GET_MISS,
+    OP_GET_HIT_CONCURRENT
+} CacheOp;
+
+static const gchar *op_names[] = { "put", "put-evict", "get-hit", "get-miss", "get-hit-concurrent" };
+
+// One run of BENCH_KEYS operations per thread, in milliseconds
+static gdouble time_op(CacheOp op, guint shards, const BenchKeys *keys, gint threads) {
+    // The evicting cache holds a quarter of the keys, so most puts evict
+    guint max_entries = op == OP_PUT_EVICT ? BENCH_KEYS / 4 : BENCH_KEYS;
+    BlurCache *cache = blur_cache_create_sharded(max_entries, BENCH_MEMORY_LIMIT, shards);
+    GThread *workers[64];
+    GetThreadData data = { cache, keys };
+    gint64 start;
+    gdouble elapsed;
+
+    if (op != OP_PUT && op != OP_PUT_EVICT) {
+        fill_cache(cache, keys);
+    }
+
+    start = g_get_monotonic_time();
+    switch (op) {
+    case OP_PUT:
+    case OP_PUT_EVICT:
+        fill_cache(cache, keys);
+        break;
+    case OP_GET_HIT:
+        get_all(cache, keys->hashes);
+        break;
+    case OP_GET_MISS:
+        get_all(cache, keys->missing_hashes);
+        break;
+    case OP_GET_HIT_CONCURRENT:
+        for (gint t = 0; t < threads; t++) {
+            workers[t] = g_thread_new("bench-cache", get_thread, &data);
+        }
+        for (gint t = 0; t < threads; t++) {
+            g_thread_join(workers[t]);
+        }
+        break;
+    }
+    elapsed = bench_elapsed_ms(start);
+
+    blur_cache_destroy(cache);
+    return elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options = { FALSE, BENCH_DEFAULT_ITERATIONS, NULL };
+    GError *error = NULL;
+    BenchReport *report;
+    BenchKeys keys;
+    gint max_threads = MIN((gint)g_get_num_processors(), 64);
+    gdouble *samples;
+
+    if (!bench_options_parse(&options, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    for (gint i = 0; i < BENCH_IMAGES; i++) {
+        keys.hashes[i] = g_strdup_printf("%016x%016x", g_random_int(), i);
+        keys.missing_hashes[i] = g_strdup_printf("%016x%016x", g_random_int(), i + BENCH_IMAGES);
+    }
+    keys.pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, 16, 16);
+
+    report = bench_report_new("cache");
+    samples = g_new(gdouble, options.iterations);
+
+    for (gsize s = 0; s < G_N_ELEMENTS(shard_counts); s++) {
+        for (gint op = OP_PUT; op <= OP_GET_HIT_CONCURRENT; op++) {
+            gint threads = op == OP_GET_HIT_CONCURRENT ? max_threads : 1;
+
+            if (options.quick && op == OP_GET_HIT_CONCURRENT) {
+                continue;
+            }
+
+            time_op(op, shard_counts[s], &keys, threads);
+            for (gint i = 0; i < options.iterations; i++) {
+                samples[i] = time_op(op, shard_counts[s], &keys, threads);
+            }
+
+            bench_report_begin(report, op_names[op]);
+            bench_report_param_int(report, "shards", shard_counts[s]);
+            bench_report_param_int(report, "keys", BENCH_KEYS);
+            bench_report_param_int(report, "threads", threads);
+            bench_report_end(report, samples, options.iterations,
+                             (gdouble)BENCH_KEYS * threads / 1e6, "Mop/s");
+        }
+    }
+
+    g_free(samples);
+    g_object_unref(keys.pixbuf);
+    for (gint i = 0; i < BENCH_IMAGES; i++) {
+        g_free(keys.hashes[i]);
+        g_free(keys.missing_hashes[i]);
+    }
+
+    if (!bench_report_write(report, options.output, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        bench_report_free(report);
+        return EXIT_FAILURE;
+    }
+
+    bench_report_free(report);
+    g_free(options.output);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/* bench-grayscale.c - Grayscale conversion timings, inline and on the pool
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+#include "bench-report.h"
+#include "src/lib/blur-processor.h"
+#include "src/lib/image-processing.h"
+
+#define BENCH_DEFAULT_ITERATIONS 5
+
+typedef struct {
+    const gchar *name;
+    gint width;
+    gint height;
+} BenchSize;
+
+static const BenchSize sizes[] = {
+    { "vga", 640, 480 },
+    { "hd", 1920, 1080 },
+    { "4k", 3840, 2160 },
+    { "8k", 7680, 4320 },
+};
+
+static void on_grayscale_done(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data) {
+    gboolean *done = user_data;
+
+    if (error) {
+        g_error("Grayscale conversion failed: %s", error->message);
+    }
+
+    *done = TRUE;
+}
+
+static GdkPixbuf* create_source(gint width, gint height, gboolean has_alpha) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, has_alpha, 8, width, height);
+    gint rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    GRand *rand = g_rand_new_with_seed(0x5eed);
+
+    for (gint y = 0; y < height; y++) {
+        guchar *row = pixels + (gsize)y * rowstride;
+        for (gint x = 0; x < rowstride; x++) {
+            row[x] = (guchar)g_rand_int(rand);
+        }
+    }
+
+    g_rand_free(rand);
+    return pixbuf;
+}
+
+static gdouble time_convert(GdkPixbuf *source) {
+    GError *error = NULL;
+    gint64 start = g_get_monotonic_time();
+    GdkPixbuf *result = image_processor_convert_to_grayscale(source, &error);
+    gdouble elapsed = bench_elapsed_ms(start);
+
+    if (!result) {
+        g_error("Grayscale conversion failed: %s", error->message);
+    }
+
+    g_object_unref(result);
+    return elapsed;
+}
+
+static gdouble time_convert_async(BlurProcessor *processor, GdkPixbuf *source) {
+    gboolean done = FALSE;
+    gint64 start = g_get_monotonic_time();
+
+    blur_processor_grayscale_async(processor, source, BLUR_PRIORITY_NORMAL,
+                                   on_grayscale_done, &done);
+    while (!done) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+
+    return bench_elapsed_ms(start);
+}
+
+static void report_result(BenchReport *report, const gchar *name, GdkPixbuf *source,
+                          const gchar *size_name, gint threads,
+                          const gdouble *samples, gint n_samples) {
+    gint width = gdk_pixbuf_get_width(source);
+    gint height = gdk_pixbuf_get_height(source);
+
+    bench_report_begin(report, name);
+    bench_report_param_string(report, "size", size_name);
+    bench_report_param_int(report, "width", width);
+    bench_report_param_int(report, "height", height);
+    bench_report_param_string(report, "format", gdk_pixbuf_get_has_alpha(source) ? "rgba" : "rgb");
+    bench_report_param_int(report, "threads", threads);
+    bench_report_end(report, samples, n_samples, (gdouble)width * height / 1e6, "Mpixel/s");
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options = { FALSE, BENCH_DEFAULT_ITERATIONS, NULL };
+    GError *error = NULL;
+    BenchReport *report;
+    gsize n_sizes = G_N_ELEMENTS(sizes);
+    gdouble *samples;
+
+    if (!bench_options_parse(&options, &argc, &argv, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    if (options.quick) {
+        n_sizes = 2; // VGA and HD
+    }
+
+    report = bench_report_new("grayscale");
+    samples = g_new(gdouble, options.iterations);
+
+    for (gsize s = 0; s < n_sizes; s++) {
+        BlurProcessor *processor = blur_processor_create(sizes[s].width, sizes[s].height, 0);
+
+        for (gint alpha = 0; alpha <= 1; alpha++) {
+            GdkPixbuf *source = create_source(sizes[s].width, sizes[s].height, alpha);
+
+            // The synchronous converter runs on the calling thread
+            time_convert(source);
+            for (gint i = 0; i < options.iterations; i++) {
+                samples[i] = time_convert(source);
+            }
+            report_result(report, "convert-to-grayscale", source, sizes[s].name, 1,
+                          samples, options.iterations);
+
+            // The viewer's path, in row bands across the worker pool
+            time_convert_async(processor, source);
+            for (gint i = 0; i < options.iterations; i++) {
+                samples[i] = time_convert_async(processor, source);
+            }
+            report_result(report, "grayscale-async", source, sizes[s].name,
+                          (gint)g_get_num_processors(), samples, options.iterations);
+
+            g_object_unref(source);
+        }
+
+        blur_processor_destroy(processor);
+    }
+
+    g_free(samples);
+
+    if (!bench_report_write(report, options.output, &error)) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        bench_report_free(report);
+        return EXIT_FAILURE;
+    }
+
+    bench_report_free(report);
+    g_free(options.output);
+    return EXIT_SUCCESS;
+}
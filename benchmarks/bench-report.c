@@ -0,0 +1,190 @@
+/* bench-report.c - Shared timing and JSON output of the benchmarks
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "bench-report.h"
+#include "src/lib/blur-kernels.h"
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct _BenchReport {
+    GString *json;
+    GString *summary;       // Human readable line of the open result
+    gboolean has_results;
+    gboolean has_params;
+};
+
+gboolean bench_options_parse(BenchOptions *options, int *argc, char ***argv, GError **error) {
+    GOptionEntry entries[] = {
+        { "quick", 'q', 0, G_OPTION_ARG_NONE, &options->quick,
+          "Run a reduced matrix", NULL },
+        { "iterations", 'n', 0, G_OPTION_ARG_INT, &options->iterations,
+          "Timed runs per measurement", "N" },
+        { "output", 'o', 0, G_OPTION_ARG_FILENAME, &options->output,
+          "Write the JSON report to FILE instead of stdout", "FILE" },
+        { NULL }
+    };
+    GOptionContext *context = g_option_context_new(NULL);
+    gboolean parsed;
+
+    g_option_context_add_main_entries(context, entries, NULL);
+    parsed = g_option_context_parse(context, argc, argv, error);
+    g_option_context_free(context);
+
+    if (parsed && options->iterations < 1) {
+        g_set_error(error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                    "--iterations must be at least 1");
+        return FALSE;
+    }
+
+    return parsed;
+}
+
+BenchReport* bench_report_new(const gchar *suite) {
+    BenchReport *report = g_new0(BenchReport, 1);
+    const BlurKernelOps *ops = blur_kernels_select(g_getenv("BLUR_PROCESSOR_SIMD"));
+    GDateTime *now = g_date_time_new_now_utc();
+    gchar *timestamp = g_date_time_format_iso8601(now);
+
+    report->json = g_string_new(NULL);
+    report->summary = g_string_new(NULL);
+
+    g_string_append_printf(report->json,
+                           "{\n"
+                           "  \"suite\": \"%s\",\n"
+                           "  \"version\": \"%s\",\n"
+                           "  \"timestamp\": \"%s\",\n"
+                           "  \"cpus\": %u,\n"
+                           "  \"kernels\": \"%s\",\n"
+                           "  \"results\": [",
+                           suite, VERSION, timestamp, g_get_num_processors(), ops->name);
+
+    g_free(timestamp);
+    g_date_time_unref(now);
+    return report;
+}
+
+void bench_report_begin(BenchReport *report, const gchar *name) {
+    g_string_append_printf(report->json, "%s\n    { \"name\": \"%s\", \"params\": {",
+                           report->has_results ? "," : "", name);
+    g_string_assign(report->summary, name);
+    report->has_results = TRUE;
+    report->has_params = FALSE;
+}
+
+// Every parameter goes to the JSON object and the summary line
+static void append_param(BenchReport *report, const gchar *key, const gchar *json_value,
+                         const gchar *text_value) {
+    g_string_append_printf(report->json, "%s\"%s\": %s",
+                           report->has_params ? ", " : " ", key, json_value);
+    g_string_append_printf(report->summary, " %s=%s", key, text_value);
+    report->has_params = TRUE;
+}
+
+void bench_report_param_int(BenchReport *report, const gchar *key, gint64 value) {
+    gchar *text = g_strdup_printf("%" G_GINT64_FORMAT, value);
+
+    append_param(report, key, text, text);
+    g_free(text);
+}
+
+void bench_report_param_double(BenchReport *report, const gchar *key, gdouble value) {
+    gchar text[G_ASCII_DTOSTR_BUF_SIZE];
+
+    // Locale independent, so the report stays valid JSON everywhere
+    g_ascii_formatd(text, sizeof(text), "%g", value);
+    append_param(report, key, text, text);
+}
+
+void bench_report_param_string(BenchReport *report, const gchar *key, const gchar *value) {
+    gchar *quoted = g_strdup_printf("\"%s\"", value);
+
+    append_param(report, key, quoted, value);
+    g_free(quoted);
+}
+
+static gint compare_doubles(gconstpointer a, gconstpointer b) {
+    gdouble x = *(const gdouble *)a;
+    gdouble y = *(const gdouble *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void append_number(GString *json, const gchar *key, gdouble value) {
+    gchar text[G_ASCII_DTOSTR_BUF_SIZE];
+
+    g_ascii_formatd(text, sizeof(text), "%.4f", value);
+    g_string_append_printf(json, ", \"%s\": %s", key, text);
+}
+
+void bench_report_end(BenchReport *report,
+                      const gdouble *samples_ms,
+                      guint n_samples,
+                      gdouble work,
+                      const gchar *work_unit) {
+    gdouble *sorted;
+    gdouble median, sum = 0.0;
+
+    g_return_if_fail(n_samples > 0);
+
+    sorted = g_new(gdouble, n_samples);
+    memcpy(sorted, samples_ms, n_samples * sizeof(gdouble));
+    qsort(sorted, n_samples, sizeof(gdouble), compare_doubles);
+    median = n_samples % 2 ? sorted[n_samples / 2] :
+        (sorted[n_samples / 2 - 1] + sorted[n_samples / 2]) / 2.0;
+    for (guint i = 0; i < n_samples; i++) {
+        sum += sorted[i];
+    }
+
+    g_string_append_printf(report->json, "%s}, \"iterations\": %u",
+                           report->has_params ? " " : "", n_samples);
+    append_number(report->json, "min_ms", sorted[0]);
+    append_number(report->json, "median_ms", median);
+    append_number(report->json, "mean_ms", sum / n_samples);
+    append_number(report->json, "max_ms", sorted[n_samples - 1]);
+    append_number(report->json, "throughput", median > 0.0 ? work / (median / 1000.0) : 0.0);
+    g_string_append_printf(report->json, ", \"throughput_unit\": \"%s\" }", work_unit);
+
+    g_printerr("%-70s %10.3f ms\n", report->summary->str, median);
+
+    g_free(sorted);
+}
+
+gboolean bench_report_write(BenchReport *report, const gchar *path, GError **error) {
+    GString *json = g_string_new(report->json->str);
+    gboolean written = TRUE;
+
+    g_string_append(json, "\n  ]\n}\n");
+
+    if (path) {
+        written = g_file_set_contents(path, json->str, json->len, error);
+    } else {
+        fputs(json->str, stdout);
+        fflush(stdout);
+    }
+
+    g_string_free(json, TRUE);
+    return written;
+}
+
+void bench_report_free(BenchReport *report) {
+    if (!report) {
+        return;
+    }
+
+    g_string_free(report->json, TRUE);
+    g_string_free(report->summary, TRUE);
+    g_free(report);
+}
+
+gdouble bench_elapsed_ms(gint64 start) {
+    return (g_get_monotonic_time() - start) / 1000.0;
+}
@@ -0,0 +1,132 @@
+/* bench-report.h - Shared timing and JSON output of the benchmarks
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _BenchReport BenchReport;
+
+/**
+ * BenchOptions:
+ * @quick: Run a reduced matrix, for a smoke run
+ * @iterations: Timed runs per measurement, after one warm-up run
+ * @output: File to write the JSON report to, NULL for stdout
+ *
+ * Command line shared by every benchmark
+ */
+typedef struct {
+    gboolean quick;
+    gint iterations;
+    gchar *output;
+} BenchOptions;
+
+/**
+ * bench_options_parse:
+ * @options: Options to fill, @iterations preset to the default
+ * @argc: Argument count
+ * @argv: Arguments
+ * @error: Return location for a #G_OPTION_ERROR
+ *
+ * Parses `--quick`, `--iterations=N` and `--output=FILE`.
+ *
+ * Returns: TRUE on success
+ */
+gboolean bench_options_parse(BenchOptions *options, int *argc, char ***argv, GError **error);
+
+/**
+ * bench_report_new:
+ * @suite: Name of the benchmark program, such as "blur"
+ *
+ * Starts a JSON report. Besides the results it records the version, time,
+ * CPU count and the blur kernels picked for this CPU, so reports of
+ * different releases and machines can be told apart.
+ *
+ * Returns: New BenchReport
+ */
+BenchReport* bench_report_new(const gchar *suite);
+
+/**
+ * bench_report_begin:
+ * @report: BenchReport instance
+ * @name: Name of the measured operation
+ *
+ * Starts a result; add its parameters, then close it with bench_report_end().
+ */
+void bench_report_begin(BenchReport *report, const gchar *name);
+
+/**
+ * bench_report_param_int:
+ * @report: BenchReport instance
+ * @key: Parameter name
+ * @value: Parameter value
+ */
+void bench_report_param_int(BenchReport *report, const gchar *key, gint64 value);
+
+/**
+ * bench_report_param_double:
+ * @report: BenchReport instance
+ * @key: Parameter name
+ * @value: Parameter value
+ */
+void bench_report_param_double(BenchReport *report, const gchar *key, gdouble value);
+
+/**
+ * bench_report_param_string:
+ * @report: BenchReport instance
+ * @key: Parameter name
+ * @value: Parameter value, plain ASCII without quotes
+ */
+void bench_report_param_string(BenchReport *report, const gchar *key, const gchar *value);
+
+/**
+ * bench_report_end:
+ * @report: BenchReport instance
+ * @samples_ms: Duration of each timed run in milliseconds
+ * @n_samples: Number of @samples_ms
+ * @work: Units of work done by one run, such as megapixels
+ * @work_unit: Name of the throughput unit, such as "Mpixel/s"
+ *
+ * Closes the result with min, median, mean and max of @samples_ms and the
+ * median throughput, and prints a one-line summary to stderr.
+ */
+void bench_report_end(BenchReport *report,
+                      const gdouble *samples_ms,
+                      guint n_samples,
+                      gdouble work,
+                      const gchar *work_unit);
+
+/**
+ * bench_report_write:
+ * @report: BenchReport instance
+ * @path: (nullable): File to write, NULL for stdout
+ * @error: Return location for a #G_FILE_ERROR
+ *
+ * Returns: TRUE if the report was written
+ */
+gboolean bench_report_write(BenchReport *report, const gchar *path, GError **error);
+
+/**
+ * bench_report_free:
+ * @report: BenchReport instance
+ */
+void bench_report_free(BenchReport *report);
+
+/**
+ * bench_elapsed_ms:
+ * @start: Value of g_get_monotonic_time() when the run started
+ *
+ * Returns: Milliseconds since @start
+ */
+gdouble bench_elapsed_ms(gint64 start);
+
+G_END_DECLS
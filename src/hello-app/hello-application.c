@@ -2,10 +2,35 @@
 #include "hello-window.h"
 #include "config.h"
 
+/* One budget for every window: the fair share shrinks as windows open,
+ * so total blur memory stays flat. The sizes suit 8GB of RAM and scale
+ * with the memory actually installed. */
+#define SHARED_BLUR_CACHE_ENTRIES 96
+#define SHARED_BLUR_CACHE_MEMORY (256 * 1024 * 1024)
+#define SHARED_BLUR_CACHE_SHARDS 8
+
+/* Low memory warnings shrink the cache budget this long after the last one */
+#define LOW_MEMORY_RESTORE_SECONDS 60
+
+/* Persistent results under $XDG_CACHE_HOME: 1GB, dropped after 30 days unused */
+#define DISK_CACHE_MAX_BYTES (G_GUINT64_CONSTANT(1024) * 1024 * 1024)
+#define DISK_CACHE_MAX_AGE_SECONDS (30 * 24 * 60 * 60)
+
 struct _HelloApplication {
     GtkApplication parent_instance;
     
     GtkWindow *main_window;
+    
+    /* Blur resources shared by all image viewer windows */
+    BlurProcessor *blur_processor;
+    BlurCache *blur_cache;
+    guint blur_cache_entries;
+    gsize blur_cache_memory;
+    
+    /* Low memory handling; the divisor applies to the cache budget */
+    GMemoryMonitor *memory_monitor;
+    guint memory_restore_id;
+    guint memory_divisor;
 };
 
 G_DEFINE_FINAL_TYPE(HelloApplication, hello_application, GTK_TYPE_APPLICATION)
@@ -29,9 +54,40 @@ hello_application_activate(GApplication *app)
     gtk_window_present(window);
 }
 
+/**
+ * restore_blur_cache_budget:
+ * @user_data: The HelloApplication instance
+ * 
+ * Gives the cache its full budget back once low memory warnings stopped.
+ * 
+ * Returns: G_SOURCE_REMOVE
+ */
+static gboolean
+restore_blur_cache_budget(gpointer user_data)
+{
+    HelloApplication *app = HELLO_APPLICATION(user_data);
+    
+    app->memory_restore_id = 0;
+    app->memory_divisor = 1;
+    if (app->blur_cache != NULL)
+        blur_cache_set_limits(app->blur_cache, app->blur_cache_entries, app->blur_cache_memory);
+    
+    return G_SOURCE_REMOVE;
+}
+
+static void
+on_low_memory_warning(GMemoryMonitor             *monitor,
+                      GMemoryMonitorWarningLevel  level,
+                      gpointer                    user_data)
+{
+    hello_application_handle_low_memory(HELLO_APPLICATION(user_data), level);
+}
+
 static void
 hello_application_startup(GApplication *app)
 {
+    HelloApplication *hello_app = HELLO_APPLICATION(app);
+    
     /* Chain up to the parent class */
     G_APPLICATION_CLASS(hello_application_parent_class)->startup(app);
     
@@ -40,6 +96,14 @@ hello_application_startup(GApplication *app)
                  "application-id", APPLICATION_ID,
                  "flags", G_APPLICATION_DEFAULT_FLAGS,
                  NULL);
+    
+    /* Warnings from the system (memory pressure on Linux) trim the blur
+     * resources before the kernel has to */
+    hello_app->memory_monitor = g_memory_monitor_dup_default();
+    if (hello_app->memory_monitor != NULL) {
+        g_signal_connect_object(hello_app->memory_monitor, "low-memory-warning",
+                                G_CALLBACK(on_low_memory_warning), hello_app, 0);
+    }
 }
 
 static void
@@ -48,6 +112,12 @@ hello_application_dispose(GObject *object)
     HelloApplication *app = HELLO_APPLICATION(object);
 
     g_clear_object(&app->main_window);
+    g_clear_object(&app->memory_monitor);
+    g_clear_handle_id(&app->memory_restore_id, g_source_remove);
+
+    /* Windows have released their owners and requests by now */
+    g_clear_pointer(&app->blur_processor, blur_processor_destroy);
+    g_clear_pointer(&app->blur_cache, blur_cache_destroy);
 
     G_OBJECT_CLASS(hello_application_parent_class)->dispose(object);
 }
@@ -68,6 +138,16 @@ static void
 hello_application_init(HelloApplication *app)
 {
     app->main_window = NULL;
+    app->blur_processor = NULL;
+    app->blur_cache = NULL;
+    app->memory_monitor = NULL;
+    app->memory_restore_id = 0;
+    app->memory_divisor = 1;
+    
+    /* Budgets follow the installed memory, entries in the same proportion */
+    app->blur_cache_memory = blur_cache_scale_to_ram(SHARED_BLUR_CACHE_MEMORY, 0);
+    app->blur_cache_entries = MAX(1, (guint)((guint64)SHARED_BLUR_CACHE_ENTRIES *
+                                             app->blur_cache_memory / SHARED_BLUR_CACHE_MEMORY));
 }
 
 HelloApplication *
@@ -86,3 +166,83 @@ hello_application_get_main_window(HelloApplication *app)
     
     return app->main_window;
 }
+
+BlurProcessor *
+hello_application_get_blur_processor(HelloApplication *app)
+{
+    g_return_val_if_fail(HELLO_IS_APPLICATION(app), NULL);
+
+    if (app->blur_processor == NULL) {
+        /* Support up to 4K images with optimal threading */
+        app->blur_processor = blur_processor_create(3840, 2160, 0);
+        if (app->blur_processor != NULL)
+            blur_processor_set_schedule_mode(app->blur_processor, BLUR_SCHEDULE_LATEST_WINS);
+    }
+
+    return app->blur_processor;
+}
+
+BlurCache *
+hello_application_get_blur_cache(HelloApplication *app)
+{
+    g_return_val_if_fail(HELLO_IS_APPLICATION(app), NULL);
+
+    if (app->blur_cache == NULL) {
+        gchar *directory = blur_disk_cache_get_default_directory(APPLICATION_ID);
+        GError *error = NULL;
+        BlurDiskCache *disk_cache;
+
+        app->blur_cache = blur_cache_create_sharded(app->blur_cache_entries,
+                                                    app->blur_cache_memory,
+                                                    SHARED_BLUR_CACHE_SHARDS);
+
+        /* Without a usable cache directory results just stay in memory */
+        disk_cache = blur_disk_cache_create(directory, DISK_CACHE_MAX_BYTES,
+                                            DISK_CACHE_MAX_AGE_SECONDS, &error);
+        if (disk_cache != NULL) {
+            blur_cache_set_disk_tier(app->blur_cache, disk_cache);
+        } else {
+            g_warning("Disk cache disabled: %s", error->message);
+            g_error_free(error);
+        }
+        g_free(directory);
+    }
+
+    return app->blur_cache;
+}
+
+void
+hello_application_handle_low_memory(HelloApplication           *app,
+                                    GMemoryMonitorWarningLevel  level)
+{
+    guint divisor;
+    
+    g_return_if_fail(HELLO_IS_APPLICATION(app));
+    
+    /* Speculative results and memory kept only for speed go first */
+    if (app->blur_cache != NULL)
+        blur_cache_drop_speculative(app->blur_cache);
+    if (app->blur_processor != NULL)
+        blur_processor_release_memory(app->blur_processor);
+    
+    if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL)
+        divisor = 8;
+    else if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM)
+        divisor = 4;
+    else
+        divisor = 2;
+    
+    /* A milder warning never grows a budget a worse one shrank */
+    app->memory_divisor = MAX(app->memory_divisor, divisor);
+    if (app->blur_cache != NULL) {
+        if (level >= G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL)
+            blur_cache_clear(app->blur_cache);
+        blur_cache_set_limits(app->blur_cache,
+                              MAX(1, app->blur_cache_entries / app->memory_divisor),
+                              MAX(1024 * 1024, app->blur_cache_memory / app->memory_divisor));
+    }
+    
+    g_clear_handle_id(&app->memory_restore_id, g_source_remove);
+    app->memory_restore_id = g_timeout_add_seconds(LOW_MEMORY_RESTORE_SECONDS,
+                                                   restore_blur_cache_budget, app);
+}
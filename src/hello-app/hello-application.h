@@ -2,6 +2,8 @@
 #define HELLO_APPLICATION_H
 
 #include <gtk/gtk.h>
+#include "../lib/blur-processor.h"
+#include "../lib/blur-cache.h"
 
 G_BEGIN_DECLS
 
@@ -27,6 +29,44 @@ HelloApplication *hello_application_new(void);
  */
 GtkWindow *hello_application_get_main_window(HelloApplication *app);
 
+/**
+ * hello_application_get_blur_processor:
+ * @app: A HelloApplication instance
+ * 
+ * Gets the blur processor shared by all windows, creating it on first use.
+ * Its worker threads are started once per application, not per window.
+ * 
+ * Returns: (transfer none): The shared processor, or NULL if it could not be created
+ */
+BlurProcessor *hello_application_get_blur_processor(HelloApplication *app);
+
+/**
+ * hello_application_get_blur_cache:
+ * @app: A HelloApplication instance
+ * 
+ * Gets the blur cache shared by all windows, creating it on first use.
+ * Windows register as cache owners so the single memory budget is split
+ * fairly between them. Results also persist in a disk tier under
+ * `$XDG_CACHE_HOME`, when that directory is usable.
+ * 
+ * Returns: (transfer none): The shared cache, or NULL if it could not be created
+ */
+BlurCache *hello_application_get_blur_cache(HelloApplication *app);
+
+/**
+ * hello_application_handle_low_memory:
+ * @app: A HelloApplication instance
+ * @level: How severe the shortage is
+ * 
+ * Responds to a low memory warning, as the application does for the
+ * #GMemoryMonitor::low-memory-warning signal. Prefetched blur results are
+ * dropped and the processor's idle buffers freed, then the cache budget is
+ * cut to a half, a quarter or (emptying the cache) an eighth, depending on
+ * @level. The full budget returns a minute after the last warning.
+ */
+void hello_application_handle_low_memory(HelloApplication           *app,
+                                         GMemoryMonitorWarningLevel  level);
+
 G_END_DECLS
 
 #endif /* HELLO_APPLICATION_H */
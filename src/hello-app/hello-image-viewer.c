@@ -1,10 +1,16 @@
 #include "hello-image-viewer.h"
+#include "hello-application.h"
 #include "../lib/image-processing.h"
+#include "../lib/image-hash.h"
 #include "../lib/blur-processor.h"
 #include "../lib/blur-cache.h"
+#include "../lib/blur-prefetch.h"
+#include "../lib/gtk-utils.h"
 #include "config.h"
 #include <glib/gi18n.h>
 
+typedef struct _ImageLoad ImageLoad;
+
 struct _HelloImageViewer {
     GtkWindow parent_instance;
     
@@ -19,21 +25,69 @@ struct _HelloImageViewer {
     GtkWidget *blur_container;
     
     /* Image data for B&W conversion */
-    GdkPixbuf *original_pixbuf;     /* Never modified, session-persistent */
+    GdkPixbuf *original_pixbuf;     /* Never modified, session-persistent; may be a proxy */
     GdkPixbuf *converted_pixbuf;    /* Created/freed as needed */
     gboolean is_converted;          /* Current conversion state */
     
     /* Blur processing data - T020 */
     BlurProcessor *blur_processor;
     BlurCache *blur_cache;
+    BlurPrefetcher *blur_prefetcher;    /* Neighbor intensities while idle */
+    guint blur_cache_owner;         /* Fair-share owner id in blur_cache */
+    gboolean owns_blur_resources;   /* Private processor/cache, not the app's */
     gdouble blur_intensity;         /* Current blur intensity 0.0-10.0 */
     guint blur_timeout_id;          /* Debouncing timer ID */
+    guint blur_tick_id;             /* Dispatch on the next frame instead */
+    gboolean slider_dragging;       /* Pointer or touch held on the slider */
+    gboolean blur_dispatch_deferred;    /* Full quality blur waits for the drag to end */
     guint active_blur_request;      /* Currently processing request ID */
+    guint preview_blur_request;     /* Downscaled preview in flight */
+    gboolean preview_pending;       /* Intensity changed while a preview ran */
+    gboolean display_is_final;      /* Full quality result is on screen */
     GdkPixbuf *current_display_pixbuf;  /* Currently displayed image */
-    gchar *image_hash;              /* Hash of original image for cache keys */
+    gchar *image_hash;              /* Content hash of original image, NULL while hashing */
+    gchar *blur_key;                /* image_hash plus pipeline state, blur cache key */
+    GCancellable *hash_cancellable; /* Content hash running on a worker */
+    guint grayscale_request;        /* Grayscale conversion in flight */
+    
+    /* Render tree blur; the CPU engine still serves exports and Cairo */
+    gboolean gpu_blur_enabled;      /* Use the GPU path when the renderer has one */
+    GdkPaintable *gpu_paintable;    /* Uploaded base image, blurred while drawn */
+    GdkPixbuf *gpu_base_pixbuf;     /* Image gpu_paintable was uploaded from */
+    
+    /* Adaptive debounce: full quality blur cost of the current base image */
+    gint64 blur_cost_us[2];         /* Moving average per engine (kernel, box), 0 until measured */
+    gint64 blur_dispatch_time;      /* Submission of active_blur_request */
+    gint blur_dispatch_engine;      /* Engine index of active_blur_request */
+    gint64 fixed_blur_cost_us;      /* Recorded instead of the measured cost, 0 to measure */
+    
+    /* Debug overlay with live timings */
+    GtkWidget *debug_overlay;
+    guint debug_overlay_id;         /* Refresh timer while the overlay is shown */
+    gint64 blur_input_time;         /* Last slider change, 0 once final is shown */
+    gint64 preview_display_us;      /* Slider change until the last preview showed */
+    gint64 final_display_us;        /* Slider change until the last final result showed */
     
     /* File information */
     char *current_filename;
+    HelloImageViewerLoadMode load_mode;
+    gint source_width;              /* Full resolution size of the file */
+    gint source_height;
+    gdouble proxy_scale;            /* original_pixbuf width / source_width */
+    ImageLoad *image_load;          /* Streaming load in progress, owned by its read chain */
+    guint partial_update_id;        /* Throttled display of partially decoded rows */
+};
+
+/* One streaming load; freed by whichever read callback sees it end */
+struct _ImageLoad {
+    HelloImageViewer *viewer;       /* Strong reference held by the read chain */
+    GFile *file;
+    GInputStream *stream;
+    GdkPixbufLoader *loader;
+    GCancellable *cancellable;
+    gboolean loader_closed;
+    gint source_width;              /* Size before proxy scaling */
+    gint source_height;
 };
 
 G_DEFINE_FINAL_TYPE(HelloImageViewer, hello_image_viewer, GTK_TYPE_WINDOW)
@@ -43,28 +97,80 @@ G_DEFINE_FINAL_TYPE(HelloImageViewer, hello_image_viewer, GTK_TYPE_WINDOW)
 #define DEFAULT_WINDOW_HEIGHT 400
 #define DEFAULT_WINDOW_TITLE  "Image Viewer"
 
+/* Streaming load: bytes fed to the decoder per main loop turn, and the
+ * minimum interval between repaints of the partially decoded image */
+#define LOAD_CHUNK_SIZE            (64 * 1024)
+#define PARTIAL_UPDATE_INTERVAL_MS 150
+
+/* Proxy bounds when no monitor is known yet */
+#define PROXY_FALLBACK_WIDTH  1920
+#define PROXY_FALLBACK_HEIGHT 1080
+
+/* Refresh interval of the debug overlay */
+#define DEBUG_OVERLAY_INTERVAL_MS 500
+
+/* Adaptive debounce. Until a blur of the image was timed the delay is the
+ * fixed default; blurs within a frame budget follow every frame, slower
+ * ones wait about as long as one takes, and beyond the preview-only cost
+ * a drag shows previews and the full blur starts on release */
+#define BLUR_DEBOUNCE_DEFAULT_MS  100
+#define BLUR_DEBOUNCE_MIN_MS      16
+#define BLUR_DEBOUNCE_MAX_MS      250
+#define BLUR_FRAME_BUDGET_US      (16 * 1000)
+#define BLUR_PREVIEW_ONLY_US      (250 * 1000)
+
 /* Forward declarations */
 static void on_conversion_button_toggled(GtkToggleButton *button, HelloImageViewer *viewer);
 static void on_blur_scale_value_changed(GtkScale *scale, HelloImageViewer *viewer);
+static gboolean on_blur_scale_event(GtkEventControllerLegacy *controller,
+                                    GdkEvent                 *event,
+                                    HelloImageViewer         *viewer);
 static gboolean blur_debounce_timeout(gpointer user_data);
 static void blur_completion_callback(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data);
-static gchar* calculate_image_hash(GdkPixbuf *pixbuf);
+static void request_blur_preview(HelloImageViewer *viewer);
+static void cancel_blur_requests(HelloImageViewer *viewer);
+static void schedule_blur_prefetch(HelloImageViewer *viewer);
+static void schedule_blur_dispatch(HelloImageViewer *viewer, gint delay_ms);
+static void start_image_hash(HelloImageViewer *viewer, GdkPixbuf *pixbuf);
+static void update_blur_key(HelloImageViewer *viewer);
 static void update_display_image(HelloImageViewer *viewer);
+static void cancel_image_load(HelloImageViewer *viewer);
+static void cancel_grayscale_conversion(HelloImageViewer *viewer);
+static gboolean show_gpu_blur(HelloImageViewer *viewer);
+static void clear_gpu_blur(HelloImageViewer *viewer);
+static void record_time_to_display(HelloImageViewer *viewer, gboolean is_final);
+static void cancel_blur_dispatch(HelloImageViewer *viewer);
+static void reset_blur_cost(HelloImageViewer *viewer);
 
 static void
 hello_image_viewer_dispose(GObject *object)
 {
     HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(object);
     
+    /* A pending read holds a reference until its callback sees the cancel */
+    cancel_image_load(viewer);
+    
+    /* The hash task holds a reference until its callback sees the cancel */
+    if (viewer->hash_cancellable) {
+        g_cancellable_cancel(viewer->hash_cancellable);
+        g_clear_object(&viewer->hash_cancellable);
+    }
+    
+    /* The conversion callback borrows the viewer */
+    cancel_grayscale_conversion(viewer);
+    
     /* Cancel any active blur processing */
-    if (viewer->blur_timeout_id > 0) {
-        g_source_remove(viewer->blur_timeout_id);
-        viewer->blur_timeout_id = 0;
+    cancel_blur_dispatch(viewer);
+    
+    /* The overlay reads the processor and cache, which go below */
+    if (viewer->debug_overlay_id > 0) {
+        g_source_remove(viewer->debug_overlay_id);
+        viewer->debug_overlay_id = 0;
     }
     
-    if (viewer->blur_processor && viewer->active_blur_request > 0) {
-        blur_processor_cancel(viewer->blur_processor, viewer->active_blur_request);
-        viewer->active_blur_request = 0;
+    if (viewer->blur_processor &&
+        (viewer->active_blur_request > 0 || viewer->preview_blur_request > 0)) {
+        cancel_blur_requests(viewer);
         
         /* Give a moment for the cancel callback to complete */
         while (g_main_context_pending(NULL)) {
@@ -73,18 +179,31 @@ hello_image_viewer_dispose(GObject *object)
     }
     
     /* Clear blur resources with extra safety */
-    if (viewer->blur_processor) {
+    if (viewer->blur_prefetcher) {
+        blur_prefetcher_destroy(viewer->blur_prefetcher);
+        viewer->blur_prefetcher = NULL;
+    }
+    
+    /* Hand this window's share of the cache back to the other windows */
+    if (viewer->blur_cache_owner > 0) {
+        blur_cache_unregister_owner(viewer->blur_cache, viewer->blur_cache_owner);
+        viewer->blur_cache_owner = 0;
+    }
+    
+    /* Shared resources belong to the application */
+    if (viewer->blur_processor && viewer->owns_blur_resources) {
         /* Wait for any pending thread pool operations */
         blur_processor_destroy(viewer->blur_processor);
-        viewer->blur_processor = NULL;
     }
+    viewer->blur_processor = NULL;
     
-    if (viewer->blur_cache) {
+    if (viewer->blur_cache && viewer->owns_blur_resources) {
         blur_cache_destroy(viewer->blur_cache);
-        viewer->blur_cache = NULL;
     }
+    viewer->blur_cache = NULL;
     
     /* Clear pixbuf references */
+    clear_gpu_blur(viewer);
     g_clear_object(&viewer->original_pixbuf);
     g_clear_object(&viewer->converted_pixbuf);
     g_clear_object(&viewer->current_display_pixbuf);
@@ -99,16 +218,60 @@ hello_image_viewer_finalize(GObject *object)
     
     g_free(viewer->current_filename);
     g_free(viewer->image_hash);
+    g_free(viewer->blur_key);
     
     G_OBJECT_CLASS(hello_image_viewer_parent_class)->finalize(object);
 }
 
+/**
+ * hello_image_viewer_constructed:
+ * @object: The HelloImageViewer instance
+ * 
+ * Picks up the blur processor and cache once the application is known.
+ * Windows of a HelloApplication share the application's resources, so
+ * opening more windows adds no worker threads and no cache budget; other
+ * applications get private ones.
+ */
+static void
+hello_image_viewer_constructed(GObject *object)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(object);
+    GtkApplication *app;
+    
+    G_OBJECT_CLASS(hello_image_viewer_parent_class)->constructed(object);
+    
+    app = gtk_window_get_application(GTK_WINDOW(viewer));
+    if (HELLO_IS_APPLICATION(app)) {
+        viewer->blur_processor = hello_application_get_blur_processor(HELLO_APPLICATION(app));
+        viewer->blur_cache = hello_application_get_blur_cache(HELLO_APPLICATION(app));
+        viewer->owns_blur_resources = FALSE;
+    } else {
+        viewer->blur_processor = blur_processor_create(3840, 2160, 0); // Max 4K, auto-detect threads
+        if (viewer->blur_processor) {
+            /* Slider input only ever needs the newest queued request */
+            blur_processor_set_schedule_mode(viewer->blur_processor, BLUR_SCHEDULE_LATEST_WINS);
+        }
+        /* 24 entries in 150MB on 8GB of RAM, scaled to the memory installed */
+        gsize cache_memory = blur_cache_scale_to_ram(150 * 1024 * 1024, 0);
+        viewer->blur_cache = blur_cache_create(MAX(1, (guint)((guint64)24 * cache_memory /
+                                                              (150 * 1024 * 1024))),
+                                               cache_memory);
+        viewer->owns_blur_resources = TRUE;
+    }
+    
+    viewer->blur_cache_owner = blur_cache_register_owner(viewer->blur_cache);
+    viewer->blur_prefetcher = (viewer->blur_processor && viewer->blur_cache) ?
+        blur_prefetcher_create(viewer->blur_processor, viewer->blur_cache) : NULL;
+    blur_prefetcher_set_cache_owner(viewer->blur_prefetcher, viewer->blur_cache_owner);
+}
+
 static void
 hello_image_viewer_class_init(HelloImageViewerClass *klass)
 {
     GObjectClass *object_class = G_OBJECT_CLASS(klass);
     GtkWidgetClass *widget_class = GTK_WIDGET_CLASS(klass);
     
+    object_class->constructed = hello_image_viewer_constructed;
     object_class->dispose = hello_image_viewer_dispose;
     object_class->finalize = hello_image_viewer_finalize;
     
@@ -123,6 +286,7 @@ hello_image_viewer_class_init(HelloImageViewerClass *klass)
     gtk_widget_class_bind_template_child(widget_class, HelloImageViewer, blur_value_label);
     gtk_widget_class_bind_template_child(widget_class, HelloImageViewer, blur_icon);
     gtk_widget_class_bind_template_child(widget_class, HelloImageViewer, blur_container);
+    gtk_widget_class_bind_template_child(widget_class, HelloImageViewer, debug_overlay);
     
     /* Bind template signal handlers */
     gtk_widget_class_bind_template_callback(widget_class, on_conversion_button_toggled);
@@ -137,19 +301,61 @@ hello_image_viewer_init(HelloImageViewer *viewer)
     viewer->converted_pixbuf = NULL;
     viewer->is_converted = FALSE;
     viewer->current_filename = NULL;
-    
-    /* Initialize blur state - T020 */
-    viewer->blur_processor = blur_processor_create(3840, 2160, 0); // Max 4K, auto-detect threads
-    viewer->blur_cache = blur_cache_create(5, 150 * 1024 * 1024); // 5 entries, 150MB max
+    viewer->image_load = NULL;
+    viewer->partial_update_id = 0;
+    viewer->load_mode = HELLO_IMAGE_VIEWER_LOAD_PROXY;
+    viewer->source_width = 0;
+    viewer->source_height = 0;
+    viewer->proxy_scale = 1.0;
+    
+    /* Initialize blur state - T020; resources are set up in constructed */
+    viewer->blur_processor = NULL;
+    viewer->blur_cache = NULL;
+    viewer->blur_prefetcher = NULL;
+    viewer->blur_cache_owner = 0;
+    viewer->owns_blur_resources = FALSE;
     viewer->blur_intensity = 0.0;
     viewer->blur_timeout_id = 0;
+    viewer->blur_tick_id = 0;
+    viewer->slider_dragging = FALSE;
+    viewer->blur_dispatch_deferred = FALSE;
     viewer->active_blur_request = 0;
+    viewer->preview_blur_request = 0;
+    viewer->preview_pending = FALSE;
+    viewer->display_is_final = FALSE;
     viewer->current_display_pixbuf = NULL;
     viewer->image_hash = NULL;
+    viewer->blur_key = NULL;
+    viewer->hash_cancellable = NULL;
+    viewer->grayscale_request = 0;
+    
+    /* HELLO_IMAGE_VIEWER_GPU_BLUR=0 keeps every blur on the CPU engine */
+    viewer->gpu_blur_enabled = g_strcmp0(g_getenv("HELLO_IMAGE_VIEWER_GPU_BLUR"), "0") != 0;
+    viewer->gpu_paintable = NULL;
+    viewer->gpu_base_pixbuf = NULL;
+    
+    reset_blur_cost(viewer);
+    viewer->blur_dispatch_time = 0;
+    viewer->blur_dispatch_engine = 0;
+    
+    /* HELLO_IMAGE_VIEWER_BLUR_COST_MS pins the recorded blur cost, so the
+     * debounce policy does not depend on the machine */
+    const gchar *fixed_cost = g_getenv("HELLO_IMAGE_VIEWER_BLUR_COST_MS");
+    viewer->fixed_blur_cost_us = fixed_cost ? MAX(g_ascii_strtoll(fixed_cost, NULL, 10), 0) * 1000 : 0;
+    
+    viewer->debug_overlay_id = 0;
+    viewer->blur_input_time = 0;
+    viewer->preview_display_us = 0;
+    viewer->final_display_us = 0;
     
     /* Initialize template */
     gtk_widget_init_template(GTK_WIDGET(viewer));
     
+    /* HELLO_IMAGE_VIEWER_DEBUG_OVERLAY=1 starts with the timings shown */
+    if (g_strcmp0(g_getenv("HELLO_IMAGE_VIEWER_DEBUG_OVERLAY"), "1") == 0) {
+        hello_image_viewer_set_debug_overlay(viewer, TRUE);
+    }
+    
     /* Set initial button state - disabled until image is loaded */
     if (viewer->conversion_button) {
         gtk_widget_set_sensitive(viewer->conversion_button, FALSE);
@@ -157,8 +363,193 @@ hello_image_viewer_init(HelloImageViewer *viewer)
     
     /* Set initial blur controls state */
     if (viewer->blur_scale) {
+        GtkEventController *controller = gtk_event_controller_legacy_new();
+        
         gtk_widget_set_sensitive(viewer->blur_scale, FALSE);
+        
+        /* Sees presses and releases before the scale's own drag gesture */
+        gtk_event_controller_set_propagation_phase(controller, GTK_PHASE_CAPTURE);
+        g_signal_connect(controller, "event", G_CALLBACK(on_blur_scale_event), viewer);
+        gtk_widget_add_controller(viewer->blur_scale, controller);
+    }
+}
+
+/**
+ * apply_conversion_state:
+ * @viewer: The HelloImageViewer instance
+ * @is_converted: TRUE to show the grayscale version
+ * 
+ * Switches the display between the original and the grayscale image,
+ * which must already exist, and updates the button to match.
+ */
+static void
+apply_conversion_state(HelloImageViewer *viewer, gboolean is_converted)
+{
+    GtkWidget *button = viewer->conversion_button;
+    
+    viewer->is_converted = is_converted;
+    update_blur_key(viewer);
+    reset_blur_cost(viewer);
+    
+    /* Clear current blur display to trigger re-blur with new base image */
+    g_clear_object(&viewer->current_display_pixbuf);
+    
+    /* Update display (handles blur if active) - T025 */
+    if (viewer->blur_intensity > 0.0) {
+        /* Trigger blur on the new base image */
+        on_blur_scale_value_changed(GTK_SCALE(viewer->blur_scale), viewer);
+    } else {
+        /* No blur - display the base image directly */
+        update_display_image(viewer);
+    }
+    
+    /* Update button appearance */
+    gtk_button_set_icon_name(GTK_BUTTON(button),
+                             is_converted ? "image-restore-symbolic" : "image-filter-symbolic");
+    gtk_widget_set_tooltip_text(button,
+                                is_converted ? "Restore original colors" : "Convert to black and white");
+    
+    /* Update accessibility state */
+    gtk_accessible_update_state(GTK_ACCESSIBLE(button),
+                               GTK_ACCESSIBLE_STATE_PRESSED, is_converted,
+                               -1);
+    gtk_accessible_update_property(GTK_ACCESSIBLE(viewer->image_widget),
+                                 GTK_ACCESSIBLE_PROPERTY_DESCRIPTION, 
+                                 is_converted ? "Image display showing black and white version"
+                                              : "Image display showing original colors",
+                                 -1);
+    
+    gtk_widget_set_sensitive(button, TRUE);
+}
+
+/**
+ * show_conversion_error:
+ * @viewer: The HelloImageViewer instance
+ * @error: (nullable): Why the conversion failed
+ * 
+ * Puts the button back to the color state and reports the failure.
+ */
+static void
+show_conversion_error(HelloImageViewer *viewer, const GError *error)
+{
+    GtkWidget *dialog;
+    
+    g_warning("Image conversion failed: %s", 
+             error ? error->message : "Unknown error");
+    
+    /* Reset button state; the nested toggle restores the color display */
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(viewer->conversion_button), FALSE);
+    gtk_widget_set_sensitive(viewer->conversion_button, TRUE);
+    gtk_widget_set_tooltip_text(viewer->conversion_button, "Convert to black and white");
+    
+    /* Show error dialog */
+    dialog = gtk_message_dialog_new(
+        GTK_WINDOW(viewer),
+        GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
+        GTK_MESSAGE_ERROR,
+        GTK_BUTTONS_OK,
+        "Failed to convert image to black and white");
+    
+    if (error) {
+        gtk_message_dialog_format_secondary_text(
+            GTK_MESSAGE_DIALOG(dialog), "%s", error->message);
+    }
+    
+    gtk_window_present(GTK_WINDOW(dialog));
+    g_signal_connect(dialog, "response", G_CALLBACK(gtk_window_destroy), NULL);
+}
+
+/**
+ * grayscale_completion_callback:
+ * @result_pixbuf: (nullable): Borrowed grayscale image
+ * @error: (nullable): Error if the conversion failed
+ * @user_data: The HelloImageViewer instance
+ * 
+ * Finishes a toggle to black and white once the worker pool has
+ * converted the image. Loading another image or closing the window
+ * cancels the request, so this only runs for the current image.
+ */
+static void
+grayscale_completion_callback(GdkPixbuf    *result_pixbuf,
+                              const GError *error,
+                              gpointer      user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(user_data);
+    
+    viewer->grayscale_request = 0;
+    
+    if (result_pixbuf == NULL) {
+        show_conversion_error(viewer, error);
+        return;
+    }
+    
+    viewer->converted_pixbuf = g_object_ref(result_pixbuf);
+    
+    /* Queue the result for the disk tier; skipped while still hashing */
+    blur_disk_cache_store(blur_cache_get_disk_tier(viewer->blur_cache), viewer->image_hash,
+                          BLUR_DISK_CACHE_OP_GRAYSCALE, 0, result_pixbuf);
+    
+    apply_conversion_state(viewer, TRUE);
+}
+
+/**
+ * cancel_grayscale_conversion:
+ * @viewer: The HelloImageViewer instance
+ * 
+ * Cancels the conversion in flight, if any; its callback will not run.
+ */
+static void
+cancel_grayscale_conversion(HelloImageViewer *viewer)
+{
+    if (viewer->grayscale_request > 0) {
+        blur_processor_cancel(viewer->blur_processor, viewer->grayscale_request);
+        viewer->grayscale_request = 0;
+    }
+}
+
+/**
+ * start_grayscale_conversion:
+ * @viewer: The HelloImageViewer instance
+ * 
+ * Gets the grayscale version of the current image. A result an earlier
+ * session stored in the disk tier is mapped straight away; otherwise the
+ * conversion runs on the blur processor's worker pool and the button
+ * stays insensitive until grayscale_completion_callback() applies it, so
+ * the main loop never blocks however large the image is.
+ */
+static void
+start_grayscale_conversion(HelloImageViewer *viewer)
+{
+    BlurDiskCache *disk_cache = blur_cache_get_disk_tier(viewer->blur_cache);
+    
+    viewer->converted_pixbuf = blur_disk_cache_lookup(disk_cache, viewer->image_hash,
+                                                      BLUR_DISK_CACHE_OP_GRAYSCALE, 0);
+    if (viewer->converted_pixbuf) {
+        apply_conversion_state(viewer, TRUE);
+        return;
+    }
+    
+    /* Without a processor there is no pool to run on */
+    if (viewer->blur_processor == NULL) {
+        GError *error = NULL;
+        GdkPixbuf *grayscale = image_processor_convert_to_grayscale(viewer->original_pixbuf, &error);
+        
+        grayscale_completion_callback(grayscale, error, viewer);
+        g_clear_object(&grayscale);
+        g_clear_error(&error);
+        return;
     }
+    
+    /* Provide processing state feedback - disable button until done */
+    gtk_widget_set_sensitive(viewer->conversion_button, FALSE);
+    gtk_widget_set_tooltip_text(viewer->conversion_button, "Processing...");
+    
+    /* Immediate failures have already called back when this returns */
+    viewer->grayscale_request = blur_processor_grayscale_async(viewer->blur_processor,
+                                                               viewer->original_pixbuf,
+                                                               BLUR_PRIORITY_VISIBLE,
+                                                               grayscale_completion_callback,
+                                                               viewer);
 }
 
 /**
@@ -172,119 +563,18 @@ hello_image_viewer_init(HelloImageViewer *viewer)
 static void
 on_conversion_button_toggled(GtkToggleButton *button, HelloImageViewer *viewer)
 {
-    GError *error = NULL;
     gboolean is_active = gtk_toggle_button_get_active(button);
     
     g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
     g_return_if_fail(viewer->original_pixbuf != NULL);
     
-    /* Provide processing state feedback - temporarily disable button */
-    gtk_widget_set_sensitive(GTK_WIDGET(button), FALSE);
-    gtk_widget_set_tooltip_text(GTK_WIDGET(button), "Processing...");
-    
-    /* Process the UI updates */
-    while (g_main_context_pending(NULL)) {
-        g_main_context_iteration(NULL, FALSE);
-    }
-    
-    if (is_active) {
-        /* Convert to grayscale */
-        if (viewer->converted_pixbuf == NULL) {
-            viewer->converted_pixbuf = image_processor_convert_to_grayscale(
-                viewer->original_pixbuf, &error);
-                
-            if (viewer->converted_pixbuf == NULL) {
-                /* Handle conversion error */
-                g_warning("Image conversion failed: %s", 
-                         error ? error->message : "Unknown error");
-                
-                /* Reset button state */
-                gtk_toggle_button_set_active(button, FALSE);
-                
-                /* Re-enable button and restore tooltip */
-                gtk_widget_set_sensitive(GTK_WIDGET(button), TRUE);
-                gtk_widget_set_tooltip_text(GTK_WIDGET(button), "Convert to black and white");
-                
-                /* Show error dialog */
-                GtkWidget *dialog = gtk_message_dialog_new(
-                    GTK_WINDOW(viewer),
-                    GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
-                    GTK_MESSAGE_ERROR,
-                    GTK_BUTTONS_OK,
-                    "Failed to convert image to black and white");
-                    
-                if (error) {
-                    gtk_message_dialog_format_secondary_text(
-                        GTK_MESSAGE_DIALOG(dialog), "%s", error->message);
-                    g_error_free(error);
-                }
-                
-                gtk_window_present(GTK_WINDOW(dialog));
-                g_signal_connect(dialog, "response", G_CALLBACK(gtk_window_destroy), NULL);
-                return;
-            }
-        }
-        
-        /* Update display to grayscale */
-        viewer->is_converted = TRUE;
-        
-        /* Clear current blur display to trigger re-blur with new base image */
-        g_clear_object(&viewer->current_display_pixbuf);
-        
-        /* Update display (handles blur if active) - T025 */
-        if (viewer->blur_intensity > 0.0) {
-            /* Trigger blur on the new B&W image */
-            on_blur_scale_value_changed(GTK_SCALE(viewer->blur_scale), viewer);
-        } else {
-            /* No blur - display B&W image directly */
-            update_display_image(viewer);
-        }
-        
-        /* Update button appearance */
-        gtk_button_set_icon_name(GTK_BUTTON(button), "image-restore-symbolic");
-        gtk_widget_set_tooltip_text(GTK_WIDGET(button), "Restore original colors");
-        
-        /* Update accessibility state */
-        gtk_accessible_update_state(GTK_ACCESSIBLE(button),
-                                   GTK_ACCESSIBLE_STATE_PRESSED, TRUE,
-                                   -1);
-        gtk_accessible_update_property(GTK_ACCESSIBLE(viewer->image_widget),
-                                     GTK_ACCESSIBLE_PROPERTY_DESCRIPTION, 
-                                     "Image display showing black and white version",
-                                     -1);
-        
-    } else {
-        /* Restore original colors */
-        viewer->is_converted = FALSE;
-        
-        /* Clear current blur display to trigger re-blur with new base image */
-        g_clear_object(&viewer->current_display_pixbuf);
-        
-        /* Update display (handles blur if active) - T025 */
-        if (viewer->blur_intensity > 0.0) {
-            /* Trigger blur on the original color image */
-            on_blur_scale_value_changed(GTK_SCALE(viewer->blur_scale), viewer);
-        } else {
-            /* No blur - display original image directly */
-            update_display_image(viewer);
-        }
-        
-        /* Update button appearance */
-        gtk_button_set_icon_name(GTK_BUTTON(button), "image-filter-symbolic");
-        gtk_widget_set_tooltip_text(GTK_WIDGET(button), "Convert to black and white");
-        
-        /* Update accessibility state */
-        gtk_accessible_update_state(GTK_ACCESSIBLE(button),
-                                   GTK_ACCESSIBLE_STATE_PRESSED, FALSE,
-                                   -1);
-        gtk_accessible_update_property(GTK_ACCESSIBLE(viewer->image_widget),
-                                     GTK_ACCESSIBLE_PROPERTY_DESCRIPTION, 
-                                     "Image display showing original colors",
-                                     -1);
+    /* Convert on first use; the toggle completes asynchronously */
+    if (is_active && viewer->converted_pixbuf == NULL) {
+        start_grayscale_conversion(viewer);
+        return;
     }
     
-    /* Re-enable button after processing is complete */
-    gtk_widget_set_sensitive(GTK_WIDGET(button), TRUE);
+    apply_conversion_state(viewer, is_active);
 }
 
 HelloImageViewer *
@@ -307,58 +597,170 @@ hello_image_viewer_new(GtkApplication *app, const char *filename)
     return viewer;
 }
 
-gboolean
-hello_image_viewer_load_image(HelloImageViewer *viewer, const char *filename)
+HelloImageViewer *
+hello_image_viewer_new_for_file(GtkApplication *app, GFile *file)
 {
-    GFile *file;
-    GdkPixbuf *pixbuf;
-    GError *error = NULL;
-    char *basename;
-    char *title;
+    HelloImageViewer *viewer;
     
-    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
-    g_return_val_if_fail(filename != NULL, FALSE);
+    g_return_val_if_fail(GTK_IS_APPLICATION(app), NULL);
+    g_return_val_if_fail(G_IS_FILE(file), NULL);
     
-    /* Create GFile from filename */
-    file = g_file_new_for_path(filename);
+    viewer = g_object_new(HELLO_TYPE_IMAGE_VIEWER,
+                         "application", app,
+                         NULL);
     
-    /* Check if file exists and is readable */
-    if (!g_file_query_exists(file, NULL)) {
-        g_object_unref(file);
-        g_warning("Image file does not exist: %s", filename);
-        return FALSE;
+    hello_image_viewer_load_file_async(viewer, file);
+    
+    return viewer;
+}
+
+/**
+ * get_proxy_bounds:
+ * @viewer: The HelloImageViewer instance
+ * @max_width: (out): Largest proxy width in device pixels
+ * @max_height: (out): Largest proxy height in device pixels
+ * 
+ * Proxies are fitted to the monitor rather than the current window, so a
+ * maximized window still shows every device pixel and resizing never
+ * needs a new decode.
+ */
+static void
+get_proxy_bounds(HelloImageViewer *viewer, gint *max_width, gint *max_height)
+{
+    GdkDisplay *display = gtk_widget_get_display(GTK_WIDGET(viewer));
+    GdkSurface *surface = gtk_native_get_surface(GTK_NATIVE(viewer));
+    GdkMonitor *monitor = NULL;
+    GdkRectangle geometry;
+    gint scale;
+    
+    if (surface)
+        monitor = gdk_display_get_monitor_at_surface(display, surface);
+    
+    if (monitor)
+        g_object_ref(monitor);
+    else
+        monitor = g_list_model_get_item(gdk_display_get_monitors(display), 0);
+    
+    if (!monitor) {
+        *max_width = PROXY_FALLBACK_WIDTH;
+        *max_height = PROXY_FALLBACK_HEIGHT;
+        return;
     }
     
-    /* Load pixbuf from file */
-    pixbuf = gdk_pixbuf_new_from_file(filename, &error);
-    if (pixbuf == NULL) {
-        g_object_unref(file);
-        g_warning("Failed to load image: %s", error ? error->message : "Unknown error");
-        if (error) {
-            g_error_free(error);
-        }
+    gdk_monitor_get_geometry(monitor, &geometry);
+    scale = gdk_monitor_get_scale_factor(monitor);
+    *max_width = geometry.width * scale;
+    *max_height = geometry.height * scale;
+    
+    g_object_unref(monitor);
+}
+
+/**
+ * get_proxy_size:
+ * @viewer: The HelloImageViewer instance
+ * @width: Full resolution width
+ * @height: Full resolution height
+ * @proxy_width: (out): Width to decode at
+ * @proxy_height: (out): Height to decode at
+ * 
+ * Returns: TRUE if the image should be decoded at the smaller proxy size
+ */
+static gboolean
+get_proxy_size(HelloImageViewer *viewer,
+               gint              width,
+               gint              height,
+               gint             *proxy_width,
+               gint             *proxy_height)
+{
+    gint max_width, max_height;
+    
+    if (viewer->load_mode != HELLO_IMAGE_VIEWER_LOAD_PROXY)
         return FALSE;
-    }
+    
+    get_proxy_bounds(viewer, &max_width, &max_height);
+    
+    return image_processor_fit_size(width, height, max_width, max_height,
+                                    proxy_width, proxy_height);
+}
+
+/**
+ * proxy_intensity:
+ * @viewer: The HelloImageViewer instance
+ * @intensity: Intensity picked on the slider
+ * 
+ * Blur intensities are defined on the full resolution image. A proxy is
+ * blurred with the sigma scaled down by the same factor as the pixels, so
+ * it shows what the full image would look like scaled to the window.
+ * 
+ * Returns: Intensity to pass to the processor for original_pixbuf
+ */
+static gdouble
+proxy_intensity(HelloImageViewer *viewer, gdouble intensity)
+{
+    return intensity * viewer->proxy_scale;
+}
+
+/**
+ * set_loaded_image:
+ * @viewer: The HelloImageViewer instance
+ * @pixbuf: Fully decoded image
+ * @file: File @pixbuf was read from
+ * @source_width: Full resolution width of @file
+ * @source_height: Full resolution height of @file
+ * 
+ * Makes @pixbuf the current image: resets conversion and blur state,
+ * starts hashing it and enables the controls. @pixbuf is smaller than
+ * the source size when it is a proxy.
+ */
+static void
+set_loaded_image(HelloImageViewer *viewer,
+                 GdkPixbuf        *pixbuf,
+                 GFile            *file,
+                 gint              source_width,
+                 gint              source_height)
+{
+    char *basename;
+    char *title;
+    
+    viewer->source_width = source_width;
+    viewer->source_height = source_height;
+    viewer->proxy_scale = source_width > 0 ?
+        MIN(1.0, (gdouble)gdk_pixbuf_get_width(pixbuf) / source_width) : 1.0;
+    blur_prefetcher_set_intensity_scale(viewer->blur_prefetcher, viewer->proxy_scale);
+    
+    /* A conversion of the previous image must not land on this one */
+    cancel_grayscale_conversion(viewer);
     
     /* Clear previous image data */
+    clear_gpu_blur(viewer);
     g_clear_object(&viewer->original_pixbuf);
     g_clear_object(&viewer->converted_pixbuf);
     g_clear_object(&viewer->current_display_pixbuf);
     
-    /* Clear previous image hash and blur cache entries */
-    if (viewer->image_hash) {
-        blur_cache_remove(viewer->blur_cache, viewer->image_hash);
-        g_free(viewer->image_hash);
+    /* Clear previous image hash; a shared cache may still serve its
+     * entries to other windows, so those are left to LRU eviction */
+    if (viewer->image_hash && viewer->owns_blur_resources) {
+        for (int i = 0; i < 2; i++) {
+            gchar *key = g_strdup_printf("%s-%s", viewer->image_hash,
+                                         i == 0 ? "color" : "gray");
+            blur_cache_remove(viewer->blur_cache, key);
+            g_free(key);
+        }
     }
+    g_clear_pointer(&viewer->image_hash, g_free);
     
     /* Store original pixbuf for B&W conversion */
     viewer->original_pixbuf = g_object_ref(pixbuf);
     
-    /* Generate new image hash for cache keys */
-    viewer->image_hash = calculate_image_hash(pixbuf);
-    
     /* Reset conversion state */
     viewer->is_converted = FALSE;
+    update_blur_key(viewer);
+    reset_blur_cost(viewer);
+    
+    /* Hash the full content in the background; blurs before it finishes
+     * are computed but not cached */
+    start_image_hash(viewer, pixbuf);
+    
     if (viewer->conversion_button) {
         gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(viewer->conversion_button), FALSE);
         gtk_button_set_icon_name(GTK_BUTTON(viewer->conversion_button), "image-filter-symbolic");
@@ -382,99 +784,1119 @@ hello_image_viewer_load_image(HelloImageViewer *viewer, const char *filename)
     
     /* Store current filename */
     g_free(viewer->current_filename);
-    viewer->current_filename = g_strdup(filename);
+    viewer->current_filename = g_file_get_path(file);
     
     /* Clean up */
     g_free(basename);
     g_free(title);
-    g_object_unref(file);
-    g_object_unref(pixbuf);
-    
-    return TRUE;
 }
 
 gboolean
-hello_image_viewer_toggle_conversion(HelloImageViewer *viewer)
+hello_image_viewer_load_image(HelloImageViewer *viewer, const char *filename)
 {
+    GFile *file;
+    GdkPixbuf *pixbuf;
+    GError *error = NULL;
+    gint source_width = 0, source_height = 0;
+    gint proxy_width, proxy_height;
+    
     g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
-    g_return_val_if_fail(viewer->conversion_button != NULL, FALSE);
-    g_return_val_if_fail(viewer->original_pixbuf != NULL, FALSE);
+    g_return_val_if_fail(filename != NULL, FALSE);
     
-    /* Toggle the button state, which will trigger the signal handler */
-    gboolean current_state = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(viewer->conversion_button));
-    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(viewer->conversion_button), !current_state);
+    /* A synchronous load replaces any streaming one */
+    cancel_image_load(viewer);
     
-    return TRUE;
-}
-
-gboolean
-hello_image_viewer_get_conversion_state(HelloImageViewer *viewer)
-{
-    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    /* Create GFile from filename */
+    file = g_file_new_for_path(filename);
     
-    return viewer->is_converted;
-}
-
-void
-hello_image_viewer_set_conversion_enabled(HelloImageViewer *viewer, gboolean enabled)
-{
-    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
-    g_return_if_fail(viewer->conversion_button != NULL);
+    /* Check if file exists and is readable */
+    if (!g_file_query_exists(file, NULL)) {
+        g_object_unref(file);
+        g_warning("Image file does not exist: %s", filename);
+        return FALSE;
+    }
+    
+    /* Load pixbuf from file, decoding large images straight at proxy size */
+    if (gdk_pixbuf_get_file_info(filename, &source_width, &source_height) &&
+        get_proxy_size(viewer, source_width, source_height, &proxy_width, &proxy_height))
+        pixbuf = gdk_pixbuf_new_from_file_at_scale(filename, proxy_width, proxy_height,
+                                                   TRUE, &error);
+    else
+        pixbuf = gdk_pixbuf_new_from_file(filename, &error);
+    if (pixbuf == NULL) {
+        g_object_unref(file);
+        g_warning("Failed to load image: %s", error ? error->message : "Unknown error");
+        if (error) {
+            g_error_free(error);
+        }
+        return FALSE;
+    }
+    
+    if (source_width <= 0 || source_height <= 0) {
+        source_width = gdk_pixbuf_get_width(pixbuf);
+        source_height = gdk_pixbuf_get_height(pixbuf);
+    }
+    
+    set_loaded_image(viewer, pixbuf, file, source_width, source_height);
+    
+    g_object_unref(file);
+    g_object_unref(pixbuf);
+    
+    return TRUE;
+}
+
+/**
+ * image_load_is_current:
+ * @load: A streaming load
+ * 
+ * Returns: TRUE if @load has been neither cancelled nor replaced
+ */
+static gboolean
+image_load_is_current(ImageLoad *load)
+{
+    return load->viewer->image_load == load &&
+           !g_cancellable_is_cancelled(load->cancellable);
+}
+
+/**
+ * image_load_free:
+ * @load: A streaming load that has ended
+ * 
+ * Detaches @load from its viewer, discards a partial decode and drops the
+ * read chain's reference to the viewer.
+ */
+static void
+image_load_free(ImageLoad *load)
+{
+    HelloImageViewer *viewer = load->viewer;
+    
+    if (viewer->image_load == load) {
+        viewer->image_load = NULL;
+        
+        if (viewer->partial_update_id > 0) {
+            g_source_remove(viewer->partial_update_id);
+            viewer->partial_update_id = 0;
+        }
+    }
+    
+    g_signal_handlers_disconnect_by_data(load->loader, load);
+    
+    /* Closing a truncated stream reports an error nobody needs */
+    if (!load->loader_closed)
+        gdk_pixbuf_loader_close(load->loader, NULL);
+    
+    g_object_unref(load->loader);
+    g_clear_object(&load->stream);
+    g_object_unref(load->cancellable);
+    g_object_unref(load->file);
+    g_object_unref(viewer);
+    g_free(load);
+}
+
+/**
+ * cancel_image_load:
+ * @viewer: HelloImageViewer instance
+ * 
+ * Stops a streaming load in progress. Its pending read completes
+ * cancelled and frees the load.
+ */
+static void
+cancel_image_load(HelloImageViewer *viewer)
+{
+    if (!viewer->image_load)
+        return;
+    
+    g_cancellable_cancel(viewer->image_load->cancellable);
+    viewer->image_load = NULL;
+    
+    if (viewer->partial_update_id > 0) {
+        g_source_remove(viewer->partial_update_id);
+        viewer->partial_update_id = 0;
+    }
+}
+
+/**
+ * on_load_error_response:
+ * @dialog: The error dialog
+ * @response_id: Dialog response
+ * @viewer: Viewer whose image failed to load
+ * 
+ * Closes the error dialog together with the empty viewer window.
+ */
+static void
+on_load_error_response(GtkDialog        *dialog,
+                       int               response_id,
+                       HelloImageViewer *viewer)
+{
+    gtk_window_destroy(GTK_WINDOW(dialog));
+    gtk_window_destroy(GTK_WINDOW(viewer));
+}
+
+/**
+ * image_load_failed:
+ * @load: The streaming load
+ * @error: (transfer full): Read or decode error
+ * 
+ * Reports a failed load of the current image and frees @load. Errors of
+ * cancelled or replaced loads are dropped silently.
+ */
+static void
+image_load_failed(ImageLoad *load, GError *error)
+{
+    if (image_load_is_current(load) &&
+        !g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        HelloImageViewer *viewer = load->viewer;
+        GtkWidget *dialog;
+        
+        g_warning("Failed to load image: %s", error->message);
+        
+        dialog = gtk_message_dialog_new(GTK_WINDOW(viewer),
+                                        GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
+                                        GTK_MESSAGE_ERROR,
+                                        GTK_BUTTONS_OK,
+                                        "Failed to load image");
+        gtk_message_dialog_format_secondary_text(GTK_MESSAGE_DIALOG(dialog),
+                                                 "%s", error->message);
+        g_signal_connect(dialog, "response", G_CALLBACK(on_load_error_response), viewer);
+        gtk_window_present(GTK_WINDOW(dialog));
+    }
+    
+    g_error_free(error);
+    image_load_free(load);
+}
+
+/**
+ * show_partial_image:
+ * @user_data: HelloImageViewer instance
+ * 
+ * Repaints the rows decoded so far. Each repaint uploads the whole
+ * pixbuf, so updates are throttled to PARTIAL_UPDATE_INTERVAL_MS.
+ * 
+ * Returns: G_SOURCE_REMOVE
+ */
+static gboolean
+show_partial_image(gpointer user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(user_data);
+    GdkPixbuf *partial;
+    
+    viewer->partial_update_id = 0;
+    
+    if (viewer->image_load) {
+        partial = gdk_pixbuf_loader_get_pixbuf(viewer->image_load->loader);
+        if (partial)
+            gtk_picture_set_pixbuf(GTK_PICTURE(viewer->image_widget), partial);
+    }
+    
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * on_loader_size_prepared:
+ * @loader: The decoder
+ * @width: Full resolution width from the file header
+ * @height: Full resolution height from the file header
+ * @load: The streaming load
+ * 
+ * Asks the decoder for the proxy size before any pixels exist. Decoders
+ * such as libjpeg then scale while decoding instead of afterwards.
+ */
+static void
+on_loader_size_prepared(GdkPixbufLoader *loader,
+                        int              width,
+                        int              height,
+                        ImageLoad       *load)
+{
+    gint proxy_width, proxy_height;
+    
+    load->source_width = width;
+    load->source_height = height;
+    
+    if (get_proxy_size(load->viewer, width, height, &proxy_width, &proxy_height))
+        gdk_pixbuf_loader_set_size(loader, proxy_width, proxy_height);
+}
+
+/**
+ * on_loader_area_updated:
+ * @loader: The decoder
+ * @x: Left edge of the decoded area
+ * @y: Top edge of the decoded area
+ * @width: Width of the decoded area
+ * @height: Height of the decoded area
+ * @load: The streaming load
+ * 
+ * Schedules a repaint once new scanlines are available.
+ */
+static void
+on_loader_area_updated(GdkPixbufLoader *loader,
+                       int              x,
+                       int              y,
+                       int              width,
+                       int              height,
+                       ImageLoad       *load)
+{
+    HelloImageViewer *viewer = load->viewer;
+    
+    if (!image_load_is_current(load) || viewer->partial_update_id > 0)
+        return;
+    
+    viewer->partial_update_id = g_timeout_add(PARTIAL_UPDATE_INTERVAL_MS,
+                                              show_partial_image, viewer);
+}
+
+static void read_next_chunk(ImageLoad *load);
+
+/**
+ * on_image_chunk_read:
+ * @source_object: The file input stream
+ * @result: Result of the read
+ * @user_data: The streaming load
+ * 
+ * Feeds one chunk to the decoder and asks for the next one. At end of
+ * file the decoded image becomes the viewer's image.
+ */
+static void
+on_image_chunk_read(GObject      *source_object,
+                    GAsyncResult *result,
+                    gpointer      user_data)
+{
+    ImageLoad *load = user_data;
+    GError *error = NULL;
+    GBytes *bytes;
+    
+    bytes = g_input_stream_read_bytes_finish(G_INPUT_STREAM(source_object), result, &error);
+    if (!bytes) {
+        image_load_failed(load, error);
+        return;
+    }
+    
+    if (!image_load_is_current(load)) {
+        g_bytes_unref(bytes);
+        image_load_free(load);
+        return;
+    }
+    
+    if (g_bytes_get_size(bytes) == 0) {
+        /* End of file: flush the decoder */
+        g_bytes_unref(bytes);
+        load->loader_closed = TRUE;
+        
+        if (!gdk_pixbuf_loader_close(load->loader, &error)) {
+            image_load_failed(load, error);
+            return;
+        }
+        
+        GdkPixbuf *pixbuf = gdk_pixbuf_loader_get_pixbuf(load->loader);
+        if (!pixbuf) {
+            image_load_failed(load, g_error_new_literal(GDK_PIXBUF_ERROR,
+                                                        GDK_PIXBUF_ERROR_CORRUPT_IMAGE,
+                                                        "No image data"));
+            return;
+        }
+        
+        /* The loader owns the pixbuf; the viewer takes its own reference */
+        set_loaded_image(load->viewer, pixbuf, load->file,
+                         load->source_width, load->source_height);
+        image_load_free(load);
+        return;
+    }
+    
+    if (!gdk_pixbuf_loader_write_bytes(load->loader, bytes, &error)) {
+        g_bytes_unref(bytes);
+        image_load_failed(load, error);
+        return;
+    }
+    
+    g_bytes_unref(bytes);
+    read_next_chunk(load);
+}
+
+/**
+ * read_next_chunk:
+ * @load: The streaming load
+ * 
+ * Reads up to LOAD_CHUNK_SIZE bytes; GIO performs the blocking read on
+ * its worker threads.
+ */
+static void
+read_next_chunk(ImageLoad *load)
+{
+    g_input_stream_read_bytes_async(load->stream,
+                                    LOAD_CHUNK_SIZE,
+                                    G_PRIORITY_DEFAULT,
+                                    load->cancellable,
+                                    on_image_chunk_read,
+                                    load);
+}
+
+/**
+ * on_image_file_opened:
+ * @source_object: The image file
+ * @result: Result of the open
+ * @user_data: The streaming load
+ * 
+ * Starts the chunked read once the file is open.
+ */
+static void
+on_image_file_opened(GObject      *source_object,
+                     GAsyncResult *result,
+                     gpointer      user_data)
+{
+    ImageLoad *load = user_data;
+    GError *error = NULL;
+    GFileInputStream *stream;
+    
+    stream = g_file_read_finish(G_FILE(source_object), result, &error);
+    if (!stream) {
+        image_load_failed(load, error);
+        return;
+    }
+    
+    load->stream = G_INPUT_STREAM(stream);
+    
+    if (!image_load_is_current(load)) {
+        image_load_free(load);
+        return;
+    }
+    
+    read_next_chunk(load);
+}
+
+void
+hello_image_viewer_load_file_async(HelloImageViewer *viewer, GFile *file)
+{
+    ImageLoad *load;
+    char *basename;
+    char *title;
+    
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    g_return_if_fail(G_IS_FILE(file));
+    
+    cancel_image_load(viewer);
+    
+    load = g_new0(ImageLoad, 1);
+    load->viewer = g_object_ref(viewer);
+    load->file = g_object_ref(file);
+    load->loader = gdk_pixbuf_loader_new();
+    load->cancellable = g_cancellable_new();
+    viewer->image_load = load;
+    
+    g_signal_connect(load->loader, "size-prepared", G_CALLBACK(on_loader_size_prepared), load);
+    g_signal_connect(load->loader, "area-updated", G_CALLBACK(on_loader_area_updated), load);
+    
+    /* Controls need the complete image; stop work on the previous one */
+    if (viewer->blur_scale) {
+        if (viewer->original_pixbuf)
+            hello_image_viewer_blur_reset(viewer, FALSE);
+        gtk_widget_set_sensitive(viewer->blur_scale, FALSE);
+    }
+    if (viewer->conversion_button)
+        gtk_widget_set_sensitive(viewer->conversion_button, FALSE);
+    
+    basename = g_file_get_basename(file);
+    title = g_strdup_printf("%s - %s", basename, DEFAULT_WINDOW_TITLE);
+    gtk_window_set_title(GTK_WINDOW(viewer), title);
+    g_free(basename);
+    g_free(title);
+    
+    g_file_read_async(file, G_PRIORITY_DEFAULT, load->cancellable,
+                      on_image_file_opened, load);
+}
+
+gboolean
+hello_image_viewer_is_loading(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->image_load != NULL;
+}
+
+void
+hello_image_viewer_set_load_mode(HelloImageViewer *viewer, HelloImageViewerLoadMode mode)
+{
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    
+    viewer->load_mode = mode;
+}
+
+gboolean
+hello_image_viewer_get_source_size(HelloImageViewer *viewer, gint *width, gint *height)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    if (!viewer->original_pixbuf)
+        return FALSE;
+    
+    if (width)
+        *width = viewer->source_width;
+    if (height)
+        *height = viewer->source_height;
+    
+    return TRUE;
+}
+
+/* State of one full resolution render */
+typedef struct {
+    gchar *path;
+    gboolean grayscale;
+    gdouble intensity;
+} FullResolutionRender;
+
+static void
+full_resolution_render_free(gpointer data)
+{
+    FullResolutionRender *render = data;
+    
+    g_free(render->path);
+    g_free(render);
+}
+
+/**
+ * decode_full_resolution_thread:
+ * @task: The decode task
+ * @source_object: HelloImageViewer instance (unused on the worker)
+ * @task_data: The #FullResolutionRender
+ * @cancellable: Render cancellable
+ * 
+ * Decodes the file at full size and converts it to grayscale when the
+ * viewer shows the grayscale version. Neither step touches the viewer.
+ */
+static void
+decode_full_resolution_thread(GTask        *task,
+                              gpointer      source_object,
+                              gpointer      task_data,
+                              GCancellable *cancellable)
+{
+    FullResolutionRender *render = task_data;
+    GError *error = NULL;
+    GdkPixbuf *pixbuf;
+    
+    pixbuf = gdk_pixbuf_new_from_file(render->path, &error);
+    
+    if (pixbuf && render->grayscale && !g_cancellable_is_cancelled(cancellable)) {
+        GdkPixbuf *grayscale = image_processor_convert_to_grayscale(pixbuf, &error);
+        g_object_unref(pixbuf);
+        pixbuf = grayscale;
+    }
+    
+    if (pixbuf)
+        g_task_return_pointer(task, pixbuf, g_object_unref);
+    else
+        g_task_return_error(task, error);
+}
+
+/**
+ * full_resolution_blur_callback:
+ * @result_pixbuf: (transfer none): Blurred full resolution image
+ * @error: Error information (or NULL on success)
+ * @user_data: (transfer full): The render task
+ * 
+ * Completes the render with the processor's result.
+ */
+static void
+full_resolution_blur_callback(GdkPixbuf    *result_pixbuf,
+                              const GError *error,
+                              gpointer      user_data)
+{
+    GTask *task = G_TASK(user_data);
+    
+    if (error)
+        g_task_return_error(task, g_error_copy(error));
+    else if (!g_task_return_error_if_cancelled(task))
+        g_task_return_pointer(task, g_object_ref(result_pixbuf), g_object_unref);
+    
+    g_object_unref(task);
+}
+
+/**
+ * on_full_resolution_decoded:
+ * @source_object: HelloImageViewer instance
+ * @result: The decode task
+ * @user_data: (transfer full): The render task
+ * 
+ * Blurs the decoded image at the intensity on the slider, which is
+ * defined on full resolution pixels and so needs no scaling here.
+ */
+static void
+on_full_resolution_decoded(GObject      *source_object,
+                           GAsyncResult *result,
+                           gpointer      user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(source_object);
+    GTask *task = G_TASK(user_data);
+    FullResolutionRender *render = g_task_get_task_data(task);
+    GError *error = NULL;
+    GdkPixbuf *pixbuf;
+    guint request_id;
+    
+    pixbuf = g_task_propagate_pointer(G_TASK(result), &error);
+    if (!pixbuf) {
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+    
+    if (g_task_return_error_if_cancelled(task)) {
+        g_object_unref(pixbuf);
+        g_object_unref(task);
+        return;
+    }
+    
+    if (render->intensity <= 0.0) {
+        g_task_return_pointer(task, pixbuf, g_object_unref);
+        g_object_unref(task);
+        return;
+    }
+    
+    request_id = viewer->blur_processor ?
+        blur_processor_apply_async(viewer->blur_processor, pixbuf, render->intensity,
+                                   FALSE, full_resolution_blur_callback, task) : 0;
+    g_object_unref(pixbuf);
+    
+    if (request_id == 0) {
+        g_task_return_new_error(task, BLUR_ERROR, BLUR_ERROR_PROCESSING_FAILED,
+                                "Full resolution blur could not be started");
+        g_object_unref(task);
+    }
+}
+
+void
+hello_image_viewer_render_full_resolution_async(HelloImageViewer    *viewer,
+                                                GCancellable        *cancellable,
+                                                GAsyncReadyCallback  callback,
+                                                gpointer             user_data)
+{
+    FullResolutionRender *render;
+    GTask *task, *decode;
+    
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    
+    task = g_task_new(viewer, cancellable, callback, user_data);
+    g_task_set_source_tag(task, hello_image_viewer_render_full_resolution_async);
+    
+    if (!viewer->original_pixbuf || !viewer->current_filename) {
+        g_task_return_new_error(task, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                                "No image loaded");
+        g_object_unref(task);
+        return;
+    }
+    
+    render = g_new0(FullResolutionRender, 1);
+    render->path = g_strdup(viewer->current_filename);
+    render->grayscale = viewer->is_converted;
+    render->intensity = viewer->blur_intensity;
+    g_task_set_task_data(task, render, full_resolution_render_free);
+    
+    /* The decode task hands the render task on to the blur stage */
+    decode = g_task_new(viewer, cancellable, on_full_resolution_decoded, task);
+    g_task_set_task_data(decode, render, NULL);
+    g_task_run_in_thread(decode, decode_full_resolution_thread);
+    g_object_unref(decode);
+}
+
+GdkPixbuf *
+hello_image_viewer_render_full_resolution_finish(HelloImageViewer  *viewer,
+                                                 GAsyncResult      *result,
+                                                 GError           **error)
+{
+    g_return_val_if_fail(g_task_is_valid(result, viewer), NULL);
+    
+    return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+gboolean
+hello_image_viewer_toggle_conversion(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    g_return_val_if_fail(viewer->conversion_button != NULL, FALSE);
+    g_return_val_if_fail(viewer->original_pixbuf != NULL, FALSE);
+    
+    /* Toggle the button state, which will trigger the signal handler */
+    gboolean current_state = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(viewer->conversion_button));
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(viewer->conversion_button), !current_state);
+    
+    return TRUE;
+}
+
+gboolean
+hello_image_viewer_get_conversion_state(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->is_converted;
+}
+
+gboolean
+hello_image_viewer_is_converting(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->grayscale_request > 0;
+}
+
+void
+hello_image_viewer_set_conversion_enabled(HelloImageViewer *viewer, gboolean enabled)
+{
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    g_return_if_fail(viewer->conversion_button != NULL);
     
     if (enabled) {
-        /* Enable button if image is loaded */
+        /* Enable button if image is loaded and not being converted */
         gtk_widget_set_sensitive(viewer->conversion_button, 
-                                 viewer->original_pixbuf != NULL);
+                                 viewer->original_pixbuf != NULL &&
+                                 viewer->grayscale_request == 0);
     } else {
-        /* Disable button and reset conversion state */
-        gtk_widget_set_sensitive(viewer->conversion_button, FALSE);
-        
-        if (viewer->is_converted) {
-            /* Reset to original image */
+        /* Drop a pending conversion and reset to the original image */
+        cancel_grayscale_conversion(viewer);
+        if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(viewer->conversion_button))) {
             gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(viewer->conversion_button), FALSE);
         }
+        
+        /* Disable last, the toggle handler re-enables the button */
+        gtk_widget_set_sensitive(viewer->conversion_button, FALSE);
+    }
+}
+
+/* Blur functionality implementation - T022, T023, T024 */
+
+/**
+ * on_blur_scale_value_changed:
+ * @scale: The blur intensity scale widget
+ * @viewer: The HelloImageViewer instance
+ *
+ * Handles blur scale value changes with debouncing for smooth interaction
+ */
+static void
+on_blur_scale_value_changed(GtkScale *scale, HelloImageViewer *viewer)
+{
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    g_return_if_fail(viewer->original_pixbuf != NULL);
+    
+    gdouble new_intensity = gtk_range_get_value(GTK_RANGE(scale));
+    
+    /* Update value label immediately */
+    gchar *value_text = g_strdup_printf("%.1f", new_intensity);
+    gtk_label_set_label(GTK_LABEL(viewer->blur_value_label), value_text);
+    g_free(value_text);
+    
+    /* Store new intensity */
+    viewer->blur_intensity = new_intensity;
+    viewer->blur_input_time = g_get_monotonic_time();
+    
+    /* Speculative work yields to the visible request right away */
+    blur_prefetcher_cancel(viewer->blur_prefetcher);
+    
+    /* Cancel any pending debounce timeout */
+    cancel_blur_dispatch(viewer);
+    
+    /* Any full quality result in flight is for a stale intensity */
+    if (viewer->active_blur_request > 0) {
+        blur_processor_cancel(viewer->blur_processor, viewer->active_blur_request);
+        viewer->active_blur_request = 0;
+    }
+    viewer->display_is_final = FALSE;
+    
+    /* The render tree redraws the blur at once; nothing to compute */
+    if (show_gpu_blur(viewer)) {
+        cancel_blur_requests(viewer);
+        record_time_to_display(viewer, TRUE);
+        return;
+    }
+    
+    /* For zero intensity, update immediately */
+    if (new_intensity <= 0.0) {
+        cancel_blur_requests(viewer);
+        update_display_image(viewer);
+        record_time_to_display(viewer, TRUE);
+        return;
+    }
+    
+    /* Cached full quality results need no preview or debounce */
+    GdkPixbuf *cached_result = blur_cache_get(viewer->blur_cache,
+                                             viewer->blur_key,
+                                             new_intensity);
+    if (cached_result) {
+        g_clear_object(&viewer->current_display_pixbuf);
+        viewer->current_display_pixbuf = cached_result;
+        viewer->display_is_final = TRUE;
+        gtk_picture_set_pixbuf(GTK_PICTURE(viewer->image_widget), cached_result);
+        record_time_to_display(viewer, TRUE);
+        schedule_blur_prefetch(viewer);
+        return;
+    }
+    
+    gint debounce_ms = hello_image_viewer_get_blur_debounce(viewer);
+    
+    /* Coarse pass: a downscaled preview follows the slider right away,
+     * unless the full blur itself lands on the next frame */
+    if (debounce_ms != 0) {
+        request_blur_preview(viewer);
+    }
+    
+    /* Fine pass: debounce the full resolution blur until the slider rests,
+     * or until the drag ends when previews are all the pool can keep up with */
+    if (debounce_ms < 0 && viewer->slider_dragging) {
+        viewer->blur_dispatch_deferred = TRUE;
+    } else {
+        schedule_blur_dispatch(viewer, debounce_ms < 0 ? BLUR_DEBOUNCE_MAX_MS : debounce_ms);
+    }
+}
+
+/**
+ * on_blur_scale_event:
+ * @controller: Capture phase controller of the blur scale
+ * @event: Event delivered to the scale
+ * @viewer: HelloImageViewer instance
+ *
+ * Tracks whether the slider is being dragged, and starts a full quality
+ * blur held back during the drag once it ends
+ *
+ * Returns: GDK_EVENT_PROPAGATE, so the scale still handles @event
+ */
+static gboolean
+on_blur_scale_event(GtkEventControllerLegacy *controller,
+                    GdkEvent                 *event,
+                    HelloImageViewer         *viewer)
+{
+    switch (gdk_event_get_event_type(event)) {
+    case GDK_BUTTON_PRESS:
+    case GDK_TOUCH_BEGIN:
+        viewer->slider_dragging = TRUE;
+        break;
+    case GDK_BUTTON_RELEASE:
+    case GDK_TOUCH_END:
+    case GDK_TOUCH_CANCEL:
+        viewer->slider_dragging = FALSE;
+        if (viewer->blur_dispatch_deferred) {
+            /* After the scale has handled the release and its last value */
+            schedule_blur_dispatch(viewer, 0);
+        }
+        break;
+    default:
+        break;
+    }
+    
+    return GDK_EVENT_PROPAGATE;
+}
+
+/**
+ * blur_engine_index:
+ * @viewer: HelloImageViewer instance
+ * @intensity: Slider intensity
+ *
+ * Returns: 1 if the processor blurs @intensity with the box engine, else 0
+ */
+static gint
+blur_engine_index(HelloImageViewer *viewer, gdouble intensity)
+{
+    return blur_calculate_sigma(proxy_intensity(viewer, intensity)) >= BLUR_BOX_SIGMA_THRESHOLD;
+}
+
+/**
+ * reset_blur_cost:
+ * @viewer: HelloImageViewer instance
+ *
+ * Forgets the measured blur cost when the base image changes size or content
+ */
+static void
+reset_blur_cost(HelloImageViewer *viewer)
+{
+    viewer->blur_cost_us[0] = 0;
+    viewer->blur_cost_us[1] = 0;
+}
+
+/**
+ * record_blur_cost:
+ * @viewer: HelloImageViewer instance
+ *
+ * Folds the completion time of the full quality blur just delivered into
+ * the moving average of its engine
+ */
+static void
+record_blur_cost(HelloImageViewer *viewer)
+{
+    gint64 *average = &viewer->blur_cost_us[viewer->blur_dispatch_engine];
+    gint64 cost = viewer->fixed_blur_cost_us > 0 ? viewer->fixed_blur_cost_us
+                                                 : g_get_monotonic_time() - viewer->blur_dispatch_time;
+    
+    /* Weighted 3:1 towards history, so one slow frame does not flip the policy */
+    *average = *average > 0 ? (*average * 3 + cost) / 4 : MAX(cost, 1);
+}
+
+/**
+ * blur_dispatch_tick:
+ * @widget: The viewer
+ * @frame_clock: Clock of the frame being drawn
+ * @user_data: Unused
+ *
+ * Starts the full quality blur at the next frame
+ */
+static gboolean
+blur_dispatch_tick(GtkWidget     *widget,
+                   GdkFrameClock *frame_clock,
+                   gpointer       user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(widget);
+    
+    viewer->blur_tick_id = 0;
+    blur_debounce_timeout(viewer);
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * schedule_blur_dispatch:
+ * @viewer: HelloImageViewer instance
+ * @delay_ms: Delay before the full quality blur, 0 for the next frame
+ *
+ * Replaces any pending dispatch. A window without a frame clock yet
+ * dispatches from the main loop instead of a frame tick.
+ */
+static void
+schedule_blur_dispatch(HelloImageViewer *viewer, gint delay_ms)
+{
+    cancel_blur_dispatch(viewer);
+    
+    if (delay_ms == 0 && gtk_widget_get_frame_clock(GTK_WIDGET(viewer)))
+        viewer->blur_tick_id = gtk_widget_add_tick_callback(GTK_WIDGET(viewer),
+                                                            blur_dispatch_tick,
+                                                            NULL, NULL);
+    else
+        viewer->blur_timeout_id = g_timeout_add(delay_ms, blur_debounce_timeout, viewer);
+}
+
+/**
+ * cancel_blur_dispatch:
+ * @viewer: HelloImageViewer instance
+ *
+ * Drops a pending or deferred full quality blur that has not started yet
+ */
+static void
+cancel_blur_dispatch(HelloImageViewer *viewer)
+{
+    if (viewer->blur_timeout_id > 0) {
+        g_source_remove(viewer->blur_timeout_id);
+        viewer->blur_timeout_id = 0;
+    }
+    
+    if (viewer->blur_tick_id > 0) {
+        gtk_widget_remove_tick_callback(GTK_WIDGET(viewer), viewer->blur_tick_id);
+        viewer->blur_tick_id = 0;
+    }
+    
+    viewer->blur_dispatch_deferred = FALSE;
+}
+
+/**
+ * get_blur_base_pixbuf:
+ * @viewer: HelloImageViewer instance
+ *
+ * Returns the image blur is applied to (original or B&W converted)
+ */
+static GdkPixbuf *
+get_blur_base_pixbuf(HelloImageViewer *viewer)
+{
+    return viewer->is_converted ? viewer->converted_pixbuf : viewer->original_pixbuf;
+}
+
+/**
+ * gpu_blur_available:
+ * @viewer: HelloImageViewer instance
+ *
+ * The GPU path needs a realized window drawn by a GL or Vulkan renderer;
+ * the Cairo renderer would run the blur node in software on every frame
+ *
+ * Returns: TRUE if blurs can be left to the render tree
+ */
+static gboolean
+gpu_blur_available(HelloImageViewer *viewer)
+{
+    GtkNative *native;
+    GskRenderer *renderer;
+    
+    if (!viewer->gpu_blur_enabled)
+        return FALSE;
+    
+    native = gtk_widget_get_native(viewer->image_widget);
+    renderer = native ? gtk_native_get_renderer(native) : NULL;
+    
+    return renderer != NULL && !GSK_IS_CAIRO_RENDERER(renderer);
+}
+
+/**
+ * clear_gpu_blur:
+ * @viewer: HelloImageViewer instance
+ *
+ * Drops the uploaded texture, for a new image or when the GPU path is off
+ */
+static void
+clear_gpu_blur(HelloImageViewer *viewer)
+{
+    g_clear_object(&viewer->gpu_paintable);
+    g_clear_object(&viewer->gpu_base_pixbuf);
+}
+
+/**
+ * show_gpu_blur:
+ * @viewer: HelloImageViewer instance
+ *
+ * Displays the base image blurred at the current intensity by the render
+ * tree. The base is uploaded once; later intensities only change the
+ * sigma of the blur node, so slider moves cost a redraw and no CPU pass.
+ *
+ * Returns: TRUE if the GPU path is showing the image
+ */
+static gboolean
+show_gpu_blur(HelloImageViewer *viewer)
+{
+    GdkPixbuf *base_pixbuf = get_blur_base_pixbuf(viewer);
+    gdouble sigma = 0.0;
+    
+    if (!base_pixbuf || !gpu_blur_available(viewer)) {
+        clear_gpu_blur(viewer);
+        return FALSE;
+    }
+    
+    /* Upload again only when the base image changed */
+    if (viewer->gpu_base_pixbuf != base_pixbuf) {
+        clear_gpu_blur(viewer);
+        viewer->gpu_base_pixbuf = g_object_ref(base_pixbuf);
+        viewer->gpu_paintable = gtk_utils_blur_paintable_new(base_pixbuf);
     }
+    
+    /* Sigma of the proxy, as the CPU engine would blur it */
+    if (viewer->blur_intensity > 0.0)
+        sigma = blur_calculate_sigma(proxy_intensity(viewer, viewer->blur_intensity));
+    gtk_utils_blur_paintable_set_sigma(viewer->gpu_paintable, sigma);
+    
+    /* CPU results cached for display are stale from here on */
+    g_clear_object(&viewer->current_display_pixbuf);
+    
+    if (gtk_picture_get_paintable(GTK_PICTURE(viewer->image_widget)) != viewer->gpu_paintable)
+        gtk_picture_set_paintable(GTK_PICTURE(viewer->image_widget), viewer->gpu_paintable);
+    
+    return TRUE;
 }
 
-/* Blur functionality implementation - T022, T023, T024 */
+/**
+ * cancel_blur_requests:
+ * @viewer: HelloImageViewer instance
+ *
+ * Cancels the preview and full quality requests in flight, if any
+ */
+static void
+cancel_blur_requests(HelloImageViewer *viewer)
+{
+    if (viewer->active_blur_request > 0) {
+        blur_processor_cancel(viewer->blur_processor, viewer->active_blur_request);
+        viewer->active_blur_request = 0;
+    }
+    
+    if (viewer->preview_blur_request > 0) {
+        blur_processor_cancel(viewer->blur_processor, viewer->preview_blur_request);
+        viewer->preview_blur_request = 0;
+    }
+    
+    viewer->preview_pending = FALSE;
+    
+    blur_prefetcher_cancel(viewer->blur_prefetcher);
+}
 
 /**
- * on_blur_scale_value_changed:
- * @scale: The blur intensity scale widget
- * @viewer: The HelloImageViewer instance
+ * schedule_blur_prefetch:
+ * @viewer: HelloImageViewer instance
  *
- * Handles blur scale value changes with debouncing for smooth interaction
+ * Once a full quality result is on screen, blurs the next intensities in
+ * the direction the slider moved so the following step is a cache hit
  */
 static void
-on_blur_scale_value_changed(GtkScale *scale, HelloImageViewer *viewer)
+schedule_blur_prefetch(HelloImageViewer *viewer)
 {
-    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
-    g_return_if_fail(viewer->original_pixbuf != NULL);
+    GdkPixbuf *base_pixbuf = get_blur_base_pixbuf(viewer);
     
-    gdouble new_intensity = gtk_range_get_value(GTK_RANGE(scale));
+    if (!viewer->blur_prefetcher || !base_pixbuf || !viewer->blur_key) {
+        return;
+    }
     
-    /* Update value label immediately */
-    gchar *value_text = g_strdup_printf("%.1f", new_intensity);
-    gtk_label_set_label(GTK_LABEL(viewer->blur_value_label), value_text);
-    g_free(value_text);
+    blur_prefetcher_schedule(viewer->blur_prefetcher, base_pixbuf,
+                             viewer->blur_key, viewer->blur_intensity);
+}
+
+/**
+ * blur_preview_callback:
+ * @result_pixbuf: Downscaled blurred preview (or NULL on error)
+ * @error: Error information (or NULL on success)
+ * @user_data: HelloImageViewer instance
+ *
+ * Shows a progressive preview stretched to the base image size, then
+ * starts the next preview if the slider moved in the meantime
+ */
+static void
+blur_preview_callback(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(user_data);
     
-    /* Store new intensity */
-    viewer->blur_intensity = new_intensity;
+    if (!HELLO_IS_IMAGE_VIEWER(viewer) || !viewer->blur_processor) {
+        return;
+    }
     
-    /* Cancel any pending debounce timeout */
-    if (viewer->blur_timeout_id > 0) {
-        g_source_remove(viewer->blur_timeout_id);
-        viewer->blur_timeout_id = 0;
+    /* A replaced request was already superseded by the one now tracked */
+    if (g_error_matches(error, BLUR_ERROR, BLUR_ERROR_CANCELLED)) {
+        return;
     }
     
-    /* For zero intensity, update immediately */
-    if (new_intensity <= 0.0) {
-        update_display_image(viewer);
+    viewer->preview_blur_request = 0;
+    
+    if (error) {
+        g_warning("Blur preview failed: %s", error->message);
+    } else if (result_pixbuf && !viewer->display_is_final && viewer->blur_intensity > 0.0) {
+        GdkPixbuf *base_pixbuf = get_blur_base_pixbuf(viewer);
+        
+        if (base_pixbuf && viewer->image_widget && GTK_IS_PICTURE(viewer->image_widget)) {
+            GdkPaintable *preview = gtk_utils_scaled_paintable_new(result_pixbuf,
+                                                                   gdk_pixbuf_get_width(base_pixbuf),
+                                                                   gdk_pixbuf_get_height(base_pixbuf));
+            gtk_picture_set_paintable(GTK_PICTURE(viewer->image_widget), preview);
+            g_object_unref(preview);
+            record_time_to_display(viewer, FALSE);
+        }
+    }
+    
+    if (viewer->preview_pending) {
+        viewer->preview_pending = FALSE;
+        request_blur_preview(viewer);
+    }
+}
+
+/**
+ * request_blur_preview:
+ * @viewer: HelloImageViewer instance
+ *
+ * Starts a progressive preview for the current intensity. Only one preview
+ * runs at a time; changes meanwhile are folded into a single follow-up.
+ */
+static void
+request_blur_preview(HelloImageViewer *viewer)
+{
+    GdkPixbuf *base_pixbuf = get_blur_base_pixbuf(viewer);
+    
+    if (!base_pixbuf || !viewer->blur_processor || viewer->display_is_final) {
+        return;
+    }
+    
+    if (viewer->preview_blur_request > 0) {
+        viewer->preview_pending = TRUE;
         return;
     }
     
-    /* Debounce blur processing to prevent excessive computation */
-    viewer->blur_timeout_id = g_timeout_add(100, blur_debounce_timeout, viewer);
+    viewer->preview_blur_request = blur_processor_apply_async_with_priority(
+        viewer->blur_processor,
+        base_pixbuf,
+        proxy_intensity(viewer, viewer->blur_intensity),
+        TRUE, // Downscaled preview
+        BLUR_PRIORITY_VISIBLE,
+        blur_preview_callback,
+        viewer
+    );
 }
 
 /**
@@ -502,8 +1924,7 @@ blur_debounce_timeout(gpointer user_data)
     }
     
     /* Get base image (original or B&W converted) */
-    GdkPixbuf *base_pixbuf = viewer->is_converted ? 
-        viewer->converted_pixbuf : viewer->original_pixbuf;
+    GdkPixbuf *base_pixbuf = get_blur_base_pixbuf(viewer);
     
     if (!base_pixbuf) {
         return G_SOURCE_REMOVE;
@@ -511,27 +1932,43 @@ blur_debounce_timeout(gpointer user_data)
     
     /* Check cache first */
     GdkPixbuf *cached_result = blur_cache_get(viewer->blur_cache, 
-                                             viewer->image_hash, 
+                                             viewer->blur_key, 
                                              viewer->blur_intensity);
     
     if (cached_result) {
         /* Use cached result */
         g_clear_object(&viewer->current_display_pixbuf);
         viewer->current_display_pixbuf = cached_result;
+        viewer->display_is_final = TRUE;
         gtk_picture_set_pixbuf(GTK_PICTURE(viewer->image_widget), cached_result);
+        record_time_to_display(viewer, TRUE);
+        schedule_blur_prefetch(viewer);
         return G_SOURCE_REMOVE;
     }
     
-    /* Start background blur processing */
-    viewer->active_blur_request = blur_processor_apply_async(
+    /* Start background blur processing, continuing from a cached lower
+     * intensity when there is one (the processor decides if it pays off) */
+    gdouble lower_intensity = 0.0;
+    GdkPixbuf *lower_result = blur_cache_get_nearest_lower(viewer->blur_cache,
+                                                           viewer->blur_key,
+                                                           viewer->blur_intensity,
+                                                           &lower_intensity);
+    
+    viewer->blur_dispatch_time = g_get_monotonic_time();
+    viewer->blur_dispatch_engine = blur_engine_index(viewer, viewer->blur_intensity);
+    viewer->active_blur_request = blur_processor_apply_async_from_base(
         viewer->blur_processor,
         base_pixbuf,
-        viewer->blur_intensity,
-        FALSE, // Full quality
+        lower_result,
+        proxy_intensity(viewer, lower_intensity),
+        proxy_intensity(viewer, viewer->blur_intensity),
+        BLUR_PRIORITY_VISIBLE,
         blur_completion_callback,
         viewer
     );
     
+    g_clear_object(&lower_result);
+    
     return G_SOURCE_REMOVE;
 }
 
@@ -554,6 +1991,11 @@ blur_completion_callback(GdkPixbuf *result_pixbuf, const GError *error, gpointer
         return;
     }
     
+    /* A replaced request was already superseded by the one now tracked */
+    if (g_error_matches(error, BLUR_ERROR, BLUR_ERROR_CANCELLED)) {
+        return;
+    }
+    
     viewer->active_blur_request = 0;
     
     if (error) {
@@ -566,18 +2008,136 @@ blur_completion_callback(GdkPixbuf *result_pixbuf, const GError *error, gpointer
         return;
     }
     
+    record_blur_cost(viewer);
+    
     /* Cache the result - check if cache still exists */
-    if (viewer->blur_cache && viewer->image_hash) {
-        blur_cache_put(viewer->blur_cache, viewer->image_hash, 
-                       viewer->blur_intensity, result_pixbuf);
+    if (viewer->blur_cache && viewer->blur_key) {
+        blur_cache_put_owned(viewer->blur_cache, viewer->blur_cache_owner, viewer->blur_key,
+                             viewer->blur_intensity, result_pixbuf);
     }
     
     /* Update display - check if widgets still exist */
     if (viewer->image_widget && GTK_IS_PICTURE(viewer->image_widget)) {
         g_clear_object(&viewer->current_display_pixbuf);
         viewer->current_display_pixbuf = g_object_ref(result_pixbuf);
+        viewer->display_is_final = TRUE;
         gtk_picture_set_pixbuf(GTK_PICTURE(viewer->image_widget), result_pixbuf);
+        record_time_to_display(viewer, TRUE);
+        schedule_blur_prefetch(viewer);
+    }
+}
+
+/**
+ * record_time_to_display:
+ * @viewer: HelloImageViewer instance
+ * @is_final: TRUE for a full quality result, FALSE for a preview
+ *
+ * Notes how long the last slider change took to reach the screen. Only
+ * the first final result after a change counts; later ones come from
+ * prefetching or reloads, not from the user's input.
+ */
+static void
+record_time_to_display(HelloImageViewer *viewer, gboolean is_final)
+{
+    if (viewer->blur_input_time == 0)
+        return;
+    
+    if (is_final) {
+        viewer->final_display_us = g_get_monotonic_time() - viewer->blur_input_time;
+        viewer->blur_input_time = 0;
+    } else {
+        viewer->preview_display_us = g_get_monotonic_time() - viewer->blur_input_time;
+    }
+}
+
+/**
+ * append_latency:
+ * @text: Overlay text being built
+ * @name: Row label
+ * @latency: Percentiles to show
+ *
+ * Appends one latency row of the debug overlay
+ */
+static void
+append_latency(GString *text, const gchar *name, const BlurLatencyStats *latency)
+{
+    g_string_append_printf(text, "\n%-10s p50 %6.1f ms  p99 %6.1f ms",
+                           name, latency->p50_us / 1000.0, latency->p99_us / 1000.0);
+}
+
+/**
+ * update_debug_overlay:
+ * @viewer: HelloImageViewer instance
+ *
+ * Fills the overlay from the processor and cache counters. Latencies are
+ * over the processor's last BLUR_LATENCY_WINDOW requests, of every window
+ * sharing it.
+ */
+static void
+update_debug_overlay(HelloImageViewer *viewer)
+{
+    GString *text = g_string_new(NULL);
+    
+    g_string_append_printf(text, "Renderer blur: %s",
+                           hello_image_viewer_is_gpu_blur_active(viewer) ? "on" : "off");
+    
+    if (viewer->blur_processor) {
+        BlurProcessorStats stats;
+        
+        blur_processor_get_stats(viewer->blur_processor, &stats);
+        g_string_append_printf(text, "   Kernels: %s",
+                               blur_processor_get_kernel_name(viewer->blur_processor));
+        append_latency(text, "Total", &stats.total);
+        append_latency(text, "Compute", &stats.compute);
+        append_latency(text, "Queue", &stats.queue_wait);
+        append_latency(text, "Delivery", &stats.delivery);
+        g_string_append_printf(text, "\nThroughput %.1f MP/s", stats.throughput_mpixels);
+        g_string_append_printf(text, "\nRequests   %" G_GUINT64_FORMAT " done, %"
+                               G_GUINT64_FORMAT " cancelled",
+                               stats.completed_requests, stats.cancelled_requests);
+        g_string_append_printf(text, "\nScratch    %.1f MB",
+                               stats.scratch_bytes / (1024.0 * 1024.0));
+    }
+    
+    if (viewer->blur_cache) {
+        BlurCacheStats cache_stats;
+        guint64 lookups;
+        
+        blur_cache_get_stats(viewer->blur_cache, &cache_stats);
+        lookups = cache_stats.hit_count + cache_stats.miss_count;
+        g_string_append_printf(text, "\nCache      %u/%u entries, %.1f MB, %.0f%% hits",
+                               cache_stats.current_entries, cache_stats.max_entries,
+                               cache_stats.current_memory / (1024.0 * 1024.0),
+                               lookups > 0 ? 100.0 * cache_stats.hit_count / lookups : 0.0);
     }
+    
+    g_string_append_printf(text, "\nDisplayed  preview %.0f ms, final %.0f ms",
+                           viewer->preview_display_us / 1000.0,
+                           viewer->final_display_us / 1000.0);
+    
+    gint debounce_ms = hello_image_viewer_get_blur_debounce(viewer);
+    if (debounce_ms < 0)
+        g_string_append(text, "\nDebounce   previews until release");
+    else if (debounce_ms == 0)
+        g_string_append(text, "\nDebounce   next frame");
+    else
+        g_string_append_printf(text, "\nDebounce   %d ms", debounce_ms);
+    
+    gtk_label_set_text(GTK_LABEL(viewer->debug_overlay), text->str);
+    g_string_free(text, TRUE);
+}
+
+/**
+ * debug_overlay_timeout:
+ * @user_data: HelloImageViewer instance
+ *
+ * Refreshes the debug overlay while it is shown
+ */
+static gboolean
+debug_overlay_timeout(gpointer user_data)
+{
+    update_debug_overlay(HELLO_IMAGE_VIEWER(user_data));
+    return G_SOURCE_CONTINUE;
 }
 
 /**
@@ -594,6 +2154,9 @@ update_display_image(HelloImageViewer *viewer)
     
     GdkPixbuf *display_pixbuf = NULL;
     
+    if (show_gpu_blur(viewer))
+        return;
+    
     if (viewer->blur_intensity <= 0.0) {
         /* No blur - use original or converted */
         display_pixbuf = viewer->is_converted ? 
@@ -614,34 +2177,106 @@ update_display_image(HelloImageViewer *viewer)
 }
 
 /**
- * calculate_image_hash:
- * @pixbuf: GdkPixbuf to hash
+ * update_blur_key:
+ * @viewer: HelloImageViewer instance
  *
- * Creates a simple hash string for cache key generation
+ * Derives the blur cache key from the content hash and the pipeline state,
+ * so blurs of the grayscale and colour versions never share an entry
  */
-static gchar*
-calculate_image_hash(GdkPixbuf *pixbuf)
+static void
+update_blur_key(HelloImageViewer *viewer)
 {
-    if (!pixbuf) {
-        return g_strdup("null");
+    g_clear_pointer(&viewer->blur_key, g_free);
+    
+    if (viewer->image_hash) {
+        viewer->blur_key = g_strdup_printf("%s-%s", viewer->image_hash,
+                                           viewer->is_converted ? "gray" : "color");
     }
+}
+
+/**
+ * image_hash_thread:
+ * @task: The hashing task
+ * @source_object: HelloImageViewer instance (unused on the worker)
+ * @task_data: Pixbuf to hash
+ * @cancellable: Cancelled when another image is loaded
+ *
+ * Hashes every pixel on a worker thread; only reads the pixbuf
+ */
+static void
+image_hash_thread(GTask        *task,
+                  gpointer      source_object,
+                  gpointer      task_data,
+                  GCancellable *cancellable)
+{
+    GdkPixbuf *pixbuf = task_data;
+    
+    if (g_task_return_error_if_cancelled(task))
+        return;
+    
+    g_task_return_pointer(task, image_hash_to_string(image_hash_pixbuf(pixbuf)), g_free);
+}
+
+/**
+ * on_image_hash_ready:
+ * @source_object: HelloImageViewer instance
+ * @result: The hashing task
+ * @user_data: Unused
+ *
+ * Installs the content hash of the current image and its cache key.
+ * Results for a replaced image arrive cancelled and are dropped.
+ */
+static void
+on_image_hash_ready(GObject      *source_object,
+                    GAsyncResult *result,
+                    gpointer      user_data)
+{
+    HelloImageViewer *viewer = HELLO_IMAGE_VIEWER(source_object);
+    GError *error = NULL;
+    gchar *hash;
     
-    gint width = gdk_pixbuf_get_width(pixbuf);
-    gint height = gdk_pixbuf_get_height(pixbuf);
-    gint channels = gdk_pixbuf_get_n_channels(pixbuf);
+    hash = g_task_propagate_pointer(G_TASK(result), &error);
+    if (!hash) {
+        if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+            g_warning("Image hashing failed: %s", error->message);
+        g_error_free(error);
+        return;
+    }
     
-    /* Simple hash based on dimensions and first few pixels */
-    const guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
-    guint hash = width * height * channels;
+    g_clear_object(&viewer->hash_cancellable);
+    g_free(viewer->image_hash);
+    viewer->image_hash = hash;
+    update_blur_key(viewer);
     
-    if (pixels && width > 0 && height > 0) {
-        gint sample_count = MIN(16, width * channels);
-        for (gint i = 0; i < sample_count; i++) {
-            hash = hash * 31 + pixels[i];
-        }
+    /* A final result already on screen can now seed the prefetcher */
+    if (viewer->display_is_final && viewer->blur_intensity > 0.0)
+        schedule_blur_prefetch(viewer);
+}
+
+/**
+ * start_image_hash:
+ * @viewer: HelloImageViewer instance
+ * @pixbuf: Newly loaded image
+ *
+ * Cancels hashing of the previous image and hashes @pixbuf on a worker
+ * thread, keeping the full-buffer pass off the main loop
+ */
+static void
+start_image_hash(HelloImageViewer *viewer, GdkPixbuf *pixbuf)
+{
+    GTask *task;
+    
+    if (viewer->hash_cancellable) {
+        g_cancellable_cancel(viewer->hash_cancellable);
+        g_object_unref(viewer->hash_cancellable);
     }
+    viewer->hash_cancellable = g_cancellable_new();
     
-    return g_strdup_printf("img_%08x", hash);
+    task = g_task_new(viewer, viewer->hash_cancellable, on_image_hash_ready, NULL);
+    g_task_set_source_tag(task, start_image_hash);
+    g_task_set_task_data(task, g_object_ref(pixbuf), g_object_unref);
+    g_task_run_in_thread(task, image_hash_thread);
+    g_object_unref(task);
 }
 
 /* Public API implementation */
@@ -685,19 +2320,19 @@ hello_image_viewer_blur_reset(HelloImageViewer *viewer, gboolean clear_cache)
     g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
     
     /* Cancel any active processing */
-    if (viewer->blur_timeout_id > 0) {
-        g_source_remove(viewer->blur_timeout_id);
-        viewer->blur_timeout_id = 0;
-    }
+    cancel_blur_dispatch(viewer);
+    cancel_blur_requests(viewer);
     
-    if (viewer->active_blur_request > 0) {
-        blur_processor_cancel(viewer->blur_processor, viewer->active_blur_request);
-        viewer->active_blur_request = 0;
-    }
-    
-    /* Clear cache if requested */
+    /* Clear cache if requested; in a shared cache only this window's
+     * entries go, by starting over as a fresh owner */
     if (clear_cache && viewer->blur_cache) {
-        blur_cache_clear(viewer->blur_cache);
+        if (viewer->owns_blur_resources) {
+            blur_cache_clear(viewer->blur_cache);
+        } else {
+            blur_cache_unregister_owner(viewer->blur_cache, viewer->blur_cache_owner);
+            viewer->blur_cache_owner = blur_cache_register_owner(viewer->blur_cache);
+            blur_prefetcher_set_cache_owner(viewer->blur_prefetcher, viewer->blur_cache_owner);
+        }
     }
     
     /* Reset slider to 0.0 */
@@ -705,3 +2340,90 @@ hello_image_viewer_blur_reset(HelloImageViewer *viewer, gboolean clear_cache)
     
     return TRUE;
 }
+
+void
+hello_image_viewer_set_gpu_blur(HelloImageViewer *viewer, gboolean enabled)
+{
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    
+    enabled = !!enabled;
+    if (viewer->gpu_blur_enabled == enabled)
+        return;
+    
+    viewer->gpu_blur_enabled = enabled;
+    if (!enabled)
+        clear_gpu_blur(viewer);
+    
+    /* Redisplay through the newly selected path */
+    if (!viewer->original_pixbuf)
+        return;
+    
+    if (viewer->blur_intensity > 0.0 && viewer->blur_scale)
+        on_blur_scale_value_changed(GTK_SCALE(viewer->blur_scale), viewer);
+    else
+        update_display_image(viewer);
+}
+
+gint
+hello_image_viewer_get_blur_debounce(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), BLUR_DEBOUNCE_DEFAULT_MS);
+    
+    gint64 cost = viewer->blur_cost_us[blur_engine_index(viewer, viewer->blur_intensity)];
+    
+    if (cost == 0)
+        return BLUR_DEBOUNCE_DEFAULT_MS;
+    if (cost <= BLUR_FRAME_BUDGET_US)
+        return 0;
+    if (cost >= BLUR_PREVIEW_ONLY_US)
+        return -1;
+    
+    return CLAMP((gint)(cost / 1000), BLUR_DEBOUNCE_MIN_MS, BLUR_DEBOUNCE_MAX_MS);
+}
+
+gboolean
+hello_image_viewer_is_blurring(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->blur_timeout_id > 0 || viewer->blur_tick_id > 0 ||
+           viewer->blur_dispatch_deferred || viewer->active_blur_request > 0;
+}
+
+void
+hello_image_viewer_set_debug_overlay(HelloImageViewer *viewer, gboolean enabled)
+{
+    g_return_if_fail(HELLO_IS_IMAGE_VIEWER(viewer));
+    
+    enabled = !!enabled;
+    if (hello_image_viewer_get_debug_overlay(viewer) == enabled)
+        return;
+    
+    if (enabled) {
+        update_debug_overlay(viewer);
+        viewer->debug_overlay_id = g_timeout_add(DEBUG_OVERLAY_INTERVAL_MS,
+                                                 debug_overlay_timeout, viewer);
+    } else {
+        g_source_remove(viewer->debug_overlay_id);
+        viewer->debug_overlay_id = 0;
+    }
+    
+    gtk_widget_set_visible(viewer->debug_overlay, enabled);
+}
+
+gboolean
+hello_image_viewer_get_debug_overlay(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->debug_overlay_id > 0;
+}
+
+gboolean
+hello_image_viewer_is_gpu_blur_active(HelloImageViewer *viewer)
+{
+    g_return_val_if_fail(HELLO_IS_IMAGE_VIEWER(viewer), FALSE);
+    
+    return viewer->gpu_paintable != NULL &&
+           gtk_picture_get_paintable(GTK_PICTURE(viewer->image_widget)) == viewer->gpu_paintable;
+}
@@ -10,6 +10,20 @@ G_BEGIN_DECLS
 #define HELLO_TYPE_IMAGE_VIEWER (hello_image_viewer_get_type())
 G_DECLARE_FINAL_TYPE(HelloImageViewer, hello_image_viewer, HELLO, IMAGE_VIEWER, GtkWindow)
 
+/**
+ * HelloImageViewerLoadMode:
+ * @HELLO_IMAGE_VIEWER_LOAD_PROXY: Decode images larger than the monitor at
+ *   a size fitted to it; blur and grayscale work on that proxy
+ * @HELLO_IMAGE_VIEWER_LOAD_FULL: Always decode at full resolution
+ * 
+ * How hello_image_viewer_load_image() and
+ * hello_image_viewer_load_file_async() decode the file.
+ */
+typedef enum {
+    HELLO_IMAGE_VIEWER_LOAD_PROXY,
+    HELLO_IMAGE_VIEWER_LOAD_FULL
+} HelloImageViewerLoadMode;
+
 /**
  * hello_image_viewer_new:
  * @app: The GtkApplication instance
@@ -21,6 +35,19 @@ G_DECLARE_FINAL_TYPE(HelloImageViewer, hello_image_viewer, HELLO, IMAGE_VIEWER,
  */
 HelloImageViewer *hello_image_viewer_new(GtkApplication *app, const char *filename);
 
+/**
+ * hello_image_viewer_new_for_file:
+ * @app: The GtkApplication instance
+ * @file: Image file to display
+ * 
+ * Creates a new HelloImageViewer window and starts streaming @file into
+ * it with hello_image_viewer_load_file_async(). Returns at once whatever
+ * the image size; a load failure is reported in the window.
+ * 
+ * Returns: (transfer full): A new HelloImageViewer instance
+ */
+HelloImageViewer *hello_image_viewer_new_for_file(GtkApplication *app, GFile *file);
+
 /**
  * hello_image_viewer_load_image:
  * @viewer: A HelloImageViewer instance
@@ -32,6 +59,79 @@ HelloImageViewer *hello_image_viewer_new(GtkApplication *app, const char *filena
  */
 gboolean hello_image_viewer_load_image(HelloImageViewer *viewer, const char *filename);
 
+/**
+ * hello_image_viewer_load_file_async:
+ * @viewer: A HelloImageViewer instance
+ * @file: Image file to display
+ * 
+ * Loads @file without blocking the main loop. The file is read in chunks
+ * by asynchronous GIO reads and fed to a #GdkPixbufLoader, and decoded
+ * scanlines are shown as they arrive. The blur and conversion controls
+ * stay disabled until the full image is available. Starting another load
+ * cancels this one.
+ */
+void hello_image_viewer_load_file_async(HelloImageViewer *viewer, GFile *file);
+
+/**
+ * hello_image_viewer_is_loading:
+ * @viewer: A HelloImageViewer instance
+ * 
+ * Returns: TRUE while a streaming load is in progress
+ */
+gboolean hello_image_viewer_is_loading(HelloImageViewer *viewer);
+
+/**
+ * hello_image_viewer_set_load_mode:
+ * @viewer: A HelloImageViewer instance
+ * @mode: Decode mode for the following loads
+ * 
+ * Selects proxy or full resolution decoding; the default is
+ * %HELLO_IMAGE_VIEWER_LOAD_PROXY. The image already shown is not reloaded.
+ */
+void hello_image_viewer_set_load_mode(HelloImageViewer *viewer, HelloImageViewerLoadMode mode);
+
+/**
+ * hello_image_viewer_get_source_size:
+ * @viewer: A HelloImageViewer instance
+ * @width: (out) (optional): Full resolution width
+ * @height: (out) (optional): Full resolution height
+ * 
+ * Gets the size of the image file, which is larger than the displayed
+ * image when a proxy was decoded.
+ * 
+ * Returns: TRUE if an image is loaded
+ */
+gboolean hello_image_viewer_get_source_size(HelloImageViewer *viewer, gint *width, gint *height);
+
+/**
+ * hello_image_viewer_render_full_resolution_async:
+ * @viewer: A HelloImageViewer instance
+ * @cancellable: (nullable): Optional cancellable
+ * @callback: Called when the render is done
+ * @user_data: Data for @callback
+ * 
+ * Recomputes the current view at the file's full resolution, for export
+ * or zoom: decodes the file again on a worker, applies grayscale if it
+ * is shown and blurs at the current intensity. The display keeps using
+ * the proxy.
+ */
+void hello_image_viewer_render_full_resolution_async(HelloImageViewer    *viewer,
+                                                     GCancellable        *cancellable,
+                                                     GAsyncReadyCallback  callback,
+                                                     gpointer             user_data);
+
+/**
+ * hello_image_viewer_render_full_resolution_finish:
+ * @viewer: A HelloImageViewer instance
+ * @result: Result passed to the callback
+ * @error: Return location for an error
+ * 
+ * Returns: (transfer full): Full resolution rendering, or NULL on error
+ */
+GdkPixbuf *hello_image_viewer_render_full_resolution_finish(HelloImageViewer  *viewer,
+                                                            GAsyncResult      *result,
+                                                            GError           **error);
+
 /**
  * hello_image_viewer_toggle_conversion:
  * @viewer: A HelloImageViewer instance
@@ -39,6 +139,10 @@ gboolean hello_image_viewer_load_image(HelloImageViewer *viewer, const char *fil
  * Programmatically toggles between color and B&W modes.
  * Equivalent to user clicking the conversion button.
  * 
+ * The first switch to B&W converts the image on the blur processor's
+ * worker pool and completes from the main loop; use
+ * hello_image_viewer_is_converting() to wait for it.
+ * 
  * Returns: TRUE if toggle was successful
  */
 gboolean hello_image_viewer_toggle_conversion(HelloImageViewer *viewer);
@@ -53,6 +157,14 @@ gboolean hello_image_viewer_toggle_conversion(HelloImageViewer *viewer);
  */
 gboolean hello_image_viewer_get_conversion_state(HelloImageViewer *viewer);
 
+/**
+ * hello_image_viewer_is_converting:
+ * @viewer: A HelloImageViewer instance
+ * 
+ * Returns: TRUE while a B&W conversion is running in the background
+ */
+gboolean hello_image_viewer_is_converting(HelloImageViewer *viewer);
+
 /**
  * hello_image_viewer_set_conversion_enabled:
  * @viewer: A HelloImageViewer instance
@@ -92,7 +204,7 @@ gboolean hello_image_viewer_set_blur_intensity(HelloImageViewer *viewer,
 /**
  * hello_image_viewer_blur_reset:
  * @viewer: A HelloImageViewer instance
- * @clear_cache: TRUE to also clear cached blur results
+ * @clear_cache: TRUE to also drop this window's cached blur results
  *
  * Resets blur to disabled state (intensity = 0.0).
  *
@@ -100,6 +212,73 @@ gboolean hello_image_viewer_set_blur_intensity(HelloImageViewer *viewer,
  */
 gboolean hello_image_viewer_blur_reset(HelloImageViewer *viewer, gboolean clear_cache);
 
+/**
+ * hello_image_viewer_set_gpu_blur:
+ * @viewer: A HelloImageViewer instance
+ * @enabled: TRUE to let the renderer blur the displayed image
+ *
+ * With a GL or Vulkan renderer the displayed blur is drawn by the render
+ * tree from a texture uploaded once, and slider moves only redraw it. The
+ * CPU engine keeps serving exports and the Cairo renderer. Enabled by
+ * default unless HELLO_IMAGE_VIEWER_GPU_BLUR is set to 0.
+ */
+void hello_image_viewer_set_gpu_blur(HelloImageViewer *viewer, gboolean enabled);
+
+/**
+ * hello_image_viewer_is_gpu_blur_active:
+ * @viewer: A HelloImageViewer instance
+ *
+ * Returns: TRUE if the renderer is drawing the displayed image
+ */
+gboolean hello_image_viewer_is_gpu_blur_active(HelloImageViewer *viewer);
+
+/**
+ * hello_image_viewer_get_blur_debounce:
+ * @viewer: A HelloImageViewer instance
+ *
+ * The delay between slider input and the full quality blur follows how
+ * long recent full quality blurs of this image took with the current
+ * intensity's engine: blurs that fit in a frame run on the next frame
+ * without a preview, slower ones wait about as long as one takes, and
+ * blurs of a quarter second or more only show previews until the drag
+ * ends. The fixed default applies until a blur of the image was timed.
+ * HELLO_IMAGE_VIEWER_BLUR_COST_MS records that many milliseconds for
+ * every blur instead of the measured time.
+ *
+ * Returns: Delay in milliseconds, 0 for the next frame, or -1 when a
+ *   drag only shows previews
+ */
+gint hello_image_viewer_get_blur_debounce(HelloImageViewer *viewer);
+
+/**
+ * hello_image_viewer_is_blurring:
+ * @viewer: A HelloImageViewer instance
+ * 
+ * Returns: TRUE while a full quality blur waits for its debounce or runs
+ *   in the background
+ */
+gboolean hello_image_viewer_is_blurring(HelloImageViewer *viewer);
+
+/**
+ * hello_image_viewer_set_debug_overlay:
+ * @viewer: A HelloImageViewer instance
+ * @enabled: TRUE to show live blur timings over the image
+ *
+ * Shows the blur engine in use, p50/p99 latencies, throughput, cancelled
+ * requests, cache usage and how long the last slider move took to reach
+ * the screen, refreshed twice a second. Shown from the start when
+ * HELLO_IMAGE_VIEWER_DEBUG_OVERLAY is set to 1.
+ */
+void hello_image_viewer_set_debug_overlay(HelloImageViewer *viewer, gboolean enabled);
+
+/**
+ * hello_image_viewer_get_debug_overlay:
+ * @viewer: A HelloImageViewer instance
+ *
+ * Returns: TRUE if the debug overlay is shown
+ */
+gboolean hello_image_viewer_get_debug_overlay(HelloImageViewer *viewer);
+
 G_END_DECLS
 
 #endif /* HELLO_IMAGE_VIEWER_H */
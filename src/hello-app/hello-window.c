@@ -133,18 +133,12 @@ on_file_dialog_response(GObject *source, GAsyncResult *result, gpointer user_dat
     file = gtk_file_dialog_open_finish(dialog, result, &error);
     
     if (file != NULL) {
-        char *filename;
         HelloImageViewer *viewer;
         
-        filename = g_file_get_path(file);
+        /* Show the viewer at once; the image streams in behind it */
+        viewer = hello_image_viewer_new_for_file(app, file);
+        gtk_window_present(GTK_WINDOW(viewer));
         
-        /* Create and show image viewer */
-        viewer = hello_image_viewer_new(app, filename);
-        if (viewer != NULL) {
-            gtk_window_present(GTK_WINDOW(viewer));
-        }
-        
-        g_free(filename);
         g_object_unref(file);
     } else if (error != NULL) {
         /* User cancelled or error occurred - just ignore silently */
@@ -0,0 +1,187 @@
+/* main.c - image-tool, batch blur and grayscale without a display
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include "../lib/image-batch.h"
+
+/* Scratch arenas of the processor; larger images are blurred in tiles */
+#define IMAGE_TOOL_ARENA_SIZE 4096
+
+static gdouble intensity = 0.0;
+static gboolean grayscale = FALSE;
+static gchar *output_dir = NULL;
+static gchar *format = NULL;
+static gboolean recursive = FALSE;
+static gint decoders = 0;
+static gint encoders = 0;
+static gint in_flight = 0;
+static gint threads = 0;
+static gboolean quiet = FALSE;
+static gchar **patterns = NULL;
+
+static GOptionEntry entries[] = {
+    { "blur", 'b', 0, G_OPTION_ARG_DOUBLE, &intensity,
+      "Blur with INTENSITY, above 0.0 and at most 10.0", "INTENSITY" },
+    { "grayscale", 'g', 0, G_OPTION_ARG_NONE, &grayscale,
+      "Convert to grayscale, before any blur", NULL },
+    { "output-dir", 'o', 0, G_OPTION_ARG_FILENAME, &output_dir,
+      "Write the results to DIR, created if missing", "DIR" },
+    { "format", 'f', 0, G_OPTION_ARG_STRING, &format,
+      "Output format, such as png or jpeg (default: png)", "FORMAT" },
+    { "recursive", 'r', 0, G_OPTION_ARG_NONE, &recursive,
+      "Also process the subdirectories of directories", NULL },
+    { "decoders", 0, 0, G_OPTION_ARG_INT, &decoders,
+      "Decoder threads (default: a quarter of the CPUs)", "N" },
+    { "encoders", 0, 0, G_OPTION_ARG_INT, &encoders,
+      "Encoder threads (default: a quarter of the CPUs)", "N" },
+    { "in-flight", 0, 0, G_OPTION_ARG_INT, &in_flight,
+      "Images held in memory at once (default: decoders + encoders + CPUs)", "N" },
+    { "threads", 't', 0, G_OPTION_ARG_INT, &threads,
+      "Blur worker threads (default: one per CPU)", "N" },
+    { "quiet", 'q', 0, G_OPTION_ARG_NONE, &quiet,
+      "Only report failures", NULL },
+    { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &patterns,
+      NULL, "PATH..." },
+    { NULL }
+};
+
+/**
+ * parse_options:
+ * @argc: Argument count
+ * @argv: Argument vector
+ * @options: Batch options to fill in
+ * @error: Return location for error
+ *
+ * Parses the command line into @options, applying the defaults.
+ *
+ * Returns: TRUE on success
+ */
+static gboolean
+parse_options(int *argc, char ***argv, ImageBatchOptions *options, GError **error)
+{
+    GOptionContext *context;
+    guint cpus = g_get_num_processors();
+    gboolean parsed;
+
+    context = g_option_context_new("PATH... - blur and convert images in bulk");
+    g_option_context_set_summary(context,
+        "Each PATH is an image, a directory or a glob such as \"photos/*.jpg\".\n"
+        "Results keep their input's name, in the output format; repeated names\n"
+        "get a -2, -3, ... suffix, and inputs are never overwritten.");
+    g_option_context_add_main_entries(context, entries, NULL);
+    parsed = g_option_context_parse(context, argc, argv, error);
+    g_option_context_free(context);
+
+    if (!parsed)
+        return FALSE;
+
+    if (!patterns || !patterns[0]) {
+        g_set_error(error, G_OPTION_ERROR, G_OPTION_ERROR_FAILED, "No input paths given");
+        return FALSE;
+    }
+    if (!output_dir) {
+        g_set_error(error, G_OPTION_ERROR, G_OPTION_ERROR_FAILED,
+                    "--output-dir is required");
+        return FALSE;
+    }
+    if (decoders < 0 || encoders < 0 || in_flight < 0 || threads < 0) {
+        g_set_error(error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                    "Thread and image counts cannot be negative");
+        return FALSE;
+    }
+
+    options->stages = (grayscale ? BLUR_STAGE_GRAYSCALE : 0) |
+                      (intensity != 0.0 ? BLUR_STAGE_BLUR : 0);
+    options->intensity = intensity;
+    options->output_dir = output_dir;
+    options->format = format ? format : "png";
+
+    /* Decoding and encoding are a fraction of the cost of the stages, so
+     * most CPUs go to the blur pool */
+    options->decoders = decoders > 0 ? (guint)decoders : MAX(1, cpus / 4);
+    options->encoders = encoders > 0 ? (guint)encoders : MAX(1, cpus / 4);
+
+    /* Enough images to keep every stage busy; memory stays bounded by it */
+    options->max_in_flight = in_flight > 0 ? (guint)in_flight
+                                           : options->decoders + options->encoders + cpus;
+
+    return TRUE;
+}
+
+int
+main(int argc, char *argv[])
+{
+    ImageBatchOptions options = { 0 };
+    ImageBatchResult result;
+    GPtrArray *inputs;
+    BlurProcessor *processor;
+    GError *error = NULL;
+    int status = EXIT_SUCCESS;
+
+    if (!parse_options(&argc, &argv, &options, &error)) {
+        g_printerr("image-tool: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    if (g_mkdir_with_parents(output_dir, 0755) != 0) {
+        g_printerr("image-tool: %s: %s\n", output_dir, g_strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    inputs = g_ptr_array_new_with_free_func(g_free);
+    for (gchar **pattern = patterns; *pattern; pattern++) {
+        if (!image_batch_collect_inputs(inputs, *pattern, recursive, &error)) {
+            /* A path with nothing to process does not stop the others */
+            g_printerr("image-tool: %s\n", error->message);
+            g_clear_error(&error);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    processor = blur_processor_create(IMAGE_TOOL_ARENA_SIZE, IMAGE_TOOL_ARENA_SIZE, threads);
+    if (!processor) {
+        g_printerr("image-tool: Could not create the blur processor\n");
+        g_ptr_array_unref(inputs);
+        return EXIT_FAILURE;
+    }
+
+    if (!image_batch_run(processor, &options, inputs, &result, &error)) {
+        g_printerr("image-tool: %s\n", error->message);
+        g_error_free(error);
+        status = EXIT_FAILURE;
+    } else {
+        gdouble seconds = result.elapsed_us / (gdouble)G_USEC_PER_SEC;
+
+        for (guint i = 0; i < result.errors->len; i++)
+            g_printerr("image-tool: %s\n", (const gchar *)result.errors->pdata[i]);
+
+        if (!quiet) {
+            g_print("Processed %u images in %.2f s (%.1f images/s), %u failed\n",
+                    result.succeeded + result.failed, seconds,
+                    seconds > 0.0 ? result.succeeded / seconds : 0.0, result.failed);
+        }
+
+        if (result.failed > 0)
+            status = EXIT_FAILURE;
+        g_ptr_array_unref(result.errors);
+    }
+
+    blur_processor_destroy(processor);
+    g_ptr_array_unref(inputs);
+    g_strfreev(patterns);
+    g_free(output_dir);
+    g_free(format);
+
+    return status;
+}
@@ -9,46 +9,132 @@
  */
 
 #include "blur-cache.h"
+#include "blur-trace.h"
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#endif
 
 /* Private structures */
 
-typedef struct _BlurCacheEntry {
-    gchar *key;                    // "pixbuf_hash:intensity" format
+typedef struct _BlurCacheEntry BlurCacheEntry;
+
+struct _BlurCacheEntry {
+    BlurCacheKey key;              // Image hash and intensity step
     GdkPixbuf *blurred_pixbuf;     // Cached blur result
     gsize memory_size;             // Memory footprint
-    gint64 access_timestamp;       // Last access for LRU
-    gint reference_count;          // Thread safety reference counting
-    GList *lru_node;               // Node in LRU linked list
-} BlurCacheEntry;
+    gsize access_tick;             // Cache-wide access order for LRU
+    guint owner_id;                // Registered owner, 0 for shared entries
+    gboolean speculative;          // Put ahead of need and not read since
+    
+    /* Intrusive LRU links, most recent at the head */
+    BlurCacheEntry *lru_prev;
+    BlurCacheEntry *lru_next;
+    
+    /* Other variants of the same image, in no particular order */
+    BlurCacheEntry *image_prev;
+    BlurCacheEntry *image_next;
+};
 
-struct _BlurCache {
+/* One lock stripe. All variants of an image live in the same shard, so
+ * per-image operations only ever take one lock. */
+typedef struct {
     /* Cache storage */
-    GHashTable *cache_table;       // key -> BlurCacheEntry mapping
-    GList *lru_list;               // LRU ordered list (most recent first)
+    GHashTable *cache_table;       // &entry->key -> BlurCacheEntry mapping
+    BlurCacheEntry *lru_head;      // Most recently used
+    BlurCacheEntry *lru_tail;      // Least recently used, next to evict
+    GHashTable *image_index;       // &head->key.image_hash -> first variant of the image
     
-    /* Limits and statistics */
-    guint max_entries;
-    gsize max_memory;
+    /* Performance statistics */
     guint current_entries;
     gsize current_memory;
-    
-    /* Performance statistics */
+    guint speculative_entries;     // Entries still flagged speculative
     guint64 hit_count;
     guint64 miss_count;
+    guint64 disk_hit_count;
     guint64 eviction_count;
     
     /* Thread safety */
-    GMutex cache_mutex;
+    GMutex mutex;
+} BlurCacheShard;
+
+struct _BlurCache {
+    BlurCacheShard *shards;
+    guint shard_count;
+    
+    /* Limits shared by all shards; the totals are updated atomically so
+     * a put only needs its own shard's lock. The limits are too, since
+     * blur_cache_set_limits() may change them at any time. */
+    guint max_entries;
+    gsize max_memory;
+    gint current_entries;
+    gsize current_memory;
+    
+    /* Ticks on every access; orders entries of different shards */
+    gsize access_clock;
+    
+    /* Fair-share accounting, owner id -> BlurCacheOwner. Taken after a
+     * shard lock, never before one. */
+    GHashTable *owners;
+    guint next_owner_id;
+    GMutex owners_mutex;
+    
+    /* Optional persistent tier behind the shards, owned by the cache */
+    BlurDiskCache *disk_tier;
 };
 
+typedef enum {
+    INSERT_ADDED,
+    INSERT_EXISTS,
+    INSERT_FAILED
+} InsertResult;
+
+typedef struct {
+    gsize memory;
+    guint entries;
+} BlurCacheOwner;
+
+/* Matches entries of every owner in oldest_entry_in_shard() */
+#define ANY_OWNER G_MAXUINT
+
 /* Private helper functions */
 
+static InsertResult insert_entry(BlurCache *cache,
+                                 guint owner_id,
+                                 const BlurCacheKey *key,
+                                 GdkPixbuf *blurred_pixbuf,
+                                 gboolean speculative);
+
+static guint cache_max_entries(BlurCache *cache) {
+    return (guint)g_atomic_int_get(&cache->max_entries);
+}
+
+static gsize cache_max_memory(BlurCache *cache) {
+    return (gsize)g_atomic_pointer_get(&cache->max_memory);
+}
+
+static guint cache_key_hash(gconstpointer data) {
+    const BlurCacheKey *key = data;
+    guint64 mixed = key->image_hash ^ ((guint64)(guint32)key->intensity_step * G_GUINT64_CONSTANT(0x9E3779B97F4A7C15));
+    return (guint)(mixed ^ (mixed >> 32));
+}
+
+static gboolean cache_key_equal(gconstpointer a, gconstpointer b) {
+    const BlurCacheKey *key_a = a;
+    const BlurCacheKey *key_b = b;
+    return key_a->image_hash == key_b->image_hash &&
+           key_a->intensity_step == key_b->intensity_step;
+}
+
+static BlurCacheShard* shard_for_hash(BlurCache *cache, guint64 image_hash) {
+    // FNV-1a leaves the low bits well mixed, fold in the high ones anyway
+    return &cache->shards[(guint)(image_hash ^ (image_hash >> 32)) % cache->shard_count];
+}
+
 static void cache_entry_free(BlurCacheEntry *entry) {
     if (entry) {
-        g_free(entry->key);
         if (entry->blurred_pixbuf) {
             g_object_unref(entry->blurred_pixbuf);
         }
@@ -56,78 +142,216 @@ static void cache_entry_free(BlurCacheEntry *entry) {
     }
 }
 
-static gint64 get_timestamp_microseconds(void) {
-    return g_get_monotonic_time();
-}
-
-static BlurCacheEntry* cache_entry_create(const gchar *key, 
-                                        GdkPixbuf *pixbuf, 
+static BlurCacheEntry* cache_entry_create(const BlurCacheKey *key,
+                                        GdkPixbuf *pixbuf,
                                         gsize memory_size) {
     BlurCacheEntry *entry = g_malloc0(sizeof(BlurCacheEntry));
     if (!entry) {
         return NULL;
     }
     
-    entry->key = g_strdup(key);
+    entry->key = *key;
     entry->blurred_pixbuf = g_object_ref(pixbuf);
     entry->memory_size = memory_size;
-    entry->access_timestamp = get_timestamp_microseconds();
-    entry->reference_count = 1;
-    entry->lru_node = NULL;
     
     return entry;
 }
 
-static void update_lru_order(BlurCache *cache, BlurCacheEntry *entry) {
-    // Remove from current position if already in list
-    if (entry->lru_node) {
-        cache->lru_list = g_list_remove_link(cache->lru_list, entry->lru_node);
-        g_list_free(entry->lru_node);
+static void lru_unlink(BlurCacheShard *shard, BlurCacheEntry *entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else if (shard->lru_head == entry) {
+        shard->lru_head = entry->lru_next;
+    }
+    
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else if (shard->lru_tail == entry) {
+        shard->lru_tail = entry->lru_prev;
+    }
+    
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void image_link(BlurCacheShard *shard, BlurCacheEntry *entry) {
+    BlurCacheEntry *head = g_hash_table_lookup(shard->image_index, &entry->key.image_hash);
+    
+    entry->image_prev = NULL;
+    entry->image_next = head;
+    if (head) {
+        head->image_prev = entry;
+    }
+    
+    // The index key points into the head entry, so replace it along with the value
+    g_hash_table_replace(shard->image_index, &entry->key.image_hash, entry);
+}
+
+static void image_unlink(BlurCacheShard *shard, BlurCacheEntry *entry) {
+    if (entry->image_prev) {
+        entry->image_prev->image_next = entry->image_next;
+    } else if (entry->image_next) {
+        g_hash_table_replace(shard->image_index, &entry->image_next->key.image_hash,
+                             entry->image_next);
+    } else {
+        g_hash_table_remove(shard->image_index, &entry->key.image_hash);
     }
     
-    // Add to front of list (most recently used)
-    cache->lru_list = g_list_prepend(cache->lru_list, entry);
-    entry->lru_node = cache->lru_list;
-    entry->access_timestamp = get_timestamp_microseconds();
+    if (entry->image_next) {
+        entry->image_next->image_prev = entry->image_prev;
+    }
+    
+    entry->image_prev = NULL;
+    entry->image_next = NULL;
 }
 
-static gboolean should_evict_for_memory(BlurCache *cache, gsize new_entry_size) {
-    return (cache->current_memory + new_entry_size > cache->max_memory);
+static void update_lru_order(BlurCache *cache, BlurCacheShard *shard, BlurCacheEntry *entry) {
+    // Move to front of list (most recently used)
+    if (shard->lru_head != entry) {
+        lru_unlink(shard, entry);
+        
+        entry->lru_next = shard->lru_head;
+        if (shard->lru_head) {
+            shard->lru_head->lru_prev = entry;
+        }
+        shard->lru_head = entry;
+        if (!shard->lru_tail) {
+            shard->lru_tail = entry;
+        }
+    }
+    
+    entry->access_tick = g_atomic_pointer_add(&cache->access_clock, 1);
 }
 
-static gboolean should_evict_for_count(BlurCache *cache) {
-    return (cache->current_entries >= cache->max_entries);
+static gboolean is_over_limit(BlurCache *cache) {
+    return (guint)g_atomic_int_get(&cache->current_entries) > cache_max_entries(cache) ||
+           g_atomic_pointer_get(&cache->current_memory) > cache_max_memory(cache);
 }
 
-static void evict_lru_entry(BlurCache *cache) {
-    if (!cache->lru_list) {
+static void charge_owner(BlurCache *cache, guint owner_id, gint entries, gssize memory) {
+    if (owner_id == 0) {
         return;
     }
     
-    // Find least recently used entry (last in list)
-    GList *last = g_list_last(cache->lru_list);
-    BlurCacheEntry *lru_entry = (BlurCacheEntry*)last->data;
+    g_mutex_lock(&cache->owners_mutex);
+    BlurCacheOwner *owner = g_hash_table_lookup(cache->owners, GUINT_TO_POINTER(owner_id));
+    if (owner) {
+        owner->entries += entries;
+        owner->memory += memory;
+    }
+    g_mutex_unlock(&cache->owners_mutex);
+}
+
+static void account_entry(BlurCache *cache, guint owner_id, gint entries, gssize memory) {
+    g_atomic_int_add(&cache->current_entries, entries);
+    g_atomic_pointer_add(&cache->current_memory, memory);
+    charge_owner(cache, owner_id, entries, memory);
+}
+
+static void remove_entry(BlurCache *cache, BlurCacheShard *shard, BlurCacheEntry *entry) {
+    lru_unlink(shard, entry);
+    image_unlink(shard, entry);
+    
+    shard->current_entries--;
+    shard->current_memory -= entry->memory_size;
+    shard->speculative_entries -= entry->speculative;
+    account_entry(cache, entry->owner_id, -1, -(gssize)entry->memory_size);
+    
+    // Frees the entry via GDestroyNotify; the key lives inside it
+    g_hash_table_remove(shard->cache_table, &entry->key);
+}
+
+static BlurCacheEntry* oldest_entry_in_shard(BlurCacheShard *shard, guint owner_id) {
+    BlurCacheEntry *entry = shard->lru_tail;
+    while (entry && owner_id != ANY_OWNER && entry->owner_id != owner_id) {
+        entry = entry->lru_prev;
+    }
+    return entry;
+}
+
+// Evicts the least recently used entry of @owner_id (or of anyone for
+// ANY_OWNER) across all shards. Takes shard locks one at a time, so the
+// caller must not hold any.
+static gboolean evict_oldest_entry(BlurCache *cache, guint owner_id) {
+    BlurCacheShard *oldest = NULL;
+    gsize oldest_tick = G_MAXSIZE;
+    
+    for (guint i = 0; i < cache->shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        g_mutex_lock(&shard->mutex);
+        BlurCacheEntry *entry = oldest_entry_in_shard(shard, owner_id);
+        if (entry && entry->access_tick < oldest_tick) {
+            oldest_tick = entry->access_tick;
+            oldest = shard;
+        }
+        g_mutex_unlock(&shard->mutex);
+    }
+    
+    if (!oldest) {
+        return FALSE;
+    }
     
-    // Store memory size before removal (entry will be freed by hash table)
-    gsize entry_memory_size = lru_entry->memory_size;
+    // The shard may have changed meanwhile; any matching entry still frees space
+    g_mutex_lock(&oldest->mutex);
+    BlurCacheEntry *entry = oldest_entry_in_shard(oldest, owner_id);
+    if (entry) {
+        remove_entry(cache, oldest, entry);
+        oldest->eviction_count++;
+    }
+    g_mutex_unlock(&oldest->mutex);
+    
+    return entry != NULL;
+}
+
+// Owner holding the most memory beyond an equal split of the budget, or
+// 0 when nobody is over their share
+static guint owner_over_fair_share(BlurCache *cache) {
+    guint heaviest = 0;
+    
+    g_mutex_lock(&cache->owners_mutex);
+    
+    guint owner_count = g_hash_table_size(cache->owners);
+    if (owner_count > 1) {
+        gsize largest = cache_max_memory(cache) / owner_count;
+        GHashTableIter iter;
+        gpointer key, value;
+        
+        g_hash_table_iter_init(&iter, cache->owners);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            BlurCacheOwner *owner = value;
+            if (owner->memory > largest) {
+                largest = owner->memory;
+                heaviest = GPOINTER_TO_UINT(key);
+            }
+        }
+    }
     
-    // Remove from LRU list first
-    cache->lru_list = g_list_remove_link(cache->lru_list, last);
-    g_list_free(last);
+    g_mutex_unlock(&cache->owners_mutex);
     
-    // Remove from hash table (this will automatically free the entry via GDestroyNotify)
-    g_hash_table_remove(cache->cache_table, lru_entry->key);
+    return heaviest;
+}
+
+// Frees space for a put: owners above their fair share give up their own
+// oldest results first, everything else is plain LRU
+static gboolean evict_for_budget(BlurCache *cache) {
+    guint owner_id = owner_over_fair_share(cache);
+    
+    if (owner_id != 0 && evict_oldest_entry(cache, owner_id)) {
+        return TRUE;
+    }
     
-    // Update statistics
-    cache->current_entries--;
-    cache->current_memory -= entry_memory_size;
-    cache->eviction_count++;
+    return evict_oldest_entry(cache, ANY_OWNER);
 }
 
 /* Public API Implementation */
 
 BlurCache* blur_cache_create(guint max_entries, gsize max_memory_bytes) {
-    if (max_entries == 0 || max_memory_bytes < 1024 * 1024) { // Minimum 1MB
+    return blur_cache_create_sharded(max_entries, max_memory_bytes, 1);
+}
+
+BlurCache* blur_cache_create_sharded(guint max_entries, gsize max_memory_bytes, guint shard_count) {
+    if (max_entries == 0 || max_memory_bytes < 1024 * 1024 || // Minimum 1MB
+        shard_count == 0 || shard_count > BLUR_CACHE_MAX_SHARDS) {
         return NULL;
     }
     
@@ -136,24 +360,25 @@ BlurCache* blur_cache_create(guint max_entries, gsize max_memory_bytes) {
         return NULL;
     }
     
-    cache->cache_table = g_hash_table_new_full(g_str_hash, g_str_equal,
-                                              NULL, (GDestroyNotify)cache_entry_free);
-    if (!cache->cache_table) {
-        g_free(cache);
-        return NULL;
+    cache->shards = g_new0(BlurCacheShard, shard_count);
+    cache->shard_count = shard_count;
+    
+    for (guint i = 0; i < shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        shard->cache_table = g_hash_table_new_full(cache_key_hash, cache_key_equal,
+                                                  NULL, (GDestroyNotify)cache_entry_free);
+        shard->image_index = g_hash_table_new(g_int64_hash, g_int64_equal);
+        g_mutex_init(&shard->mutex);
     }
     
     cache->max_entries = max_entries;
     cache->max_memory = max_memory_bytes;
     cache->current_entries = 0;
     cache->current_memory = 0;
-    cache->lru_list = NULL;
-    
-    cache->hit_count = 0;
-    cache->miss_count = 0;
-    cache->eviction_count = 0;
     
-    g_mutex_init(&cache->cache_mutex);
+    cache->owners = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    cache->next_owner_id = 1;
+    g_mutex_init(&cache->owners_mutex);
     
     return cache;
 }
@@ -163,85 +388,209 @@ GdkPixbuf* blur_cache_get(BlurCache *cache, const gchar *pixbuf_hash, gdouble in
         return NULL;
     }
     
-    gchar *key = blur_cache_make_key(pixbuf_hash, intensity);
-    if (!key) {
-        return NULL;
-    }
+    gint64 trace_start = blur_trace_now();
+    BlurCacheKey key;
+    blur_cache_key_init(&key, pixbuf_hash, intensity);
+    BlurCacheShard *shard = shard_for_hash(cache, key.image_hash);
     
-    g_mutex_lock(&cache->cache_mutex);
+    g_mutex_lock(&shard->mutex);
     
-    BlurCacheEntry *entry = g_hash_table_lookup(cache->cache_table, key);
+    BlurCacheEntry *entry = g_hash_table_lookup(shard->cache_table, &key);
     GdkPixbuf *result = NULL;
     
     if (entry) {
         // Cache hit - update LRU order and return pixbuf
-        update_lru_order(cache, entry);
+        update_lru_order(cache, shard, entry);
         result = g_object_ref(entry->blurred_pixbuf);
-        cache->hit_count++;
+        shard->speculative_entries -= entry->speculative;
+        entry->speculative = FALSE;
+        shard->hit_count++;
     } else {
         // Cache miss
-        cache->miss_count++;
+        shard->miss_count++;
+    }
+    
+    g_mutex_unlock(&shard->mutex);
+    
+    if (!result && cache->disk_tier) {
+        // Mapped, not decoded; promoted without being written back
+        result = blur_disk_cache_lookup(cache->disk_tier, pixbuf_hash,
+                                        BLUR_DISK_CACHE_OP_BLUR, key.intensity_step);
+        if (result) {
+            insert_entry(cache, 0, &key, result, FALSE);
+            
+            g_mutex_lock(&shard->mutex);
+            shard->disk_hit_count++;
+            g_mutex_unlock(&shard->mutex);
+            
+            blur_trace_mark(trace_start, blur_trace_now(), "cache-get",
+                            "disk hit, intensity %.1f", intensity);
+            return result;
+        }
+    }
+    
+    blur_trace_mark(trace_start, blur_trace_now(), "cache-get",
+                    "%s, intensity %.1f", result ? "hit" : "miss", intensity);
+    return result;
+}
+
+GdkPixbuf* blur_cache_get_nearest_lower(BlurCache *cache,
+                                       const gchar *pixbuf_hash,
+                                       gdouble intensity,
+                                       gdouble *found_intensity) {
+    if (!cache || !pixbuf_hash) {
+        return NULL;
     }
     
-    g_mutex_unlock(&cache->cache_mutex);
-    g_free(key);
+    BlurCacheKey key;
+    blur_cache_key_init(&key, pixbuf_hash, intensity);
+    BlurCacheShard *shard = shard_for_hash(cache, key.image_hash);
+    GdkPixbuf *result = NULL;
+    
+    g_mutex_lock(&shard->mutex);
+    
+    // Pick the highest step below the target among the image's variants
+    BlurCacheEntry *best = NULL;
+    for (BlurCacheEntry *entry = g_hash_table_lookup(shard->image_index, &key.image_hash);
+         entry; entry = entry->image_next) {
+        if (entry->key.intensity_step > 0 &&
+            entry->key.intensity_step < key.intensity_step &&
+            (!best || entry->key.intensity_step > best->key.intensity_step)) {
+            best = entry;
+        }
+    }
+    
+    if (best) {
+        update_lru_order(cache, shard, best);
+        result = g_object_ref(best->blurred_pixbuf);
+        if (found_intensity) {
+            *found_intensity = best->key.intensity_step / 10.0;
+        }
+    }
+    
+    g_mutex_unlock(&shard->mutex);
     
     return result;
 }
 
+gboolean blur_cache_contains(BlurCache *cache, const gchar *pixbuf_hash, gdouble intensity) {
+    if (!cache || !pixbuf_hash) {
+        return FALSE;
+    }
+    
+    BlurCacheKey key;
+    blur_cache_key_init(&key, pixbuf_hash, intensity);
+    BlurCacheShard *shard = shard_for_hash(cache, key.image_hash);
+    
+    g_mutex_lock(&shard->mutex);
+    gboolean found = g_hash_table_contains(shard->cache_table, &key);
+    g_mutex_unlock(&shard->mutex);
+    
+    if (!found && cache->disk_tier) {
+        found = blur_disk_cache_contains(cache->disk_tier, pixbuf_hash,
+                                         BLUR_DISK_CACHE_OP_BLUR, key.intensity_step);
+    }
+    
+    return found;
+}
+
 gboolean blur_cache_put(BlurCache *cache,
                        const gchar *pixbuf_hash,
                        gdouble intensity,
                        GdkPixbuf *blurred_pixbuf) {
+    return blur_cache_put_owned(cache, 0, pixbuf_hash, intensity, blurred_pixbuf);
+}
+
+static gboolean put_entry(BlurCache *cache,
+                          guint owner_id,
+                          const gchar *pixbuf_hash,
+                          gdouble intensity,
+                          GdkPixbuf *blurred_pixbuf,
+                          gboolean speculative) {
     if (!cache || !pixbuf_hash || !blurred_pixbuf) {
         return FALSE;
     }
     
-    gchar *key = blur_cache_make_key(pixbuf_hash, intensity);
-    if (!key) {
-        return FALSE;
+    gint64 trace_start = blur_trace_now();
+    BlurCacheKey key;
+    blur_cache_key_init(&key, pixbuf_hash, intensity);
+    
+    InsertResult inserted = insert_entry(cache, owner_id, &key, blurred_pixbuf, speculative);
+    
+    // Only new results go to disk; hits from the disk tier never come back here
+    if (inserted == INSERT_ADDED && cache->disk_tier) {
+        blur_disk_cache_store(cache->disk_tier, pixbuf_hash, BLUR_DISK_CACHE_OP_BLUR,
+                              key.intensity_step, blurred_pixbuf);
     }
     
+    blur_trace_mark(trace_start, blur_trace_now(), "cache-put", "%s, intensity %.1f",
+                    inserted == INSERT_ADDED ? "added" :
+                    inserted == INSERT_EXISTS ? "exists" : "rejected", intensity);
+    return inserted != INSERT_FAILED;
+}
+
+gboolean blur_cache_put_owned(BlurCache *cache,
+                             guint owner_id,
+                             const gchar *pixbuf_hash,
+                             gdouble intensity,
+                             GdkPixbuf *blurred_pixbuf) {
+    return put_entry(cache, owner_id, pixbuf_hash, intensity, blurred_pixbuf, FALSE);
+}
+
+gboolean blur_cache_put_speculative(BlurCache *cache,
+                                   guint owner_id,
+                                   const gchar *pixbuf_hash,
+                                   gdouble intensity,
+                                   GdkPixbuf *blurred_pixbuf) {
+    return put_entry(cache, owner_id, pixbuf_hash, intensity, blurred_pixbuf, TRUE);
+}
+
+static InsertResult insert_entry(BlurCache *cache,
+                                 guint owner_id,
+                                 const BlurCacheKey *key,
+                                 GdkPixbuf *blurred_pixbuf,
+                                 gboolean speculative) {
+    BlurCacheShard *shard = shard_for_hash(cache, key->image_hash);
+    
     gsize memory_size = blur_cache_calculate_pixbuf_size(blurred_pixbuf);
+    if (memory_size > cache_max_memory(cache)) {
+        return INSERT_FAILED; // Entry too large for the cache
+    }
     
-    g_mutex_lock(&cache->cache_mutex);
+    g_mutex_lock(&shard->mutex);
     
     // Check if entry already exists
-    if (g_hash_table_contains(cache->cache_table, key)) {
-        g_mutex_unlock(&cache->cache_mutex);
-        g_free(key);
-        return TRUE; // Already cached
-    }
-    
-    // Perform eviction if necessary
-    while (should_evict_for_count(cache) || should_evict_for_memory(cache, memory_size)) {
-        if (!cache->lru_list) {
-            // Cache is empty but limits exceeded - entry too large
-            g_mutex_unlock(&cache->cache_mutex);
-            g_free(key);
-            return FALSE;
-        }
-        evict_lru_entry(cache);
+    if (g_hash_table_contains(shard->cache_table, key)) {
+        g_mutex_unlock(&shard->mutex);
+        return INSERT_EXISTS; // Already cached
     }
     
     // Create and insert new entry
     BlurCacheEntry *entry = cache_entry_create(key, blurred_pixbuf, memory_size);
     if (!entry) {
-        g_mutex_unlock(&cache->cache_mutex);
-        g_free(key);
-        return FALSE;
+        g_mutex_unlock(&shard->mutex);
+        return INSERT_FAILED;
     }
+    entry->owner_id = owner_id;
+    entry->speculative = speculative;
     
-    g_hash_table_insert(cache->cache_table, entry->key, entry);
-    update_lru_order(cache, entry);
+    g_hash_table_insert(shard->cache_table, &entry->key, entry);
+    update_lru_order(cache, shard, entry);
+    image_link(shard, entry);
     
-    cache->current_entries++;
-    cache->current_memory += memory_size;
+    shard->current_entries++;
+    shard->current_memory += memory_size;
+    shard->speculative_entries += speculative;
+    account_entry(cache, owner_id, 1, (gssize)memory_size);
     
-    g_mutex_unlock(&cache->cache_mutex);
-    g_free(key);
+    g_mutex_unlock(&shard->mutex);
     
-    return TRUE;
+    // Perform eviction if necessary. The new entry heads its shard's LRU,
+    // so it is only ever the oldest when it is alone and fits.
+    while (is_over_limit(cache) && evict_for_budget(cache)) {
+    }
+    
+    return INSERT_ADDED;
 }
 
 void blur_cache_remove(BlurCache *cache, const gchar *pixbuf_hash) {
@@ -249,37 +598,21 @@ void blur_cache_remove(BlurCache *cache, const gchar *pixbuf_hash) {
         return;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
+    BlurCacheKey key;
+    blur_cache_key_init(&key, pixbuf_hash, 0.0);
+    BlurCacheShard *shard = shard_for_hash(cache, key.image_hash);
     
-    // Find and remove all entries matching the pixbuf hash
-    GHashTableIter iter;
-    gpointer key, value;
-    GList *keys_to_remove = NULL;
+    g_mutex_lock(&shard->mutex);
     
-    g_hash_table_iter_init(&iter, cache->cache_table);
-    while (g_hash_table_iter_next(&iter, &key, &value)) {
-        const gchar *entry_key = (const gchar*)key;
-        if (g_str_has_prefix(entry_key, pixbuf_hash)) {
-            keys_to_remove = g_list_prepend(keys_to_remove, g_strdup(entry_key));
-        }
+    // Only this image's variants are visited, not the whole table
+    BlurCacheEntry *entry = g_hash_table_lookup(shard->image_index, &key.image_hash);
+    while (entry) {
+        BlurCacheEntry *next = entry->image_next;
+        remove_entry(cache, shard, entry);
+        entry = next;
     }
     
-    // Remove found entries
-    for (GList *node = keys_to_remove; node; node = node->next) {
-        BlurCacheEntry *entry = g_hash_table_lookup(cache->cache_table, node->data);
-        if (entry) {
-            if (entry->lru_node) {
-                cache->lru_list = g_list_remove_link(cache->lru_list, entry->lru_node);
-                g_list_free(entry->lru_node);
-            }
-            cache->current_entries--;
-            cache->current_memory -= entry->memory_size;
-            g_hash_table_remove(cache->cache_table, node->data);
-        }
-    }
-    
-    g_list_free_full(keys_to_remove, g_free);
-    g_mutex_unlock(&cache->cache_mutex);
+    g_mutex_unlock(&shard->mutex);
 }
 
 void blur_cache_clear(BlurCache *cache) {
@@ -287,16 +620,26 @@ void blur_cache_clear(BlurCache *cache) {
         return;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
-    
-    g_hash_table_remove_all(cache->cache_table);
-    g_list_free(cache->lru_list);
-    cache->lru_list = NULL;
-    
-    cache->current_entries = 0;
-    cache->current_memory = 0;
-    
-    g_mutex_unlock(&cache->cache_mutex);
+    for (guint i = 0; i < cache->shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        
+        g_mutex_lock(&shard->mutex);
+        
+        for (BlurCacheEntry *entry = shard->lru_head; entry; entry = entry->lru_next) {
+            charge_owner(cache, entry->owner_id, -1, -(gssize)entry->memory_size);
+        }
+        account_entry(cache, 0, -(gint)shard->current_entries, -(gssize)shard->current_memory);
+        g_hash_table_remove_all(shard->image_index);
+        g_hash_table_remove_all(shard->cache_table);
+        shard->lru_head = NULL;
+        shard->lru_tail = NULL;
+        
+        shard->current_entries = 0;
+        shard->current_memory = 0;
+        shard->speculative_entries = 0;
+        
+        g_mutex_unlock(&shard->mutex);
+    }
 }
 
 void blur_cache_destroy(BlurCache *cache) {
@@ -305,8 +648,15 @@ void blur_cache_destroy(BlurCache *cache) {
     }
     
     blur_cache_clear(cache);
-    g_hash_table_unref(cache->cache_table);
-    g_mutex_clear(&cache->cache_mutex);
+    blur_disk_cache_destroy(cache->disk_tier);
+    for (guint i = 0; i < cache->shard_count; i++) {
+        g_hash_table_unref(cache->shards[i].image_index);
+        g_hash_table_unref(cache->shards[i].cache_table);
+        g_mutex_clear(&cache->shards[i].mutex);
+    }
+    g_free(cache->shards);
+    g_hash_table_unref(cache->owners);
+    g_mutex_clear(&cache->owners_mutex);
     g_free(cache);
 }
 
@@ -315,17 +665,23 @@ void blur_cache_get_stats(BlurCache *cache, BlurCacheStats *stats) {
         return;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
-    
-    stats->current_entries = cache->current_entries;
-    stats->max_entries = cache->max_entries;
-    stats->current_memory = cache->current_memory;
-    stats->max_memory = cache->max_memory;
-    stats->hit_count = cache->hit_count;
-    stats->miss_count = cache->miss_count;
-    stats->eviction_count = cache->eviction_count;
-    
-    g_mutex_unlock(&cache->cache_mutex);
+    memset(stats, 0, sizeof(BlurCacheStats));
+    stats->max_entries = cache_max_entries(cache);
+    stats->max_memory = cache_max_memory(cache);
+    
+    for (guint i = 0; i < cache->shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        
+        g_mutex_lock(&shard->mutex);
+        stats->current_entries += shard->current_entries;
+        stats->current_memory += shard->current_memory;
+        stats->hit_count += shard->hit_count;
+        stats->miss_count += shard->miss_count;
+        stats->disk_hit_count += shard->disk_hit_count;
+        stats->eviction_count += shard->eviction_count;
+        stats->speculative_entries += shard->speculative_entries;
+        g_mutex_unlock(&shard->mutex);
+    }
 }
 
 gsize blur_cache_get_memory_usage(BlurCache *cache) {
@@ -333,11 +689,7 @@ gsize blur_cache_get_memory_usage(BlurCache *cache) {
         return 0;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
-    gsize usage = cache->current_memory;
-    g_mutex_unlock(&cache->cache_mutex);
-    
-    return usage;
+    return g_atomic_pointer_get(&cache->current_memory);
 }
 
 gboolean blur_cache_is_memory_pressure(BlurCache *cache, gdouble threshold) {
@@ -345,11 +697,16 @@ gboolean blur_cache_is_memory_pressure(BlurCache *cache, gdouble threshold) {
         return FALSE;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
-    gboolean pressure = (cache->current_memory >= threshold * cache->max_memory);
-    g_mutex_unlock(&cache->cache_mutex);
+    return g_atomic_pointer_get(&cache->current_memory) >= threshold * cache_max_memory(cache);
+}
+
+gboolean blur_cache_has_room(BlurCache *cache, gsize entry_size) {
+    if (!cache) {
+        return FALSE;
+    }
     
-    return pressure;
+    return (guint)g_atomic_int_get(&cache->current_entries) < cache_max_entries(cache) &&
+           g_atomic_pointer_get(&cache->current_memory) + entry_size <= cache_max_memory(cache);
 }
 
 guint blur_cache_evict_lru(BlurCache *cache, guint min_entries_to_free) {
@@ -357,21 +714,162 @@ guint blur_cache_evict_lru(BlurCache *cache, guint min_entries_to_free) {
         return 0;
     }
     
-    g_mutex_lock(&cache->cache_mutex);
-    
     guint evicted = 0;
-    while (evicted < min_entries_to_free && cache->lru_list) {
-        evict_lru_entry(cache);
+    while (evicted < min_entries_to_free && evict_oldest_entry(cache, ANY_OWNER)) {
         evicted++;
     }
     
-    g_mutex_unlock(&cache->cache_mutex);
-    
     return evicted;
 }
 
+guint blur_cache_drop_speculative(BlurCache *cache) {
+    if (!cache) {
+        return 0;
+    }
+    
+    guint dropped = 0;
+    for (guint i = 0; i < cache->shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        
+        g_mutex_lock(&shard->mutex);
+        BlurCacheEntry *entry = shard->lru_head;
+        while (entry) {
+            BlurCacheEntry *next = entry->lru_next;
+            if (entry->speculative) {
+                remove_entry(cache, shard, entry);
+                shard->eviction_count++;
+                dropped++;
+            }
+            entry = next;
+        }
+        g_mutex_unlock(&shard->mutex);
+    }
+    
+    return dropped;
+}
+
+gboolean blur_cache_set_limits(BlurCache *cache, guint max_entries, gsize max_memory_bytes) {
+    if (!cache || max_entries == 0 || max_memory_bytes < 1024 * 1024) {
+        return FALSE;
+    }
+    
+    g_atomic_int_set(&cache->max_entries, max_entries);
+    g_atomic_pointer_set(&cache->max_memory, max_memory_bytes);
+    
+    while (is_over_limit(cache) && evict_for_budget(cache)) {
+    }
+    
+    return TRUE;
+}
+
+static guint64 detect_physical_memory(void) {
+#if defined(G_OS_UNIX) && defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    
+    if (pages > 0 && page_size > 0) {
+        return (guint64)pages * (guint64)page_size;
+    }
+#endif
+    return 0;
+}
+
+gsize blur_cache_scale_to_ram(gsize reference_bytes, guint64 physical_memory) {
+    if (physical_memory == 0) {
+        physical_memory = detect_physical_memory();
+    }
+    if (physical_memory == 0) {
+        return MAX(reference_bytes, 1024 * 1024);
+    }
+    
+    gdouble scale = CLAMP((gdouble)physical_memory / BLUR_CACHE_REFERENCE_RAM, 0.25, 4.0);
+    return MAX((gsize)(reference_bytes * scale), 1024 * 1024);
+}
+
+/* Disk Tier */
+
+void blur_cache_set_disk_tier(BlurCache *cache, BlurDiskCache *disk_cache) {
+    if (!cache) {
+        blur_disk_cache_destroy(disk_cache);
+        return;
+    }
+    
+    if (cache->disk_tier != disk_cache) {
+        blur_disk_cache_destroy(cache->disk_tier);
+        cache->disk_tier = disk_cache;
+    }
+}
+
+BlurDiskCache* blur_cache_get_disk_tier(BlurCache *cache) {
+    return cache ? cache->disk_tier : NULL;
+}
+
+/* Fair Share Between Owners */
+
+guint blur_cache_register_owner(BlurCache *cache) {
+    if (!cache) {
+        return 0;
+    }
+    
+    g_mutex_lock(&cache->owners_mutex);
+    guint owner_id = cache->next_owner_id++;
+    g_hash_table_insert(cache->owners, GUINT_TO_POINTER(owner_id), g_new0(BlurCacheOwner, 1));
+    g_mutex_unlock(&cache->owners_mutex);
+    
+    return owner_id;
+}
+
+void blur_cache_unregister_owner(BlurCache *cache, guint owner_id) {
+    if (!cache || owner_id == 0) {
+        return;
+    }
+    
+    for (guint i = 0; i < cache->shard_count; i++) {
+        BlurCacheShard *shard = &cache->shards[i];
+        
+        g_mutex_lock(&shard->mutex);
+        BlurCacheEntry *entry = shard->lru_head;
+        while (entry) {
+            BlurCacheEntry *next = entry->lru_next;
+            if (entry->owner_id == owner_id) {
+                remove_entry(cache, shard, entry);
+            }
+            entry = next;
+        }
+        g_mutex_unlock(&shard->mutex);
+    }
+    
+    g_mutex_lock(&cache->owners_mutex);
+    g_hash_table_remove(cache->owners, GUINT_TO_POINTER(owner_id));
+    g_mutex_unlock(&cache->owners_mutex);
+}
+
+gsize blur_cache_get_owner_memory(BlurCache *cache, guint owner_id) {
+    if (!cache) {
+        return 0;
+    }
+    
+    g_mutex_lock(&cache->owners_mutex);
+    BlurCacheOwner *owner = g_hash_table_lookup(cache->owners, GUINT_TO_POINTER(owner_id));
+    gsize memory = owner ? owner->memory : 0;
+    g_mutex_unlock(&cache->owners_mutex);
+    
+    return memory;
+}
+
 /* Utility Functions */
 
+void blur_cache_key_init(BlurCacheKey *key, const gchar *pixbuf_hash, gdouble intensity) {
+    // FNV-1a, 64-bit
+    guint64 hash = G_GUINT64_CONSTANT(0xcbf29ce484222325);
+    for (const guchar *c = (const guchar*)pixbuf_hash; c && *c; c++) {
+        hash = (hash ^ *c) * G_GUINT64_CONSTANT(0x100000001b3);
+    }
+    
+    key->image_hash = hash;
+    key->intensity_step = (gint32)lround(intensity * 10.0);
+}
+
 gchar* blur_cache_make_key(const gchar *pixbuf_hash, gdouble intensity) {
     if (!pixbuf_hash) {
         return NULL;
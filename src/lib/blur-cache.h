@@ -12,11 +12,24 @@
 
 #include <glib.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
+#include "blur-disk-cache.h"
 
 G_BEGIN_DECLS
 
 typedef struct _BlurCache BlurCache;
 
+/**
+ * BlurCacheKey:
+ * @image_hash: 64-bit hash of the pixbuf hash string
+ * @intensity_step: Intensity in 0.1 steps (2.5 is 25)
+ *
+ * Fixed size lookup key, built on the stack so lookups never allocate.
+ */
+typedef struct {
+    guint64 image_hash;
+    gint32 intensity_step;
+} BlurCacheKey;
+
 /**
  * BlurCacheStats:
  * @current_entries: Number of cached blur results
@@ -25,7 +38,9 @@ typedef struct _BlurCache BlurCache;
  * @max_memory: Maximum memory limit in bytes
  * @hit_count: Number of cache hits
  * @miss_count: Number of cache misses
+ * @disk_hit_count: Misses served from the disk tier instead of recomputed
  * @eviction_count: Number of LRU evictions performed
+ * @speculative_entries: Cached results put speculatively and never read
  *
  * Cache performance and usage statistics
  */
@@ -36,7 +51,9 @@ typedef struct {
     gsize max_memory;
     guint64 hit_count;
     guint64 miss_count;
+    guint64 disk_hit_count;
     guint64 eviction_count;
+    guint speculative_entries;
 } BlurCacheStats;
 
 /* Core Cache Functions */
@@ -55,6 +72,33 @@ typedef struct {
  */
 BlurCache* blur_cache_create(guint max_entries, gsize max_memory_bytes);
 
+/**
+ * BLUR_CACHE_MAX_SHARDS:
+ *
+ * Upper bound for the shard count of blur_cache_create_sharded().
+ */
+#define BLUR_CACHE_MAX_SHARDS 64
+
+/**
+ * blur_cache_create_sharded:
+ * @max_entries: Maximum number of cached blur variants, across all shards
+ * @max_memory_bytes: Maximum total memory usage in bytes, across all shards
+ * @shard_count: Number of lock stripes, 1 to %BLUR_CACHE_MAX_SHARDS
+ *
+ * Creates a cache split into @shard_count shards, each with its own lock,
+ * LRU list and statistics, for many threads putting and getting at once.
+ * Images are assigned to shards by hash, so all variants of one image
+ * share a shard. The limits are global: totals are tracked atomically
+ * and a put that goes over them evicts the oldest entries of any shard.
+ * While puts race, the totals can briefly exceed the limits by the size
+ * of the entries being inserted.
+ *
+ * blur_cache_create() is the single shard case, with exact LRU order.
+ *
+ * Returns: New BlurCache instance, or NULL on failure
+ */
+BlurCache* blur_cache_create_sharded(guint max_entries, gsize max_memory_bytes, guint shard_count);
+
 /**
  * blur_cache_get:
  * @cache: BlurCache instance
@@ -62,9 +106,11 @@ BlurCache* blur_cache_create(guint max_entries, gsize max_memory_bytes);
  * @intensity: Blur intensity to look up (rounded to 0.1 precision)
  *
  * Retrieves cached blur result if available. Cache hit updates LRU order.
- * Returned pixbuf has incremented reference count.
+ * Returned pixbuf has incremented reference count. On a memory miss the
+ * disk tier, if set, is consulted and a stored result is promoted.
  *
- * Performance: O(1) average case lookup, O(1) amortized LRU update
+ * Performance: O(1) average case lookup and O(1) LRU update, no
+ * allocations
  *
  * Returns: Cached pixbuf with added reference, or NULL if not found
  */
@@ -72,6 +118,39 @@ GdkPixbuf* blur_cache_get(BlurCache *cache,
                          const gchar *pixbuf_hash, 
                          gdouble intensity);
 
+/**
+ * blur_cache_get_nearest_lower:
+ * @cache: BlurCache instance
+ * @pixbuf_hash: Hash of original pixbuf
+ * @intensity: Target blur intensity
+ * @found_intensity: (out): Intensity of the returned result
+ *
+ * Finds the highest cached intensity below @intensity for the image, as
+ * a starting point for blur_processor_apply_async_from_base(). A result
+ * updates LRU order but not hit/miss statistics.
+ *
+ * Returns: Cached pixbuf with added reference, or NULL if none is lower
+ */
+GdkPixbuf* blur_cache_get_nearest_lower(BlurCache *cache,
+                                       const gchar *pixbuf_hash,
+                                       gdouble intensity,
+                                       gdouble *found_intensity);
+
+/**
+ * blur_cache_contains:
+ * @cache: BlurCache instance
+ * @pixbuf_hash: Hash of original pixbuf
+ * @intensity: Blur intensity to look up (rounded to 0.1 precision)
+ *
+ * Checks for a cached result without touching LRU order or hit/miss
+ * statistics. Meant for speculative work that must not skew either.
+ *
+ * Returns: TRUE if a result for @intensity is cached in memory or on disk
+ */
+gboolean blur_cache_contains(BlurCache *cache,
+                            const gchar *pixbuf_hash,
+                            gdouble intensity);
+
 /**
  * blur_cache_put:
  * @cache: BlurCache instance
@@ -90,6 +169,98 @@ gboolean blur_cache_put(BlurCache *cache,
                        gdouble intensity,
                        GdkPixbuf *blurred_pixbuf);
 
+/**
+ * blur_cache_put_owned:
+ * @cache: BlurCache instance
+ * @owner_id: Id from blur_cache_register_owner(), or 0 for a shared entry
+ * @pixbuf_hash: Hash of original pixbuf (must be unique)
+ * @intensity: Blur intensity (rounded to 0.1 precision)
+ * @blurred_pixbuf: Blur result to cache
+ *
+ * Like blur_cache_put() but charges the entry to @owner_id. When the cache
+ * is full, owners holding more than an equal share of the memory budget
+ * lose their own least recently used entries first.
+ *
+ * Returns: TRUE if successfully cached, FALSE if rejected
+ */
+gboolean blur_cache_put_owned(BlurCache *cache,
+                             guint owner_id,
+                             const gchar *pixbuf_hash,
+                             gdouble intensity,
+                             GdkPixbuf *blurred_pixbuf);
+
+/**
+ * blur_cache_put_speculative:
+ * @cache: BlurCache instance
+ * @owner_id: Id from blur_cache_register_owner(), or 0 for a shared entry
+ * @pixbuf_hash: Hash of original pixbuf (must be unique)
+ * @intensity: Blur intensity (rounded to 0.1 precision)
+ * @blurred_pixbuf: Blur result to cache
+ *
+ * Like blur_cache_put_owned() for results nobody asked for yet, such as
+ * prefetched intensities. The entry stays speculative until a
+ * blur_cache_get() returns it, and speculative entries are the first to
+ * go under memory pressure (see blur_cache_drop_speculative()).
+ *
+ * Returns: TRUE if successfully cached, FALSE if rejected
+ */
+gboolean blur_cache_put_speculative(BlurCache *cache,
+                                   guint owner_id,
+                                   const gchar *pixbuf_hash,
+                                   gdouble intensity,
+                                   GdkPixbuf *blurred_pixbuf);
+
+/**
+ * blur_cache_register_owner:
+ * @cache: BlurCache instance
+ *
+ * Registers a consumer (typically one window) sharing @cache. The memory
+ * budget is split evenly between registered owners for eviction.
+ *
+ * Returns: Owner id, never 0
+ */
+guint blur_cache_register_owner(BlurCache *cache);
+
+/**
+ * blur_cache_unregister_owner:
+ * @cache: BlurCache instance
+ * @owner_id: Id from blur_cache_register_owner()
+ *
+ * Drops every entry charged to @owner_id and forgets the owner, so the
+ * remaining owners get a larger share.
+ */
+void blur_cache_unregister_owner(BlurCache *cache, guint owner_id);
+
+/**
+ * blur_cache_get_owner_memory:
+ * @cache: BlurCache instance
+ * @owner_id: Id from blur_cache_register_owner()
+ *
+ * Returns: Bytes currently charged to @owner_id
+ */
+gsize blur_cache_get_owner_memory(BlurCache *cache, guint owner_id);
+
+/**
+ * blur_cache_set_disk_tier:
+ * @cache: BlurCache instance
+ * @disk_cache: (transfer full) (nullable): Persistent tier, or NULL to detach
+ *
+ * Puts @disk_cache behind the memory shards. New results are also queued
+ * for writing to disk, and memory misses are served by mapping a stored
+ * result, so previously seen blurs survive a restart. Set it before the
+ * cache is shared with other threads; @cache destroys it.
+ */
+void blur_cache_set_disk_tier(BlurCache *cache, BlurDiskCache *disk_cache);
+
+/**
+ * blur_cache_get_disk_tier:
+ * @cache: BlurCache instance
+ *
+ * Returns: (transfer none) (nullable): The disk tier, for other operations
+ *   on the same images such as grayscale conversions
+ */
+BlurDiskCache* blur_cache_get_disk_tier(BlurCache *cache);
+
 /**
  * blur_cache_remove:
  * @cache: BlurCache instance
@@ -97,6 +268,8 @@ gboolean blur_cache_put(BlurCache *cache,
  *
  * Removes all cached blur variants for the given image.
  * Used when image is unloaded or changed.
+ *
+ * Performance: O(variants of the image), through a per-image index
  */
 void blur_cache_remove(BlurCache *cache, const gchar *pixbuf_hash);
 
@@ -105,7 +278,8 @@ void blur_cache_remove(BlurCache *cache, const gchar *pixbuf_hash);
  * @cache: BlurCache instance
  *
  * Removes all entries from cache and frees associated memory.
- * Used for memory pressure relief or cache reset.
+ * Used for memory pressure relief or cache reset. The disk tier is kept;
+ * use blur_disk_cache_clear() on it to drop persisted results.
  */
 void blur_cache_clear(BlurCache *cache);
 
@@ -126,6 +300,7 @@ void blur_cache_destroy(BlurCache *cache);
  *
  * Retrieves current cache performance and usage statistics.
  * Useful for monitoring cache effectiveness and memory usage.
+ * Sharded caches report the sum over their shards.
  */
 void blur_cache_get_stats(BlurCache *cache, BlurCacheStats *stats);
 
@@ -151,6 +326,18 @@ gsize blur_cache_get_memory_usage(BlurCache *cache);
  */
 gboolean blur_cache_is_memory_pressure(BlurCache *cache, gdouble threshold);
 
+/**
+ * blur_cache_has_room:
+ * @cache: BlurCache instance
+ * @entry_size: Size of the prospective entry in bytes
+ *
+ * Checks whether an entry of @entry_size would fit within both the entry
+ * and memory limits without evicting anything.
+ *
+ * Returns: TRUE if blur_cache_put() would not need to evict
+ */
+gboolean blur_cache_has_room(BlurCache *cache, gsize entry_size);
+
 /**
  * blur_cache_evict_lru:
  * @cache: BlurCache instance
@@ -163,14 +350,73 @@ gboolean blur_cache_is_memory_pressure(BlurCache *cache, gdouble threshold);
  */
 guint blur_cache_evict_lru(BlurCache *cache, guint min_entries_to_free);
 
+/**
+ * blur_cache_drop_speculative:
+ * @cache: BlurCache instance
+ *
+ * Evicts every speculative entry, whatever its LRU position; results that
+ * were actually displayed stay. The first response to memory pressure.
+ *
+ * Returns: Number of entries evicted
+ */
+guint blur_cache_drop_speculative(BlurCache *cache);
+
+/**
+ * blur_cache_set_limits:
+ * @cache: BlurCache instance
+ * @max_entries: New maximum number of entries, at least 1
+ * @max_memory_bytes: New memory limit in bytes, at least 1MB
+ *
+ * Changes the budget of a live cache, for instance to shrink it under
+ * memory pressure and restore it later. Entries beyond a smaller budget
+ * are evicted before this returns, owners above their fair share first.
+ *
+ * Returns: TRUE if the limits were applied, FALSE if they are invalid
+ */
+gboolean blur_cache_set_limits(BlurCache *cache, guint max_entries, gsize max_memory_bytes);
+
+/**
+ * BLUR_CACHE_REFERENCE_RAM:
+ *
+ * Installed memory the fixed cache budgets of the app were chosen for.
+ */
+#define BLUR_CACHE_REFERENCE_RAM (G_GUINT64_CONSTANT(8) * 1024 * 1024 * 1024)
+
+/**
+ * blur_cache_scale_to_ram:
+ * @reference_bytes: Budget suitable for %BLUR_CACHE_REFERENCE_RAM
+ * @physical_memory: Installed memory in bytes, or 0 to detect it
+ *
+ * Scales a budget in proportion to installed memory, between a quarter
+ * and four times @reference_bytes, so large machines cache more while
+ * small ones stay lean. Without a way to detect memory, @reference_bytes
+ * is returned unchanged.
+ *
+ * Returns: Budget in bytes, never below 1MB
+ */
+gsize blur_cache_scale_to_ram(gsize reference_bytes, guint64 physical_memory);
+
 /* Utility Functions */
 
+/**
+ * blur_cache_key_init:
+ * @key: Key to fill in
+ * @pixbuf_hash: Hash string of original pixbuf
+ * @intensity: Blur intensity (will be rounded to 0.1 precision)
+ *
+ * Builds the lookup key the cache uses internally. @pixbuf_hash is folded
+ * into 64 bits with FNV-1a, so two images only share entries if their
+ * hash strings collide in 64 bits.
+ */
+void blur_cache_key_init(BlurCacheKey *key, const gchar *pixbuf_hash, gdouble intensity);
+
 /**
  * blur_cache_make_key:
  * @pixbuf_hash: Hash string of original pixbuf
  * @intensity: Blur intensity (will be rounded to 0.1 precision)
  *
- * Creates cache key string for given image hash and blur intensity.
+ * Creates a printable key for given image hash and blur intensity, for
+ * logging. Lookups use #BlurCacheKey instead.
  * Key format: "pixbuf_hash:intensity" (e.g., "abc123:2.5")
  *
  * Returns: Newly allocated key string, caller must free with g_free()
@@ -0,0 +1,505 @@
+/* blur-disk-cache.c - Persistent tier for processed image results
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "blur-disk-cache.h"
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define DISK_FILE_MAGIC 0x31434442u     // "BDC1" in little endian
+#define DISK_FILE_VERSION 1
+#define DISK_FILE_SUFFIX ".px"
+#define DISK_HEADER_SIZE 64
+
+/* Evict a little below the limit so a full cache does not rescan the
+ * directory after every write */
+#define EVICT_TARGET_PERCENT 90
+
+/* Temporary files this old were left behind by a crashed writer */
+#define STALE_TEMP_SECONDS 3600
+
+/* On-disk layout: this header, then the pixel rows exactly as GdkPixbuf
+ * stores them. The header is padded so pixel data starts 64-byte aligned
+ * in the mapping. Files are only read back on the machine that wrote them. */
+typedef struct {
+    guint32 magic;
+    guint32 version;
+    gint32 width;
+    gint32 height;
+    gint32 rowstride;
+    gint32 n_channels;
+    guint32 has_alpha;
+    guint32 reserved;
+    guint64 data_size;
+    guint8 padding[DISK_HEADER_SIZE - 40];
+} BlurDiskHeader;
+
+G_STATIC_ASSERT(sizeof(BlurDiskHeader) == DISK_HEADER_SIZE);
+
+struct _BlurDiskCache {
+    gchar *directory;
+    gsize max_bytes;
+    gint64 max_age_seconds;
+    
+    /* One writer thread, so eviction scans never run concurrently */
+    GThreadPool *writer;
+    
+    /* Guards the fields below */
+    GMutex mutex;
+    GCond idle_cond;
+    guint pending_writes;
+    BlurDiskCacheStats stats;
+};
+
+/* A job without a pixbuf is the startup scan of the directory */
+typedef struct {
+    BlurDiskCache *cache;
+    gchar *path;
+    GdkPixbuf *pixbuf;
+} DiskWriteJob;
+
+typedef struct {
+    gchar *path;
+    gint64 mtime;
+    gsize size;
+} DiskFileInfo;
+
+static void disk_file_info_free(gpointer data) {
+    DiskFileInfo *info = data;
+    g_free(info->path);
+    g_free(info);
+}
+
+static gint compare_file_age(gconstpointer a, gconstpointer b) {
+    const DiskFileInfo *file_a = *(const DiskFileInfo * const *)a;
+    const DiskFileInfo *file_b = *(const DiskFileInfo * const *)b;
+    
+    return (file_a->mtime > file_b->mtime) - (file_a->mtime < file_b->mtime);
+}
+
+static gchar* result_path(BlurDiskCache *cache,
+                          const gchar *image_hash,
+                          const gchar *operation,
+                          gint32 parameter) {
+    // Hashing the key keeps file names short and free of odd characters
+    gchar *key = g_strdup_printf("%s\n%s\n%d", image_hash, operation, parameter);
+    gchar *digest = g_compute_checksum_for_string(G_CHECKSUM_SHA1, key, -1);
+    gchar *name = g_strconcat(digest, DISK_FILE_SUFFIX, NULL);
+    gchar *path = g_build_filename(cache->directory, name, NULL);
+    
+    g_free(name);
+    g_free(digest);
+    g_free(key);
+    
+    return path;
+}
+
+// Stored results, oldest first. Leftover temporary files are removed.
+static GPtrArray* list_result_files(BlurDiskCache *cache, gsize *total_bytes) {
+    GPtrArray *files = g_ptr_array_new_with_free_func(disk_file_info_free);
+    gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+    const gchar *name;
+    
+    *total_bytes = 0;
+    
+    GDir *dir = g_dir_open(cache->directory, 0, NULL);
+    if (!dir) {
+        return files;
+    }
+    
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        gchar *path = g_build_filename(cache->directory, name, NULL);
+        GStatBuf st;
+        
+        if (g_stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            g_free(path);
+            continue;
+        }
+        
+        if (!g_str_has_suffix(name, DISK_FILE_SUFFIX)) {
+            if (strstr(name, DISK_FILE_SUFFIX ".") && now - st.st_mtime > STALE_TEMP_SECONDS) {
+                g_unlink(path);
+            }
+            g_free(path);
+            continue;
+        }
+        
+        DiskFileInfo *info = g_new(DiskFileInfo, 1);
+        info->path = path;
+        info->mtime = st.st_mtime;
+        info->size = st.st_size;
+        g_ptr_array_add(files, info);
+        *total_bytes += info->size;
+    }
+    
+    g_dir_close(dir);
+    g_ptr_array_sort(files, compare_file_age);
+    
+    return files;
+}
+
+/* Deletes expired files, then the least recently used ones until the
+ * total is back under the target. Runs on the writer thread. */
+static void enforce_limits(BlurDiskCache *cache) {
+    gsize total_bytes;
+    GPtrArray *files = list_result_files(cache, &total_bytes);
+    gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+    gsize target = cache->max_bytes / 100 * EVICT_TARGET_PERCENT;
+    guint64 evicted = 0;
+    
+    for (guint i = 0; i < files->len; i++) {
+        DiskFileInfo *info = g_ptr_array_index(files, i);
+        gboolean expired = cache->max_age_seconds > 0 && now - info->mtime > cache->max_age_seconds;
+        
+        // Oldest first: once one file survives, all newer ones do too
+        if (!expired && total_bytes <= target) {
+            break;
+        }
+        
+        if (g_unlink(info->path) == 0) {
+            total_bytes -= info->size;
+            evicted++;
+        }
+    }
+    
+    g_ptr_array_unref(files);
+    
+    g_mutex_lock(&cache->mutex);
+    cache->stats.current_bytes = total_bytes;
+    cache->stats.evictions += evicted;
+    g_mutex_unlock(&cache->mutex);
+}
+
+static gboolean header_is_valid(const BlurDiskHeader *header, gsize length) {
+    if (length < DISK_HEADER_SIZE ||
+        header->magic != DISK_FILE_MAGIC || header->version != DISK_FILE_VERSION) {
+        return FALSE;
+    }
+    
+    if (header->width <= 0 || header->height <= 0 ||
+        (header->n_channels != 3 && header->n_channels != 4) ||
+        header->has_alpha != (header->n_channels == 4)) {
+        return FALSE;
+    }
+    
+    guint64 row_bytes = (guint64)header->width * header->n_channels;
+    if ((guint64)header->rowstride < row_bytes) {
+        return FALSE;
+    }
+    
+    guint64 expected = (guint64)(header->height - 1) * header->rowstride + row_bytes;
+    return header->data_size == expected && length - DISK_HEADER_SIZE >= expected;
+}
+
+static GdkPixbuf* map_result_file(const gchar *path) {
+    GMappedFile *mapped = g_mapped_file_new(path, FALSE, NULL);
+    if (!mapped) {
+        return NULL;
+    }
+    
+    // The bytes keep the mapping alive for as long as the pixbuf needs it
+    GBytes *contents = g_mapped_file_get_bytes(mapped);
+    g_mapped_file_unref(mapped);
+    
+    gsize length;
+    const BlurDiskHeader *header = g_bytes_get_data(contents, &length);
+    GdkPixbuf *pixbuf = NULL;
+    
+    if (header && header_is_valid(header, length)) {
+        GBytes *pixels = g_bytes_new_from_bytes(contents, DISK_HEADER_SIZE, header->data_size);
+        pixbuf = gdk_pixbuf_new_from_bytes(pixels, GDK_COLORSPACE_RGB, header->has_alpha, 8,
+                                           header->width, header->height, header->rowstride);
+        g_bytes_unref(pixels);
+    } else {
+        // Truncated or written by another format version: never usable
+        g_unlink(path);
+    }
+    
+    g_bytes_unref(contents);
+    
+    return pixbuf;
+}
+
+static gboolean write_all(gint fd, const void *data, gsize size) {
+    const guint8 *bytes = data;
+    
+    while (size > 0) {
+        gssize written = write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return FALSE;
+        }
+        bytes += written;
+        size -= written;
+    }
+    
+    return TRUE;
+}
+
+static gboolean write_result_file(const gchar *path, GdkPixbuf *pixbuf) {
+    BlurDiskHeader header = { 0 };
+    
+    if (gdk_pixbuf_get_colorspace(pixbuf) != GDK_COLORSPACE_RGB ||
+        gdk_pixbuf_get_bits_per_sample(pixbuf) != 8) {
+        return FALSE;
+    }
+    
+    header.magic = DISK_FILE_MAGIC;
+    header.version = DISK_FILE_VERSION;
+    header.width = gdk_pixbuf_get_width(pixbuf);
+    header.height = gdk_pixbuf_get_height(pixbuf);
+    header.rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    header.n_channels = gdk_pixbuf_get_n_channels(pixbuf);
+    header.has_alpha = gdk_pixbuf_get_has_alpha(pixbuf) ? 1 : 0;
+    header.data_size = gdk_pixbuf_get_byte_length(pixbuf);
+    
+    // Written aside and renamed, so a reader maps either nothing or all of it
+    gchar *temp_path = g_strconcat(path, ".XXXXXX", NULL);
+    gint fd = g_mkstemp(temp_path);
+    if (fd < 0) {
+        g_free(temp_path);
+        return FALSE;
+    }
+    
+    gboolean ok = write_all(fd, &header, sizeof(header)) &&
+                  write_all(fd, gdk_pixbuf_read_pixels(pixbuf), header.data_size);
+    ok = g_close(fd, NULL) && ok;
+    ok = ok && g_rename(temp_path, path) == 0;
+    
+    if (!ok) {
+        g_unlink(temp_path);
+    }
+    g_free(temp_path);
+    
+    return ok;
+}
+
+static void disk_write_job_free(DiskWriteJob *job) {
+    g_clear_object(&job->pixbuf);
+    g_free(job->path);
+    g_free(job);
+}
+
+static void finish_pending_write(BlurDiskCache *cache) {
+    g_mutex_lock(&cache->mutex);
+    if (--cache->pending_writes == 0) {
+        g_cond_broadcast(&cache->idle_cond);
+    }
+    g_mutex_unlock(&cache->mutex);
+}
+
+static void disk_write_func(gpointer data, gpointer user_data) {
+    DiskWriteJob *job = data;
+    BlurDiskCache *cache = job->cache;
+    
+    if (!job->pixbuf) {
+        enforce_limits(cache);
+        disk_write_job_free(job);
+        finish_pending_write(cache);
+        return;
+    }
+    
+    // The same result may have been queued twice or stored by another instance
+    gboolean exists = g_file_test(job->path, G_FILE_TEST_EXISTS);
+    gboolean written = !exists && write_result_file(job->path, job->pixbuf);
+    
+    g_mutex_lock(&cache->mutex);
+    if (written) {
+        cache->stats.writes++;
+        cache->stats.current_bytes += DISK_HEADER_SIZE + gdk_pixbuf_get_byte_length(job->pixbuf);
+    } else if (!exists) {
+        cache->stats.write_failures++;
+    }
+    gboolean over_limit = cache->stats.current_bytes > cache->max_bytes;
+    g_mutex_unlock(&cache->mutex);
+    
+    if (over_limit) {
+        enforce_limits(cache);
+    }
+    
+    disk_write_job_free(job);
+    finish_pending_write(cache);
+}
+
+static void queue_job(BlurDiskCache *cache, DiskWriteJob *job) {
+    g_mutex_lock(&cache->mutex);
+    cache->pending_writes++;
+    g_mutex_unlock(&cache->mutex);
+    
+    if (!g_thread_pool_push(cache->writer, job, NULL)) {
+        // No writer thread available: write here rather than drop it
+        disk_write_func(job, NULL);
+    }
+}
+
+/* Public API Implementation */
+
+BlurDiskCache* blur_disk_cache_create(const gchar *directory,
+                                      gsize max_bytes,
+                                      gint64 max_age_seconds,
+                                      GError **error) {
+    g_return_val_if_fail(directory != NULL, NULL);
+    g_return_val_if_fail(max_bytes > 0, NULL);
+    
+    if (g_mkdir_with_parents(directory, 0700) != 0) {
+        gint saved_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(saved_errno),
+                    "Cannot create disk cache directory %s: %s",
+                    directory, g_strerror(saved_errno));
+        return NULL;
+    }
+    
+    BlurDiskCache *cache = g_new0(BlurDiskCache, 1);
+    cache->directory = g_strdup(directory);
+    cache->max_bytes = max_bytes;
+    cache->max_age_seconds = MAX(max_age_seconds, 0);
+    g_mutex_init(&cache->mutex);
+    g_cond_init(&cache->idle_cond);
+    
+    cache->writer = g_thread_pool_new(disk_write_func, NULL, 1, FALSE, error);
+    if (!cache->writer) {
+        blur_disk_cache_destroy(cache);
+        return NULL;
+    }
+    
+    // Picks up the size of earlier sessions and drops expired files. Runs
+    // ahead of any store, so the writes are counted on top of its total.
+    DiskWriteJob *scan = g_new0(DiskWriteJob, 1);
+    scan->cache = cache;
+    queue_job(cache, scan);
+    
+    return cache;
+}
+
+gchar* blur_disk_cache_get_default_directory(const gchar *application_id) {
+    g_return_val_if_fail(application_id != NULL, NULL);
+    
+    return g_build_filename(g_get_user_cache_dir(), application_id, "image-results", NULL);
+}
+
+GdkPixbuf* blur_disk_cache_lookup(BlurDiskCache *cache,
+                                  const gchar *image_hash,
+                                  const gchar *operation,
+                                  gint32 parameter) {
+    if (!cache || !image_hash || !operation) {
+        return NULL;
+    }
+    
+    gchar *path = result_path(cache, image_hash, operation, parameter);
+    GdkPixbuf *pixbuf = map_result_file(path);
+    
+    // The modification time doubles as the last use for eviction
+    if (pixbuf) {
+        g_utime(path, NULL);
+    }
+    g_free(path);
+    
+    g_mutex_lock(&cache->mutex);
+    if (pixbuf) {
+        cache->stats.hits++;
+    } else {
+        cache->stats.misses++;
+    }
+    g_mutex_unlock(&cache->mutex);
+    
+    return pixbuf;
+}
+
+gboolean blur_disk_cache_contains(BlurDiskCache *cache,
+                                  const gchar *image_hash,
+                                  const gchar *operation,
+                                  gint32 parameter) {
+    if (!cache || !image_hash || !operation) {
+        return FALSE;
+    }
+    
+    gchar *path = result_path(cache, image_hash, operation, parameter);
+    gboolean exists = g_file_test(path, G_FILE_TEST_IS_REGULAR);
+    g_free(path);
+    
+    return exists;
+}
+
+void blur_disk_cache_store(BlurDiskCache *cache,
+                           const gchar *image_hash,
+                           const gchar *operation,
+                           gint32 parameter,
+                           GdkPixbuf *pixbuf) {
+    if (!cache || !image_hash || !operation || !pixbuf) {
+        return;
+    }
+    
+    DiskWriteJob *job = g_new(DiskWriteJob, 1);
+    job->cache = cache;
+    job->path = result_path(cache, image_hash, operation, parameter);
+    job->pixbuf = g_object_ref(pixbuf);
+    
+    queue_job(cache, job);
+}
+
+void blur_disk_cache_flush(BlurDiskCache *cache) {
+    if (!cache) {
+        return;
+    }
+    
+    g_mutex_lock(&cache->mutex);
+    while (cache->pending_writes > 0) {
+        g_cond_wait(&cache->idle_cond, &cache->mutex);
+    }
+    g_mutex_unlock(&cache->mutex);
+}
+
+void blur_disk_cache_clear(BlurDiskCache *cache) {
+    if (!cache) {
+        return;
+    }
+    
+    blur_disk_cache_flush(cache);
+    
+    gsize total_bytes;
+    GPtrArray *files = list_result_files(cache, &total_bytes);
+    for (guint i = 0; i < files->len; i++) {
+        DiskFileInfo *info = g_ptr_array_index(files, i);
+        g_unlink(info->path);
+    }
+    g_ptr_array_unref(files);
+    
+    g_mutex_lock(&cache->mutex);
+    cache->stats.current_bytes = 0;
+    g_mutex_unlock(&cache->mutex);
+}
+
+void blur_disk_cache_get_stats(BlurDiskCache *cache, BlurDiskCacheStats *stats) {
+    if (!cache || !stats) {
+        return;
+    }
+    
+    g_mutex_lock(&cache->mutex);
+    *stats = cache->stats;
+    g_mutex_unlock(&cache->mutex);
+}
+
+void blur_disk_cache_destroy(BlurDiskCache *cache) {
+    if (!cache) {
+        return;
+    }
+    
+    if (cache->writer) {
+        blur_disk_cache_flush(cache);
+        g_thread_pool_free(cache->writer, FALSE, TRUE);
+    }
+    
+    g_cond_clear(&cache->idle_cond);
+    g_mutex_clear(&cache->mutex);
+    g_free(cache->directory);
+    g_free(cache);
+}
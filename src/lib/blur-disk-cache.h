@@ -0,0 +1,168 @@
+/* blur-disk-cache.h - Persistent tier for processed image results
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+G_BEGIN_DECLS
+
+typedef struct _BlurDiskCache BlurDiskCache;
+
+/**
+ * BLUR_DISK_CACHE_OP_BLUR:
+ *
+ * Operation name of blur results; the parameter is the intensity step.
+ */
+#define BLUR_DISK_CACHE_OP_BLUR "blur"
+
+/**
+ * BLUR_DISK_CACHE_OP_GRAYSCALE:
+ *
+ * Operation name of grayscale conversions; the parameter is unused (0).
+ */
+#define BLUR_DISK_CACHE_OP_GRAYSCALE "grayscale"
+
+/**
+ * BlurDiskCacheStats:
+ * @hits: Lookups served by mapping a stored file
+ * @misses: Lookups that found no usable file
+ * @writes: Results written to disk
+ * @write_failures: Writes that failed (disk full, permissions)
+ * @evictions: Files deleted to stay within the size and age limits
+ * @current_bytes: Bytes currently stored on disk
+ *
+ * Disk tier activity counters
+ */
+typedef struct {
+    guint64 hits;
+    guint64 misses;
+    guint64 writes;
+    guint64 write_failures;
+    guint64 evictions;
+    gsize current_bytes;
+} BlurDiskCacheStats;
+
+/**
+ * blur_disk_cache_create:
+ * @directory: Directory holding the result files, created if missing
+ * @max_bytes: Total size limit of the stored files
+ * @max_age_seconds: Files unused for longer are deleted, 0 for no limit
+ * @error: Return location for a #G_FILE_ERROR
+ *
+ * Opens a disk cache of processed pixels. Each result is one file of raw
+ * rows behind a small header, named after the content hash and operation
+ * parameters, so a hit maps the file instead of decoding anything.
+ *
+ * Writes run on a background thread; lookups may be called from any thread.
+ * The directory scan that applies the limits to files of earlier sessions
+ * runs there too, so the size in the stats is only complete after
+ * blur_disk_cache_flush().
+ *
+ * Returns: New BlurDiskCache instance, or NULL if @directory is unusable
+ */
+BlurDiskCache* blur_disk_cache_create(const gchar *directory,
+                                      gsize max_bytes,
+                                      gint64 max_age_seconds,
+                                      GError **error);
+
+/**
+ * blur_disk_cache_get_default_directory:
+ * @application_id: Subdirectory name, usually the application id
+ *
+ * Returns: (transfer full): `$XDG_CACHE_HOME/@application_id/image-results`
+ */
+gchar* blur_disk_cache_get_default_directory(const gchar *application_id);
+
+/**
+ * blur_disk_cache_lookup:
+ * @cache: BlurDiskCache instance
+ * @image_hash: Content hash of the source image
+ * @operation: Operation name such as %BLUR_DISK_CACHE_OP_BLUR
+ * @parameter: Operation parameter
+ *
+ * Maps a stored result. The returned pixbuf reads straight from the page
+ * cache; the mapping stays valid even if the file is evicted meanwhile.
+ * Writing to its pixels makes GdkPixbuf take a private copy first.
+ *
+ * Returns: (transfer full): Stored result, or NULL if none is usable
+ */
+GdkPixbuf* blur_disk_cache_lookup(BlurDiskCache *cache,
+                                  const gchar *image_hash,
+                                  const gchar *operation,
+                                  gint32 parameter);
+
+/**
+ * blur_disk_cache_contains:
+ * @cache: BlurDiskCache instance
+ * @image_hash: Content hash of the source image
+ * @operation: Operation name
+ * @parameter: Operation parameter
+ *
+ * Checks for a stored result without mapping it or touching statistics.
+ *
+ * Returns: TRUE if a file for the key exists
+ */
+gboolean blur_disk_cache_contains(BlurDiskCache *cache,
+                                  const gchar *image_hash,
+                                  const gchar *operation,
+                                  gint32 parameter);
+
+/**
+ * blur_disk_cache_store:
+ * @cache: BlurDiskCache instance
+ * @image_hash: Content hash of the source image
+ * @operation: Operation name
+ * @parameter: Operation parameter
+ * @pixbuf: Result to persist, 8-bit RGB or RGBA
+ *
+ * Queues @pixbuf for writing and returns at once. The background writer
+ * keeps a reference until the file is in place; files are written under a
+ * temporary name and renamed, so readers never see a partial result.
+ */
+void blur_disk_cache_store(BlurDiskCache *cache,
+                           const gchar *image_hash,
+                           const gchar *operation,
+                           gint32 parameter,
+                           GdkPixbuf *pixbuf);
+
+/**
+ * blur_disk_cache_flush:
+ * @cache: BlurDiskCache instance
+ *
+ * Blocks until every queued write, and the startup scan, has finished.
+ */
+void blur_disk_cache_flush(BlurDiskCache *cache);
+
+/**
+ * blur_disk_cache_clear:
+ * @cache: BlurDiskCache instance
+ *
+ * Deletes every stored result after finishing queued writes.
+ */
+void blur_disk_cache_clear(BlurDiskCache *cache);
+
+/**
+ * blur_disk_cache_get_stats:
+ * @cache: BlurDiskCache instance
+ * @stats: Output structure for statistics
+ */
+void blur_disk_cache_get_stats(BlurDiskCache *cache, BlurDiskCacheStats *stats);
+
+/**
+ * blur_disk_cache_destroy:
+ * @cache: BlurDiskCache instance to destroy
+ *
+ * Finishes queued writes and frees @cache. Stored files are kept.
+ */
+void blur_disk_cache_destroy(BlurDiskCache *cache);
+
+G_END_DECLS
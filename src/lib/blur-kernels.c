@@ -0,0 +1,1188 @@
+/* blur-kernels.c - Separable convolution kernels with CPU dispatch
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "blur-kernels.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BLUR_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#define BLUR_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define BLUR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(__ARM_NEON)
+#define BLUR_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define BLUR_MAX_KERNEL_SIZE 121
+
+/* Q14 weights: 255 * 16384 still fits comfortably in 32-bit sums */
+#define FIXED_SHIFT 14
+#define FIXED_ROUND (1 << (FIXED_SHIFT - 1))
+
+/* Q15 luminance weights for 0.299 R + 0.587 G + 0.114 B. They sum to
+ * exactly 1 << 15, so gray input maps to itself, and fit the signed
+ * 16-bit multiplies of the vector kernels. */
+#define GRAY_WEIGHT_R 9798
+#define GRAY_WEIGHT_G 19235
+#define GRAY_WEIGHT_B 3735
+#define GRAY_SHIFT 15
+
+#if defined(__GNUC__)
+#define BLUR_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define BLUR_ALWAYS_INLINE inline
+#endif
+
+/* Mirror edge handling shared by every implementation. The final clamp
+ * only matters for images smaller than the kernel radius. */
+static inline gint mirror_sample(gint sample, gint size) {
+    if (sample < 0) {
+        sample = -sample;
+    } else if (sample >= size) {
+        sample = 2 * size - sample - 1;
+    }
+    return CLAMP(sample, 0, size - 1);
+}
+
+/* Scalar reference implementation - T006 & T007 */
+
+static void apply_horizontal_pass(const guchar *src_pixels, guchar *dst_pixels,
+                                gint width, gint rowstride, gint channels,
+                                const gfloat *kernel, gint kernel_size,
+                                gint y_start, gint y_end) {
+    gint half_kernel = kernel_size / 2;
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        
+        for (gint x = 0; x < width; x++) {
+            gfloat sum_r = 0.0f, sum_g = 0.0f, sum_b = 0.0f, sum_a = 0.0f;
+            
+            for (gint k = 0; k < kernel_size; k++) {
+                // Mirror edge handling for boundary pixels
+                gint sample_x = mirror_sample(x + k - half_kernel, width);
+                
+                const guchar *sample_pixel = src_row + sample_x * channels;
+                gfloat weight = kernel[k];
+                
+                sum_r += sample_pixel[0] * weight;
+                sum_g += sample_pixel[1] * weight;
+                sum_b += sample_pixel[2] * weight;
+                if (channels == 4) {
+                    sum_a += sample_pixel[3] * weight;
+                }
+            }
+            
+            // Clamp values to [0, 255] and store
+            guchar *dst_pixel = dst_row + x * channels;
+            dst_pixel[0] = (guchar)CLAMP(sum_r + 0.5f, 0, 255);
+            dst_pixel[1] = (guchar)CLAMP(sum_g + 0.5f, 0, 255);
+            dst_pixel[2] = (guchar)CLAMP(sum_b + 0.5f, 0, 255);
+            if (channels == 4) {
+                dst_pixel[3] = (guchar)CLAMP(sum_a + 0.5f, 0, 255);
+            }
+        }
+    }
+}
+
+static void apply_vertical_pass(const guchar *src_pixels, guchar *dst_pixels,
+                              gint height, gint rowstride, gint channels,
+                              const gfloat *kernel, gint kernel_size,
+                              gint x_start, gint x_end) {
+    gint half_kernel = kernel_size / 2;
+    gint offset = x_start * channels;
+    gint span = (x_end - x_start) * channels;
+    gfloat *sums = g_malloc(sizeof(gfloat) * span);
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride + offset;
+        
+        // Accumulate whole source rows, tap by tap, instead of walking down
+        // a column per output pixel. Every read stays sequential and each
+        // channel still sums its taps in kernel order.
+        memset(sums, 0, sizeof(gfloat) * span);
+        for (gint k = 0; k < kernel_size; k++) {
+            // Mirror edge handling for boundary rows
+            gint sample_y = mirror_sample(y + k - half_kernel, height);
+            
+            const guchar *sample_row = src_pixels + sample_y * rowstride + offset;
+            gfloat weight = kernel[k];
+            
+            for (gint i = 0; i < span; i++) {
+                sums[i] += sample_row[i] * weight;
+            }
+        }
+        
+        // Clamp values to [0, 255] and store
+        for (gint i = 0; i < span; i++) {
+            dst_row[i] = (guchar)CLAMP(sums[i] + 0.5f, 0, 255);
+        }
+    }
+    
+    g_free(sums);
+}
+
+/* Fixed-point scalar reference
+ *
+ * Same structure as the float passes, but every tap is an integer
+ * multiply-add on Q14 weights, and the result is rounded with one shift.
+ */
+
+static void apply_horizontal_pass_fixed(const guchar *src_pixels, guchar *dst_pixels,
+                                      gint width, gint rowstride, gint channels,
+                                      const gint16 *kernel, gint kernel_size,
+                                      gint y_start, gint y_end) {
+    gint half_kernel = kernel_size / 2;
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        
+        for (gint x = 0; x < width; x++) {
+            gint32 sums[4] = { FIXED_ROUND, FIXED_ROUND, FIXED_ROUND, FIXED_ROUND };
+            
+            for (gint k = 0; k < kernel_size; k++) {
+                const guchar *sample_pixel = src_row + mirror_sample(x + k - half_kernel, width) * channels;
+                for (gint c = 0; c < channels; c++) {
+                    sums[c] += sample_pixel[c] * kernel[k];
+                }
+            }
+            
+            guchar *dst_pixel = dst_row + x * channels;
+            for (gint c = 0; c < channels; c++) {
+                dst_pixel[c] = (guchar)MIN(sums[c] >> FIXED_SHIFT, 255);
+            }
+        }
+    }
+}
+
+static void apply_vertical_pass_fixed(const guchar *src_pixels, guchar *dst_pixels,
+                                    gint height, gint rowstride, gint channels,
+                                    const gint16 *kernel, gint kernel_size,
+                                    gint x_start, gint x_end) {
+    gint half_kernel = kernel_size / 2;
+    gint offset = x_start * channels;
+    gint span = (x_end - x_start) * channels;
+    gint32 *sums = g_malloc(sizeof(gint32) * span);
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride + offset;
+        
+        for (gint i = 0; i < span; i++) {
+            sums[i] = FIXED_ROUND;
+        }
+        for (gint k = 0; k < kernel_size; k++) {
+            const guchar *sample_row = src_pixels + mirror_sample(y + k - half_kernel, height) * rowstride + offset;
+            gint32 weight = kernel[k];
+            
+            for (gint i = 0; i < span; i++) {
+                sums[i] += sample_row[i] * weight;
+            }
+        }
+        
+        for (gint i = 0; i < span; i++) {
+            dst_row[i] = (guchar)MIN(sums[i] >> FIXED_SHIFT, 255);
+        }
+    }
+    
+    g_free(sums);
+}
+
+static inline guchar luminance_fixed(const guchar *pixel) {
+    return (guchar)((pixel[0] * GRAY_WEIGHT_R + pixel[1] * GRAY_WEIGHT_G +
+                     pixel[2] * GRAY_WEIGHT_B) >> GRAY_SHIFT);
+}
+
+/* Converts pixels [x_start, width) of one row; vector kernels use it for
+ * the pixels left over after their last full vector */
+static inline void grayscale_span(const guchar *src_row, guchar *dst_row,
+                                  gint x_start, gint width, gint channels) {
+    for (gint x = x_start; x < width; x++) {
+        const guchar *src_pixel = src_row + x * channels;
+        guchar *dst_pixel = dst_row + x * channels;
+        guchar gray = luminance_fixed(src_pixel);
+        
+        dst_pixel[0] = gray;
+        dst_pixel[1] = gray;
+        dst_pixel[2] = gray;
+        if (channels == 4) {
+            dst_pixel[3] = src_pixel[3];
+        }
+    }
+}
+
+static void apply_grayscale_rows(const guchar *src_pixels, gint src_rowstride,
+                                 guchar *dst_pixels, gint dst_rowstride,
+                                 gint width, gint channels,
+                                 gint y_start, gint y_end) {
+    for (gint y = y_start; y < y_end; y++) {
+        grayscale_span(src_pixels + (gsize)y * src_rowstride,
+                       dst_pixels + (gsize)y * dst_rowstride, 0, width, channels);
+    }
+}
+
+/* Vector implementations
+ *
+ * Each vector lane holds one channel of one pixel as a float, and the taps
+ * are accumulated in the same order as the scalar loop so results match it.
+ * Channel count is a compile-time constant in the inlined row helpers, so
+ * the hot loops carry no RGB/RGBA branch. RGB pixels are assembled from
+ * three bytes to avoid reading past the end of a row.
+ *
+ * Horizontal passes split each row into a mirrored prologue, a branch-free
+ * interior and a mirrored epilogue. Vertical passes resolve the mirrored
+ * row pointers once per output row, which leaves the inner loops free of
+ * boundary checks entirely.
+ */
+
+static inline guint32 load_pixel_bits(const guchar *pixel, gint channels) {
+    guint32 bits;
+    if (channels == 4) {
+        memcpy(&bits, pixel, 4);
+    } else {
+        bits = pixel[0] | (pixel[1] << 8) | ((guint32)pixel[2] << 16);
+    }
+    return bits;
+}
+
+static inline void store_pixel_bits(guchar *pixel, guint32 bits, gint channels) {
+    if (channels == 4) {
+        memcpy(pixel, &bits, 4);
+    } else {
+        pixel[0] = bits & 0xff;
+        pixel[1] = (bits >> 8) & 0xff;
+        pixel[2] = (bits >> 16) & 0xff;
+    }
+}
+
+static inline void resolve_rows(const guchar **rows, const guchar *src_pixels,
+                               gint y, gint height, gint rowstride, gint kernel_size) {
+    gint half_kernel = kernel_size / 2;
+    for (gint k = 0; k < kernel_size; k++) {
+        rows[k] = src_pixels + mirror_sample(y + k - half_kernel, height) * rowstride;
+    }
+}
+
+#ifdef BLUR_HAVE_X86_SIMD
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128 load_pixel_sse41(const guchar *pixel, gint channels) {
+    __m128i bytes = _mm_cvtsi32_si128((gint)load_pixel_bits(pixel, channels));
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes));
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 void store_pixel_sse41(guchar *pixel, __m128 sum, gint channels) {
+    // Truncating sum + 0.5 and saturating matches CLAMP(sum + 0.5f, 0, 255)
+    __m128i values = _mm_cvttps_epi32(_mm_add_ps(sum, _mm_set1_ps(0.5f)));
+    values = _mm_packus_epi32(values, values);
+    values = _mm_packus_epi16(values, values);
+    store_pixel_bits(pixel, (guint32)_mm_cvtsi128_si32(values), channels);
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128 mirrored_pixel_sse41(const guchar *src_row, gint x, gint width,
+                                                                        gint channels, const __m128 *weights,
+                                                                        gint kernel_size) {
+    gint half_kernel = kernel_size / 2;
+    __m128 sum = _mm_setzero_ps();
+    for (gint k = 0; k < kernel_size; k++) {
+        const guchar *sample = src_row + mirror_sample(x + k - half_kernel, width) * channels;
+        sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel_sse41(sample, channels), weights[k]));
+    }
+    return sum;
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 void horizontal_rows_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                                       gint width, gint rowstride, gint channels,
+                                                                       const gfloat *kernel, gint kernel_size,
+                                                                       gint y_start, gint y_end) {
+    __m128 weights[BLUR_MAX_KERNEL_SIZE];
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint interior_end = MAX(width - half_kernel, interior_start);
+    
+    for (gint k = 0; k < kernel_size; k++) {
+        weights[k] = _mm_set1_ps(kernel[k]);
+    }
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        gint x = 0;
+        
+        for (; x < interior_start; x++) {
+            store_pixel_sse41(dst_row + x * channels,
+                             mirrored_pixel_sse41(src_row, x, width, channels, weights, kernel_size),
+                             channels);
+        }
+        
+        for (; x < interior_end; x++) {
+            const guchar *window = src_row + (x - half_kernel) * channels;
+            __m128 sum = _mm_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel_sse41(window + k * channels, channels), weights[k]));
+            }
+            store_pixel_sse41(dst_row + x * channels, sum, channels);
+        }
+        
+        for (; x < width; x++) {
+            store_pixel_sse41(dst_row + x * channels,
+                             mirrored_pixel_sse41(src_row, x, width, channels, weights, kernel_size),
+                             channels);
+        }
+    }
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 void vertical_columns_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                                        gint height, gint rowstride, gint channels,
+                                                                        const gfloat *kernel, gint kernel_size,
+                                                                        gint x_start, gint x_end) {
+    __m128 weights[BLUR_MAX_KERNEL_SIZE];
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE];
+    
+    for (gint k = 0; k < kernel_size; k++) {
+        weights[k] = _mm_set1_ps(kernel[k]);
+    }
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        
+        for (gint x = x_start; x < x_end; x++) {
+            gint offset = x * channels;
+            __m128 sum = _mm_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel_sse41(rows[k] + offset, channels), weights[k]));
+            }
+            store_pixel_sse41(dst_row + offset, sum, channels);
+        }
+    }
+}
+
+static BLUR_TARGET_SSE41 void horizontal_pass_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                   gint width, gint rowstride, gint channels,
+                                                   const gfloat *kernel, gint kernel_size,
+                                                   gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_sse41(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_sse41(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+static BLUR_TARGET_SSE41 void vertical_pass_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                 gint height, gint rowstride, gint channels,
+                                                 const gfloat *kernel, gint kernel_size,
+                                                 gint x_start, gint x_end) {
+    if (channels == 4) {
+        vertical_columns_sse41(src_pixels, dst_pixels, height, rowstride, 4, kernel, kernel_size, x_start, x_end);
+    } else {
+        vertical_columns_sse41(src_pixels, dst_pixels, height, rowstride, 3, kernel, kernel_size, x_start, x_end);
+    }
+}
+
+/* Fixed-point SSE4.1 kernels. Two taps are interleaved per register as
+ * 16-bit values (t0 t1 t0 t1 ...) so one _mm_madd_epi16 against (w0 w1)
+ * pairs yields four 32-bit channel sums. An odd kernel's last tap is
+ * paired with a zero weight. Sums are exact integers, so every variant
+ * matches the scalar reference bit for bit. */
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 gint prepare_weight_pairs_sse41(gint32 *pairs, const gint16 *kernel,
+                                                                          gint kernel_size) {
+    gint pair_count = (kernel_size + 1) / 2;
+    for (gint j = 0; j < pair_count; j++) {
+        guint16 first = (guint16)kernel[2 * j];
+        guint16 second = (2 * j + 1 < kernel_size) ? (guint16)kernel[2 * j + 1] : 0;
+        pairs[j] = (gint32)(first | ((guint32)second << 16));
+    }
+    return pair_count;
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128i load_tap_pair_sse41(const guchar *first, const guchar *second,
+                                                                       gint channels) {
+    __m128i a = _mm_cvtsi32_si128((gint)load_pixel_bits(first, channels));
+    __m128i b = _mm_cvtsi32_si128((gint)load_pixel_bits(second, channels));
+    return _mm_cvtepu8_epi16(_mm_unpacklo_epi8(a, b));
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128i round_fixed_sse41(__m128i sum) {
+    return _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(FIXED_ROUND)), FIXED_SHIFT);
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 guint32 pack_pixel_fixed_sse41(__m128i sum) {
+    __m128i values = round_fixed_sse41(sum);
+    values = _mm_packus_epi32(values, values);
+    values = _mm_packus_epi16(values, values);
+    return (guint32)_mm_cvtsi128_si32(values);
+}
+
+/* Mirrored taps for one output pixel near the row ends */
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 guint32 horizontal_edge_fixed_sse41(const guchar *src_row, gint x, gint width,
+                                                                              gint channels, const gint32 *pairs,
+                                                                              gint pair_count, gint kernel_size) {
+    gint half_kernel = kernel_size / 2;
+    __m128i sum = _mm_setzero_si128();
+    
+    for (gint j = 0; j < pair_count; j++) {
+        gint k = 2 * j;
+        const guchar *first = src_row + mirror_sample(x + k - half_kernel, width) * channels;
+        const guchar *second = (k + 1 < kernel_size)
+            ? src_row + mirror_sample(x + k + 1 - half_kernel, width) * channels
+            : first;
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(load_tap_pair_sse41(first, second, channels),
+                                                _mm_set1_epi32(pairs[j])));
+    }
+    
+    return pack_pixel_fixed_sse41(sum);
+}
+
+/* Shuffle picking taps (p0, p1) of pixel x, or (p1, p2) of pixel x + 1,
+ * out of 16 loaded bytes as zero-extended 16-bit pairs per channel */
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128i tap_pair_shuffle_sse41(gint channels, gint pixel) {
+    gint8 mask[16];
+    
+    for (gint c = 0; c < 4; c++) {
+        gint base = pixel * channels + c;
+        mask[4 * c + 0] = (c < channels) ? (gint8)base : (gint8)0x80;
+        mask[4 * c + 1] = (gint8)0x80;
+        mask[4 * c + 2] = (c < channels) ? (gint8)(base + channels) : (gint8)0x80;
+        mask[4 * c + 3] = (gint8)0x80;
+    }
+    
+    return _mm_loadu_si128((const __m128i*)mask);
+}
+
+/* End of the x range whose 16-byte loads, shared by x and x + 1, stay
+ * inside the row; those loads also cover every tap of both pixels */
+static BLUR_ALWAYS_INLINE gint fixed_pair_end(gint width, gint channels, gint half_kernel, gint pair_count) {
+    if (width * channels < 16) {
+        return 0;
+    }
+    gint last_load = 2 * (pair_count - 1);  // Pixel offset of the last load from x - half_kernel
+    return (width * channels - 16) / channels - last_load + half_kernel + 1;
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 void horizontal_rows_fixed_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                                             gint width, gint rowstride, gint channels,
+                                                                             const gint16 *kernel, gint kernel_size,
+                                                                             gint y_start, gint y_end) {
+    gint32 pairs[(BLUR_MAX_KERNEL_SIZE + 1) / 2];
+    gint pair_count = prepare_weight_pairs_sse41(pairs, kernel, kernel_size);
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint pair_end = fixed_pair_end(width, channels, half_kernel, pair_count);
+    __m128i shuffle_first = tap_pair_shuffle_sse41(channels, 0);
+    __m128i shuffle_second = tap_pair_shuffle_sse41(channels, 1);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        gint x = 0;
+        
+        for (; x < interior_start; x++) {
+            store_pixel_bits(dst_row + x * channels,
+                             horizontal_edge_fixed_sse41(src_row, x, width, channels, pairs, pair_count, kernel_size),
+                             channels);
+        }
+        
+        // Two output pixels share every 16-byte load
+        for (; x < pair_end; x += 2) {
+            const guchar *window = src_row + (x - half_kernel) * channels;
+            __m128i sum_first = _mm_setzero_si128();
+            __m128i sum_second = _mm_setzero_si128();
+            
+            for (gint j = 0; j < pair_count; j++) {
+                __m128i bytes = _mm_loadu_si128((const __m128i*)(window + 2 * j * channels));
+                __m128i weights = _mm_set1_epi32(pairs[j]);
+                sum_first = _mm_add_epi32(sum_first, _mm_madd_epi16(_mm_shuffle_epi8(bytes, shuffle_first), weights));
+                sum_second = _mm_add_epi32(sum_second, _mm_madd_epi16(_mm_shuffle_epi8(bytes, shuffle_second), weights));
+            }
+            
+            __m128i values = _mm_packus_epi32(round_fixed_sse41(sum_first), round_fixed_sse41(sum_second));
+            values = _mm_packus_epi16(values, values);
+            store_pixel_bits(dst_row + x * channels, (guint32)_mm_cvtsi128_si32(values), channels);
+            store_pixel_bits(dst_row + (x + 1) * channels, (guint32)_mm_extract_epi32(values, 1), channels);
+        }
+        
+        for (; x < width; x++) {
+            store_pixel_bits(dst_row + x * channels,
+                             horizontal_edge_fixed_sse41(src_row, x, width, channels, pairs, pair_count, kernel_size),
+                             channels);
+        }
+    }
+}
+
+static BLUR_TARGET_SSE41 void horizontal_pass_fixed_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                         gint width, gint rowstride, gint channels,
+                                                         const gint16 *kernel, gint kernel_size,
+                                                         gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_fixed_sse41(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_fixed_sse41(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+/* Scalar tail of the vertical integer passes, one byte at a time */
+static inline void vertical_bytes_fixed(const guchar **rows, guchar *dst_row, const gint16 *kernel,
+                                        gint kernel_size, gint start, gint end) {
+    for (gint i = start; i < end; i++) {
+        gint32 sum = FIXED_ROUND;
+        for (gint k = 0; k < kernel_size; k++) {
+            sum += rows[k][i] * kernel[k];
+        }
+        dst_row[i] = (guchar)MIN(sum >> FIXED_SHIFT, 255);
+    }
+}
+
+/* The vertical pass weighs every byte of a row the same way, so it works
+ * on raw bytes regardless of the channel count, eight at a time */
+static BLUR_TARGET_SSE41 void vertical_pass_fixed_sse41(const guchar *src_pixels, guchar *dst_pixels,
+                                                       gint height, gint rowstride, gint channels,
+                                                       const gint16 *kernel, gint kernel_size,
+                                                       gint x_start, gint x_end) {
+    gint32 pairs[(BLUR_MAX_KERNEL_SIZE + 1) / 2];
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE + 1];
+    gint pair_count = prepare_weight_pairs_sse41(pairs, kernel, kernel_size);
+    gint start = x_start * channels;
+    gint end = x_end * channels;
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        rows[kernel_size] = rows[kernel_size - 1];  // Zero-weight partner for an odd last tap
+        
+        gint i = start;
+        for (; i + 8 <= end; i += 8) {
+            __m128i sum_low = _mm_setzero_si128();
+            __m128i sum_high = _mm_setzero_si128();
+            
+            for (gint j = 0; j < pair_count; j++) {
+                __m128i first = _mm_loadl_epi64((const __m128i*)(rows[2 * j] + i));
+                __m128i second = _mm_loadl_epi64((const __m128i*)(rows[2 * j + 1] + i));
+                __m128i taps = _mm_unpacklo_epi8(first, second);
+                __m128i weights = _mm_set1_epi32(pairs[j]);
+                sum_low = _mm_add_epi32(sum_low, _mm_madd_epi16(_mm_cvtepu8_epi16(taps), weights));
+                sum_high = _mm_add_epi32(sum_high, _mm_madd_epi16(_mm_unpackhi_epi8(taps, _mm_setzero_si128()), weights));
+            }
+            
+            __m128i values = _mm_packus_epi32(round_fixed_sse41(sum_low), round_fixed_sse41(sum_high));
+            _mm_storel_epi64((__m128i*)(dst_row + i), _mm_packus_epi16(values, values));
+        }
+        
+        vertical_bytes_fixed(rows, dst_row, kernel, kernel_size, i, end);
+    }
+}
+
+/* AVX2 handles two adjacent pixels per 256-bit register. Both pixels
+ * need the same weight at tap k and their samples are adjacent, so one
+ * 6 or 8 byte load feeds both lanes. */
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_AVX2 __m256 load_pixel_pair_avx2(const guchar *pixel, gint channels) {
+    __m128i bytes;
+    if (channels == 4) {
+        bytes = _mm_loadl_epi64((const __m128i*)pixel);
+    } else {
+        // Move the second pixel from byte 3 to byte 4 so both sit in 32-bit slots.
+        // A 4 and a 2 byte load go straight to the register; assembling the 6
+        // bytes in memory first stalls store forwarding on every tap.
+        guint32 low;
+        guint16 high;
+        memcpy(&low, pixel, 4);
+        memcpy(&high, pixel + 4, 2);
+        bytes = _mm_shuffle_epi8(_mm_insert_epi16(_mm_cvtsi32_si128((gint)low), high, 2),
+                                 _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                               -1, -1, -1, -1, -1, -1, -1, -1));
+    }
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_AVX2 void store_pixel_pair_avx2(guchar *pixel, __m256 sum, gint channels) {
+    store_pixel_sse41(pixel, _mm256_castps256_ps128(sum), channels);
+    store_pixel_sse41(pixel + channels, _mm256_extractf128_ps(sum, 1), channels);
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_AVX2 void horizontal_rows_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                                     gint width, gint rowstride, gint channels,
+                                                                     const gfloat *kernel, gint kernel_size,
+                                                                     gint y_start, gint y_end) {
+    __m128 weights[BLUR_MAX_KERNEL_SIZE];
+    __m256 weights_wide[BLUR_MAX_KERNEL_SIZE];
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint interior_end = MAX(width - half_kernel, interior_start);
+    
+    for (gint k = 0; k < kernel_size; k++) {
+        weights[k] = _mm_set1_ps(kernel[k]);
+        weights_wide[k] = _mm256_set1_ps(kernel[k]);
+    }
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        gint x = 0;
+        
+        for (; x < interior_start; x++) {
+            store_pixel_sse41(dst_row + x * channels,
+                             mirrored_pixel_sse41(src_row, x, width, channels, weights, kernel_size),
+                             channels);
+        }
+        
+        for (; x + 1 < interior_end; x += 2) {
+            const guchar *window = src_row + (x - half_kernel) * channels;
+            __m256 sum = _mm256_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(load_pixel_pair_avx2(window + k * channels, channels),
+                                                       weights_wide[k]));
+            }
+            store_pixel_pair_avx2(dst_row + x * channels, sum, channels);
+        }
+        
+        for (; x < interior_end; x++) {
+            const guchar *window = src_row + (x - half_kernel) * channels;
+            __m128 sum = _mm_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel_sse41(window + k * channels, channels), weights[k]));
+            }
+            store_pixel_sse41(dst_row + x * channels, sum, channels);
+        }
+        
+        for (; x < width; x++) {
+            store_pixel_sse41(dst_row + x * channels,
+                             mirrored_pixel_sse41(src_row, x, width, channels, weights, kernel_size),
+                             channels);
+        }
+    }
+}
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_AVX2 void vertical_columns_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                                      gint height, gint rowstride, gint channels,
+                                                                      const gfloat *kernel, gint kernel_size,
+                                                                      gint x_start, gint x_end) {
+    __m128 weights[BLUR_MAX_KERNEL_SIZE];
+    __m256 weights_wide[BLUR_MAX_KERNEL_SIZE];
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE];
+    
+    for (gint k = 0; k < kernel_size; k++) {
+        weights[k] = _mm_set1_ps(kernel[k]);
+        weights_wide[k] = _mm256_set1_ps(kernel[k]);
+    }
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        gint x = x_start;
+        
+        for (; x + 1 < x_end; x += 2) {
+            gint offset = x * channels;
+            __m256 sum = _mm256_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(load_pixel_pair_avx2(rows[k] + offset, channels),
+                                                       weights_wide[k]));
+            }
+            store_pixel_pair_avx2(dst_row + offset, sum, channels);
+        }
+        
+        for (; x < x_end; x++) {
+            gint offset = x * channels;
+            __m128 sum = _mm_setzero_ps();
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(load_pixel_sse41(rows[k] + offset, channels), weights[k]));
+            }
+            store_pixel_sse41(dst_row + offset, sum, channels);
+        }
+    }
+}
+
+static BLUR_TARGET_AVX2 void horizontal_pass_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                 gint width, gint rowstride, gint channels,
+                                                 const gfloat *kernel, gint kernel_size,
+                                                 gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_avx2(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_avx2(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+static BLUR_TARGET_AVX2 void vertical_pass_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                               gint height, gint rowstride, gint channels,
+                                               const gfloat *kernel, gint kernel_size,
+                                               gint x_start, gint x_end) {
+    if (channels == 4) {
+        vertical_columns_avx2(src_pixels, dst_pixels, height, rowstride, 4, kernel, kernel_size, x_start, x_end);
+    } else {
+        vertical_columns_avx2(src_pixels, dst_pixels, height, rowstride, 3, kernel, kernel_size, x_start, x_end);
+    }
+}
+
+/* Fixed-point AVX2 kernels: the horizontal pass computes pixels x and
+ * x + 1 in the two 128-bit lanes of one register, the vertical pass
+ * works on 16 bytes at a time */
+
+static BLUR_ALWAYS_INLINE BLUR_TARGET_AVX2 void horizontal_rows_fixed_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                                           gint width, gint rowstride, gint channels,
+                                                                           const gint16 *kernel, gint kernel_size,
+                                                                           gint y_start, gint y_end) {
+    gint32 pairs[(BLUR_MAX_KERNEL_SIZE + 1) / 2];
+    gint pair_count = prepare_weight_pairs_sse41(pairs, kernel, kernel_size);
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint pair_end = fixed_pair_end(width, channels, half_kernel, pair_count);
+    __m256i shuffle = _mm256_setr_m128i(tap_pair_shuffle_sse41(channels, 0), tap_pair_shuffle_sse41(channels, 1));
+    __m256i rounding = _mm256_set1_epi32(FIXED_ROUND);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        gint x = 0;
+        
+        for (; x < interior_start; x++) {
+            store_pixel_bits(dst_row + x * channels,
+                             horizontal_edge_fixed_sse41(src_row, x, width, channels, pairs, pair_count, kernel_size),
+                             channels);
+        }
+        
+        for (; x < pair_end; x += 2) {
+            const guchar *window = src_row + (x - half_kernel) * channels;
+            __m256i sum = _mm256_setzero_si256();
+            
+            for (gint j = 0; j < pair_count; j++) {
+                __m256i bytes = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(window + 2 * j * channels)));
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_shuffle_epi8(bytes, shuffle),
+                                                              _mm256_set1_epi32(pairs[j])));
+            }
+            
+            __m256i values = _mm256_srai_epi32(_mm256_add_epi32(sum, rounding), FIXED_SHIFT);
+            values = _mm256_packus_epi32(values, values);
+            values = _mm256_packus_epi16(values, values);
+            store_pixel_bits(dst_row + x * channels,
+                             (guint32)_mm_cvtsi128_si32(_mm256_castsi256_si128(values)), channels);
+            store_pixel_bits(dst_row + (x + 1) * channels,
+                             (guint32)_mm_cvtsi128_si32(_mm256_extracti128_si256(values, 1)), channels);
+        }
+        
+        for (; x < width; x++) {
+            store_pixel_bits(dst_row + x * channels,
+                             horizontal_edge_fixed_sse41(src_row, x, width, channels, pairs, pair_count, kernel_size),
+                             channels);
+        }
+    }
+}
+
+static BLUR_TARGET_AVX2 void horizontal_pass_fixed_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                       gint width, gint rowstride, gint channels,
+                                                       const gint16 *kernel, gint kernel_size,
+                                                       gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_fixed_avx2(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_fixed_avx2(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+static BLUR_TARGET_AVX2 void vertical_pass_fixed_avx2(const guchar *src_pixels, guchar *dst_pixels,
+                                                     gint height, gint rowstride, gint channels,
+                                                     const gint16 *kernel, gint kernel_size,
+                                                     gint x_start, gint x_end) {
+    gint32 pairs[(BLUR_MAX_KERNEL_SIZE + 1) / 2];
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE + 1];
+    gint pair_count = prepare_weight_pairs_sse41(pairs, kernel, kernel_size);
+    gint start = x_start * channels;
+    gint end = x_end * channels;
+    __m256i rounding = _mm256_set1_epi32(FIXED_ROUND);
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        rows[kernel_size] = rows[kernel_size - 1];  // Zero-weight partner for an odd last tap
+        
+        gint i = start;
+        for (; i + 16 <= end; i += 16) {
+            __m256i sum_low = _mm256_setzero_si256();
+            __m256i sum_high = _mm256_setzero_si256();
+            
+            for (gint j = 0; j < pair_count; j++) {
+                __m128i first = _mm_loadu_si128((const __m128i*)(rows[2 * j] + i));
+                __m128i second = _mm_loadu_si128((const __m128i*)(rows[2 * j + 1] + i));
+                __m256i weights = _mm256_set1_epi32(pairs[j]);
+                __m256i taps_low = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(first, second));
+                __m256i taps_high = _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(first, second));
+                sum_low = _mm256_add_epi32(sum_low, _mm256_madd_epi16(taps_low, weights));
+                sum_high = _mm256_add_epi32(sum_high, _mm256_madd_epi16(taps_high, weights));
+            }
+            
+            // packus works per 128-bit lane; the permute restores byte order
+            __m256i values = _mm256_packus_epi32(_mm256_srai_epi32(_mm256_add_epi32(sum_low, rounding), FIXED_SHIFT),
+                                                 _mm256_srai_epi32(_mm256_add_epi32(sum_high, rounding), FIXED_SHIFT));
+            values = _mm256_permute4x64_epi64(values, _MM_SHUFFLE(3, 1, 2, 0));
+            __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+            _mm_storeu_si128((__m128i*)(dst_row + i), bytes);
+        }
+        
+        vertical_bytes_fixed(rows, dst_row, kernel, kernel_size, i, end);
+    }
+}
+
+/* Luminance of four pixels laid out as R G B x bytes: the weighted pairs
+ * (R, G) and (B, x) are summed by madd and then by hadd, which keeps the
+ * pixels in order. The result holds one gray byte per 32-bit lane. */
+static BLUR_ALWAYS_INLINE BLUR_TARGET_SSE41 __m128i luminance4_sse41(__m128i pixels) {
+    const __m128i weights = _mm_setr_epi16(GRAY_WEIGHT_R, GRAY_WEIGHT_G, GRAY_WEIGHT_B, 0,
+                                           GRAY_WEIGHT_R, GRAY_WEIGHT_G, GRAY_WEIGHT_B, 0);
+    __m128i zero = _mm_setzero_si128();
+    __m128i low = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights);
+    __m128i high = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights);
+    
+    return _mm_srli_epi32(_mm_hadd_epi32(low, high), GRAY_SHIFT);
+}
+
+static BLUR_TARGET_SSE41 void grayscale_rows_sse41(const guchar *src_pixels, gint src_rowstride,
+                                                   guchar *dst_pixels, gint dst_rowstride,
+                                                   gint width, gint channels,
+                                                   gint y_start, gint y_end) {
+    const __m128i spread_rgba = _mm_setr_epi8(0, 0, 0, -1, 4, 4, 4, -1, 8, 8, 8, -1, 12, 12, 12, -1);
+    const __m128i alpha_mask = _mm_set1_epi32((gint)0xff000000);
+    const __m128i expand_rgb = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i spread_rgb = _mm_setr_epi8(0, 0, 0, 4, 4, 4, 8, 8, 8, 12, 12, 12, -1, -1, -1, -1);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + (gsize)y * src_rowstride;
+        guchar *dst_row = dst_pixels + (gsize)y * dst_rowstride;
+        gint x = 0;
+        
+        if (channels == 4) {
+            for (; x + 4 <= width; x += 4) {
+                __m128i pixels = _mm_loadu_si128((const __m128i*)(src_row + x * 4));
+                __m128i gray = _mm_shuffle_epi8(luminance4_sse41(pixels), spread_rgba);
+                gray = _mm_or_si128(gray, _mm_and_si128(pixels, alpha_mask));
+                _mm_storeu_si128((__m128i*)(dst_row + x * 4), gray);
+            }
+        } else {
+            // Four RGB pixels are 12 bytes; the 16 byte load needs two
+            // more pixels in the row so it never reads past its end
+            for (; x + 6 <= width; x += 4) {
+                __m128i pixels = _mm_loadu_si128((const __m128i*)(src_row + x * 3));
+                pixels = _mm_shuffle_epi8(pixels, expand_rgb);
+                __m128i gray = _mm_shuffle_epi8(luminance4_sse41(pixels), spread_rgb);
+                _mm_storel_epi64((__m128i*)(dst_row + x * 3), gray);
+                guint32 last = (guint32)_mm_extract_epi32(gray, 2);
+                memcpy(dst_row + x * 3 + 8, &last, 4);
+            }
+        }
+        
+        grayscale_span(src_row, dst_row, x, width, channels);
+    }
+}
+
+static gboolean cpu_has_sse41(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+}
+
+static gboolean cpu_has_avx2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif /* BLUR_HAVE_X86_SIMD */
+
+#ifdef BLUR_HAVE_NEON
+
+static BLUR_ALWAYS_INLINE float32x4_t load_pixel_neon(const guchar *pixel, gint channels) {
+    uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(load_pixel_bits(pixel, channels)));
+    uint16x4_t words = vget_low_u16(vmovl_u8(bytes));
+    return vcvtq_f32_u32(vmovl_u16(words));
+}
+
+static BLUR_ALWAYS_INLINE void store_pixel_neon(guchar *pixel, float32x4_t sum, gint channels) {
+    uint32x4_t values = vcvtq_u32_f32(vaddq_f32(sum, vdupq_n_f32(0.5f)));
+    uint16x4_t words = vqmovn_u32(values);
+    uint8x8_t bytes = vqmovn_u16(vcombine_u16(words, words));
+    store_pixel_bits(pixel, vget_lane_u32(vreinterpret_u32_u8(bytes), 0), channels);
+}
+
+static BLUR_ALWAYS_INLINE float32x4_t accumulate_neon(float32x4_t sum, float32x4_t value, float weight) {
+    // Separate multiply and add, like the scalar loop, rather than a fused vfmaq
+    return vaddq_f32(sum, vmulq_n_f32(value, weight));
+}
+
+static BLUR_ALWAYS_INLINE void horizontal_rows_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                                    gint width, gint rowstride, gint channels,
+                                                    const gfloat *kernel, gint kernel_size,
+                                                    gint y_start, gint y_end) {
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint interior_end = MAX(width - half_kernel, interior_start);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        
+        for (gint x = 0; x < width; x++) {
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            
+            if (x >= interior_start && x < interior_end) {
+                const guchar *window = src_row + (x - half_kernel) * channels;
+                for (gint k = 0; k < kernel_size; k++) {
+                    sum = accumulate_neon(sum, load_pixel_neon(window + k * channels, channels), kernel[k]);
+                }
+            } else {
+                for (gint k = 0; k < kernel_size; k++) {
+                    const guchar *sample = src_row + mirror_sample(x + k - half_kernel, width) * channels;
+                    sum = accumulate_neon(sum, load_pixel_neon(sample, channels), kernel[k]);
+                }
+            }
+            
+            store_pixel_neon(dst_row + x * channels, sum, channels);
+        }
+    }
+}
+
+static BLUR_ALWAYS_INLINE void vertical_columns_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                                     gint height, gint rowstride, gint channels,
+                                                     const gfloat *kernel, gint kernel_size,
+                                                     gint x_start, gint x_end) {
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE];
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        
+        for (gint x = x_start; x < x_end; x++) {
+            gint offset = x * channels;
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = accumulate_neon(sum, load_pixel_neon(rows[k] + offset, channels), kernel[k]);
+            }
+            store_pixel_neon(dst_row + offset, sum, channels);
+        }
+    }
+}
+
+static void horizontal_pass_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                gint width, gint rowstride, gint channels,
+                                const gfloat *kernel, gint kernel_size,
+                                gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_neon(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_neon(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+static void vertical_pass_neon(const guchar *src_pixels, guchar *dst_pixels,
+                              gint height, gint rowstride, gint channels,
+                              const gfloat *kernel, gint kernel_size,
+                              gint x_start, gint x_end) {
+    if (channels == 4) {
+        vertical_columns_neon(src_pixels, dst_pixels, height, rowstride, 4, kernel, kernel_size, x_start, x_end);
+    } else {
+        vertical_columns_neon(src_pixels, dst_pixels, height, rowstride, 3, kernel, kernel_size, x_start, x_end);
+    }
+}
+
+static BLUR_ALWAYS_INLINE uint32x4_t accumulate_fixed_neon(uint32x4_t sum, const guchar *pixel,
+                                                          gint channels, gint16 weight) {
+    uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(load_pixel_bits(pixel, channels)));
+    return vmlal_n_u16(sum, vget_low_u16(vmovl_u8(bytes)), (uint16_t)weight);
+}
+
+static BLUR_ALWAYS_INLINE void store_pixel_fixed_neon(guchar *pixel, uint32x4_t sum, gint channels) {
+    uint16x4_t words = vqmovn_u32(vrshrq_n_u32(sum, FIXED_SHIFT));
+    uint8x8_t bytes = vqmovn_u16(vcombine_u16(words, words));
+    store_pixel_bits(pixel, vget_lane_u32(vreinterpret_u32_u8(bytes), 0), channels);
+}
+
+static BLUR_ALWAYS_INLINE void horizontal_rows_fixed_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                                          gint width, gint rowstride, gint channels,
+                                                          const gint16 *kernel, gint kernel_size,
+                                                          gint y_start, gint y_end) {
+    gint half_kernel = kernel_size / 2;
+    gint interior_start = MIN(half_kernel, width);
+    gint interior_end = MAX(width - half_kernel, interior_start);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + y * rowstride;
+        guchar *dst_row = dst_pixels + y * rowstride;
+        
+        for (gint x = 0; x < width; x++) {
+            uint32x4_t sum = vdupq_n_u32(0);
+            
+            if (x >= interior_start && x < interior_end) {
+                const guchar *window = src_row + (x - half_kernel) * channels;
+                for (gint k = 0; k < kernel_size; k++) {
+                    sum = accumulate_fixed_neon(sum, window + k * channels, channels, kernel[k]);
+                }
+            } else {
+                for (gint k = 0; k < kernel_size; k++) {
+                    const guchar *sample = src_row + mirror_sample(x + k - half_kernel, width) * channels;
+                    sum = accumulate_fixed_neon(sum, sample, channels, kernel[k]);
+                }
+            }
+            
+            store_pixel_fixed_neon(dst_row + x * channels, sum, channels);
+        }
+    }
+}
+
+static BLUR_ALWAYS_INLINE void vertical_columns_fixed_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                                           gint height, gint rowstride, gint channels,
+                                                           const gint16 *kernel, gint kernel_size,
+                                                           gint x_start, gint x_end) {
+    const guchar *rows[BLUR_MAX_KERNEL_SIZE];
+    
+    for (gint y = 0; y < height; y++) {
+        guchar *dst_row = dst_pixels + y * rowstride;
+        resolve_rows(rows, src_pixels, y, height, rowstride, kernel_size);
+        
+        for (gint x = x_start; x < x_end; x++) {
+            gint offset = x * channels;
+            uint32x4_t sum = vdupq_n_u32(0);
+            for (gint k = 0; k < kernel_size; k++) {
+                sum = accumulate_fixed_neon(sum, rows[k] + offset, channels, kernel[k]);
+            }
+            store_pixel_fixed_neon(dst_row + offset, sum, channels);
+        }
+    }
+}
+
+static BLUR_ALWAYS_INLINE uint8x8_t luminance8_neon(uint8x8_t red, uint8x8_t green, uint8x8_t blue) {
+    uint16x8_t r = vmovl_u8(red);
+    uint16x8_t g = vmovl_u8(green);
+    uint16x8_t b = vmovl_u8(blue);
+    
+    uint32x4_t low = vmull_n_u16(vget_low_u16(r), GRAY_WEIGHT_R);
+    low = vmlal_n_u16(low, vget_low_u16(g), GRAY_WEIGHT_G);
+    low = vmlal_n_u16(low, vget_low_u16(b), GRAY_WEIGHT_B);
+    uint32x4_t high = vmull_n_u16(vget_high_u16(r), GRAY_WEIGHT_R);
+    high = vmlal_n_u16(high, vget_high_u16(g), GRAY_WEIGHT_G);
+    high = vmlal_n_u16(high, vget_high_u16(b), GRAY_WEIGHT_B);
+    
+    return vmovn_u16(vcombine_u16(vshrn_n_u32(low, GRAY_SHIFT), vshrn_n_u32(high, GRAY_SHIFT)));
+}
+
+static BLUR_ALWAYS_INLINE uint8x16_t luminance16_neon(uint8x16_t red, uint8x16_t green, uint8x16_t blue) {
+    return vcombine_u8(luminance8_neon(vget_low_u8(red), vget_low_u8(green), vget_low_u8(blue)),
+                       luminance8_neon(vget_high_u8(red), vget_high_u8(green), vget_high_u8(blue)));
+}
+
+// The structured loads deinterleave 16 pixels into channel planes
+static void grayscale_rows_neon(const guchar *src_pixels, gint src_rowstride,
+                                guchar *dst_pixels, gint dst_rowstride,
+                                gint width, gint channels,
+                                gint y_start, gint y_end) {
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = src_pixels + (gsize)y * src_rowstride;
+        guchar *dst_row = dst_pixels + (gsize)y * dst_rowstride;
+        gint x = 0;
+        
+        if (channels == 4) {
+            for (; x + 16 <= width; x += 16) {
+                uint8x16x4_t pixels = vld4q_u8(src_row + x * 4);
+                uint8x16_t gray = luminance16_neon(pixels.val[0], pixels.val[1], pixels.val[2]);
+                pixels.val[0] = gray;
+                pixels.val[1] = gray;
+                pixels.val[2] = gray;
+                vst4q_u8(dst_row + x * 4, pixels);
+            }
+        } else {
+            for (; x + 16 <= width; x += 16) {
+                uint8x16x3_t pixels = vld3q_u8(src_row + x * 3);
+                uint8x16_t gray = luminance16_neon(pixels.val[0], pixels.val[1], pixels.val[2]);
+                pixels.val[0] = gray;
+                pixels.val[1] = gray;
+                pixels.val[2] = gray;
+                vst3q_u8(dst_row + x * 3, pixels);
+            }
+        }
+        
+        grayscale_span(src_row, dst_row, x, width, channels);
+    }
+}
+
+static void horizontal_pass_fixed_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                      gint width, gint rowstride, gint channels,
+                                      const gint16 *kernel, gint kernel_size,
+                                      gint y_start, gint y_end) {
+    if (channels == 4) {
+        horizontal_rows_fixed_neon(src_pixels, dst_pixels, width, rowstride, 4, kernel, kernel_size, y_start, y_end);
+    } else {
+        horizontal_rows_fixed_neon(src_pixels, dst_pixels, width, rowstride, 3, kernel, kernel_size, y_start, y_end);
+    }
+}
+
+static void vertical_pass_fixed_neon(const guchar *src_pixels, guchar *dst_pixels,
+                                    gint height, gint rowstride, gint channels,
+                                    const gint16 *kernel, gint kernel_size,
+                                    gint x_start, gint x_end) {
+    if (channels == 4) {
+        vertical_columns_fixed_neon(src_pixels, dst_pixels, height, rowstride, 4, kernel, kernel_size, x_start, x_end);
+    } else {
+        vertical_columns_fixed_neon(src_pixels, dst_pixels, height, rowstride, 3, kernel, kernel_size, x_start, x_end);
+    }
+}
+
+#endif /* BLUR_HAVE_NEON */
+
+/* Dispatch */
+
+typedef struct {
+    BlurKernelOps ops;
+    gboolean (*is_supported)(void);
+} BlurKernelEntry;
+
+static gboolean always_supported(void) {
+    return TRUE;
+}
+
+/* Ordered from slowest to fastest; selection takes the last supported.
+ * The luminance kernel is bound by memory bandwidth, so AVX2 shares the
+ * SSE4.1 one. */
+static const BlurKernelEntry kernel_entries[] = {
+    { { "scalar", apply_horizontal_pass, apply_vertical_pass,
+        apply_horizontal_pass_fixed, apply_vertical_pass_fixed,
+        apply_grayscale_rows }, always_supported },
+#ifdef BLUR_HAVE_X86_SIMD
+    { { "sse4.1", horizontal_pass_sse41, vertical_pass_sse41,
+        horizontal_pass_fixed_sse41, vertical_pass_fixed_sse41,
+        grayscale_rows_sse41 }, cpu_has_sse41 },
+    { { "avx2", horizontal_pass_avx2, vertical_pass_avx2,
+        horizontal_pass_fixed_avx2, vertical_pass_fixed_avx2,
+        grayscale_rows_sse41 }, cpu_has_avx2 },
+#endif
+#ifdef BLUR_HAVE_NEON
+    { { "neon", horizontal_pass_neon, vertical_pass_neon,
+        horizontal_pass_fixed_neon, vertical_pass_fixed_neon,
+        grayscale_rows_neon }, always_supported },
+#endif
+};
+
+const BlurKernelOps* blur_kernels_get_scalar(void) {
+    return &kernel_entries[0].ops;
+}
+
+const BlurKernelOps* blur_kernels_select(const gchar *name) {
+    const BlurKernelOps *best = blur_kernels_get_scalar();
+    
+    for (gsize i = 0; i < G_N_ELEMENTS(kernel_entries); i++) {
+        if (!kernel_entries[i].is_supported()) {
+            continue;
+        }
+        if (name && g_strcmp0(name, kernel_entries[i].ops.name) == 0) {
+            return &kernel_entries[i].ops;
+        }
+        best = &kernel_entries[i].ops;
+    }
+    
+    return best;
+}
@@ -0,0 +1,137 @@
+/* blur-kernels.h - Separable convolution kernels with CPU dispatch
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * BlurHorizontalPassFunc:
+ * @src_pixels: Source pixel rows
+ * @dst_pixels: Destination pixel rows, same layout as @src_pixels
+ * @width: Row width in pixels
+ * @rowstride: Bytes between rows of both buffers
+ * @channels: 3 for RGB, 4 for RGBA
+ * @kernel: Normalized 1D Gaussian weights
+ * @kernel_size: Number of weights (odd)
+ * @y_start: First row to process
+ * @y_end: Row after the last one to process
+ *
+ * Convolves rows [@y_start, @y_end) along x with mirrored edges.
+ */
+typedef void (*BlurHorizontalPassFunc)(const guchar *src_pixels, guchar *dst_pixels,
+                                      gint width, gint rowstride, gint channels,
+                                      const gfloat *kernel, gint kernel_size,
+                                      gint y_start, gint y_end);
+
+/**
+ * BlurVerticalPassFunc:
+ * @src_pixels: Source pixel rows
+ * @dst_pixels: Destination pixel rows, same layout as @src_pixels
+ * @height: Number of rows in the image
+ * @rowstride: Bytes between rows of both buffers
+ * @channels: 3 for RGB, 4 for RGBA
+ * @kernel: Normalized 1D Gaussian weights
+ * @kernel_size: Number of weights (odd)
+ * @x_start: First column to process
+ * @x_end: Column after the last one to process
+ *
+ * Convolves columns [@x_start, @x_end) along y with mirrored edges.
+ */
+typedef void (*BlurVerticalPassFunc)(const guchar *src_pixels, guchar *dst_pixels,
+                                    gint height, gint rowstride, gint channels,
+                                    const gfloat *kernel, gint kernel_size,
+                                    gint x_start, gint x_end);
+
+/**
+ * BlurHorizontalPassFixedFunc:
+ * @kernel: Q14 fixed-point weights from blur_generate_kernel_fixed()
+ *
+ * Integer variant of #BlurHorizontalPassFunc; other parameters are the same.
+ */
+typedef void (*BlurHorizontalPassFixedFunc)(const guchar *src_pixels, guchar *dst_pixels,
+                                           gint width, gint rowstride, gint channels,
+                                           const gint16 *kernel, gint kernel_size,
+                                           gint y_start, gint y_end);
+
+/**
+ * BlurVerticalPassFixedFunc:
+ * @kernel: Q14 fixed-point weights from blur_generate_kernel_fixed()
+ *
+ * Integer variant of #BlurVerticalPassFunc; other parameters are the same.
+ */
+typedef void (*BlurVerticalPassFixedFunc)(const guchar *src_pixels, guchar *dst_pixels,
+                                         gint height, gint rowstride, gint channels,
+                                         const gint16 *kernel, gint kernel_size,
+                                         gint x_start, gint x_end);
+
+/**
+ * BlurGrayscaleRowsFunc:
+ * @src_pixels: Source pixel rows
+ * @src_rowstride: Bytes between rows of @src_pixels
+ * @dst_pixels: Destination pixel rows with the same channel layout
+ * @dst_rowstride: Bytes between rows of @dst_pixels
+ * @width: Row width in pixels
+ * @channels: 3 for RGB, 4 for RGBA
+ * @y_start: First row to process
+ * @y_end: Row after the last one to process
+ *
+ * Replaces the color of rows [@y_start, @y_end) with its luminance,
+ * (0.299 R + 0.587 G + 0.114 B) in Q15 fixed point, truncated. Alpha is
+ * copied unchanged.
+ */
+typedef void (*BlurGrayscaleRowsFunc)(const guchar *src_pixels, gint src_rowstride,
+                                      guchar *dst_pixels, gint dst_rowstride,
+                                      gint width, gint channels,
+                                      gint y_start, gint y_end);
+
+/**
+ * BlurKernelOps:
+ * @name: Implementation name ("scalar", "sse4.1", "avx2" or "neon")
+ * @horizontal_pass: Row convolution
+ * @vertical_pass: Column convolution
+ * @horizontal_pass_fixed: Row convolution with integer weights
+ * @vertical_pass_fixed: Column convolution with integer weights
+ * @grayscale_rows: Luminance conversion
+ *
+ * One implementation of the separable Gaussian passes and the grayscale
+ * conversion. Every variant produces the same output as the scalar
+ * reference.
+ */
+typedef struct {
+    const gchar *name;
+    BlurHorizontalPassFunc horizontal_pass;
+    BlurVerticalPassFunc vertical_pass;
+    BlurHorizontalPassFixedFunc horizontal_pass_fixed;
+    BlurVerticalPassFixedFunc vertical_pass_fixed;
+    BlurGrayscaleRowsFunc grayscale_rows;
+} BlurKernelOps;
+
+/**
+ * blur_kernels_select:
+ * @name: Preferred implementation name, or NULL for the best available
+ *
+ * Picks the kernel implementation for the running CPU. A @name that is
+ * unknown or unsupported on this CPU falls back to the best available.
+ *
+ * Returns: Static kernel table, never NULL
+ */
+const BlurKernelOps* blur_kernels_select(const gchar *name);
+
+/**
+ * blur_kernels_get_scalar:
+ *
+ * Returns: The portable scalar reference implementation
+ */
+const BlurKernelOps* blur_kernels_get_scalar(void);
+
+G_END_DECLS
@@ -0,0 +1,241 @@
+/* blur-prefetch.c - Speculative blur of neighboring intensities
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "blur-prefetch.h"
+
+/* Offsets from the displayed intensity, nearest first */
+static const gdouble prefetch_steps[] = { 0.1, 0.5 };
+
+#define PREFETCH_MAX_CANDIDATES G_N_ELEMENTS(prefetch_steps)
+
+struct _BlurPrefetcher {
+    BlurProcessor *processor;
+    BlurCache *cache;
+    guint cache_owner;
+    gdouble intensity_scale;
+    
+    /* Image being prefetched for */
+    GdkPixbuf *source;
+    gchar *pixbuf_hash;
+    
+    /* Slider movement */
+    gdouble last_intensity;
+    gint direction;
+    
+    /* Neighbors still to blur, in order */
+    gdouble candidates[PREFETCH_MAX_CANDIDATES];
+    guint candidate_count;
+    guint next_candidate;
+    
+    /* Work in flight */
+    guint idle_id;
+    guint active_request;
+    gdouble active_intensity;
+    
+    BlurPrefetchStats stats;
+};
+
+static gboolean prefetch_idle_callback(gpointer user_data);
+
+static void prefetch_completion_callback(GdkPixbuf *result_pixbuf,
+                                         const GError *error,
+                                         gpointer user_data) {
+    BlurPrefetcher *prefetcher = user_data;
+    
+    prefetcher->active_request = 0;
+    
+    // Superseded or failed, try again on the next schedule
+    if (error || !result_pixbuf) {
+        prefetcher->stats.cancelled++;
+        prefetcher->candidate_count = 0;
+        return;
+    }
+    
+    // Speculative, so memory pressure drops it before anything displayed
+    if (blur_cache_put_speculative(prefetcher->cache, prefetcher->cache_owner, prefetcher->pixbuf_hash,
+                                   prefetcher->active_intensity, result_pixbuf)) {
+        prefetcher->stats.completed++;
+    }
+    
+    // Go back through the idle source so UI events run first
+    prefetcher->idle_id = g_idle_add_full(G_PRIORITY_LOW, prefetch_idle_callback,
+                                          prefetcher, NULL);
+}
+
+static void prefetch_start_next(BlurPrefetcher *prefetcher) {
+    gsize entry_size = blur_cache_calculate_pixbuf_size(prefetcher->source);
+    
+    while (prefetcher->next_candidate < prefetcher->candidate_count) {
+        gdouble intensity = prefetcher->candidates[prefetcher->next_candidate++];
+        
+        if (blur_cache_contains(prefetcher->cache, prefetcher->pixbuf_hash, intensity)) {
+            prefetcher->stats.skipped_cached++;
+            continue;
+        }
+        
+        // Results are all the same size, so nothing further fits either
+        if (!blur_cache_has_room(prefetcher->cache, entry_size)) {
+            prefetcher->stats.skipped_budget +=
+                prefetcher->candidate_count - prefetcher->next_candidate + 1;
+            prefetcher->candidate_count = 0;
+            return;
+        }
+        
+        // Full quality, ready to display as final; upward steps can usually
+        // continue from the result on screen
+        gdouble lower_intensity = 0.0;
+        GdkPixbuf *lower_result = blur_cache_get_nearest_lower(prefetcher->cache,
+                                                               prefetcher->pixbuf_hash,
+                                                               intensity,
+                                                               &lower_intensity);
+        guint request_id = blur_processor_apply_async_from_base(
+            prefetcher->processor,
+            prefetcher->source,
+            lower_result,
+            lower_intensity * prefetcher->intensity_scale,
+            intensity * prefetcher->intensity_scale,
+            BLUR_PRIORITY_BACKGROUND,
+            prefetch_completion_callback,
+            prefetcher
+        );
+        g_clear_object(&lower_result);
+        
+        if (request_id > 0) {
+            prefetcher->active_request = request_id;
+            prefetcher->active_intensity = intensity;
+            prefetcher->stats.started++;
+            return;
+        }
+    }
+}
+
+static gboolean prefetch_idle_callback(gpointer user_data) {
+    BlurPrefetcher *prefetcher = user_data;
+    
+    prefetcher->idle_id = 0;
+    prefetch_start_next(prefetcher);
+    
+    return G_SOURCE_REMOVE;
+}
+
+/* Public API Implementation */
+
+BlurPrefetcher* blur_prefetcher_create(BlurProcessor *processor, BlurCache *cache) {
+    if (!processor || !cache) {
+        return NULL;
+    }
+    
+    BlurPrefetcher *prefetcher = g_new0(BlurPrefetcher, 1);
+    prefetcher->processor = processor;
+    prefetcher->cache = cache;
+    prefetcher->direction = 1; // Sliders usually start at zero and go up
+    prefetcher->intensity_scale = 1.0;
+    
+    return prefetcher;
+}
+
+void blur_prefetcher_set_cache_owner(BlurPrefetcher *prefetcher, guint owner_id) {
+    if (!prefetcher) {
+        return;
+    }
+    
+    prefetcher->cache_owner = owner_id;
+}
+
+void blur_prefetcher_set_intensity_scale(BlurPrefetcher *prefetcher, gdouble scale) {
+    if (!prefetcher || scale <= 0.0 || scale > 1.0) {
+        return;
+    }
+    
+    prefetcher->intensity_scale = scale;
+}
+
+void blur_prefetcher_schedule(BlurPrefetcher *prefetcher,
+                              GdkPixbuf *source,
+                              const gchar *pixbuf_hash,
+                              gdouble intensity) {
+    if (!prefetcher || !source || !pixbuf_hash) {
+        return;
+    }
+    
+    blur_prefetcher_cancel(prefetcher);
+    
+    gdouble rounded = blur_cache_round_intensity(intensity);
+    
+    // Keep the previous direction when the value did not move
+    if (rounded > prefetcher->last_intensity) {
+        prefetcher->direction = 1;
+    } else if (rounded < prefetcher->last_intensity) {
+        prefetcher->direction = -1;
+    }
+    prefetcher->last_intensity = rounded;
+    
+    g_set_object(&prefetcher->source, source);
+    if (g_strcmp0(prefetcher->pixbuf_hash, pixbuf_hash) != 0) {
+        g_free(prefetcher->pixbuf_hash);
+        prefetcher->pixbuf_hash = g_strdup(pixbuf_hash);
+    }
+    
+    for (guint i = 0; i < PREFETCH_MAX_CANDIDATES; i++) {
+        gdouble candidate = blur_cache_round_intensity(
+            rounded + prefetcher->direction * prefetch_steps[i]);
+        
+        // Zero needs no blur and the processor rejects values past 10
+        if (candidate <= 0.0 || !blur_validate_intensity(candidate)) {
+            continue;
+        }
+        prefetcher->candidates[prefetcher->candidate_count++] = candidate;
+    }
+    
+    if (prefetcher->candidate_count > 0) {
+        prefetcher->idle_id = g_idle_add_full(G_PRIORITY_LOW, prefetch_idle_callback,
+                                              prefetcher, NULL);
+    }
+}
+
+void blur_prefetcher_cancel(BlurPrefetcher *prefetcher) {
+    if (!prefetcher) {
+        return;
+    }
+    
+    if (prefetcher->idle_id > 0) {
+        g_source_remove(prefetcher->idle_id);
+        prefetcher->idle_id = 0;
+    }
+    
+    // Cancelled requests get no callback, so the id is ours to clear
+    if (prefetcher->active_request > 0) {
+        blur_processor_cancel(prefetcher->processor, prefetcher->active_request);
+        prefetcher->active_request = 0;
+        prefetcher->stats.cancelled++;
+    }
+    
+    prefetcher->candidate_count = 0;
+    prefetcher->next_candidate = 0;
+}
+
+void blur_prefetcher_get_stats(BlurPrefetcher *prefetcher, BlurPrefetchStats *stats) {
+    if (!prefetcher || !stats) {
+        return;
+    }
+    
+    *stats = prefetcher->stats;
+}
+
+void blur_prefetcher_destroy(BlurPrefetcher *prefetcher) {
+    if (!prefetcher) {
+        return;
+    }
+    
+    blur_prefetcher_cancel(prefetcher);
+    g_clear_object(&prefetcher->source);
+    g_free(prefetcher->pixbuf_hash);
+    g_free(prefetcher);
+}
@@ -0,0 +1,123 @@
+/* blur-prefetch.h - Speculative blur of neighboring intensities
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include "blur-processor.h"
+#include "blur-cache.h"
+
+G_BEGIN_DECLS
+
+typedef struct _BlurPrefetcher BlurPrefetcher;
+
+/**
+ * BlurPrefetchStats:
+ * @started: Prefetch blurs submitted to the processor
+ * @completed: Prefetch results stored in the cache
+ * @cancelled: Prefetch blurs abandoned for foreground work
+ * @skipped_cached: Neighbors skipped because they were already cached
+ * @skipped_budget: Neighbors skipped because the cache had no free room
+ *
+ * Prefetcher activity counters
+ */
+typedef struct {
+    guint64 started;
+    guint64 completed;
+    guint64 cancelled;
+    guint64 skipped_cached;
+    guint64 skipped_budget;
+} BlurPrefetchStats;
+
+/**
+ * blur_prefetcher_create:
+ * @processor: Processor that runs the prefetch blurs
+ * @cache: Cache that receives the results
+ *
+ * Creates a prefetcher that, while the UI is idle, blurs the intensities
+ * next to the last one shown (+0.1 and +0.5 in the direction the value
+ * last moved) so the next slider step is a cache hit.
+ *
+ * Prefetch blurs run at %BLUR_PRIORITY_BACKGROUND one at a time and only
+ * while the cache has room without evicting, so they never displace
+ * results the user has already seen. The prefetcher is main thread only
+ * and does not own @processor or @cache; both must outlive it.
+ *
+ * Returns: New BlurPrefetcher instance, or NULL on failure
+ */
+BlurPrefetcher* blur_prefetcher_create(BlurProcessor *processor, BlurCache *cache);
+
+/**
+ * blur_prefetcher_set_cache_owner:
+ * @prefetcher: BlurPrefetcher instance
+ * @owner_id: Id from blur_cache_register_owner(), or 0 for shared entries
+ *
+ * Charges prefetched results to @owner_id, so a window's speculative
+ * blurs count against its own share of a shared cache.
+ */
+void blur_prefetcher_set_cache_owner(BlurPrefetcher *prefetcher, guint owner_id);
+
+/**
+ * blur_prefetcher_set_intensity_scale:
+ * @prefetcher: BlurPrefetcher instance
+ * @scale: Factor in (0, 1] applied to intensities sent to the processor
+ *
+ * For sources that are downsampled proxies of a larger image. Cache keys
+ * keep the intensity the user picked, while the blur itself runs at
+ * @scale times that intensity so the proxy result matches the full
+ * resolution result scaled down. Defaults to 1.0.
+ */
+void blur_prefetcher_set_intensity_scale(BlurPrefetcher *prefetcher, gdouble scale);
+
+/**
+ * blur_prefetcher_schedule:
+ * @prefetcher: BlurPrefetcher instance
+ * @source: Image the displayed result was blurred from
+ * @pixbuf_hash: Cache hash of @source
+ * @intensity: Intensity now on screen at full quality
+ *
+ * Replaces any pending prefetch with the neighbors of @intensity. The
+ * direction is taken from the previously scheduled intensity. Work starts
+ * from a low priority idle source, after pending UI events.
+ */
+void blur_prefetcher_schedule(BlurPrefetcher *prefetcher,
+                              GdkPixbuf *source,
+                              const gchar *pixbuf_hash,
+                              gdouble intensity);
+
+/**
+ * blur_prefetcher_cancel:
+ * @prefetcher: BlurPrefetcher instance
+ *
+ * Yields to foreground work: drops pending neighbors and cancels the
+ * running prefetch blur, which frees its worker at the next chunk.
+ * Call this before submitting a visible request.
+ */
+void blur_prefetcher_cancel(BlurPrefetcher *prefetcher);
+
+/**
+ * blur_prefetcher_get_stats:
+ * @prefetcher: BlurPrefetcher instance
+ * @stats: Output structure for statistics
+ *
+ * Retrieves prefetch activity counters.
+ */
+void blur_prefetcher_get_stats(BlurPrefetcher *prefetcher, BlurPrefetchStats *stats);
+
+/**
+ * blur_prefetcher_destroy:
+ * @prefetcher: BlurPrefetcher instance to destroy
+ *
+ * Cancels outstanding work and frees the prefetcher.
+ */
+void blur_prefetcher_destroy(BlurPrefetcher *prefetcher);
+
+G_END_DECLS
@@ -9,56 +9,248 @@
  */
 
 #include "blur-processor.h"
+#include "blur-kernels.h"
+#include "blur-trace.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_THREADS 8
+#define MAX_THREADS 16
 #define MIN_THREADS 1
 #define MAX_IMAGE_DIMENSION 8192
 
+/* Smallest slice handed to a band worker; below this the pool overhead
+ * outweighs the extra parallelism */
+#define MIN_BAND_ROWS 32
+#define MIN_TILE_COLUMNS 64
+
+/* Stacked box blurs used above BLUR_BOX_SIGMA_THRESHOLD. Three passes
+ * keep the result visually indistinguishable from a true Gaussian. */
+#define BOX_PASS_COUNT 3
+
+/* Images larger than the processor's max size are blurred in tiles of
+ * BLUR_TILE_SIZE pixels plus a halo of up to BLUR_TILE_MAX_HALO on each
+ * side. The halo covers the support of every kernel up to sigma 20
+ * (intensity 10): the Gaussian is capped at 121 taps and the three boxes
+ * sum to at most 60 pixels of radius. */
+#define BLUR_TILE_SIZE 1024
+#define BLUR_TILE_MAX_HALO 64
+
+/* Granularity of cancellation checks inside a band */
+#define CANCEL_CHECK_ROWS 64
+#define CANCEL_CHECK_COLUMNS 256
+
+/* Scratch arenas are allocated on first use in size classes four per
+ * power of two, so similar images share an arena with at most 25% slack.
+ * An arena or pooled result buffer nobody used for
+ * BLUR_SCRATCH_IDLE_SECONDS is freed by the next checkout or return. */
+#define BLUR_SCRATCH_MIN_CLASS (64 * 1024)
+#define BLUR_SCRATCH_IDLE_SECONDS 10
+
 /* Forward declarations */
 static void blur_worker_thread_func(gpointer data, gpointer user_data);
 static gboolean blur_completion_idle_callback(gpointer data);
 static gboolean ensure_thread_pool_created(BlurProcessor *processor);
+static void blur_band_thread_func(gpointer data, gpointer user_data);
+static void complete_superseded(BlurCompletionCallback callback, gpointer user_data);
+static void complete_destroyed(BlurCompletionCallback callback, gpointer user_data);
 
 /* Private structures */
 
 typedef struct {
     guint request_id;
     GdkPixbuf *source_pixbuf;
+    /* Pipeline stages; intensity is unused without BLUR_STAGE_BLUR */
+    BlurStages stages;
     gdouble intensity;
     gboolean is_progressive;
+    BlurPriority priority;
     BlurCompletionCallback callback;
     gpointer user_data;
+    
+    /* Where the callback runs; context is NULL for the default one */
+    BlurDeliveryMode delivery;
+    GMainContext *context;
+    
+    /* Replaced under latest-wins; a worker delivered item is then
+     * completed with BLUR_ERROR_CANCELLED by the worker that drops it */
+    gboolean superseded;
+    
+    /* Blocking and batch requests, which latest-wins never replaces: each
+     * one has a caller waiting for exactly that result */
+    gboolean never_supersede;
+    
+    /* Lower intensity result to continue from, NULL to blur the source */
+    GdkPixbuf *base_pixbuf;
+    gdouble base_intensity;
+    
+    /* Set once a worker picks the item up; guarded by processor_mutex */
+    gboolean started;
+    
+    /* Timing probes: submission, end of the worker's part, and the time
+     * spent in row ([0]) and column ([1]) passes */
+    gint64 submit_time;
+    gint64 finish_time;
+    gint64 pass_time_us[2];
+    
+    /* Set by blur_processor_cancel(), polled by the worker between chunks.
+     * The item stays alive until its idle callback, so cancel can always
+     * reach it while it is listed in active_requests. */
+    gint cancelled;
 } BlurWorkItem;
 
+/* Scratch arena owned by one in-flight request at a time. Whole-image
+ * blurs only need buffer1; tiled ones also use buffer2. */
 typedef struct {
-    BlurCompletionCallback callback;
-    gpointer user_data;
+    guchar *buffer1;
+    guchar *buffer2;
+    gsize size;
+    gsize spare_size;
+    gint64 released_us;     /* When it last went back to the pool */
+} BlurScratch;
+
+/* Recycled result pixel buffers shared by the processor and every result
+ * pixbuf it handed out. A buffer returns to the pool when the last
+ * reference to its pixbuf is dropped, typically on cache eviction, so the
+ * next result of the same size reuses it instead of allocating. */
+typedef struct {
+    gint ref_count;
+    GMutex mutex;
+    GQueue free_buffers;    /* BlurPooledBuffer, most recently freed first */
+    gsize free_bytes;
+    gsize max_free_bytes;
+    gboolean closed;        /* Processor destroyed; returning buffers are freed */
+    guint64 reused;
+} BlurResultPool;
+
+typedef struct {
+    BlurResultPool *pool;
+    guchar *data;
+    gsize size;
+    gint64 released_us;     /* When it last went back to the pool */
+} BlurPooledBuffer;
+
+/* What a pass computes. Everything but BLUR_PASS_CONVOLVE is pointwise
+ * in row bands and ignores the kernel fields. */
+typedef enum {
+    BLUR_PASS_CONVOLVE,         /* Kernel or box pass along is_vertical */
+    BLUR_PASS_GRAYSCALE,        /* Luminance as RGB(A) in dst's layout */
+    BLUR_PASS_PACK_PLANES,      /* Luminance (plus alpha) into row groups */
+    BLUR_PASS_UNPACK_PLANES,    /* Row groups back to one row per image row */
+    BLUR_PASS_EXPAND_PLANES     /* Planes out to the RGB(A) result */
+} BlurPassStep;
+
+/* One separable pass split into bands and shared across the band pool */
+typedef struct {
+    const guchar *src_pixels;
+    guchar *dst_pixels;
+    gint width;
+    gint height;
+    gint rowstride;
+    gint channels;
+    const BlurKernelOps *kernel_ops;
+    const gfloat *kernel;
+    /* Q14 variant of @kernel; when set the integer passes are used */
+    const gint16 *kernel_fixed;
+    gint kernel_size;
+    gboolean is_vertical;
+    gint band_count;
+    
+    /* Bytes between rows of dst_pixels. Horizontal and grayscale passes
+     * may read a source with another layout (rowstride); vertical passes
+     * need both to match. */
+    gint dst_rowstride;
+    
+    BlurPassStep step;
+    
+    /* Image rows behind the plane steps, whose height counts row groups */
+    gint plane_rows;
+    
+    /* Box engine: radii of the stacked boxes, NULL for the Gaussian kernel.
+     * The vertical box pass ping-pongs between dst_pixels and spare_pixels,
+     * which must hold the same data as src_pixels. */
+    const gint *box_radii;
+    guchar *spare_pixels;
+    
+    /* Owning request's cancellation flag, NULL if not cancellable */
+    const gint *cancel_flag;
+    
+    /* Owning request's row and column pass times, NULL if not timed */
+    gint64 *pass_time_us;
+    
+    GMutex mutex;
+    GCond cond;
+    gint pending;
+} BlurPassJob;
+
+typedef struct {
+    BlurPassJob *job;
+    gint index;
+} BlurBandTask;
+
+typedef struct {
+    BlurWorkItem *item;
     GdkPixbuf *result;
-    guint request_id;
     BlurProcessor *processor;
 } CallbackData;
 
+/* Most recent durations of one stage, oldest overwritten first. @work
+ * holds the pixels behind each sample where throughput is wanted. */
+typedef struct {
+    gint64 values[BLUR_LATENCY_WINDOW];
+    gint64 work[BLUR_LATENCY_WINDOW];
+    guint count;
+    guint next;
+} LatencyWindow;
+
 struct _BlurProcessor {
     gint max_width;
     gint max_height;
     gint thread_count;
     
+    /* Convolution kernels picked for this CPU at creation time */
+    const BlurKernelOps *kernel_ops;
+    
     /* Threading infrastructure */
     GThreadPool *thread_pool;
+    GThreadPool *band_pool;
     GAsyncQueue *work_queue;
     GMutex processor_mutex;
     
     /* Request tracking */
     guint next_request_id;
     GHashTable *active_requests;
-    
-    /* Processing buffers (preallocated for efficiency) */
-    guchar *horizontal_buffer;
-    guchar *vertical_buffer;
-    gsize buffer_size;
+    BlurScheduleMode schedule_mode;
+    
+    /* Cancellation accounting, guarded by processor_mutex. The cost model
+     * is the running average worker time per blurred pixel. */
+    BlurProcessorStats stats;
+    gdouble ns_per_pixel;
+    
+    /* Timing probes of completed requests, guarded by processor_mutex */
+    LatencyWindow queue_wait_window;
+    LatencyWindow horizontal_window;
+    LatencyWindow vertical_window;
+    LatencyWindow compute_window;
+    LatencyWindow delivery_window;
+    LatencyWindow total_window;
+    
+    /* Free scratch arenas, one checked out per running request. Nothing
+     * is allocated before the first blur; arenas idle for long are freed
+     * on a later checkout or return, without any main loop. */
+    GSList *scratch_pool;
+    gsize scratch_bytes;
+    guint scratch_in_use;
+    GMutex scratch_mutex;
+    
+    /* Pixel buffers of results, recycled after their pixbufs are freed */
+    BlurResultPool *result_pool;
+    
+    /* Downsampled copy of the last progressive source, reused while the
+     * slider is dragged over the same image */
+    GdkPixbuf *preview_source;
+    GdkPixbuf *preview_pixbuf;
+    GMutex preview_mutex;
     
     gboolean is_destroyed;
 };
@@ -80,6 +272,17 @@ gdouble blur_calculate_sigma(gdouble intensity) {
     return intensity * 2.0;
 }
 
+gdouble blur_calculate_residual_sigma(gdouble base_intensity, gdouble intensity) {
+    gdouble base_sigma = blur_calculate_sigma(base_intensity);
+    gdouble sigma = blur_calculate_sigma(intensity);
+    
+    if (base_sigma >= sigma) {
+        return 0.0;
+    }
+    
+    return sqrt(sigma * sigma - base_sigma * base_sigma);
+}
+
 gint blur_calculate_kernel_size(gdouble sigma) {
     if (sigma <= 0.0) {
         return 3; // Minimum kernel size
@@ -131,6 +334,65 @@ gfloat* blur_generate_kernel(gdouble sigma, gint kernel_size) {
     return kernel;
 }
 
+gint16* blur_generate_kernel_fixed(gdouble sigma, gint kernel_size) {
+    gfloat *kernel = blur_generate_kernel(sigma, kernel_size);
+    if (!kernel) {
+        return NULL;
+    }
+    
+    gint16 *kernel_fixed = g_malloc(sizeof(gint16) * kernel_size);
+    gint center = kernel_size / 2;
+    gint sum = 0;
+    
+    // Round each weight, then give the rounding residue to the center tap
+    // so the weights sum to exactly 1.0 and flat regions stay unchanged
+    for (gint i = 0; i < kernel_size; i++) {
+        kernel_fixed[i] = (gint16)lrint(kernel[i] * BLUR_FIXED_POINT_ONE);
+        sum += kernel_fixed[i];
+    }
+    kernel_fixed[center] = (gint16)(kernel_fixed[center] + BLUR_FIXED_POINT_ONE - sum);
+    
+    g_free(kernel);
+    return kernel_fixed;
+}
+
+gint blur_calculate_preview_factor(gint width, gint height) {
+    gint factor = 1;
+    gint longest = MAX(width, height);
+    
+    // Power-of-two steps keep the box downsample exact and cheap
+    while (factor < BLUR_PREVIEW_MAX_FACTOR && longest > BLUR_PREVIEW_MAX_SIZE * factor) {
+        factor *= 2;
+    }
+    
+    return factor;
+}
+
+gboolean blur_calculate_box_sizes(gdouble sigma, gint *sizes, gint count) {
+    if (sigma <= 0.0 || !sizes || count <= 0) {
+        return FALSE;
+    }
+    
+    // "Boxes for Gauss": pick count odd widths, m of them wl and the rest
+    // wl + 2, so the summed variance (w^2 - 1) / 12 matches sigma^2
+    gdouble ideal_width = sqrt(12.0 * sigma * sigma / count + 1.0);
+    gint lower = (gint)floor(ideal_width);
+    if (lower % 2 == 0) {
+        lower--;
+    }
+    gint upper = lower + 2;
+    
+    gdouble ideal_m = (12.0 * sigma * sigma - count * lower * lower - 4.0 * count * lower - 3.0 * count) /
+                      (-4.0 * lower - 4.0);
+    gint m = (gint)round(ideal_m);
+    
+    for (gint i = 0; i < count; i++) {
+        sizes[i] = i < m ? lower : upper;
+    }
+    
+    return TRUE;
+}
+
 gboolean blur_validate_intensity(gdouble intensity) {
     return (intensity >= 0.0 && intensity <= 10.0 && !isnan(intensity) && !isinf(intensity));
 }
@@ -145,9 +407,8 @@ gboolean blur_validate_pixbuf(GdkPixbuf *pixbuf) {
     gint channels = gdk_pixbuf_get_n_channels(pixbuf);
     gint bits_per_sample = gdk_pixbuf_get_bits_per_sample(pixbuf);
     
-    // Validate dimensions
-    if (width <= 0 || height <= 0 || 
-        width > MAX_IMAGE_DIMENSION || height > MAX_IMAGE_DIMENSION) {
+    // Any size works: images beyond the processor's arena are tiled
+    if (width <= 0 || height <= 0) {
         return FALSE;
     }
     
@@ -157,7 +418,7 @@ gboolean blur_validate_pixbuf(GdkPixbuf *pixbuf) {
     }
     
     // Ensure pixbuf has pixel data
-    const guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    const guchar *pixels = gdk_pixbuf_read_pixels(pixbuf);
     if (!pixels) {
         return FALSE;
     }
@@ -165,22 +426,382 @@ gboolean blur_validate_pixbuf(GdkPixbuf *pixbuf) {
     return TRUE;
 }
 
+gboolean blur_pixbuf_is_grayscale(GdkPixbuf *pixbuf) {
+    if (!blur_validate_pixbuf(pixbuf)) {
+        return FALSE;
+    }
+    
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    gint channels = gdk_pixbuf_get_n_channels(pixbuf);
+    gint rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    const guchar *pixels = gdk_pixbuf_read_pixels(pixbuf);
+    
+    for (gint y = 0; y < height; y++) {
+        const guchar *row = pixels + (gsize)y * rowstride;
+        for (gint x = 0; x < width; x++) {
+            const guchar *pixel = row + x * channels;
+            if (pixel[0] != pixel[1] || pixel[1] != pixel[2]) {
+                return FALSE;
+            }
+        }
+    }
+    
+    return TRUE;
+}
+
 /* Private helper functions */
 
+/* Whether a pixbuf is gray, kept on the pixbuf once known so slider ticks
+ * on the same source do not rescan it. Sources are never modified while
+ * the processor reads them, so the answer stays valid. */
+enum {
+    GRAYSCALE_UNKNOWN = 0,
+    GRAYSCALE_NO,
+    GRAYSCALE_YES
+};
+
+static GQuark grayscale_quark(void) {
+    return g_quark_from_static_string("blur-processor-grayscale");
+}
+
+static void mark_grayscale(GdkPixbuf *pixbuf, gboolean grayscale) {
+    g_object_set_qdata(G_OBJECT(pixbuf), grayscale_quark(),
+                       GINT_TO_POINTER(grayscale ? GRAYSCALE_YES : GRAYSCALE_NO));
+}
+
+static gboolean source_is_grayscale(GdkPixbuf *pixbuf) {
+    gint known = GPOINTER_TO_INT(g_object_get_qdata(G_OBJECT(pixbuf), grayscale_quark()));
+    
+    if (known == GRAYSCALE_UNKNOWN) {
+        gboolean grayscale = blur_pixbuf_is_grayscale(pixbuf);
+        mark_grayscale(pixbuf, grayscale);
+        return grayscale;
+    }
+    return known == GRAYSCALE_YES;
+}
+
 static gsize calculate_buffer_size(gint width, gint height) {
     // Calculate size for RGBA buffer with alignment padding
     return (gsize)width * height * 4 + 64; // Extra space for alignment
 }
 
+static gboolean blur_needs_tiles(BlurProcessor *processor, GdkPixbuf *pixbuf) {
+    return gdk_pixbuf_get_width(pixbuf) > processor->max_width ||
+           gdk_pixbuf_get_height(pixbuf) > processor->max_height;
+}
+
+// Same row alignment as gdk_pixbuf_new()
+static gint calculate_rowstride(gint width, gint channels) {
+    return (width * channels + 3) & ~3;
+}
+
+// The horizontal pass writes buffer1 in the result's layout; tiles add a
+// second buffer of the same size for the vertical pass
+static gsize calculate_scratch_size(BlurProcessor *processor, GdkPixbuf *pixbuf) {
+    if (blur_needs_tiles(processor, pixbuf)) {
+        gint region = BLUR_TILE_SIZE + 2 * BLUR_TILE_MAX_HALO;
+        return calculate_buffer_size(region, region);
+    }
+    
+    return (gsize)gdk_pixbuf_get_height(pixbuf) *
+           calculate_rowstride(gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_n_channels(pixbuf));
+}
+
+/* Result buffer pool */
+
+static BlurResultPool* result_pool_new(gsize max_free_bytes) {
+    BlurResultPool *pool = g_new0(BlurResultPool, 1);
+    pool->ref_count = 1;
+    g_mutex_init(&pool->mutex);
+    g_queue_init(&pool->free_buffers);
+    pool->max_free_bytes = max_free_bytes;
+    return pool;
+}
+
+static void pooled_buffer_free(BlurPooledBuffer *buffer) {
+    g_aligned_free(buffer->data);
+    g_free(buffer);
+}
+
+static void result_pool_unref(BlurResultPool *pool) {
+    if (!g_atomic_int_dec_and_test(&pool->ref_count)) {
+        return;
+    }
+    
+    g_queue_clear_full(&pool->free_buffers, (GDestroyNotify)pooled_buffer_free);
+    g_mutex_clear(&pool->mutex);
+    g_free(pool);
+}
+
+// Drops every idle buffer; later returns are freed instead of kept
+static void result_pool_close(BlurResultPool *pool) {
+    g_mutex_lock(&pool->mutex);
+    pool->closed = TRUE;
+    g_queue_clear_full(&pool->free_buffers, (GDestroyNotify)pooled_buffer_free);
+    pool->free_bytes = 0;
+    g_mutex_unlock(&pool->mutex);
+    
+    result_pool_unref(pool);
+}
+
+// GdkPixbufDestroyNotify of pooled results; runs on whichever thread
+// drops the last reference
+static void result_buffer_release(guchar *pixels, gpointer data) {
+    BlurPooledBuffer *buffer = data;
+    BlurResultPool *pool = buffer->pool;
+    
+    buffer->released_us = g_get_monotonic_time();
+    g_mutex_lock(&pool->mutex);
+    if (!pool->closed && buffer->size <= pool->max_free_bytes) {
+        // Make room by dropping the buffers idle for longest
+        while (pool->free_bytes + buffer->size > pool->max_free_bytes) {
+            BlurPooledBuffer *oldest = g_queue_pop_tail(&pool->free_buffers);
+            pool->free_bytes -= oldest->size;
+            pooled_buffer_free(oldest);
+        }
+        g_queue_push_head(&pool->free_buffers, buffer);
+        pool->free_bytes += buffer->size;
+        buffer = NULL;
+    }
+    g_mutex_unlock(&pool->mutex);
+    
+    if (buffer) {
+        pooled_buffer_free(buffer);
+    }
+    result_pool_unref(pool);
+}
+
+/* New result pixbuf over a pooled buffer, in the row layout of
+ * gdk_pixbuf_new(). Pixel contents are undefined. */
+static GdkPixbuf* result_pixbuf_new(BlurProcessor *processor, gboolean has_alpha,
+                                    gint width, gint height) {
+    BlurResultPool *pool = processor->result_pool;
+    gint rowstride = calculate_rowstride(width, has_alpha ? 4 : 3);
+    gsize size = (gsize)height * rowstride;
+    BlurPooledBuffer *buffer = NULL;
+    
+    g_mutex_lock(&pool->mutex);
+    for (GList *link = pool->free_buffers.head; link; link = link->next) {
+        BlurPooledBuffer *candidate = link->data;
+        if (candidate->size == size) {
+            g_queue_delete_link(&pool->free_buffers, link);
+            pool->free_bytes -= size;
+            pool->reused++;
+            buffer = candidate;
+            break;
+        }
+    }
+    g_mutex_unlock(&pool->mutex);
+    
+    if (!buffer) {
+        guchar *data = g_aligned_alloc(1, size, 64);
+        if (!data) {
+            return NULL;
+        }
+        buffer = g_new(BlurPooledBuffer, 1);
+        buffer->data = data;
+        buffer->size = size;
+    }
+    
+    g_atomic_int_inc(&pool->ref_count);
+    buffer->pool = pool;
+    
+    return gdk_pixbuf_new_from_data(buffer->data, GDK_COLORSPACE_RGB, has_alpha, 8,
+                                    width, height, rowstride,
+                                    result_buffer_release, buffer);
+}
+
+// Rounds @size up to its class: 1, 1.25, 1.5 or 1.75 times a power of two
+static gsize scratch_size_class(gsize size) {
+    if (size <= BLUR_SCRATCH_MIN_CLASS) {
+        return size ? BLUR_SCRATCH_MIN_CLASS : 0;
+    }
+    
+    gsize power = (gsize)1 << g_bit_nth_msf(size - 1, -1);
+    gsize step = power / 4;
+    return (size + step - 1) / step * step;
+}
+
+static void scratch_free(BlurScratch *scratch) {
+    if (scratch) {
+        g_aligned_free(scratch->buffer1);
+        g_aligned_free(scratch->buffer2);
+        g_free(scratch);
+    }
+}
+
+static gboolean reserve_buffer(guchar **buffer, gsize *current_size, gsize size) {
+    if (*current_size >= size) {
+        return TRUE;
+    }
+    
+    size = scratch_size_class(size);
+    g_aligned_free(*buffer);
+    *buffer = g_aligned_alloc(1, size, 64);
+    *current_size = *buffer ? size : 0;
+    return *buffer != NULL;
+}
+
+static gboolean scratch_reserve(BlurScratch *scratch, gsize size, gsize spare_size) {
+    return reserve_buffer(&scratch->buffer1, &scratch->size, size) &&
+           reserve_buffer(&scratch->buffer2, &scratch->spare_size, spare_size);
+}
+
+static gsize scratch_footprint(BlurScratch *scratch) {
+    return scratch->size + scratch->spare_size;
+}
+
+// Frees the pooled result buffers returned before @cutoff
+static void result_pool_trim(BlurResultPool *pool, gint64 cutoff) {
+    GSList *expired = NULL;
+    
+    g_mutex_lock(&pool->mutex);
+    BlurPooledBuffer *oldest;
+    while ((oldest = g_queue_peek_tail(&pool->free_buffers)) && oldest->released_us <= cutoff) {
+        g_queue_pop_tail(&pool->free_buffers);
+        pool->free_bytes -= oldest->size;
+        expired = g_slist_prepend(expired, oldest);
+    }
+    g_mutex_unlock(&pool->mutex);
+    
+    g_slist_free_full(expired, (GDestroyNotify)pooled_buffer_free);
+}
+
+// Unlinks the arenas idle for BLUR_SCRATCH_IDLE_SECONDS; the caller holds
+// scratch_mutex and frees them after dropping it
+static GSList* scratch_take_expired(BlurProcessor *processor, gint64 cutoff) {
+    GSList *expired = NULL;
+    GSList *l = processor->scratch_pool;
+    
+    while (l) {
+        GSList *next = l->next;
+        BlurScratch *scratch = l->data;
+        
+        if (scratch->released_us <= cutoff) {
+            processor->scratch_pool = g_slist_remove_link(processor->scratch_pool, l);
+            processor->scratch_bytes -= scratch_footprint(scratch);
+            expired = g_slist_concat(l, expired);
+        }
+        l = next;
+    }
+    
+    return expired;
+}
+
+static gint64 scratch_idle_cutoff(void) {
+    return g_get_monotonic_time() - BLUR_SCRATCH_IDLE_SECONDS * G_USEC_PER_SEC;
+}
+
+static BlurScratch* scratch_acquire(BlurProcessor *processor, gsize size, gsize spare_size) {
+    gint64 cutoff = scratch_idle_cutoff();
+    
+    g_mutex_lock(&processor->scratch_mutex);
+    GSList *expired = scratch_take_expired(processor, cutoff);
+    
+    // Smallest arena that fits, so large arenas go idle and get trimmed
+    // when the images shrink. Without one, the largest grows.
+    GSList *best = NULL;
+    for (GSList *l = processor->scratch_pool; l; l = l->next) {
+        BlurScratch *candidate = l->data;
+        gboolean fits = candidate->size >= size && candidate->spare_size >= spare_size;
+        
+        if (!best) {
+            best = l;
+            continue;
+        }
+        
+        BlurScratch *current = best->data;
+        gboolean current_fits = current->size >= size && current->spare_size >= spare_size;
+        if (fits ? (!current_fits || scratch_footprint(candidate) < scratch_footprint(current))
+                 : (!current_fits && scratch_footprint(candidate) > scratch_footprint(current))) {
+            best = l;
+        }
+    }
+    
+    BlurScratch *scratch = NULL;
+    if (best) {
+        scratch = best->data;
+        processor->scratch_pool = g_slist_delete_link(processor->scratch_pool, best);
+    }
+    processor->scratch_in_use++;
+    g_mutex_unlock(&processor->scratch_mutex);
+    
+    g_slist_free_full(expired, (GDestroyNotify)scratch_free);
+    result_pool_trim(processor->result_pool, cutoff);
+    
+    if (!scratch) {
+        scratch = g_malloc0(sizeof(BlurScratch));
+    }
+    
+    // Grow the arena if this image is larger than anything it served before
+    gsize before = scratch_footprint(scratch);
+    gboolean reserved = scratch_reserve(scratch, size, spare_size);
+    gsize after = scratch_footprint(scratch);
+    
+    g_mutex_lock(&processor->scratch_mutex);
+    processor->scratch_bytes = processor->scratch_bytes - before + after;
+    if (!reserved) {
+        processor->scratch_bytes -= after;
+        processor->scratch_in_use--;
+    }
+    g_mutex_unlock(&processor->scratch_mutex);
+    
+    if (!reserved) {
+        scratch_free(scratch);
+        return NULL;
+    }
+    
+    return scratch;
+}
+
+/* Result buffer pool: drops every idle buffer, returning the bytes freed */
+static gsize result_pool_drain(BlurResultPool *pool) {
+    g_mutex_lock(&pool->mutex);
+    gsize freed = pool->free_bytes;
+    g_queue_clear_full(&pool->free_buffers, (GDestroyNotify)pooled_buffer_free);
+    pool->free_bytes = 0;
+    g_mutex_unlock(&pool->mutex);
+    
+    return freed;
+}
+
+static void scratch_release(BlurProcessor *processor, BlurScratch *scratch) {
+    gint64 cutoff = scratch_idle_cutoff();
+    
+    scratch->released_us = g_get_monotonic_time();
+    
+    g_mutex_lock(&processor->scratch_mutex);
+    GSList *expired = scratch_take_expired(processor, cutoff);
+    processor->scratch_pool = g_slist_prepend(processor->scratch_pool, scratch);
+    processor->scratch_in_use--;
+    g_mutex_unlock(&processor->scratch_mutex);
+    
+    g_slist_free_full(expired, (GDestroyNotify)scratch_free);
+    result_pool_trim(processor->result_pool, cutoff);
+}
+
 static void work_item_free(BlurWorkItem *item) {
     if (item) {
         if (item->source_pixbuf) {
             g_object_unref(item->source_pixbuf);
         }
+        g_clear_object(&item->base_pixbuf);
+        g_clear_pointer(&item->context, g_main_context_unref);
         g_free(item);
     }
 }
 
+// Runs @func once in @context, the default one when NULL
+static void attach_idle(GMainContext *context, GSourceFunc func, gpointer data, GDestroyNotify notify) {
+    GSource *source = g_idle_source_new();
+    
+    g_source_set_priority(source, G_PRIORITY_DEFAULT);
+    g_source_set_callback(source, func, data, notify);
+    g_source_attach(source, context);
+    g_source_unref(source);
+}
+
 /* Core API Implementation */
 
 BlurProcessor* blur_processor_create(gint max_width, gint max_height, gint thread_count) {
@@ -190,7 +811,7 @@ BlurProcessor* blur_processor_create(gint max_width, gint max_height, gint threa
         return NULL;
     }
     
-    if (thread_count < 0) {
+    if (thread_count <= 0) {
         thread_count = g_get_num_processors();
     }
     if (thread_count < MIN_THREADS) thread_count = MIN_THREADS;
@@ -206,14 +827,17 @@ BlurProcessor* blur_processor_create(gint max_width, gint max_height, gint threa
     processor->thread_count = thread_count;
     processor->next_request_id = 1;
     processor->is_destroyed = FALSE;
+    processor->kernel_ops = blur_kernels_select(g_getenv("BLUR_PROCESSOR_SIMD"));
     
     // Initialize synchronization primitives
     g_mutex_init(&processor->processor_mutex);
+    g_mutex_init(&processor->scratch_mutex);
     
     // Create work queue
     processor->work_queue = g_async_queue_new_full((GDestroyNotify)work_item_free);
     if (!processor->work_queue) {
         g_mutex_clear(&processor->processor_mutex);
+        g_mutex_clear(&processor->scratch_mutex);
         g_free(processor);
         return NULL;
     }
@@ -224,24 +848,18 @@ BlurProcessor* blur_processor_create(gint max_width, gint max_height, gint threa
     if (!processor->active_requests) {
         g_async_queue_unref(processor->work_queue);
         g_mutex_clear(&processor->processor_mutex);
+        g_mutex_clear(&processor->scratch_mutex);
         g_free(processor);
         return NULL;
     }
     
-    // Pre-allocate processing buffers for maximum efficiency
-    processor->buffer_size = calculate_buffer_size(max_width, max_height);
-    processor->horizontal_buffer = g_aligned_alloc(1, processor->buffer_size, 64);
-    processor->vertical_buffer = g_aligned_alloc(1, processor->buffer_size, 64);
+    // Scratch arenas and worker threads wait for the first request, so
+    // creating a processor costs no image-sized allocation
     
-    if (!processor->horizontal_buffer || !processor->vertical_buffer) {
-        g_free(processor->horizontal_buffer);
-        g_free(processor->vertical_buffer);
-        g_hash_table_unref(processor->active_requests);
-        g_async_queue_unref(processor->work_queue);
-        g_mutex_clear(&processor->processor_mutex);
-        g_free(processor);
-        return NULL;
-    }
+    // Idle result buffers kept for reuse: two images of the maximum size
+    processor->result_pool = result_pool_new(2 * calculate_buffer_size(max_width, max_height));
+    
+    g_mutex_init(&processor->preview_mutex);
     
     return processor;
 }
@@ -255,12 +873,19 @@ void blur_processor_destroy(BlurProcessor *processor) {
     processor->is_destroyed = TRUE;
     g_mutex_unlock(&processor->processor_mutex);
     
-    // Stop thread pool and wait for completion
+    // Let the workers drain the queue: with is_destroyed set they drop
+    // each item unprocessed, waking up callers blocked on it
     if (processor->thread_pool) {
-        g_thread_pool_free(processor->thread_pool, TRUE, TRUE);
+        g_thread_pool_free(processor->thread_pool, FALSE, TRUE);
         processor->thread_pool = NULL;
     }
     
+    // Request workers are gone, so no band task can still be queued
+    if (processor->band_pool) {
+        g_thread_pool_free(processor->band_pool, FALSE, TRUE);
+        processor->band_pool = NULL;
+    }
+    
     // Clean up remaining work items
     BlurWorkItem *item;
     while ((item = g_async_queue_try_pop(processor->work_queue)) != NULL) {
@@ -268,162 +893,863 @@ void blur_processor_destroy(BlurProcessor *processor) {
     }
     
     // Free resources
-    g_aligned_free(processor->horizontal_buffer);
-    g_aligned_free(processor->vertical_buffer);
+    g_slist_free_full(processor->scratch_pool, (GDestroyNotify)scratch_free);
+    
+    // Results still referenced elsewhere keep the pool until they are freed
+    result_pool_close(processor->result_pool);
+    g_clear_object(&processor->preview_source);
+    g_clear_object(&processor->preview_pixbuf);
+    g_mutex_clear(&processor->preview_mutex);
     g_hash_table_unref(processor->active_requests);
     g_async_queue_unref(processor->work_queue);
     g_mutex_clear(&processor->processor_mutex);
+    g_mutex_clear(&processor->scratch_mutex);
     
     g_free(processor);
 }
 
-/* Placeholder implementations for remaining functions */
-/* These will be implemented in subsequent tasks */
+/* Box blur engine - running sums make the cost per pixel independent of
+ * sigma, unlike the kernel passes above whose cost grows with the radius */
+
+static inline gint mirror_coordinate(gint x, gint n) {
+    // Reflect with the edge repeated; folds any radius back into range,
+    // even on images narrower than the box
+    gint period = 2 * n;
+    x %= period;
+    if (x < 0) {
+        x += period;
+    }
+    return x < n ? x : period - 1 - x;
+}
+
+static inline guint32 box_scale(gint radius) {
+    // Q16 reciprocal of the window size replaces a divide per channel
+    gint window = 2 * radius + 1;
+    return (65536 + window / 2) / window;
+}
 
-/* Separable convolution implementation - T006 & T007 */
+static void box_blur_row(const guchar *src_row, guchar *dst_row,
+                        gint width, gint channels, gint radius) {
+    guint32 scale = box_scale(radius);
+    guint32 sums[4] = { 0, 0, 0, 0 };
+    
+    for (gint i = -radius; i <= radius; i++) {
+        const guchar *pixel = src_row + mirror_coordinate(i, width) * channels;
+        for (gint c = 0; c < channels; c++) {
+            sums[c] += pixel[c];
+        }
+    }
+    
+    for (gint x = 0; x < width; x++) {
+        gint enter_x = x + radius + 1;
+        gint leave_x = x - radius;
+        
+        // Only the first and last radius pixels need reflecting
+        if (leave_x < 0 || enter_x >= width) {
+            enter_x = mirror_coordinate(enter_x, width);
+            leave_x = mirror_coordinate(leave_x, width);
+        }
+        
+        const guchar *entering = src_row + enter_x * channels;
+        const guchar *leaving = src_row + leave_x * channels;
+        guchar *dst_pixel = dst_row + x * channels;
+        
+        for (gint c = 0; c < channels; c++) {
+            dst_pixel[c] = (guchar)((sums[c] * scale + 32768) >> 16);
+            sums[c] += entering[c] - leaving[c];
+        }
+    }
+}
 
-static void apply_horizontal_pass(const guchar *src_pixels, guchar *dst_pixels,
-                                gint width, gint height, gint rowstride, gint channels,
-                                const gfloat *kernel, gint kernel_size) {
-    gint half_kernel = kernel_size / 2;
+static void box_blur_columns(const guchar *src_pixels, guchar *dst_pixels,
+                            gint height, gint rowstride, gint channels, gint radius,
+                            gint x_start, gint x_end, guint32 *sums) {
+    guint32 scale = box_scale(radius);
+    gint offset = x_start * channels;
+    gint span = (x_end - x_start) * channels;
+    
+    // One accumulator per column keeps every read a sequential row walk
+    memset(sums, 0, sizeof(guint32) * span);
+    for (gint i = -radius; i <= radius; i++) {
+        const guchar *row = src_pixels + mirror_coordinate(i, height) * rowstride + offset;
+        for (gint j = 0; j < span; j++) {
+            sums[j] += row[j];
+        }
+    }
     
     for (gint y = 0; y < height; y++) {
-        const guchar *src_row = src_pixels + y * rowstride;
-        guchar *dst_row = dst_pixels + y * rowstride;
+        const guchar *entering = src_pixels + mirror_coordinate(y + radius + 1, height) * rowstride + offset;
+        const guchar *leaving = src_pixels + mirror_coordinate(y - radius, height) * rowstride + offset;
+        guchar *dst_row = dst_pixels + y * rowstride + offset;
         
-        for (gint x = 0; x < width; x++) {
-            gfloat sum_r = 0.0f, sum_g = 0.0f, sum_b = 0.0f, sum_a = 0.0f;
+        for (gint j = 0; j < span; j++) {
+            dst_row[j] = (guchar)((sums[j] * scale + 32768) >> 16);
+            sums[j] += entering[j] - leaving[j];
+        }
+    }
+}
+
+static void apply_horizontal_box_pass(const BlurPassJob *job, gint y_start, gint y_end) {
+    gsize row_bytes = (gsize)job->width * job->channels;
+    guchar *rows = g_malloc(row_bytes * 2);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = job->src_pixels + y * job->rowstride;
+        guchar *dst_row = job->dst_pixels + y * job->dst_rowstride;
+        
+        // All box passes run on one row while it is hot in L1
+        const guchar *input = src_row;
+        for (gint pass = 0; pass < BOX_PASS_COUNT; pass++) {
+            guchar *output = (pass == BOX_PASS_COUNT - 1) ? dst_row : rows + (pass % 2) * row_bytes;
+            box_blur_row(input, output, job->width, job->channels, job->box_radii[pass]);
+            input = output;
+        }
+    }
+    
+    g_free(rows);
+}
+
+static void apply_vertical_box_pass(const BlurPassJob *job, gint x_start, gint x_end) {
+    guint32 *sums = g_malloc(sizeof(guint32) * (x_end - x_start) * job->channels);
+    
+    // Ping-pong spare -> dst -> spare -> dst; BOX_PASS_COUNT is odd so the
+    // last pass lands in dst
+    for (gint pass = 0; pass < BOX_PASS_COUNT; pass++) {
+        const guchar *input = (pass % 2 == 0) ? job->spare_pixels : job->dst_pixels;
+        guchar *output = (pass % 2 == 0) ? job->dst_pixels : job->spare_pixels;
+        box_blur_columns(input, output, job->height, job->rowstride, job->channels,
+                        job->box_radii[pass], x_start, x_end, sums);
+    }
+    
+    g_free(sums);
+}
+
+G_STATIC_ASSERT(BOX_PASS_COUNT % 2 == 1);
+
+/* Band-parallel pass execution - rows for the horizontal pass, column
+ * tiles for the vertical one so every band writes a disjoint region */
+
+/* Single-plane layout - gray content is blurred as one luminance plane,
+ * plus alpha for RGBA, instead of three equal colour channels. The
+ * 4-channel kernels do the work on two arrangements of the planes:
+ *
+ * - Packed: each 4-byte pixel holds one column of a group of four rows
+ *   (two rows of luminance and alpha), so a horizontal pass over four
+ *   channels blurs the whole group at once with the usual edge mirroring.
+ * - Unpacked: one row per image row with the planes interleaved, padded
+ *   to whole 4-byte pixels. The vertical pass weighs every byte on its
+ *   own, so it runs on these rows as if they were RGBA.
+ *
+ * Every lane gets exactly the arithmetic of one colour channel, so the
+ * result matches the colour blur of the gray image byte for byte. */
+
+static gint plane_count(gint channels) {
+    return channels == 4 ? 2 : 1;
+}
+
+// Image rows per packed row
+static gint plane_group_rows(gint channels) {
+    return 4 / plane_count(channels);
+}
+
+static gint plane_unpacked_rowstride(gint width, gint channels) {
+    return calculate_rowstride(width * plane_count(channels), 1);
+}
+
+// Both buffers of a single-plane blur hold either layout of the planes
+static gsize calculate_plane_scratch_size(GdkPixbuf *pixbuf) {
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    gint channels = gdk_pixbuf_get_n_channels(pixbuf);
+    gint groups = (height + plane_group_rows(channels) - 1) / plane_group_rows(channels);
+    gsize packed_size = (gsize)groups * width * 4;
+    gsize unpacked_size = (gsize)height * plane_unpacked_rowstride(width, channels);
+    
+    return MAX(packed_size, unpacked_size);
+}
+
+static void pack_plane_groups(const BlurPassJob *job, gint group_start, gint group_end) {
+    gint planes = plane_count(job->channels);
+    gint group_rows = plane_group_rows(job->channels);
+    guchar *gray_row = g_malloc((gsize)job->width * job->channels);
+    
+    for (gint group = group_start; group < group_end; group++) {
+        guchar *dst_row = job->dst_pixels + (gsize)group * job->dst_rowstride;
+        
+        for (gint r = 0; r < group_rows; r++) {
+            gint y = group * group_rows + r;
+            guchar *lanes = dst_row + r * planes;
             
-            for (gint k = 0; k < kernel_size; k++) {
-                gint sample_x = x + k - half_kernel;
-                
-                // Mirror edge handling for boundary pixels
-                if (sample_x < 0) {
-                    sample_x = -sample_x;
-                } else if (sample_x >= width) {
-                    sample_x = 2 * width - sample_x - 1;
-                }
-                
-                const guchar *sample_pixel = src_row + sample_x * channels;
-                gfloat weight = kernel[k];
-                
-                sum_r += sample_pixel[0] * weight;
-                sum_g += sample_pixel[1] * weight;
-                sum_b += sample_pixel[2] * weight;
-                if (channels == 4) {
-                    sum_a += sample_pixel[3] * weight;
+            // Rows past the end of the image pad the last group with zeros
+            if (y >= job->plane_rows) {
+                for (gint x = 0; x < job->width; x++) {
+                    memset(lanes + x * 4, 0, planes);
                 }
+                continue;
             }
             
-            // Clamp values to [0, 255] and store
-            guchar *dst_pixel = dst_row + x * channels;
-            dst_pixel[0] = (guchar)CLAMP(sum_r + 0.5f, 0, 255);
-            dst_pixel[1] = (guchar)CLAMP(sum_g + 0.5f, 0, 255);
-            dst_pixel[2] = (guchar)CLAMP(sum_b + 0.5f, 0, 255);
-            if (channels == 4) {
-                dst_pixel[3] = (guchar)CLAMP(sum_a + 0.5f, 0, 255);
+            // The luminance of a gray pixel is its red value (the weights
+            // sum to one exactly), so gray and colour sources share this
+            job->kernel_ops->grayscale_rows(job->src_pixels + (gsize)y * job->rowstride, 0,
+                                            gray_row, 0, job->width, job->channels, 0, 1);
+            for (gint x = 0; x < job->width; x++) {
+                lanes[x * 4] = gray_row[x * job->channels];
+                if (planes == 2) {
+                    lanes[x * 4 + 1] = gray_row[x * 4 + 3];
+                }
             }
         }
     }
+    
+    g_free(gray_row);
 }
 
-static void apply_vertical_pass(const guchar *src_pixels, guchar *dst_pixels,
-                              gint width, gint height, gint rowstride, gint channels,
-                              const gfloat *kernel, gint kernel_size) {
-    gint half_kernel = kernel_size / 2;
+static void unpack_plane_groups(const BlurPassJob *job, gint group_start, gint group_end) {
+    gint planes = plane_count(job->channels);
+    gint group_rows = plane_group_rows(job->channels);
+    gsize row_bytes = (gsize)job->width * planes;
     
-    for (gint y = 0; y < height; y++) {
-        guchar *dst_row = dst_pixels + y * rowstride;
+    for (gint group = group_start; group < group_end; group++) {
+        const guchar *src_row = job->src_pixels + (gsize)group * job->rowstride;
         
-        for (gint x = 0; x < width; x++) {
-            gfloat sum_r = 0.0f, sum_g = 0.0f, sum_b = 0.0f, sum_a = 0.0f;
+        for (gint r = 0; r < group_rows; r++) {
+            gint y = group * group_rows + r;
+            if (y >= job->plane_rows) {
+                break;
+            }
             
-            for (gint k = 0; k < kernel_size; k++) {
-                gint sample_y = y + k - half_kernel;
-                
-                // Mirror edge handling for boundary pixels
-                if (sample_y < 0) {
-                    sample_y = -sample_y;
-                } else if (sample_y >= height) {
-                    sample_y = 2 * height - sample_y - 1;
-                }
-                
-                const guchar *sample_row = src_pixels + sample_y * rowstride;
-                const guchar *sample_pixel = sample_row + x * channels;
-                gfloat weight = kernel[k];
-                
-                sum_r += sample_pixel[0] * weight;
-                sum_g += sample_pixel[1] * weight;
-                sum_b += sample_pixel[2] * weight;
-                if (channels == 4) {
-                    sum_a += sample_pixel[3] * weight;
+            const guchar *lanes = src_row + r * planes;
+            guchar *dst_row = job->dst_pixels + (gsize)y * job->dst_rowstride;
+            for (gint x = 0; x < job->width; x++) {
+                for (gint p = 0; p < planes; p++) {
+                    dst_row[x * planes + p] = lanes[x * 4 + p];
                 }
             }
             
-            // Clamp values to [0, 255] and store
-            guchar *dst_pixel = dst_row + x * channels;
-            dst_pixel[0] = (guchar)CLAMP(sum_r + 0.5f, 0, 255);
-            dst_pixel[1] = (guchar)CLAMP(sum_g + 0.5f, 0, 255);
-            dst_pixel[2] = (guchar)CLAMP(sum_b + 0.5f, 0, 255);
-            if (channels == 4) {
-                dst_pixel[3] = (guchar)CLAMP(sum_a + 0.5f, 0, 255);
-            }
+            // The vertical pass blurs the padding too; keep it defined
+            memset(dst_row + row_bytes, 0, job->dst_rowstride - row_bytes);
         }
     }
 }
 
-static GdkPixbuf* apply_separable_gaussian_blur(GdkPixbuf *source_pixbuf, 
-                                              gdouble sigma, 
-                                              gboolean is_progressive,
-                                              guchar *temp_buffer1,
-                                              guchar *temp_buffer2) {
-    if (!source_pixbuf || sigma <= 0.0) {
-        return g_object_ref(source_pixbuf);
-    }
+static void expand_plane_rows(const BlurPassJob *job, gint y_start, gint y_end) {
+    gint planes = plane_count(job->channels);
+    
+    for (gint y = y_start; y < y_end; y++) {
+        const guchar *src_row = job->src_pixels + (gsize)y * job->rowstride;
+        guchar *dst_row = job->dst_pixels + (gsize)y * job->dst_rowstride;
+        
+        for (gint x = 0; x < job->width; x++) {
+            const guchar *sample = src_row + x * planes;
+            guchar *pixel = dst_row + x * job->channels;
+            
+            pixel[0] = sample[0];
+            pixel[1] = sample[0];
+            pixel[2] = sample[0];
+            if (planes == 2) {
+                pixel[3] = sample[1];
+            }
+        }
+    }
+}
+
+static void run_horizontal_kernel(const BlurPassJob *job,
+                                  const guchar *src_pixels, guchar *dst_pixels,
+                                  gint rowstride, gint start, gint end) {
+    if (job->kernel_fixed) {
+        job->kernel_ops->horizontal_pass_fixed(src_pixels, dst_pixels,
+                               job->width, rowstride, job->channels,
+                               job->kernel_fixed, job->kernel_size,
+                               start, end);
+    } else {
+        job->kernel_ops->horizontal_pass(src_pixels, dst_pixels,
+                             job->width, rowstride, job->channels,
+                             job->kernel, job->kernel_size,
+                             start, end);
+    }
+}
+
+static void run_pass_span(BlurPassJob *job, gint start, gint end) {
+    if (job->step == BLUR_PASS_GRAYSCALE) {
+        job->kernel_ops->grayscale_rows(job->src_pixels, job->rowstride,
+                                        job->dst_pixels, job->dst_rowstride,
+                                        job->width, job->channels,
+                                        start, end);
+    } else if (job->step == BLUR_PASS_PACK_PLANES) {
+        pack_plane_groups(job, start, end);
+    } else if (job->step == BLUR_PASS_UNPACK_PLANES) {
+        unpack_plane_groups(job, start, end);
+    } else if (job->step == BLUR_PASS_EXPAND_PLANES) {
+        expand_plane_rows(job, start, end);
+    } else if (job->is_vertical) {
+        if (job->box_radii) {
+            apply_vertical_box_pass(job, start, end);
+        } else if (job->kernel_fixed) {
+            job->kernel_ops->vertical_pass_fixed(job->src_pixels, job->dst_pixels,
+                                 job->height, job->rowstride, job->channels,
+                                 job->kernel_fixed, job->kernel_size,
+                                 start, end);
+        } else {
+            job->kernel_ops->vertical_pass(job->src_pixels, job->dst_pixels,
+                               job->height, job->rowstride, job->channels,
+                               job->kernel, job->kernel_size,
+                               start, end);
+        }
+    } else if (job->box_radii) {
+        apply_horizontal_box_pass(job, start, end);
+    } else if (job->rowstride == job->dst_rowstride) {
+        run_horizontal_kernel(job, job->src_pixels, job->dst_pixels, job->rowstride, start, end);
+    } else {
+        // The kernels take one rowstride, so differing layouts go row by row
+        for (gint y = start; y < end; y++) {
+            run_horizontal_kernel(job,
+                                  job->src_pixels + (gsize)y * job->rowstride,
+                                  job->dst_pixels + (gsize)y * job->dst_rowstride,
+                                  0, 0, 1);
+        }
+    }
+}
+
+static gboolean pass_job_cancelled(const BlurPassJob *job) {
+    return job->cancel_flag && g_atomic_int_get(job->cancel_flag);
+}
+
+static void run_pass_band(BlurPassJob *job, gint index) {
+    gint extent = job->is_vertical ? job->width : job->height;
+    gint start = (gint)((gint64)extent * index / job->band_count);
+    gint end = (gint)((gint64)extent * (index + 1) / job->band_count);
+    gint step = job->is_vertical ? CANCEL_CHECK_COLUMNS : CANCEL_CHECK_ROWS;
+    
+    // Work through the band in chunks so a cancelled request stops
+    // within one chunk instead of finishing the whole pass
+    for (gint chunk = start; chunk < end; chunk += step) {
+        if (pass_job_cancelled(job)) {
+            return;
+        }
+        run_pass_span(job, chunk, MIN(chunk + step, end));
+    }
+}
+
+static void blur_band_thread_func(gpointer data, gpointer user_data) {
+    BlurBandTask *task = (BlurBandTask*)data;
+    BlurPassJob *job = task->job;
+    
+    run_pass_band(job, task->index);
+    
+    g_mutex_lock(&job->mutex);
+    if (--job->pending == 0) {
+        g_cond_signal(&job->cond);
+    }
+    g_mutex_unlock(&job->mutex);
+}
+
+static gint calculate_band_count(BlurProcessor *processor, gint extent, gint min_extent) {
+    gint band_count = extent / min_extent;
+    
+    if (band_count > processor->thread_count) band_count = processor->thread_count;
+    if (band_count < 1) band_count = 1;
+    
+    // Without a band pool everything runs on the calling worker
+    if (!processor->band_pool) band_count = 1;
+    
+    return band_count;
+}
+
+static void run_pass_bands(BlurProcessor *processor, BlurPassJob *job) {
+    gint extent = job->is_vertical ? job->width : job->height;
+    gint min_extent = job->is_vertical ? MIN_TILE_COLUMNS : MIN_BAND_ROWS;
+    job->band_count = calculate_band_count(processor, extent, min_extent);
+    
+    if (job->band_count == 1) {
+        run_pass_band(job, 0);
+        return;
+    }
+    
+    BlurBandTask tasks[MAX_THREADS];
+    
+    g_mutex_init(&job->mutex);
+    g_cond_init(&job->cond);
+    job->pending = job->band_count - 1;
+    
+    for (gint i = 1; i < job->band_count; i++) {
+        tasks[i].job = job;
+        tasks[i].index = i;
+        
+        if (!g_thread_pool_push(processor->band_pool, &tasks[i], NULL)) {
+            // Pool refused the task: do the band here instead
+            run_pass_band(job, i);
+            g_mutex_lock(&job->mutex);
+            job->pending--;
+            g_mutex_unlock(&job->mutex);
+        }
+    }
+    
+    // The submitting worker takes the first band rather than idling
+    run_pass_band(job, 0);
+    
+    g_mutex_lock(&job->mutex);
+    while (job->pending > 0) {
+        g_cond_wait(&job->cond, &job->mutex);
+    }
+    g_mutex_unlock(&job->mutex);
+    
+    g_cond_clear(&job->cond);
+    g_mutex_clear(&job->mutex);
+}
+
+static const gchar* pass_step_name(const BlurPassJob *job) {
+    switch (job->step) {
+    case BLUR_PASS_GRAYSCALE:
+        return "grayscale";
+    case BLUR_PASS_PACK_PLANES:
+        return "pack-planes";
+    case BLUR_PASS_UNPACK_PLANES:
+        return "unpack-planes";
+    case BLUR_PASS_EXPAND_PLANES:
+        return "expand-planes";
+    case BLUR_PASS_CONVOLVE:
+    default:
+        return job->is_vertical ? "vertical" : "horizontal";
+    }
+}
+
+static void run_pass(BlurProcessor *processor, BlurPassJob *job) {
+    gint64 start = g_get_monotonic_time();
+    
+    run_pass_bands(processor, job);
+    
+    gint64 end = g_get_monotonic_time();
+    if (job->pass_time_us) {
+        job->pass_time_us[job->is_vertical ? 1 : 0] += end - start;
+    }
+    blur_trace_mark(start, end, pass_step_name(job), "%dx%d, %d bands",
+                    job->width, job->height, job->band_count);
+}
+
+/* Progressive previews - the blur runs on a box-filtered downsample with
+ * a proportionally smaller sigma and the caller scales the result up */
+
+static GdkPixbuf* downsample_pixbuf(GdkPixbuf *source, gint factor) {
+    gint width = gdk_pixbuf_get_width(source);
+    gint height = gdk_pixbuf_get_height(source);
+    gint channels = gdk_pixbuf_get_n_channels(source);
+    gint rowstride = gdk_pixbuf_get_rowstride(source);
+    const guchar *src_pixels = gdk_pixbuf_read_pixels(source);
+    gint out_width = (width + factor - 1) / factor;
+    gint out_height = (height + factor - 1) / factor;
+    
+    GdkPixbuf *result = gdk_pixbuf_new(GDK_COLORSPACE_RGB, channels == 4, 8, out_width, out_height);
+    if (!result) {
+        return NULL;
+    }
+    
+    guchar *dst_pixels = gdk_pixbuf_get_pixels(result);
+    gint dst_rowstride = gdk_pixbuf_get_rowstride(result);
+    gint row_span = out_width * channels;
+    guint32 *sums = g_malloc(sizeof(guint32) * row_span);
+    
+    for (gint oy = 0; oy < out_height; oy++) {
+        gint y_start = oy * factor;
+        gint y_end = MIN(y_start + factor, height);
+        
+        memset(sums, 0, sizeof(guint32) * row_span);
+        
+        // Sum each block row by row so source reads stay sequential
+        for (gint y = y_start; y < y_end; y++) {
+            const guchar *src_pixel = src_pixels + (gsize)y * rowstride;
+            for (gint ox = 0; ox < out_width; ox++) {
+                guint32 *sum = sums + ox * channels;
+                gint block_width = MIN(factor, width - ox * factor);
+                for (gint x = 0; x < block_width; x++, src_pixel += channels) {
+                    for (gint c = 0; c < channels; c++) {
+                        sum[c] += src_pixel[c];
+                    }
+                }
+            }
+        }
+        
+        // Edge blocks may be partial, so divide by the real sample count
+        guchar *dst_row = dst_pixels + (gsize)oy * dst_rowstride;
+        gint block_rows = y_end - y_start;
+        for (gint ox = 0; ox < out_width; ox++) {
+            guint32 count = (guint32)(MIN(ox * factor + factor, width) - ox * factor) * block_rows;
+            for (gint c = 0; c < channels; c++) {
+                dst_row[ox * channels + c] = (guchar)((sums[ox * channels + c] + count / 2) / count);
+            }
+        }
+    }
+    
+    g_free(sums);
+    return result;
+}
+
+/* Returns a new reference to the downsampled @source, building it only
+ * when the source differs from the previous progressive request */
+static GdkPixbuf* acquire_preview_source(BlurProcessor *processor, GdkPixbuf *source, gint factor) {
+    if (factor <= 1) {
+        return g_object_ref(source);
+    }
+    
+    g_mutex_lock(&processor->preview_mutex);
+    if (processor->preview_source == source && processor->preview_pixbuf) {
+        GdkPixbuf *cached = g_object_ref(processor->preview_pixbuf);
+        g_mutex_unlock(&processor->preview_mutex);
+        return cached;
+    }
+    g_mutex_unlock(&processor->preview_mutex);
+    
+    GdkPixbuf *preview = downsample_pixbuf(source, factor);
+    if (!preview) {
+        return NULL;
+    }
+    
+    // Holding a ref to the source keeps its address from being reused by
+    // a different image while it serves as the cache key
+    g_mutex_lock(&processor->preview_mutex);
+    g_set_object(&processor->preview_source, source);
+    g_set_object(&processor->preview_pixbuf, preview);
+    g_mutex_unlock(&processor->preview_mutex);
+    
+    return preview;
+}
+
+/* Tiled engine - the horizontal pass reads each tile and its halo straight
+ * from the source into the scratch arena, the vertical pass finishes it
+ * there, and only its core is written back. Halo pixels are clamped at
+ * the image border, where the passes mirror exactly as they would on the
+ * whole image; at interior tile edges the mirrored data only reaches the
+ * halo, never the core. With @convert the tile and its halo are first
+ * converted to gray in buffer1, so no gray copy of the image is made. */
+
+static gboolean run_tiled_passes(BlurProcessor *processor,
+                                 const BlurPassJob *template,
+                                 gint halo,
+                                 gboolean convert,
+                                 const guchar *src_pixels, gint src_rowstride,
+                                 guchar *dst_pixels, gint dst_rowstride,
+                                 guchar *tile_buffer1, guchar *tile_buffer2) {
+    gint width = template->width;
+    gint height = template->height;
+    gint channels = template->channels;
+    
+    for (gint tile_y = 0; tile_y < height; tile_y += BLUR_TILE_SIZE) {
+        for (gint tile_x = 0; tile_x < width; tile_x += BLUR_TILE_SIZE) {
+            gint core_width = MIN(BLUR_TILE_SIZE, width - tile_x);
+            gint core_height = MIN(BLUR_TILE_SIZE, height - tile_y);
+            gint x0 = MAX(tile_x - halo, 0);
+            gint y0 = MAX(tile_y - halo, 0);
+            gint x1 = MIN(tile_x + core_width + halo, width);
+            gint y1 = MIN(tile_y + core_height + halo, height);
+            gint region_width = x1 - x0;
+            gint region_height = y1 - y0;
+            gint region_rowstride = calculate_rowstride(region_width, channels);
+            
+            BlurPassJob job = *template;
+            job.width = region_width;
+            job.height = region_height;
+            job.src_pixels = src_pixels + (gsize)y0 * src_rowstride + (gsize)x0 * channels;
+            job.rowstride = src_rowstride;
+            
+            // Grayscale: source region -> buffer1, then read from there
+            if (convert) {
+                BlurPassJob gray = job;
+                gray.step = BLUR_PASS_GRAYSCALE;
+                gray.dst_pixels = tile_buffer1;
+                gray.dst_rowstride = region_rowstride;
+                gray.is_vertical = FALSE;
+                run_pass(processor, &gray);
+                if (pass_job_cancelled(&gray)) {
+                    return FALSE;
+                }
+                job.src_pixels = tile_buffer1;
+                job.rowstride = region_rowstride;
+            }
+            
+            // Horizontal: source region -> buffer2; vertical: buffer2 ->
+            // buffer1, with buffer2 doubling as the box ping-pong spare
+            job.dst_pixels = tile_buffer2;
+            job.dst_rowstride = region_rowstride;
+            job.is_vertical = FALSE;
+            run_pass(processor, &job);
+            if (pass_job_cancelled(&job)) {
+                return FALSE;
+            }
+            
+            job.src_pixels = tile_buffer2;
+            job.dst_pixels = tile_buffer1;
+            job.spare_pixels = tile_buffer2;
+            job.rowstride = region_rowstride;
+            job.is_vertical = TRUE;
+            run_pass(processor, &job);
+            if (pass_job_cancelled(&job)) {
+                return FALSE;
+            }
+            
+            for (gint y = 0; y < core_height; y++) {
+                memcpy(dst_pixels + (gsize)(tile_y + y) * dst_rowstride + (gsize)tile_x * channels,
+                       tile_buffer1 + (gsize)(tile_y - y0 + y) * region_rowstride +
+                           (gsize)(tile_x - x0) * channels,
+                       (gsize)core_width * channels);
+            }
+        }
+    }
+    
+    return TRUE;
+}
+
+/* Single-plane engine - luminance (plus alpha) is packed into buffer1,
+ * blurred along x into buffer2, unpacked back into buffer1, blurred along
+ * y into buffer2 and expanded into the result. See the layout notes above
+ * pack_plane_groups(). */
+
+static gboolean run_plane_passes(BlurProcessor *processor,
+                                 const BlurPassJob *template,
+                                 const guchar *src_pixels, gint src_rowstride,
+                                 guchar *dst_pixels, gint dst_rowstride,
+                                 guchar *plane_buffer1, guchar *plane_buffer2) {
+    gint width = template->width;
+    gint height = template->height;
+    gint channels = template->channels;
+    gint group_rows = plane_group_rows(channels);
+    gint packed_rowstride = width * 4;
+    gint unpacked_rowstride = plane_unpacked_rowstride(width, channels);
+    
+    BlurPassJob job = *template;
+    job.plane_rows = height;
+    job.height = (height + group_rows - 1) / group_rows;
+    job.is_vertical = FALSE;
+    
+    job.step = BLUR_PASS_PACK_PLANES;
+    job.src_pixels = src_pixels;
+    job.dst_pixels = plane_buffer1;
+    job.rowstride = src_rowstride;
+    job.dst_rowstride = packed_rowstride;
+    run_pass(processor, &job);
+    if (pass_job_cancelled(&job)) {
+        return FALSE;
+    }
+    
+    job.step = BLUR_PASS_CONVOLVE;
+    job.channels = 4;
+    job.src_pixels = plane_buffer1;
+    job.dst_pixels = plane_buffer2;
+    job.rowstride = packed_rowstride;
+    run_pass(processor, &job);
+    if (pass_job_cancelled(&job)) {
+        return FALSE;
+    }
+    
+    job.step = BLUR_PASS_UNPACK_PLANES;
+    job.channels = channels;
+    job.src_pixels = plane_buffer2;
+    job.dst_pixels = plane_buffer1;
+    job.dst_rowstride = unpacked_rowstride;
+    run_pass(processor, &job);
+    if (pass_job_cancelled(&job)) {
+        return FALSE;
+    }
+    
+    // Padded rows as RGBA pixels, with buffer1 as the box ping-pong spare
+    job.step = BLUR_PASS_CONVOLVE;
+    job.channels = 4;
+    job.width = unpacked_rowstride / 4;
+    job.height = height;
+    job.src_pixels = plane_buffer1;
+    job.dst_pixels = plane_buffer2;
+    job.spare_pixels = plane_buffer1;
+    job.rowstride = unpacked_rowstride;
+    job.is_vertical = TRUE;
+    run_pass(processor, &job);
+    if (pass_job_cancelled(&job)) {
+        return FALSE;
+    }
+    
+    job.step = BLUR_PASS_EXPAND_PLANES;
+    job.channels = channels;
+    job.width = width;
+    job.src_pixels = plane_buffer2;
+    job.dst_pixels = dst_pixels;
+    job.dst_rowstride = dst_rowstride;
+    job.is_vertical = FALSE;
+    run_pass(processor, &job);
+    
+    return !pass_job_cancelled(&job);
+}
+
+static GdkPixbuf* apply_separable_gaussian_blur(BlurProcessor *processor,
+                                              GdkPixbuf *source_pixbuf, 
+                                              gdouble sigma, 
+                                              gboolean use_fixed_point,
+                                              gboolean single_channel,
+                                              gboolean convert_tiles,
+                                              const gint *cancel_flag,
+                                              gint64 *pass_time_us,
+                                              guchar *temp_buffer1,
+                                              guchar *temp_buffer2) {
+    // Failures fall back to the unblurred source, which is no result at
+    // all when the tiles were also to be converted
+    GdkPixbuf *fallback = convert_tiles ? NULL : source_pixbuf;
+    
+    if (!source_pixbuf || sigma <= 0.0) {
+        return fallback ? g_object_ref(fallback) : NULL;
+    }
     
     gint width = gdk_pixbuf_get_width(source_pixbuf);
     gint height = gdk_pixbuf_get_height(source_pixbuf);
     gint channels = gdk_pixbuf_get_n_channels(source_pixbuf);
     gint rowstride = gdk_pixbuf_get_rowstride(source_pixbuf);
-    const guchar *src_pixels = gdk_pixbuf_get_pixels(source_pixbuf);
-    
-    // Adjust sigma for progressive quality
-    gdouble effective_sigma = is_progressive ? sigma * 0.5 : sigma;
+    const guchar *src_pixels = gdk_pixbuf_read_pixels(source_pixbuf);
+    
+    gdouble effective_sigma = sigma;
+    
+    // Large sigmas use stacked box blurs whose cost does not grow with
+    // the radius; small ones keep the exact Gaussian kernel
+    gint box_sizes[BOX_PASS_COUNT];
+    gint box_radii[BOX_PASS_COUNT];
+    gboolean use_box = effective_sigma >= BLUR_BOX_SIGMA_THRESHOLD &&
+                       blur_calculate_box_sizes(effective_sigma, box_sizes, BOX_PASS_COUNT);
+    
+    gint kernel_size = 0;
+    gfloat *kernel = NULL;
+    gint16 *kernel_fixed = NULL;
+    gint halo = 0;
+    if (use_box) {
+        for (gint i = 0; i < BOX_PASS_COUNT; i++) {
+            box_radii[i] = box_sizes[i] / 2;
+            halo += box_radii[i];
+        }
+    } else {
+        // Generate Gaussian kernel; progressive previews trade the float
+        // path's exactness for the integer one (within 2 levels per channel)
+        kernel_size = blur_calculate_kernel_size(effective_sigma);
+        if (use_fixed_point) {
+            kernel_fixed = blur_generate_kernel_fixed(effective_sigma, kernel_size);
+        } else {
+            kernel = blur_generate_kernel(effective_sigma, kernel_size);
+        }
+        if (!kernel && !kernel_fixed) {
+            return fallback ? g_object_ref(fallback) : NULL;
+        }
+        halo = kernel_size / 2;
+    }
     
-    // Generate Gaussian kernel
-    gint kernel_size = blur_calculate_kernel_size(effective_sigma);
-    gfloat *kernel = blur_generate_kernel(effective_sigma, kernel_size);
-    if (!kernel) {
-        return g_object_ref(source_pixbuf);
+    gboolean use_tiles = blur_needs_tiles(processor, source_pixbuf);
+    if (use_tiles && halo > BLUR_TILE_MAX_HALO) {
+        g_free(kernel);
+        g_free(kernel_fixed);
+        return NULL;
     }
     
-    // Create result pixbuf
-    GdkPixbuf *result = gdk_pixbuf_new(GDK_COLORSPACE_RGB, 
-                                      channels == 4,
-                                      8, width, height);
+    // Result pixels come from the recycled pool
+    GdkPixbuf *result = result_pixbuf_new(processor, channels == 4, width, height);
     if (!result) {
         g_free(kernel);
-        return g_object_ref(source_pixbuf);
+        g_free(kernel_fixed);
+        return fallback ? g_object_ref(fallback) : NULL;
     }
     
     guchar *result_pixels = gdk_pixbuf_get_pixels(result);
     gint result_rowstride = gdk_pixbuf_get_rowstride(result);
     
-    // Copy source to temp buffer1 for processing
-    gsize image_size = height * rowstride;
-    memcpy(temp_buffer1, src_pixels, image_size);
+    BlurPassJob job = {
+        .width = width,
+        .height = height,
+        .channels = channels,
+        .kernel_ops = processor->kernel_ops,
+        .kernel = kernel,
+        .kernel_fixed = kernel_fixed,
+        .kernel_size = kernel_size,
+        .box_radii = use_box ? box_radii : NULL,
+        .cancel_flag = cancel_flag,
+        .pass_time_us = pass_time_us,
+    };
+    
+    if (use_tiles || single_channel) {
+        gboolean completed = use_tiles
+            ? run_tiled_passes(processor, &job, halo, convert_tiles,
+                               src_pixels, rowstride,
+                               result_pixels, result_rowstride,
+                               temp_buffer1, temp_buffer2)
+            : run_plane_passes(processor, &job,
+                               src_pixels, rowstride,
+                               result_pixels, result_rowstride,
+                               temp_buffer1, temp_buffer2);
+        g_free(kernel);
+        g_free(kernel_fixed);
+        if (!completed) {
+            g_object_unref(result);
+            return NULL;
+        }
+        return result;
+    }
     
-    // Apply horizontal pass: temp_buffer1 -> temp_buffer2
-    apply_horizontal_pass(temp_buffer1, temp_buffer2, 
-                         width, height, rowstride, channels, 
-                         kernel, kernel_size);
+    // Apply horizontal pass in row bands straight from the source:
+    // source -> temp_buffer1, which takes the result's row layout
+    job.src_pixels = src_pixels;
+    job.dst_pixels = temp_buffer1;
+    job.rowstride = rowstride;
+    job.dst_rowstride = result_rowstride;
+    job.is_vertical = FALSE;
+    run_pass(processor, &job);
+    
+    if (pass_job_cancelled(&job)) {
+        g_object_unref(result);
+        g_free(kernel);
+        g_free(kernel_fixed);
+        return NULL;
+    }
     
-    // Apply vertical pass: temp_buffer2 -> result
-    apply_vertical_pass(temp_buffer2, result_pixels,
-                       width, height, result_rowstride, channels,
-                       kernel, kernel_size);
+    // Apply vertical pass in column tiles: temp_buffer1 -> result.
+    // run_pass() only returns once every horizontal band is written.
+    job.src_pixels = temp_buffer1;
+    job.dst_pixels = result_pixels;
+    job.spare_pixels = temp_buffer1;
+    job.rowstride = result_rowstride;
+    job.is_vertical = TRUE;
+    run_pass(processor, &job);
     
     g_free(kernel);
+    g_free(kernel_fixed);
+    return result;
+}
+
+/* Grayscale conversion - one pointwise pass in row bands, so it needs no
+ * scratch arena and no tiling at any image size */
+
+static GdkPixbuf* apply_grayscale(BlurProcessor *processor,
+                                  GdkPixbuf *source_pixbuf,
+                                  const gint *cancel_flag,
+                                  gint64 *pass_time_us) {
+    gint width = gdk_pixbuf_get_width(source_pixbuf);
+    gint height = gdk_pixbuf_get_height(source_pixbuf);
+    gint channels = gdk_pixbuf_get_n_channels(source_pixbuf);
+    
+    GdkPixbuf *result = result_pixbuf_new(processor, channels == 4, width, height);
+    if (!result) {
+        return NULL;
+    }
+    
+    BlurPassJob job = {
+        .src_pixels = gdk_pixbuf_read_pixels(source_pixbuf),
+        .dst_pixels = gdk_pixbuf_get_pixels(result),
+        .width = width,
+        .height = height,
+        .rowstride = gdk_pixbuf_get_rowstride(source_pixbuf),
+        .channels = channels,
+        .kernel_ops = processor->kernel_ops,
+        .is_vertical = FALSE,
+        .step = BLUR_PASS_GRAYSCALE,
+        .dst_rowstride = gdk_pixbuf_get_rowstride(result),
+        .cancel_flag = cancel_flag,
+        .pass_time_us = pass_time_us,
+    };
+    run_pass(processor, &job);
+    
+    if (pass_job_cancelled(&job)) {
+        g_object_unref(result);
+        return NULL;
+    }
+    
     return result;
 }
 
@@ -433,6 +1759,76 @@ typedef struct {
     gpointer data;
 } ThreadWorkData;
 
+static void latency_window_add(LatencyWindow *window, gint64 value, gint64 work) {
+    window->values[window->next] = MAX(value, 0);
+    window->work[window->next] = work;
+    window->next = (window->next + 1) % BLUR_LATENCY_WINDOW;
+    window->count = MIN(window->count + 1, BLUR_LATENCY_WINDOW);
+}
+
+static gint compare_latencies(gconstpointer a, gconstpointer b) {
+    gint64 x = *(const gint64*)a;
+    gint64 y = *(const gint64*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentiles of a sorted copy; 256 samples sort in microseconds
+static void latency_window_summarize(const LatencyWindow *window, BlurLatencyStats *stats) {
+    gint64 sorted[BLUR_LATENCY_WINDOW];
+    
+    memset(stats, 0, sizeof(*stats));
+    if (window->count == 0) {
+        return;
+    }
+    
+    memcpy(sorted, window->values, window->count * sizeof(gint64));
+    qsort(sorted, window->count, sizeof(gint64), compare_latencies);
+    
+    stats->samples = window->count;
+    stats->p50_us = sorted[(window->count - 1) / 2];
+    stats->p99_us = sorted[(window->count * 99 + 99) / 100 - 1];
+    stats->max_us = sorted[window->count - 1];
+}
+
+static gdouble latency_window_throughput(const LatencyWindow *window) {
+    gint64 time_us = 0;
+    gint64 work = 0;
+    
+    // Grayscale-only requests blur nothing and stay out of the rate
+    for (guint i = 0; i < window->count; i++) {
+        if (window->work[i] > 0) {
+            time_us += window->values[i];
+            work += window->work[i];
+        }
+    }
+    
+    // Pixels per microsecond are megapixels per second
+    return time_us > 0 ? (gdouble)work / time_us : 0.0;
+}
+
+static gint64 estimate_blur_time_us(BlurProcessor *processor, gint64 pixels) {
+    return (gint64)(processor->ns_per_pixel * pixels / 1000.0);
+}
+
+// Grayscale requests count as no blur work, so they neither feed the
+// blur cost model nor add to time_saved_us when cancelled
+static gint64 count_blur_pixels(const BlurWorkItem *item) {
+    if (!(item->stages & BLUR_STAGE_BLUR)) {
+        return 0;
+    }
+    
+    gint width = gdk_pixbuf_get_width(item->source_pixbuf);
+    gint height = gdk_pixbuf_get_height(item->source_pixbuf);
+    gint64 pixels = (gint64)width * height;
+    
+    if (item->is_progressive) {
+        gint factor = blur_calculate_preview_factor(width, height);
+        pixels /= (gint64)factor * factor;
+    }
+    
+    return pixels;
+}
+
 static void blur_worker_thread_func(gpointer data, gpointer user_data) {
     BlurWorkItem *item = (BlurWorkItem*)data;
     BlurProcessor *processor = (BlurProcessor*)user_data;
@@ -441,65 +1837,291 @@ static void blur_worker_thread_func(gpointer data, gpointer user_data) {
         return;
     }
     
-    // Check if processor is being destroyed
+    gint64 pixels = count_blur_pixels(item);
+    
+    // Check if processor is being destroyed, and drop requests cancelled
+    // while they were still queued before spending anything on them
     g_mutex_lock(&processor->processor_mutex);
     if (processor->is_destroyed) {
         g_mutex_unlock(&processor->processor_mutex);
+        // Worker deliveries may have a thread waiting on them; main context
+        // ones go away with the processor, as explicitly cancelled ones do
+        if (item->delivery == BLUR_DELIVERY_WORKER &&
+            (!g_atomic_int_get(&item->cancelled) || item->superseded)) {
+            complete_destroyed(item->callback, item->user_data);
+        }
+        work_item_free(item);
         return;
     }
+    if (g_atomic_int_get(&item->cancelled)) {
+        processor->stats.cancelled_before_start++;
+        processor->stats.time_saved_us += estimate_blur_time_us(processor, pixels);
+        g_mutex_unlock(&processor->processor_mutex);
+        if (item->superseded) {
+            complete_superseded(item->callback, item->user_data);
+        }
+        work_item_free(item);
+        return;
+    }
+    item->started = TRUE;
     g_mutex_unlock(&processor->processor_mutex);
     
-    // Perform blur processing
+    gint64 start_time = g_get_monotonic_time();
+    blur_trace_mark(item->submit_time, start_time, "queue-wait", "request %u", item->request_id);
+    
+    // Progressive requests blur a downsample with the sigma scaled to
+    // match, using the integer kernels
     gdouble sigma = blur_calculate_sigma(item->intensity);
-    GdkPixbuf *result = apply_separable_gaussian_blur(
-        item->source_pixbuf, 
-        sigma, 
-        item->is_progressive,
-        processor->horizontal_buffer,
-        processor->vertical_buffer
-    );
+    GdkPixbuf *blur_source = NULL;
+    if (item->base_pixbuf) {
+        // Continue from a lower intensity result with the residual kernel
+        sigma = blur_calculate_residual_sigma(item->base_intensity, item->intensity);
+        blur_source = g_object_ref(item->base_pixbuf);
+    } else if (item->is_progressive) {
+        gint factor = blur_calculate_preview_factor(gdk_pixbuf_get_width(item->source_pixbuf),
+                                                    gdk_pixbuf_get_height(item->source_pixbuf));
+        blur_source = acquire_preview_source(processor, item->source_pixbuf, factor);
+        sigma /= factor;
+    } else {
+        blur_source = g_object_ref(item->source_pixbuf);
+    }
+    
+    GdkPixbuf *result = NULL;
+    gboolean blur = (item->stages & BLUR_STAGE_BLUR) != 0;
+    gboolean convert = (item->stages & BLUR_STAGE_GRAYSCALE) != 0;
+    gboolean tiled = blur_source && blur && blur_needs_tiles(processor, blur_source);
+    
+    // Tiles are converted one at a time in the blur's scratch arena;
+    // otherwise the conversion is fused into a single-plane blur
+    if (blur_source && convert && !blur) {
+        result = apply_grayscale(processor, blur_source, &item->cancelled, item->pass_time_us);
+        g_object_unref(blur_source);
+        blur_source = blur ? g_steal_pointer(&result) : NULL;
+    }
+    gboolean single_channel = blur_source && !tiled &&
+                              (convert || source_is_grayscale(blur_source));
+    
+    // Check out a private scratch arena so concurrent requests never share
+    // intermediate buffers
+    if (blur_source) {
+        gsize needed = single_channel ? calculate_plane_scratch_size(blur_source)
+                                      : calculate_scratch_size(processor, blur_source);
+        BlurScratch *scratch = scratch_acquire(processor, needed,
+                                               (tiled || single_channel) ? needed : 0);
+        
+        // Perform blur processing
+        if (scratch) {
+            result = apply_separable_gaussian_blur(
+                processor,
+                blur_source, 
+                sigma, 
+                item->is_progressive,
+                single_channel,
+                convert && tiled,
+                &item->cancelled,
+                item->pass_time_us,
+                scratch->buffer1,
+                scratch->buffer2
+            );
+            scratch_release(processor, scratch);
+        }
+        g_object_unref(blur_source);
+    }
+    
+    // Gray results stay gray when they come back as incremental bases
+    if (result && (convert || single_channel)) {
+        mark_grayscale(result, TRUE);
+    }
+    
+    item->finish_time = g_get_monotonic_time();
+    gint64 elapsed_us = item->finish_time - start_time;
+    blur_trace_mark(start_time, item->finish_time, "request", "request %u, %dx%d, intensity %.1f%s%s%s",
+                    item->request_id,
+                    gdk_pixbuf_get_width(item->source_pixbuf),
+                    gdk_pixbuf_get_height(item->source_pixbuf),
+                    item->intensity,
+                    item->is_progressive ? ", progressive" : "",
+                    tiled ? ", tiled" : "",
+                    g_atomic_int_get(&item->cancelled) ? ", cancelled" : "");
+    
+    // An idle attached now would outlive a processor being destroyed;
+    // worker deliveries still run while destroy waits for this worker
+    g_mutex_lock(&processor->processor_mutex);
+    if (processor->is_destroyed && item->delivery != BLUR_DELIVERY_WORKER) {
+        g_mutex_unlock(&processor->processor_mutex);
+        g_clear_object(&result);
+        work_item_free(item);
+        return;
+    }
+    
+    // A request cancelled mid-flight has already left active_requests, so
+    // nothing else references the item
+    if (g_atomic_int_get(&item->cancelled)) {
+        processor->stats.cancelled_in_flight++;
+        processor->stats.time_saved_us += MAX(estimate_blur_time_us(processor, pixels) - elapsed_us, 0);
+        g_mutex_unlock(&processor->processor_mutex);
+        g_clear_object(&result);
+        work_item_free(item);
+        return;
+    }
+    if (result) {
+        if (pixels > 0) {
+            gdouble sample = elapsed_us * 1000.0 / pixels;
+            processor->ns_per_pixel = processor->stats.completed_requests == 0
+                ? sample : 0.8 * processor->ns_per_pixel + 0.2 * sample;
+        }
+        processor->stats.completed_requests++;
+        if (item->base_pixbuf) {
+            processor->stats.incremental_requests++;
+        }
+        if (tiled) {
+            processor->stats.tiled_requests++;
+        }
+        if (!blur) {
+            processor->stats.grayscale_requests++;
+        }
+        if (single_channel) {
+            processor->stats.single_channel_requests++;
+        }
+        
+        latency_window_add(&processor->queue_wait_window, start_time - item->submit_time, 0);
+        latency_window_add(&processor->horizontal_window, item->pass_time_us[0], 0);
+        latency_window_add(&processor->vertical_window, item->pass_time_us[1], 0);
+        latency_window_add(&processor->compute_window, elapsed_us, pixels);
+    }
+    g_mutex_unlock(&processor->processor_mutex);
     
     // Create completion callback data
     CallbackData *callback_data = g_malloc(sizeof(CallbackData));
-    callback_data->callback = item->callback;
-    callback_data->user_data = item->user_data;
+    callback_data->item = item;
     callback_data->result = result;
-    callback_data->request_id = item->request_id;
     callback_data->processor = processor;
     
-    // Schedule callback on main thread
-    g_idle_add_full(G_PRIORITY_DEFAULT, 
-                   (GSourceFunc)blur_completion_idle_callback, 
-                   callback_data, 
-                   g_free);
+    if (item->delivery == BLUR_DELIVERY_WORKER) {
+        blur_completion_idle_callback(callback_data);
+        g_free(callback_data);
+        return;
+    }
+    
+    // Schedule callback on the requester's main context
+    attach_idle(item->context, blur_completion_idle_callback, callback_data, g_free);
 }
 
 static gboolean blur_completion_idle_callback(gpointer data) {
     CallbackData *callback_data = (CallbackData*)data;
+    BlurWorkItem *item = callback_data->item;
     
     // Check if request is still active (not cancelled)
     g_mutex_lock(&callback_data->processor->processor_mutex);
-    gboolean request_active = g_hash_table_contains(callback_data->processor->active_requests,
-                                                   GUINT_TO_POINTER(callback_data->request_id));
-    if (request_active) {
-        g_hash_table_remove(callback_data->processor->active_requests,
-                           GUINT_TO_POINTER(callback_data->request_id));
-    }
+    gboolean request_active = g_hash_table_remove(callback_data->processor->active_requests,
+                                                 GUINT_TO_POINTER(item->request_id));
     g_mutex_unlock(&callback_data->processor->processor_mutex);
     
     // Only invoke callback if request is still active (not cancelled)
-    if (request_active && callback_data->callback) {
-        callback_data->callback(callback_data->result, NULL, callback_data->user_data);
+    if (request_active && item->callback) {
+        if (callback_data->result) {
+            item->callback(callback_data->result, NULL, item->user_data);
+            
+            // Delivery includes the callback, where the caller displays the result
+            gint64 delivered_time = g_get_monotonic_time();
+            blur_trace_mark(item->finish_time, delivered_time, "delivery", "request %u", item->request_id);
+            
+            g_mutex_lock(&callback_data->processor->processor_mutex);
+            latency_window_add(&callback_data->processor->delivery_window,
+                               delivered_time - item->finish_time, 0);
+            latency_window_add(&callback_data->processor->total_window,
+                               delivered_time - item->submit_time, 0);
+            g_mutex_unlock(&callback_data->processor->processor_mutex);
+        } else {
+            GError *error = g_error_new(BLUR_ERROR, BLUR_ERROR_MEMORY_ALLOCATION,
+                                       !(item->stages & BLUR_STAGE_BLUR) ? "Failed to allocate grayscale image"
+                                                          : "Failed to allocate blur buffers");
+            item->callback(NULL, error, item->user_data);
+            g_error_free(error);
+        }
     }
     
     // Always clean up the result pixbuf - it was created by the worker thread
     if (callback_data->result) {
         g_object_unref(callback_data->result);
     }
+    work_item_free(item);
+    
+    return G_SOURCE_REMOVE;
+}
+
+/* Queue order: higher priority first, then submission order */
+static gint compare_work_items(gconstpointer a, gconstpointer b, gpointer user_data) {
+    const BlurWorkItem *item_a = a;
+    const BlurWorkItem *item_b = b;
+    
+    if (item_a->priority != item_b->priority) {
+        return item_a->priority > item_b->priority ? -1 : 1;
+    }
+    return item_a->request_id < item_b->request_id ? -1 : (item_a->request_id > item_b->request_id);
+}
+
+typedef struct {
+    BlurCompletionCallback callback;
+    gpointer user_data;
+} SupersededData;
+
+static void complete_superseded(BlurCompletionCallback callback, gpointer user_data) {
+    GError *error = g_error_new(BLUR_ERROR, BLUR_ERROR_CANCELLED,
+                               "Blur request replaced by a newer one");
+    
+    callback(NULL, error, user_data);
+    g_error_free(error);
+}
+
+static void complete_destroyed(BlurCompletionCallback callback, gpointer user_data) {
+    GError *error = g_error_new(BLUR_ERROR, BLUR_ERROR_CANCELLED,
+                               "Processor destroyed before the request ran");
+    
+    callback(NULL, error, user_data);
+    g_error_free(error);
+}
+
+static gboolean blur_superseded_idle_callback(gpointer data) {
+    SupersededData *superseded = data;
     
+    complete_superseded(superseded->callback, superseded->user_data);
     return G_SOURCE_REMOVE;
 }
 
+/* Latest-wins scheduling: cancels queued requests @item makes redundant.
+ * Called with processor_mutex held; workers drop the items on dequeue. */
+static void supersede_queued_requests(BlurProcessor *processor, const BlurWorkItem *item) {
+    GHashTableIter iter;
+    gpointer value;
+    
+    g_hash_table_iter_init(&iter, processor->active_requests);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        BlurWorkItem *queued = value;
+        
+        if (queued->started || queued->never_supersede ||
+            queued->source_pixbuf != item->source_pixbuf ||
+            queued->stages != item->stages ||
+            queued->is_progressive != item->is_progressive || queued->priority != item->priority) {
+            continue;
+        }
+        
+        if (queued->delivery == BLUR_DELIVERY_WORKER) {
+            queued->superseded = TRUE;
+        } else {
+            SupersededData *superseded = g_new(SupersededData, 1);
+            superseded->callback = queued->callback;
+            superseded->user_data = queued->user_data;
+            attach_idle(queued->context, blur_superseded_idle_callback, superseded, g_free);
+        }
+        
+        g_hash_table_iter_remove(&iter);
+        g_atomic_int_set(&queued->cancelled, 1);
+        processor->stats.cancelled_requests++;
+        processor->stats.superseded_requests++;
+    }
+}
+
 static gboolean ensure_thread_pool_created(BlurProcessor *processor) {
     if (processor->thread_pool) {
         return TRUE;
@@ -520,6 +2142,25 @@ static gboolean ensure_thread_pool_created(BlurProcessor *processor) {
         return FALSE;
     }
     
+    g_thread_pool_set_sort_function(processor->thread_pool, compare_work_items, NULL);
+    
+    // Band workers split a single image across cores. Failure here is not
+    // fatal, requests then just run each pass on their own worker.
+    if (processor->thread_count > 1) {
+        processor->band_pool = g_thread_pool_new(
+            blur_band_thread_func,
+            processor,
+            processor->thread_count,
+            FALSE,
+            &error
+        );
+        
+        if (error) {
+            g_warning("Failed to create band thread pool: %s", error->message);
+            g_clear_error(&error);
+        }
+    }
+    
     return processor->thread_pool != NULL;
 }
 
@@ -529,12 +2170,29 @@ guint blur_processor_apply_async(BlurProcessor *processor,
                                gboolean is_progressive,
                                BlurCompletionCallback callback,
                                gpointer user_data) {
+    return blur_processor_apply_async_with_priority(processor, pixbuf, intensity, is_progressive,
+                                                    BLUR_PRIORITY_NORMAL, callback, user_data);
+}
+
+static guint submit_blur_request(BlurProcessor *processor,
+                                GdkPixbuf *pixbuf,
+                                BlurStages stages,
+                                GdkPixbuf *base_pixbuf,
+                                gdouble base_intensity,
+                                gdouble intensity,
+                                gboolean is_progressive,
+                                BlurPriority priority,
+                                BlurDeliveryMode delivery,
+                                GMainContext *context,
+                                gboolean never_supersede,
+                                BlurCompletionCallback callback,
+                                gpointer user_data) {
     // Input validation - T010
-    if (!processor || !pixbuf || !callback) {
+    if (!processor || !pixbuf || !callback || !stages) {
         return 0;
     }
     
-    if (!blur_validate_intensity(intensity)) {
+    if ((stages & BLUR_STAGE_BLUR) && !blur_validate_intensity(intensity)) {
         GError *error = g_error_new(BLUR_ERROR, BLUR_ERROR_INVALID_INTENSITY,
                                    "Invalid blur intensity: %f", intensity);
         callback(NULL, error, user_data);
@@ -562,12 +2220,17 @@ guint blur_processor_apply_async(BlurProcessor *processor,
         return 0;
     }
     
-    // Handle zero intensity case (no blur needed)
-    if (intensity <= 0.0) {
+    // Handle zero intensity case (no blur needed, any conversion still runs)
+    if ((stages & BLUR_STAGE_BLUR) && intensity <= 0.0) {
+        stages &= ~BLUR_STAGE_BLUR;
+    }
+    if (!stages) {
+        guint request_id = processor->next_request_id++;
         g_mutex_unlock(&processor->processor_mutex);
-        GdkPixbuf *result = g_object_ref(pixbuf);
-        callback(result, NULL, user_data);
-        return processor->next_request_id++; // Return valid ID even for immediate completion
+        
+        // The source is the result; callbacks borrow it like any other
+        callback(pixbuf, NULL, user_data);
+        return request_id; // Return valid ID even for immediate completion
     }
     
     // Ensure thread pool is created
@@ -584,10 +2247,23 @@ guint blur_processor_apply_async(BlurProcessor *processor,
     BlurWorkItem *work_item = g_malloc0(sizeof(BlurWorkItem));
     work_item->request_id = processor->next_request_id++;
     work_item->source_pixbuf = g_object_ref(pixbuf);
+    work_item->stages = stages;
     work_item->intensity = intensity;
     work_item->is_progressive = is_progressive;
+    work_item->priority = priority;
     work_item->callback = callback;
     work_item->user_data = user_data;
+    work_item->delivery = delivery;
+    work_item->context = context ? g_main_context_ref(context) : NULL;
+    work_item->never_supersede = never_supersede;
+    work_item->base_pixbuf = base_pixbuf ? g_object_ref(base_pixbuf) : NULL;
+    work_item->base_intensity = base_intensity;
+    work_item->submit_time = g_get_monotonic_time();
+    
+    // Waited for requests neither replace queued ones nor get replaced
+    if (processor->schedule_mode == BLUR_SCHEDULE_LATEST_WINS && !never_supersede) {
+        supersede_queued_requests(processor, work_item);
+    }
     
     // Add to active requests tracking
     g_hash_table_insert(processor->active_requests,
@@ -619,6 +2295,369 @@ guint blur_processor_apply_async(BlurProcessor *processor,
     return request_id;
 }
 
+guint blur_processor_apply_async_with_priority(BlurProcessor *processor,
+                                             GdkPixbuf *pixbuf,
+                                             gdouble intensity,
+                                             gboolean is_progressive,
+                                             BlurPriority priority,
+                                             BlurCompletionCallback callback,
+                                             gpointer user_data) {
+    return submit_blur_request(processor, pixbuf, BLUR_STAGE_BLUR, NULL, 0.0, intensity, is_progressive,
+                               priority, BLUR_DELIVERY_IDLE, NULL, FALSE, callback, user_data);
+}
+
+// A residual blur only pays off while the target uses the Gaussian
+// kernel; the box engine costs the same at every sigma
+static gboolean residual_blur_is_cheaper(gdouble base_intensity, gdouble intensity) {
+    gdouble sigma = blur_calculate_sigma(intensity);
+    gdouble residual_sigma = blur_calculate_residual_sigma(base_intensity, intensity);
+    
+    if (residual_sigma <= 0.0 || sigma >= BLUR_BOX_SIGMA_THRESHOLD) {
+        return FALSE;
+    }
+    
+    return blur_calculate_kernel_size(residual_sigma) < blur_calculate_kernel_size(sigma);
+}
+
+guint blur_processor_apply_async_from_base(BlurProcessor *processor,
+                                         GdkPixbuf *pixbuf,
+                                         GdkPixbuf *base_pixbuf,
+                                         gdouble base_intensity,
+                                         gdouble intensity,
+                                         BlurPriority priority,
+                                         BlurCompletionCallback callback,
+                                         gpointer user_data) {
+    gboolean use_base = pixbuf && base_pixbuf &&
+                        blur_validate_pixbuf(base_pixbuf) &&
+                        blur_validate_intensity(base_intensity) &&
+                        gdk_pixbuf_get_width(base_pixbuf) == gdk_pixbuf_get_width(pixbuf) &&
+                        gdk_pixbuf_get_height(base_pixbuf) == gdk_pixbuf_get_height(pixbuf) &&
+                        gdk_pixbuf_get_n_channels(base_pixbuf) == gdk_pixbuf_get_n_channels(pixbuf) &&
+                        residual_blur_is_cheaper(base_intensity, intensity);
+    
+    return submit_blur_request(processor, pixbuf, BLUR_STAGE_BLUR, use_base ? base_pixbuf : NULL,
+                               base_intensity, intensity, FALSE, priority,
+                               BLUR_DELIVERY_IDLE, NULL, FALSE, callback, user_data);
+}
+
+guint blur_processor_grayscale_async(BlurProcessor *processor,
+                                    GdkPixbuf *pixbuf,
+                                    BlurPriority priority,
+                                    BlurCompletionCallback callback,
+                                    gpointer user_data) {
+    return submit_blur_request(processor, pixbuf, BLUR_STAGE_GRAYSCALE, NULL, 0.0, 0.0, FALSE,
+                               priority, BLUR_DELIVERY_IDLE, NULL, FALSE, callback, user_data);
+}
+
+guint blur_processor_apply_stages_async(BlurProcessor *processor,
+                                       GdkPixbuf *pixbuf,
+                                       BlurStages stages,
+                                       gdouble intensity,
+                                       gboolean is_progressive,
+                                       BlurPriority priority,
+                                       BlurCompletionCallback callback,
+                                       gpointer user_data) {
+    return submit_blur_request(processor, pixbuf, stages, NULL, 0.0, intensity, is_progressive,
+                               priority, BLUR_DELIVERY_IDLE, NULL, FALSE, callback, user_data);
+}
+
+guint blur_processor_apply_stages_full(BlurProcessor *processor,
+                                      GdkPixbuf *pixbuf,
+                                      BlurStages stages,
+                                      gdouble intensity,
+                                      gboolean is_progressive,
+                                      BlurPriority priority,
+                                      BlurDeliveryMode delivery,
+                                      GMainContext *context,
+                                      BlurCompletionCallback callback,
+                                      gpointer user_data) {
+    return submit_blur_request(processor, pixbuf, stages, NULL, 0.0, intensity, is_progressive,
+                               priority, delivery, context, FALSE, callback, user_data);
+}
+
+/* Blocking calls wait on one of these for worker delivered completions */
+typedef struct {
+    GMutex mutex;
+    GCond cond;
+    gboolean done;
+    GdkPixbuf *result;
+    GError *error;
+} BlurWaiter;
+
+static void waiter_init(BlurWaiter *waiter) {
+    memset(waiter, 0, sizeof(*waiter));
+    g_mutex_init(&waiter->mutex);
+    g_cond_init(&waiter->cond);
+}
+
+static void waiter_signal(BlurWaiter *waiter) {
+    g_mutex_lock(&waiter->mutex);
+    waiter->done = TRUE;
+    g_cond_signal(&waiter->cond);
+    g_mutex_unlock(&waiter->mutex);
+}
+
+static void waiter_wait_and_clear(BlurWaiter *waiter) {
+    g_mutex_lock(&waiter->mutex);
+    while (!waiter->done) {
+        g_cond_wait(&waiter->cond, &waiter->mutex);
+    }
+    g_mutex_unlock(&waiter->mutex);
+    
+    g_mutex_clear(&waiter->mutex);
+    g_cond_clear(&waiter->cond);
+}
+
+static void on_sync_done(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data) {
+    BlurWaiter *waiter = user_data;
+    
+    // Results are borrowed, so the waiter takes its own reference
+    if (result_pixbuf) {
+        waiter->result = g_object_ref(result_pixbuf);
+    } else {
+        waiter->error = error ? g_error_copy(error)
+                              : g_error_new(BLUR_ERROR, BLUR_ERROR_PROCESSING_FAILED, "No result");
+    }
+    waiter_signal(waiter);
+}
+
+GdkPixbuf* blur_processor_apply_stages_sync(BlurProcessor *processor,
+                                            GdkPixbuf *pixbuf,
+                                            BlurStages stages,
+                                            gdouble intensity,
+                                            GError **error) {
+    BlurWaiter waiter;
+    
+    if (!processor || !pixbuf || !stages) {
+        g_set_error(error, BLUR_ERROR, BLUR_ERROR_INVALID_PIXBUF,
+                    "Invalid blur request");
+        return NULL;
+    }
+    
+    // Immediate failures complete before submission returns, so the wait
+    // below never misses them
+    waiter_init(&waiter);
+    submit_blur_request(processor, pixbuf, stages, NULL, 0.0, intensity, FALSE,
+                        BLUR_PRIORITY_NORMAL, BLUR_DELIVERY_WORKER, NULL, TRUE,
+                        on_sync_done, &waiter);
+    waiter_wait_and_clear(&waiter);
+    
+    if (waiter.error) {
+        g_propagate_error(error, waiter.error);
+    }
+    return waiter.result;
+}
+
+GdkPixbuf* blur_processor_apply_sync(BlurProcessor *processor,
+                                     GdkPixbuf *pixbuf,
+                                     gdouble intensity,
+                                     GError **error) {
+    return blur_processor_apply_stages_sync(processor, pixbuf, BLUR_STAGE_BLUR, intensity, error);
+}
+
+/* A batch in flight; the extra pending count held during submission keeps
+ * items failing immediately from completing it early */
+typedef struct {
+    BlurBatchItem *items;
+    guint n_items;
+    gint pending;
+    GMainContext *context;
+    BlurDeliveryMode delivery;
+    BlurBatchCallback callback;
+    gpointer user_data;
+} BlurBatch;
+
+typedef struct {
+    BlurBatch *batch;
+    BlurBatchItem *item;
+} BlurBatchSlot;
+
+static void batch_free(BlurBatch *batch) {
+    g_clear_pointer(&batch->context, g_main_context_unref);
+    g_free(batch);
+}
+
+static gboolean batch_idle_callback(gpointer data) {
+    BlurBatch *batch = data;
+    
+    batch->callback(batch->items, batch->n_items, batch->user_data);
+    return G_SOURCE_REMOVE;
+}
+
+static void batch_item_done(BlurBatch *batch) {
+    if (!g_atomic_int_dec_and_test(&batch->pending)) {
+        return;
+    }
+    
+    if (batch->delivery == BLUR_DELIVERY_WORKER) {
+        batch_idle_callback(batch);
+        batch_free(batch);
+    } else {
+        attach_idle(batch->context, batch_idle_callback, batch, (GDestroyNotify)batch_free);
+    }
+}
+
+static void on_batch_item_done(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data) {
+    BlurBatchSlot *slot = user_data;
+    BlurBatch *batch = slot->batch;
+    
+    if (result_pixbuf) {
+        slot->item->result = g_object_ref(result_pixbuf);
+    } else {
+        slot->item->error = error ? g_error_copy(error)
+                                  : g_error_new(BLUR_ERROR, BLUR_ERROR_PROCESSING_FAILED, "No result");
+    }
+    
+    g_free(slot);
+    batch_item_done(batch);
+}
+
+void blur_processor_apply_batch_async(BlurProcessor *processor,
+                                      BlurBatchItem *items,
+                                      guint n_items,
+                                      BlurStages stages,
+                                      BlurPriority priority,
+                                      BlurDeliveryMode delivery,
+                                      GMainContext *context,
+                                      BlurBatchCallback callback,
+                                      gpointer user_data) {
+    g_return_if_fail(callback != NULL);
+    g_return_if_fail(items != NULL || n_items == 0);
+    
+    if (n_items == 0) {
+        callback(items, 0, user_data);
+        return;
+    }
+    
+    BlurBatch *batch = g_new0(BlurBatch, 1);
+    batch->items = items;
+    batch->n_items = n_items;
+    batch->pending = (gint)n_items + 1;
+    batch->context = context ? g_main_context_ref(context) : NULL;
+    batch->delivery = delivery;
+    batch->callback = callback;
+    batch->user_data = user_data;
+    
+    // Items complete on the workers; only the batch goes through @context
+    for (guint i = 0; i < n_items; i++) {
+        BlurBatchSlot *slot = g_new(BlurBatchSlot, 1);
+        slot->batch = batch;
+        slot->item = &items[i];
+        items[i].result = NULL;
+        items[i].error = NULL;
+        
+        if (!processor || !items[i].pixbuf || !stages) {
+            GError *error = g_error_new(BLUR_ERROR, BLUR_ERROR_INVALID_PIXBUF,
+                                       "Invalid blur request");
+            on_batch_item_done(NULL, error, slot);
+            g_error_free(error);
+            continue;
+        }
+        submit_blur_request(processor, items[i].pixbuf, stages, NULL, 0.0, items[i].intensity,
+                            FALSE, priority, BLUR_DELIVERY_WORKER, NULL, TRUE,
+                            on_batch_item_done, slot);
+    }
+    
+    batch_item_done(batch);
+}
+
+static void on_batch_sync_done(BlurBatchItem *items, guint n_items, gpointer user_data) {
+    waiter_signal(user_data);
+}
+
+guint blur_processor_apply_batch_sync(BlurProcessor *processor,
+                                      BlurBatchItem *items,
+                                      guint n_items,
+                                      BlurStages stages) {
+    BlurWaiter waiter;
+    guint failed = 0;
+    
+    waiter_init(&waiter);
+    blur_processor_apply_batch_async(processor, items, n_items, stages, BLUR_PRIORITY_NORMAL,
+                                     BLUR_DELIVERY_WORKER, NULL, on_batch_sync_done, &waiter);
+    waiter_wait_and_clear(&waiter);
+    
+    for (guint i = 0; i < n_items; i++) {
+        if (items[i].error) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+void blur_processor_set_schedule_mode(BlurProcessor *processor, BlurScheduleMode mode) {
+    if (!processor) {
+        return;
+    }
+    
+    g_mutex_lock(&processor->processor_mutex);
+    processor->schedule_mode = mode;
+    g_mutex_unlock(&processor->processor_mutex);
+}
+
+void blur_processor_get_stats(BlurProcessor *processor, BlurProcessorStats *stats) {
+    if (!processor || !stats) {
+        return;
+    }
+    
+    g_mutex_lock(&processor->processor_mutex);
+    *stats = processor->stats;
+    latency_window_summarize(&processor->queue_wait_window, &stats->queue_wait);
+    latency_window_summarize(&processor->horizontal_window, &stats->horizontal_pass);
+    latency_window_summarize(&processor->vertical_window, &stats->vertical_pass);
+    latency_window_summarize(&processor->compute_window, &stats->compute);
+    latency_window_summarize(&processor->delivery_window, &stats->delivery);
+    latency_window_summarize(&processor->total_window, &stats->total);
+    stats->throughput_mpixels = latency_window_throughput(&processor->compute_window);
+    g_mutex_unlock(&processor->processor_mutex);
+    
+    g_mutex_lock(&processor->result_pool->mutex);
+    stats->result_buffers_reused = processor->result_pool->reused;
+    g_mutex_unlock(&processor->result_pool->mutex);
+    
+    g_mutex_lock(&processor->scratch_mutex);
+    stats->scratch_bytes = processor->scratch_bytes;
+    g_mutex_unlock(&processor->scratch_mutex);
+}
+
+gsize blur_processor_release_memory(BlurProcessor *processor) {
+    if (!processor) {
+        return 0;
+    }
+    
+    gsize freed = 0;
+    
+    // Arenas checked out by running requests are not in the pool
+    g_mutex_lock(&processor->scratch_mutex);
+    GSList *scratch_pool = g_steal_pointer(&processor->scratch_pool);
+    for (GSList *l = scratch_pool; l; l = l->next) {
+        freed += scratch_footprint(l->data);
+    }
+    processor->scratch_bytes -= freed;
+    g_mutex_unlock(&processor->scratch_mutex);
+    g_slist_free_full(scratch_pool, (GDestroyNotify)scratch_free);
+    
+    freed += result_pool_drain(processor->result_pool);
+    
+    g_mutex_lock(&processor->preview_mutex);
+    if (processor->preview_pixbuf) {
+        freed += (gsize)gdk_pixbuf_get_byte_length(processor->preview_pixbuf);
+    }
+    g_clear_object(&processor->preview_source);
+    g_clear_object(&processor->preview_pixbuf);
+    g_mutex_unlock(&processor->preview_mutex);
+    
+    return freed;
+}
+
+const gchar* blur_processor_get_kernel_name(BlurProcessor *processor) {
+    if (!processor) {
+        return NULL;
+    }
+    
+    return processor->kernel_ops->name;
+}
+
 gboolean blur_processor_cancel(BlurProcessor *processor, guint request_id) {
     if (!processor || request_id == 0) {
         return FALSE;
@@ -630,9 +2669,12 @@ gboolean blur_processor_cancel(BlurProcessor *processor, guint request_id) {
                                                  GUINT_TO_POINTER(request_id));
     
     if (work_item) {
-        // Remove from active requests - the worker thread completion callback will detect this
-        // and not invoke the user callback
+        // Remove from active requests so the completion callback is never
+        // invoked, then flag the worker to stop at its next check. Queued
+        // items are dropped when they reach a worker.
         g_hash_table_remove(processor->active_requests, GUINT_TO_POINTER(request_id));
+        g_atomic_int_set(&work_item->cancelled, 1);
+        processor->stats.cancelled_requests++;
         
         g_mutex_unlock(&processor->processor_mutex);
         return TRUE;
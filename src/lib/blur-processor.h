@@ -19,13 +19,12 @@ typedef struct _BlurProcessor BlurProcessor;
 
 /**
  * BlurCompletionCallback:
- * @result_pixbuf: Blurred pixbuf on success, NULL on error
+ * @result_pixbuf: (transfer none): Blurred pixbuf on success, NULL on
+ *   error; ref it to keep it past the callback
  * @error: Error details, NULL on success  
  * @user_data: User data from blur_processor_apply_async()
  *
  * Called when blur processing completes or fails
- * 
- * Note: result_pixbuf ownership transferred to caller, must unreference
  */
 typedef void (*BlurCompletionCallback)(GdkPixbuf *result_pixbuf,
                                      const GError *error,
@@ -56,6 +55,61 @@ typedef enum {
 #define BLUR_ERROR (blur_error_quark())
 GQuark blur_error_quark(void);
 
+/**
+ * BLUR_BOX_SIGMA_THRESHOLD:
+ *
+ * Sigma from which blurs switch from the Gaussian kernel to stacked box
+ * blurs. The box engine uses running sums, so its cost per pixel is the
+ * same for every sigma above this value.
+ */
+#define BLUR_BOX_SIGMA_THRESHOLD 3.0
+
+/**
+ * BlurPriority:
+ * @BLUR_PRIORITY_BACKGROUND: Speculative work such as prefetching
+ * @BLUR_PRIORITY_NORMAL: Default for blur_processor_apply_async()
+ * @BLUR_PRIORITY_VISIBLE: Results the user is waiting to see
+ *
+ * Queued requests start in priority order, FIFO within one priority.
+ * Running requests are never interrupted by higher priority ones.
+ */
+typedef enum {
+    BLUR_PRIORITY_BACKGROUND = 0,
+    BLUR_PRIORITY_NORMAL = 1,
+    BLUR_PRIORITY_VISIBLE = 2
+} BlurPriority;
+
+/**
+ * BlurScheduleMode:
+ * @BLUR_SCHEDULE_FIFO: Every request is processed (default)
+ * @BLUR_SCHEDULE_LATEST_WINS: A new request replaces queued, not yet
+ *   started requests for the same source pixbuf, quality and priority
+ *
+ * Scheduling policy for blur_processor_set_schedule_mode(). Replaced
+ * requests complete with %BLUR_ERROR_CANCELLED, so their callers can tell
+ * them apart from explicitly cancelled ones, which get no callback.
+ * Blocking and batch requests are always processed, and do not replace
+ * other requests either.
+ */
+typedef enum {
+    BLUR_SCHEDULE_FIFO = 0,
+    BLUR_SCHEDULE_LATEST_WINS = 1
+} BlurScheduleMode;
+
+/**
+ * BlurStages:
+ * @BLUR_STAGE_GRAYSCALE: Luminance conversion, as in
+ *   blur_processor_grayscale_async()
+ * @BLUR_STAGE_BLUR: Gaussian blur, as in blur_processor_apply_async()
+ *
+ * Stages of a blur_processor_apply_stages_async() pipeline. Stages always
+ * run in the order listed, whatever the order of the flags.
+ */
+typedef enum {
+    BLUR_STAGE_GRAYSCALE = 1 << 0,
+    BLUR_STAGE_BLUR = 1 << 1
+} BlurStages;
+
 /* Core API Functions */
 
 /**
@@ -64,8 +118,27 @@ GQuark blur_error_quark(void);
  * @max_height: Maximum expected image height for buffer optimization
  * @thread_count: Number of worker threads (0 for auto-detect)
  *
- * Creates a new blur processor instance with pre-allocated buffers
- * and worker thread pool ready for processing.
+ * Creates a new blur processor instance. Nothing image-sized is allocated
+ * and no worker thread starts until the first request, so creating one per
+ * window is cheap.
+ *
+ * Every running request checks out its own scratch arena, so up to
+ * @thread_count requests are processed concurrently. Each request is
+ * additionally split into row bands (horizontal pass) and column tiles
+ * (vertical pass) that are spread across the worker threads.
+ *
+ * @max_width and @max_height (at most 8192) bound the scratch arenas, not
+ * the accepted images: a larger image is blurred in overlapping 1024
+ * pixel tiles, so its working memory stays bounded by the tile size.
+ * Arenas grow to the images actually processed, in size classes. Arenas
+ * and pooled result buffers unused for 10 seconds are freed by the next
+ * request, so no main loop is needed; blur_processor_release_memory()
+ * frees them right away.
+ *
+ * The convolution kernels are chosen here from the CPU features (AVX2,
+ * SSE4.1 or NEON, with a scalar reference fallback). Setting the
+ * BLUR_PROCESSOR_SIMD environment variable to "scalar", "sse4.1", "avx2"
+ * or "neon" forces a specific implementation when it is supported.
  *
  * Returns: New BlurProcessor instance, or NULL on failure
  */
@@ -78,13 +151,24 @@ BlurProcessor* blur_processor_create(gint max_width,
  * @processor: BlurProcessor instance
  * @pixbuf: Source pixbuf to blur (must be valid)
  * @intensity: Blur intensity 0.0-10.0
- * @is_progressive: TRUE for lower quality/faster processing
+ * @is_progressive: TRUE for a fast, downscaled preview
  * @callback: Completion callback function
  * @user_data: User data passed to callback
  *
  * Applies Gaussian blur asynchronously to a pixbuf. Processing request
  * queued for background execution, callback invoked with result or error.
  *
+ * Progressive requests blur a copy downscaled by
+ * blur_calculate_preview_factor() with the sigma scaled to match, using
+ * the integer kernels. The result is that smaller pixbuf; display it
+ * scaled to the source size while the full quality request runs. The
+ * downscaled copy is reused by following progressive requests on the
+ * same source pixbuf.
+ *
+ * Gray sources, such as the output of blur_processor_grayscale_async(),
+ * are detected and blurred as a single luminance plane at about a third
+ * of the cost, with the same result.
+ *
  * Performance guarantees:
  * - Progressive mode: <50ms for HD images
  * - Full quality mode: <500ms for HD images
@@ -104,13 +188,437 @@ guint blur_processor_apply_async(BlurProcessor *processor,
  * @processor: BlurProcessor instance
  * @request_id: Request ID from blur_processor_apply_async()
  *
- * Cancels an in-progress blur operation. Processing stopped as soon 
- * as safely possible, callback invoked with BLUR_ERROR_CANCELLED.
+ * Cancels a queued or in-progress blur operation. The completion callback
+ * is not invoked for a cancelled request. Queued requests are dropped
+ * before they start; running ones stop at the next chunk of rows or
+ * columns, so a cancelled request frees its worker almost immediately.
  *
  * Returns: TRUE if cancellation successful, FALSE if already completed
  */
 gboolean blur_processor_cancel(BlurProcessor *processor, guint request_id);
 
+/**
+ * blur_processor_apply_async_with_priority:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf to blur (must be valid)
+ * @intensity: Blur intensity 0.0-10.0
+ * @is_progressive: TRUE for a fast, downscaled preview
+ * @priority: Scheduling priority of the request
+ * @callback: Completion callback function
+ * @user_data: User data passed to callback
+ *
+ * Same as blur_processor_apply_async() with an explicit @priority.
+ *
+ * Returns: Request ID for cancellation, or 0 on immediate failure
+ */
+guint blur_processor_apply_async_with_priority(BlurProcessor *processor,
+                                             GdkPixbuf *pixbuf,
+                                             gdouble intensity,
+                                             gboolean is_progressive,
+                                             BlurPriority priority,
+                                             BlurCompletionCallback callback,
+                                             gpointer user_data);
+
+/**
+ * blur_processor_apply_async_from_base:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf the result is for (must be valid)
+ * @base_pixbuf: Full quality result of @pixbuf at @base_intensity
+ * @base_intensity: Intensity @base_pixbuf was blurred with
+ * @intensity: Target blur intensity 0.0-10.0
+ * @priority: Scheduling priority of the request
+ * @callback: Completion callback function
+ * @user_data: User data passed to callback
+ *
+ * Full quality blur of @pixbuf at @intensity that may start from a lower
+ * intensity result, typically the one found by
+ * blur_cache_get_nearest_lower(). Gaussian blurs compose, so blurring
+ * @base_pixbuf with blur_calculate_residual_sigma() gives the target up
+ * to 8-bit rounding of the intermediate (within 2 levels per channel).
+ *
+ * The base is used only when the residual kernel is cheaper than the
+ * full one, which means targets below %BLUR_BOX_SIGMA_THRESHOLD; above
+ * it the box engine costs the same for any sigma and the request blurs
+ * @pixbuf directly. An unusable base (other size, not a lower intensity)
+ * is ignored the same way.
+ *
+ * Returns: Request ID for cancellation, or 0 on immediate failure
+ */
+guint blur_processor_apply_async_from_base(BlurProcessor *processor,
+                                         GdkPixbuf *pixbuf,
+                                         GdkPixbuf *base_pixbuf,
+                                         gdouble base_intensity,
+                                         gdouble intensity,
+                                         BlurPriority priority,
+                                         BlurCompletionCallback callback,
+                                         gpointer user_data);
+
+/**
+ * blur_processor_grayscale_async:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf to convert (must be valid)
+ * @priority: Scheduling priority of the request
+ * @callback: Completion callback function
+ * @user_data: User data passed to callback
+ *
+ * Converts @pixbuf to grayscale on the processor's worker pool, with the
+ * rows split into bands across the workers like a blur pass. Each pixel
+ * gets the luminance 0.299 R + 0.587 G + 0.114 B computed with Q15
+ * integer weights in the CPU's vector kernels; alpha is copied unchanged.
+ *
+ * Completion, cancellation with blur_processor_cancel() and scheduling
+ * behave as for blur_processor_apply_async(). Under
+ * %BLUR_SCHEDULE_LATEST_WINS a conversion only supersedes queued
+ * conversions, never blurs.
+ *
+ * Returns: Request ID for cancellation, or 0 on immediate failure
+ */
+guint blur_processor_grayscale_async(BlurProcessor *processor,
+                                    GdkPixbuf *pixbuf,
+                                    BlurPriority priority,
+                                    BlurCompletionCallback callback,
+                                    gpointer user_data);
+
+/**
+ * blur_processor_apply_stages_async:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf (must be valid)
+ * @stages: Stages to run on @pixbuf, at least one
+ * @intensity: Blur intensity 0.0-10.0, unused without %BLUR_STAGE_BLUR
+ * @is_progressive: TRUE for a fast, downscaled preview of the blur
+ * @priority: Scheduling priority of the request
+ * @callback: Completion callback function
+ * @user_data: User data passed to callback
+ *
+ * Runs a pipeline of stages as one request. With both stages the
+ * conversion is fused into the blur: the luminance of @pixbuf is written
+ * to a single plane (plus alpha), the plane is blurred, and it is expanded
+ * to RGB(A) only in the final write, so a B&W blur does about a third of
+ * the work of a colour one (half for RGBA) and no gray RGB copy is made.
+ * The result matches blurring the output of blur_processor_grayscale_async()
+ * byte for byte.
+ *
+ * Plain blurs take the same single-plane path when @pixbuf is already gray
+ * (see blur_pixbuf_is_grayscale()). Images beyond the processor's arena are
+ * blurred in colour tiles, each converted in the scratch arena just before
+ * its blur, so the result is the only image-sized buffer. A zero
+ * @intensity leaves only the conversion.
+ *
+ * Completion, cancellation and scheduling behave as for
+ * blur_processor_apply_async(); under %BLUR_SCHEDULE_LATEST_WINS a request
+ * only supersedes queued ones with the same stages.
+ *
+ * Returns: Request ID for cancellation, or 0 on immediate failure
+ */
+guint blur_processor_apply_stages_async(BlurProcessor *processor,
+                                       GdkPixbuf *pixbuf,
+                                       BlurStages stages,
+                                       gdouble intensity,
+                                       gboolean is_progressive,
+                                       BlurPriority priority,
+                                       BlurCompletionCallback callback,
+                                       gpointer user_data);
+
+/**
+ * BlurDeliveryMode:
+ * @BLUR_DELIVERY_IDLE: An idle source in a main context runs the callback,
+ *   the default context unless another one is given (the default of every
+ *   *_async() call)
+ * @BLUR_DELIVERY_WORKER: The worker thread that finished the request runs
+ *   the callback as soon as the result is ready, with no main loop involved
+ *
+ * Where a blur_processor_apply_stages_full() request completes. Callbacks
+ * on a worker must be thread-safe, must not block for long since they hold
+ * a worker, and must not wait for other requests of the same processor.
+ */
+typedef enum {
+    BLUR_DELIVERY_IDLE = 0,
+    BLUR_DELIVERY_WORKER = 1
+} BlurDeliveryMode;
+
+/**
+ * blur_processor_apply_stages_full:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf (must be valid)
+ * @stages: Stages to run on @pixbuf, at least one
+ * @intensity: Blur intensity 0.0-10.0, unused without %BLUR_STAGE_BLUR
+ * @is_progressive: TRUE for a fast, downscaled preview of the blur
+ * @priority: Scheduling priority of the request
+ * @delivery: Where @callback runs
+ * @context: Main context of %BLUR_DELIVERY_IDLE, NULL for the default one
+ * @callback: Completion callback function
+ * @user_data: User data passed to callback
+ *
+ * Same as blur_processor_apply_stages_async() with the delivery of the
+ * result chosen by the caller, so a thread running its own #GMainContext
+ * gets its results there, and callers without any main loop, such as
+ * batch tools, get them from the worker without a round trip.
+ *
+ * Immediate failures still call @callback on the calling thread before
+ * this returns. Under %BLUR_SCHEDULE_LATEST_WINS replaced worker delivered
+ * requests complete on the worker that drops them.
+ *
+ * Returns: Request ID for cancellation, or 0 on immediate failure
+ */
+guint blur_processor_apply_stages_full(BlurProcessor *processor,
+                                      GdkPixbuf *pixbuf,
+                                      BlurStages stages,
+                                      gdouble intensity,
+                                      gboolean is_progressive,
+                                      BlurPriority priority,
+                                      BlurDeliveryMode delivery,
+                                      GMainContext *context,
+                                      BlurCompletionCallback callback,
+                                      gpointer user_data);
+
+/**
+ * blur_processor_apply_sync:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf to blur (must be valid)
+ * @intensity: Blur intensity 0.0-10.0
+ * @error: Return location for error, or NULL
+ *
+ * Blurs @pixbuf at full quality on the worker pool and waits for the
+ * result, without needing a running main loop. The pass bands still run
+ * in parallel, so the call takes about as long as the blur itself, which
+ * also makes it the way to time pure compute.
+ *
+ * Must not be called from a completion callback delivered on a worker
+ * (%BLUR_DELIVERY_WORKER), which would wait for itself.
+ *
+ * Returns: (transfer full): Blurred pixbuf, or NULL with @error set
+ */
+GdkPixbuf* blur_processor_apply_sync(BlurProcessor *processor,
+                                     GdkPixbuf *pixbuf,
+                                     gdouble intensity,
+                                     GError **error);
+
+/**
+ * blur_processor_apply_stages_sync:
+ * @processor: BlurProcessor instance
+ * @pixbuf: Source pixbuf (must be valid)
+ * @stages: Stages to run on @pixbuf, at least one
+ * @intensity: Blur intensity 0.0-10.0, unused without %BLUR_STAGE_BLUR
+ * @error: Return location for error, or NULL
+ *
+ * Blocking variant of blur_processor_apply_stages_async(), see
+ * blur_processor_apply_sync().
+ *
+ * Returns: (transfer full): Result pixbuf, or NULL with @error set
+ */
+GdkPixbuf* blur_processor_apply_stages_sync(BlurProcessor *processor,
+                                            GdkPixbuf *pixbuf,
+                                            BlurStages stages,
+                                            gdouble intensity,
+                                            GError **error);
+
+/**
+ * BlurBatchItem:
+ * @pixbuf: Source pixbuf (must be valid), set by the caller
+ * @intensity: Blur intensity 0.0-10.0, set by the caller
+ * @result: Result on success, owned by the caller once the batch completes
+ * @error: Error of this item on failure, owned by the caller likewise
+ *
+ * One image of a blur_processor_apply_batch_async() batch.
+ */
+typedef struct {
+    GdkPixbuf *pixbuf;
+    gdouble intensity;
+    GdkPixbuf *result;
+    GError *error;
+} BlurBatchItem;
+
+/**
+ * BlurBatchCallback:
+ * @items: The items of the batch, each with its result or error
+ * @n_items: Number of @items
+ * @user_data: User data from blur_processor_apply_batch_async()
+ *
+ * Called once every item of a batch has completed or failed.
+ */
+typedef void (*BlurBatchCallback)(BlurBatchItem *items,
+                                  guint n_items,
+                                  gpointer user_data);
+
+/**
+ * blur_processor_apply_batch_async:
+ * @processor: BlurProcessor instance
+ * @items: Images to process; must stay alive until @callback
+ * @n_items: Number of @items
+ * @stages: Stages to run on every item, at least one
+ * @priority: Scheduling priority of the requests
+ * @delivery: Where @callback runs
+ * @context: Main context of %BLUR_DELIVERY_IDLE, NULL for the default one
+ * @callback: Called once when the whole batch is done
+ * @user_data: User data passed to callback
+ *
+ * Submits one request per item and reports them together. The items
+ * complete on the workers, so whatever @delivery is, the batch costs a
+ * single main loop round trip instead of one per image. A failed item
+ * does not fail the others; the caller checks each @error and frees every
+ * @result and @error.
+ *
+ * Items are processed concurrently and cannot be cancelled on their own.
+ * An empty batch completes on the calling thread before this returns.
+ */
+void blur_processor_apply_batch_async(BlurProcessor *processor,
+                                      BlurBatchItem *items,
+                                      guint n_items,
+                                      BlurStages stages,
+                                      BlurPriority priority,
+                                      BlurDeliveryMode delivery,
+                                      GMainContext *context,
+                                      BlurBatchCallback callback,
+                                      gpointer user_data);
+
+/**
+ * blur_processor_apply_batch_sync:
+ * @processor: BlurProcessor instance
+ * @items: Images to process
+ * @n_items: Number of @items
+ * @stages: Stages to run on every item, at least one
+ *
+ * Blocking variant of blur_processor_apply_batch_async(): returns once
+ * every item has its result or error, with the same restrictions as
+ * blur_processor_apply_sync().
+ *
+ * Returns: Number of items that failed
+ */
+guint blur_processor_apply_batch_sync(BlurProcessor *processor,
+                                      BlurBatchItem *items,
+                                      guint n_items,
+                                      BlurStages stages);
+
+/**
+ * blur_processor_set_schedule_mode:
+ * @processor: BlurProcessor instance
+ * @mode: Scheduling policy for requests submitted from now on
+ *
+ * With %BLUR_SCHEDULE_LATEST_WINS the queue holds at most one waiting
+ * request per source, quality and priority, so fast input such as a
+ * slider drag never builds up a backlog.
+ */
+void blur_processor_set_schedule_mode(BlurProcessor *processor, BlurScheduleMode mode);
+
+/**
+ * BLUR_LATENCY_WINDOW:
+ *
+ * Number of most recent samples behind each #BlurLatencyStats.
+ */
+#define BLUR_LATENCY_WINDOW 256
+
+/**
+ * BlurLatencyStats:
+ * @p50_us: Median duration in microseconds
+ * @p99_us: 99th percentile duration in microseconds
+ * @max_us: Longest duration in microseconds
+ * @samples: Number of samples, at most %BLUR_LATENCY_WINDOW
+ *
+ * Distribution of one stage's duration over the most recent requests.
+ * All fields are 0 until the stage has run.
+ */
+typedef struct {
+    gint64 p50_us;
+    gint64 p99_us;
+    gint64 max_us;
+    guint samples;
+} BlurLatencyStats;
+
+/**
+ * BlurProcessorStats:
+ * @completed_requests: Requests whose blur ran to completion
+ * @cancelled_requests: Successful blur_processor_cancel() calls
+ * @cancelled_before_start: Cancelled requests dropped from the queue
+ * @cancelled_in_flight: Cancelled requests stopped part way through
+ * @superseded_requests: Queued requests replaced under
+ *   %BLUR_SCHEDULE_LATEST_WINS (also counted as cancelled before start)
+ * @incremental_requests: Requests that blurred a lower intensity result
+ *   with a residual kernel instead of the source
+ * @tiled_requests: Requests larger than the processor's maximum size,
+ *   blurred tile by tile
+ * @grayscale_requests: Completed blur_processor_grayscale_async() requests,
+ *   also counted in @completed_requests
+ * @single_channel_requests: Blurs run on one luminance plane (plus alpha)
+ *   because the source was gray or the pipeline converted it first
+ * @result_buffers_reused: Results whose pixels reused the buffer of a
+ *   freed earlier result instead of a new allocation
+ * @scratch_bytes: Scratch memory currently allocated, idle or checked out
+ *   by running requests
+ * @time_saved_us: Estimated worker time not spent on cancelled requests,
+ *   based on the average cost per pixel of completed requests
+ * @queue_wait: Submission until a worker picks the request up
+ * @horizontal_pass: Row passes of one request: horizontal convolution,
+ *   the grayscale conversion and the luminance plane steps
+ * @vertical_pass: Column passes of one request
+ * @compute: Worker time of one request, all passes included
+ * @delivery: Worker done until the completion callback returned, which
+ *   is the time the result waited for the main loop plus the callback
+ * @total: Submission until the completion callback returned
+ * @throughput_mpixels: Blurred megapixels per second of worker time over
+ *   the requests behind @compute
+ *
+ * Counters are cumulative since the processor was created; the latency
+ * fields cover the last %BLUR_LATENCY_WINDOW completed requests, so they
+ * follow the current workload. Cancelled requests are only counted.
+ *
+ * When built with libsysprof-capture, every request, pass and delivery
+ * is also recorded as a mark in the "blur" group of a sysprof capture.
+ */
+typedef struct {
+    guint64 completed_requests;
+    guint64 cancelled_requests;
+    guint64 cancelled_before_start;
+    guint64 cancelled_in_flight;
+    guint64 superseded_requests;
+    guint64 incremental_requests;
+    guint64 tiled_requests;
+    guint64 grayscale_requests;
+    guint64 single_channel_requests;
+    guint64 result_buffers_reused;
+    gsize scratch_bytes;
+    gint64 time_saved_us;
+    BlurLatencyStats queue_wait;
+    BlurLatencyStats horizontal_pass;
+    BlurLatencyStats vertical_pass;
+    BlurLatencyStats compute;
+    BlurLatencyStats delivery;
+    BlurLatencyStats total;
+    gdouble throughput_mpixels;
+} BlurProcessorStats;
+
+/**
+ * blur_processor_get_stats:
+ * @processor: BlurProcessor instance
+ * @stats: Output structure receiving a snapshot of the counters
+ *
+ * Reports request and cancellation statistics.
+ */
+void blur_processor_get_stats(BlurProcessor *processor, BlurProcessorStats *stats);
+
+/**
+ * blur_processor_get_kernel_name:
+ * @processor: BlurProcessor instance
+ *
+ * Reports which convolution kernel implementation the processor uses.
+ *
+ * Returns: Implementation name such as "avx2" or "scalar", or NULL
+ */
+const gchar* blur_processor_get_kernel_name(BlurProcessor *processor);
+
+/**
+ * blur_processor_release_memory:
+ * @processor: BlurProcessor instance
+ *
+ * Frees memory the processor keeps around to go faster: idle scratch
+ * arenas, result buffers waiting in the pool for reuse, and the downsample
+ * of the last progressive source. Running requests keep their arenas, and
+ * everything is allocated again on demand, so the next blurs only pay for
+ * the allocations. Meant for low memory warnings.
+ *
+ * Returns: Bytes freed
+ */
+gsize blur_processor_release_memory(BlurProcessor *processor);
+
 /**
  * blur_processor_destroy:
  * @processor: BlurProcessor instance to destroy
@@ -118,6 +626,12 @@ gboolean blur_processor_cancel(BlurProcessor *processor, guint request_id);
  * Destroys blur processor and frees all resources. All worker threads
  * stopped and joined, all memory buffers freed.
  *
+ * Running requests finish first. Queued requests are dropped without
+ * being processed; those delivered on the worker (%BLUR_DELIVERY_WORKER),
+ * which includes blocking and batch requests, complete with
+ * %BLUR_ERROR_CANCELLED so no caller is left waiting. Main context
+ * deliveries get no callback.
+ *
  * Precondition: No active processing requests (call cancel first)
  */
 void blur_processor_destroy(BlurProcessor *processor);
@@ -135,6 +649,18 @@ void blur_processor_destroy(BlurProcessor *processor);
  */
 gdouble blur_calculate_sigma(gdouble intensity);
 
+/**
+ * blur_calculate_residual_sigma:
+ * @base_intensity: Intensity an image is already blurred with
+ * @intensity: Target intensity
+ *
+ * Sigma that takes a blur at @base_intensity to @intensity, from
+ * sigma_target^2 = sigma_base^2 + sigma_residual^2.
+ *
+ * Returns: Residual sigma, or 0.0 if @base_intensity is not lower
+ */
+gdouble blur_calculate_residual_sigma(gdouble base_intensity, gdouble intensity);
+
 /**
  * blur_calculate_kernel_size:
  * @sigma: Gaussian sigma value
@@ -158,6 +684,66 @@ gint blur_calculate_kernel_size(gdouble sigma);
  */
 gfloat* blur_generate_kernel(gdouble sigma, gint kernel_size);
 
+/**
+ * BLUR_FIXED_POINT_SHIFT:
+ *
+ * Fractional bits of the integer kernel weights (Q14, so 1.0 == 16384).
+ */
+#define BLUR_FIXED_POINT_SHIFT 14
+#define BLUR_FIXED_POINT_ONE (1 << BLUR_FIXED_POINT_SHIFT)
+
+/**
+ * blur_generate_kernel_fixed:
+ * @sigma: Gaussian sigma parameter
+ * @kernel_size: Size of kernel to generate (must be odd)
+ *
+ * Generates the 1D Gaussian kernel as Q14 integer weights for the 8-bit
+ * integer passes. Weights sum to exactly %BLUR_FIXED_POINT_ONE, so flat
+ * images are reproduced exactly.
+ *
+ * Each integer pass differs from the float pass by at most 1 level per
+ * channel; a full blur (two passes) is within 2 levels of the float result.
+ * Progressive requests use this path by default.
+ *
+ * Returns: Dynamically allocated kernel array, caller must g_free()
+ */
+gint16* blur_generate_kernel_fixed(gdouble sigma, gint kernel_size);
+
+/**
+ * BLUR_PREVIEW_MAX_SIZE:
+ *
+ * Longest edge, in pixels, that progressive previews aim for.
+ */
+#define BLUR_PREVIEW_MAX_SIZE 1024
+#define BLUR_PREVIEW_MAX_FACTOR 8
+
+/**
+ * blur_calculate_preview_factor:
+ * @width: Source width in pixels
+ * @height: Source height in pixels
+ *
+ * Calculates the downscale factor for progressive previews: the smallest
+ * power of two that brings the longest edge to %BLUR_PREVIEW_MAX_SIZE or
+ * below, capped at %BLUR_PREVIEW_MAX_FACTOR.
+ *
+ * Returns: 1, 2, 4 or 8
+ */
+gint blur_calculate_preview_factor(gint width, gint height);
+
+/**
+ * blur_calculate_box_sizes:
+ * @sigma: Gaussian sigma to approximate
+ * @sizes: Output array receiving @count odd box widths
+ * @count: Number of stacked box passes
+ *
+ * Calculates box widths whose repeated convolution approximates a
+ * Gaussian of the given sigma. The widths differ by at most 2 and their
+ * combined variance is as close to sigma^2 as odd widths allow.
+ *
+ * Returns: TRUE on success, FALSE for invalid parameters
+ */
+gboolean blur_calculate_box_sizes(gdouble sigma, gint *sizes, gint count);
+
 /**
  * blur_validate_intensity:
  * @intensity: Intensity value to validate
@@ -172,10 +758,23 @@ gboolean blur_validate_intensity(gdouble intensity);
  * blur_validate_pixbuf:
  * @pixbuf: Pixbuf to validate for blur processing
  *
- * Validates pixbuf is suitable for blur operations.
+ * Validates pixbuf is suitable for blur operations. There is no upper
+ * size limit; images beyond the processor's arena are tiled.
  *
  * Returns: TRUE if pixbuf valid with acceptable dimensions, FALSE otherwise
  */
 gboolean blur_validate_pixbuf(GdkPixbuf *pixbuf);
 
+/**
+ * blur_pixbuf_is_grayscale:
+ * @pixbuf: Valid 8-bit RGB or RGBA pixbuf
+ *
+ * Checks whether every pixel of @pixbuf has equal red, green and blue
+ * values, as the output of a grayscale conversion does. The scan stops at
+ * the first coloured pixel.
+ *
+ * Returns: TRUE if @pixbuf holds single-channel content
+ */
+gboolean blur_pixbuf_is_grayscale(GdkPixbuf *pixbuf);
+
 G_END_DECLS
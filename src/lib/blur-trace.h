@@ -0,0 +1,66 @@
+/* blur-trace.h - sysprof marks of the blur pipeline
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include "config.h"
+
+#ifdef HAVE_SYSPROF
+#include <sysprof-capture.h>
+#endif
+
+G_BEGIN_DECLS
+
+/**
+ * BLUR_TRACE_GROUP:
+ *
+ * Group of every blur mark in a sysprof capture.
+ */
+#define BLUR_TRACE_GROUP "blur"
+
+#ifdef HAVE_SYSPROF
+
+/**
+ * blur_trace_now:
+ *
+ * Timestamp for blur_trace_mark(), on the monotonic clock sysprof uses.
+ * Without sysprof support it is 0 and costs nothing.
+ *
+ * Returns: Current time in microseconds
+ */
+#define blur_trace_now() g_get_monotonic_time()
+
+/**
+ * blur_trace_mark:
+ * @begin_us: Start of the span, from g_get_monotonic_time()
+ * @end_us: End of the span
+ * @name: Mark name, such as "blur"
+ * @...: printf() format and arguments of the mark's message
+ *
+ * Records a span in the capture of a running `sysprof-cli` or Sysprof.
+ * Nothing is recorded when no profiler is attached; without sysprof
+ * support the mark is compiled out, arguments included.
+ */
+#define blur_trace_mark(begin_us, end_us, name, ...) \
+    sysprof_collector_mark_printf((begin_us) * 1000, ((end_us) - (begin_us)) * 1000, \
+                                  BLUR_TRACE_GROUP, name, __VA_ARGS__)
+
+#else
+
+#define blur_trace_now() G_GINT64_CONSTANT(0)
+#define blur_trace_mark(begin_us, end_us, name, ...) G_STMT_START { \
+        (void)(begin_us); \
+        (void)(end_us); \
+    } G_STMT_END
+
+#endif
+
+G_END_DECLS
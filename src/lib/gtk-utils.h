@@ -56,6 +56,52 @@ void gtk_utils_show_error_dialog(GtkWindow *parent, const char *title, const cha
  */
 char *gtk_utils_get_resource_string(const char *resource_path);
 
+/**
+ * gtk_utils_scaled_paintable_new:
+ * @pixbuf: Image content, typically a downscaled preview
+ * @width: Intrinsic width to report
+ * @height: Intrinsic height to report
+ * 
+ * Wraps @pixbuf in a paintable that reports @width x @height as its
+ * intrinsic size and stretches the content to whatever size it is drawn
+ * at. Showing a small preview this way keeps a #GtkPicture laid out as
+ * it would be for the full size image.
+ * 
+ * Returns: (transfer full): A new #GdkPaintable
+ */
+GdkPaintable *gtk_utils_scaled_paintable_new(GdkPixbuf *pixbuf, int width, int height);
+
+/**
+ * gtk_utils_blur_paintable_new:
+ * @pixbuf: Image content
+ * 
+ * Uploads @pixbuf once as a texture and draws it through a blur node of
+ * the render tree. Changing the blur only invalidates the contents, so the
+ * renderer redoes it on the GPU without any pixels leaving it. With the
+ * Cairo renderer the blur falls back to software and gains nothing.
+ * 
+ * Returns: (transfer full): A new #GdkPaintable, unblurred
+ */
+GdkPaintable *gtk_utils_blur_paintable_new(GdkPixbuf *pixbuf);
+
+/**
+ * gtk_utils_blur_paintable_set_sigma:
+ * @paintable: Paintable from gtk_utils_blur_paintable_new()
+ * @sigma: Standard deviation in image pixels, 0 to draw unblurred
+ * 
+ * Sets the blur strength. It is scaled with the drawn size, so a picture
+ * shown smaller than the image looks as the full size result would.
+ */
+void gtk_utils_blur_paintable_set_sigma(GdkPaintable *paintable, double sigma);
+
+/**
+ * gtk_utils_blur_paintable_get_sigma:
+ * @paintable: Paintable from gtk_utils_blur_paintable_new()
+ * 
+ * Returns: The blur strength in image pixels
+ */
+double gtk_utils_blur_paintable_get_sigma(GdkPaintable *paintable);
+
 G_END_DECLS
 
 #endif /* GTK_UTILS_H */
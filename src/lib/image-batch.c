@@ -0,0 +1,511 @@
+/* image-batch.c - Headless blur and grayscale of many image files
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "image-batch.h"
+#include <gio/gio.h>
+#include <string.h>
+
+typedef struct {
+    const ImageBatchOptions *options;
+    BlurProcessor *processor;
+    GPtrArray *inputs;
+    GPtrArray *outputs;         // From image_batch_plan_outputs()
+    gint next_input;            // Next index a decoder takes, atomic
+    
+    /* Images between decode and encode; guarded by mutex */
+    GMutex mutex;
+    GCond slot_cond;
+    GCond done_cond;
+    guint in_flight;
+    guint peak_in_flight;
+    guint finished;
+    guint succeeded;
+    GPtrArray *errors;
+    
+    GAsyncQueue *encode_queue;
+} ImageBatch;
+
+typedef struct {
+    ImageBatch *batch;
+    guint index;
+    GdkPixbuf *result;
+} BatchJob;
+
+// Queued once per encoder to stop it
+static BatchJob stop_job;
+
+static GdkPixbufFormat* find_writer(const gchar *name) {
+    GSList *formats = gdk_pixbuf_get_formats();
+    GdkPixbufFormat *writer = NULL;
+    
+    for (GSList *l = formats; l; l = l->next) {
+        gchar *format_name = gdk_pixbuf_format_get_name(l->data);
+        if (g_strcmp0(format_name, name) == 0 && gdk_pixbuf_format_is_writable(l->data)) {
+            writer = l->data;
+        }
+        g_free(format_name);
+    }
+    
+    g_slist_free(formats);
+    return writer;
+}
+
+static GHashTable* loader_extensions(void) {
+    GHashTable *extensions = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    GSList *formats = gdk_pixbuf_get_formats();
+    
+    for (GSList *l = formats; l; l = l->next) {
+        gchar **format_extensions = gdk_pixbuf_format_get_extensions(l->data);
+        for (gchar **ext = format_extensions; *ext; ext++) {
+            g_hash_table_add(extensions, g_ascii_strdown(*ext, -1));
+        }
+        g_strfreev(format_extensions);
+    }
+    
+    g_slist_free(formats);
+    return extensions;
+}
+
+static gboolean has_loader_extension(GHashTable *extensions, const gchar *name) {
+    const gchar *dot = strrchr(name, '.');
+    
+    if (!dot || dot == name) {
+        return FALSE;
+    }
+    
+    gchar *ext = g_ascii_strdown(dot + 1, -1);
+    gboolean known = g_hash_table_contains(extensions, ext);
+    g_free(ext);
+    return known;
+}
+
+static gint compare_names(gconstpointer a, gconstpointer b) {
+    return strcmp(*(const gchar *const *)a, *(const gchar *const *)b);
+}
+
+static void collect_directory(GPtrArray *inputs,
+                              const gchar *directory,
+                              const gchar *glob,
+                              gboolean recursive,
+                              GHashTable *extensions) {
+    GDir *dir = g_dir_open(directory, 0, NULL);
+    GPtrArray *names = g_ptr_array_new_with_free_func(g_free);
+    const gchar *name;
+    
+    if (!dir) {
+        g_ptr_array_unref(names);
+        return;
+    }
+    
+    while ((name = g_dir_read_name(dir))) {
+        g_ptr_array_add(names, g_strdup(name));
+    }
+    g_dir_close(dir);
+    
+    // Sorted, so batches run and report in a stable order
+    g_ptr_array_sort(names, compare_names);
+    
+    for (guint i = 0; i < names->len; i++) {
+        const gchar *entry = names->pdata[i];
+        gchar *path = g_build_filename(directory, entry, NULL);
+        
+        if (g_file_test(path, G_FILE_TEST_IS_DIR)) {
+            if (recursive) {
+                collect_directory(inputs, path, glob, recursive, extensions);
+            }
+        } else if (g_file_test(path, G_FILE_TEST_IS_REGULAR) &&
+                   has_loader_extension(extensions, entry) &&
+                   (!glob || g_pattern_match_simple(glob, entry))) {
+            g_ptr_array_add(inputs, g_steal_pointer(&path));
+        }
+        
+        g_free(path);
+    }
+    
+    g_ptr_array_unref(names);
+}
+
+gboolean image_batch_collect_inputs(GPtrArray *inputs,
+                                    const gchar *pattern,
+                                    gboolean recursive,
+                                    GError **error) {
+    g_return_val_if_fail(inputs != NULL, FALSE);
+    g_return_val_if_fail(pattern != NULL, FALSE);
+    
+    if (g_file_test(pattern, G_FILE_TEST_IS_REGULAR)) {
+        g_ptr_array_add(inputs, g_strdup(pattern));
+        return TRUE;
+    }
+    
+    gboolean is_directory = g_file_test(pattern, G_FILE_TEST_IS_DIR);
+    gchar *basename = g_path_get_basename(pattern);
+    
+    if (!is_directory && !strpbrk(basename, "*?")) {
+        g_free(basename);
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOENT,
+                    "%s: No such file or directory", pattern);
+        return FALSE;
+    }
+    
+    // A glob matches file names within one directory
+    gchar *directory = is_directory ? g_strdup(pattern) : g_path_get_dirname(pattern);
+    GHashTable *extensions = loader_extensions();
+    guint found = inputs->len;
+    
+    collect_directory(inputs, directory, is_directory ? NULL : basename, recursive, extensions);
+    found = inputs->len - found;
+    
+    g_hash_table_unref(extensions);
+    g_free(directory);
+    g_free(basename);
+    
+    if (found == 0) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOENT,
+                    "%s: No images found", pattern);
+        return FALSE;
+    }
+    
+    return TRUE;
+}
+
+// Output of @input; copies after the first get a "-N" suffix
+static gchar* output_name(const ImageBatchOptions *options, const gchar *input, guint copy) {
+    gchar *basename = g_path_get_basename(input);
+    gchar *dot = strrchr(basename, '.');
+    const gchar *extension = g_strcmp0(options->format, "jpeg") == 0 ? "jpg" : options->format;
+    
+    if (dot && dot != basename) {
+        *dot = '\0';
+    }
+    
+    gchar *name = copy > 1 ? g_strdup_printf("%s-%u.%s", basename, copy, extension)
+                           : g_strdup_printf("%s.%s", basename, extension);
+    gchar *path = g_build_filename(options->output_dir, name, NULL);
+    
+    g_free(name);
+    g_free(basename);
+    return path;
+}
+
+gchar* image_batch_output_path(const ImageBatchOptions *options, const gchar *input) {
+    return output_name(options, input, 1);
+}
+
+// Device and inode, or the platform's equivalent, of what @path points to
+static gchar* file_id(const gchar *path) {
+    GFile *file = g_file_new_for_path(path);
+    GFileInfo *info = g_file_query_info(file, G_FILE_ATTRIBUTE_ID_FILE,
+                                        G_FILE_QUERY_INFO_NONE, NULL, NULL);
+    gchar *id = NULL;
+    
+    if (info) {
+        id = g_strdup(g_file_info_get_attribute_string(info, G_FILE_ATTRIBUTE_ID_FILE));
+        g_object_unref(info);
+    }
+    g_object_unref(file);
+    return id;
+}
+
+// Adds the normalized name of @path and, when it exists, its file id, so
+// other spellings of the name and links to the file both match
+static void add_file_keys(GHashTable *files, const gchar *path) {
+    gchar *id = file_id(path);
+    
+    g_hash_table_add(files, g_canonicalize_filename(path, NULL));
+    if (id) {
+        g_hash_table_add(files, id);
+    }
+}
+
+static gboolean names_file_in(GHashTable *files, const gchar *path) {
+    gchar *canonical = g_canonicalize_filename(path, NULL);
+    gboolean found = g_hash_table_contains(files, canonical);
+    
+    if (!found) {
+        gchar *id = file_id(path);
+        found = id && g_hash_table_contains(files, id);
+        g_free(id);
+    }
+    
+    g_free(canonical);
+    return found;
+}
+
+GPtrArray* image_batch_plan_outputs(const ImageBatchOptions *options, GPtrArray *inputs) {
+    g_return_val_if_fail(options != NULL, NULL);
+    g_return_val_if_fail(inputs != NULL, NULL);
+    
+    GHashTable *input_files = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    GHashTable *taken = g_hash_table_new(g_str_hash, g_str_equal);
+    GPtrArray *outputs = g_ptr_array_new_full(inputs->len, g_free);
+    
+    for (guint i = 0; i < inputs->len; i++) {
+        add_file_keys(input_files, inputs->pdata[i]);
+    }
+    
+    // In input order, so the first of several same-named images keeps the
+    // plain name on every run
+    for (guint i = 0; i < inputs->len; i++) {
+        gchar *path = NULL;
+        
+        for (guint copy = 1; ; copy++) {
+            path = output_name(options, inputs->pdata[i], copy);
+            gboolean is_input = names_file_in(input_files, path);
+            
+            if (is_input && copy == 1) {
+                // The output directory holds this very image
+                g_clear_pointer(&path, g_free);
+                break;
+            }
+            if (!is_input && !g_hash_table_contains(taken, path)) {
+                break;
+            }
+            g_free(path);
+        }
+        
+        if (path) {
+            g_hash_table_add(taken, path);
+        }
+        g_ptr_array_add(outputs, path);
+    }
+    
+    g_hash_table_unref(taken);
+    g_hash_table_unref(input_files);
+    return outputs;
+}
+
+static void acquire_slot(ImageBatch *batch) {
+    g_mutex_lock(&batch->mutex);
+    while (batch->in_flight >= batch->options->max_in_flight) {
+        g_cond_wait(&batch->slot_cond, &batch->mutex);
+    }
+    batch->in_flight++;
+    batch->peak_in_flight = MAX(batch->peak_in_flight, batch->in_flight);
+    g_mutex_unlock(&batch->mutex);
+}
+
+// Ends an image: frees its slot for the decoders and counts it as done
+static void finish_image(ImageBatch *batch, guint index, const GError *error) {
+    g_mutex_lock(&batch->mutex);
+    batch->in_flight--;
+    batch->finished++;
+    if (error) {
+        g_ptr_array_add(batch->errors, g_strdup_printf("%s: %s",
+                                                       (const gchar *)batch->inputs->pdata[index],
+                                                       error->message));
+    } else {
+        batch->succeeded++;
+    }
+    g_cond_signal(&batch->slot_cond);
+    if (batch->finished == batch->inputs->len) {
+        g_cond_signal(&batch->done_cond);
+    }
+    g_mutex_unlock(&batch->mutex);
+}
+
+// Processor worker, or the decoder on an immediate failure
+static void on_stages_done(GdkPixbuf *result_pixbuf, const GError *error, gpointer user_data) {
+    BatchJob *job = user_data;
+    
+    if (error || !result_pixbuf) {
+        GError *missing = error ? NULL : g_error_new(BLUR_ERROR, BLUR_ERROR_PROCESSING_FAILED,
+                                                     "No result");
+        finish_image(job->batch, job->index, error ? error : missing);
+        g_clear_error(&missing);
+        g_free(job);
+        return;
+    }
+    
+    // The processor drops its reference after this returns
+    job->result = g_object_ref(result_pixbuf);
+    g_async_queue_push(job->batch->encode_queue, job);
+}
+
+static gpointer decoder_thread(gpointer user_data) {
+    ImageBatch *batch = user_data;
+    
+    for (;;) {
+        guint index = (guint)g_atomic_int_add(&batch->next_input, 1);
+        if (index >= batch->inputs->len) {
+            break;
+        }
+        
+        // Backpressure: no decode starts while the pipeline is full
+        acquire_slot(batch);
+        
+        GError *error = NULL;
+        if (!batch->outputs->pdata[index]) {
+            g_set_error(&error, G_FILE_ERROR, G_FILE_ERROR_EXIST,
+                        "Output would overwrite an input image");
+            finish_image(batch, index, error);
+            g_error_free(error);
+            continue;
+        }
+        
+        GdkPixbuf *decoded = gdk_pixbuf_new_from_file(batch->inputs->pdata[index], &error);
+        if (!decoded) {
+            finish_image(batch, index, error);
+            g_error_free(error);
+            continue;
+        }
+        
+        GdkPixbuf *oriented = gdk_pixbuf_apply_embedded_orientation(decoded);
+        g_object_unref(decoded);
+        
+        BatchJob *job = g_new0(BatchJob, 1);
+        job->batch = batch;
+        job->index = index;
+        // Results go straight from the worker to the encoders, without
+        // a main loop round trip per image
+        blur_processor_apply_stages_full(batch->processor, oriented,
+                                         batch->options->stages,
+                                         batch->options->intensity,
+                                         FALSE,
+                                         BLUR_PRIORITY_NORMAL,
+                                         BLUR_DELIVERY_WORKER,
+                                         NULL,
+                                         on_stages_done,
+                                         job);
+        g_object_unref(oriented);
+    }
+    
+    return NULL;
+}
+
+static gpointer encoder_thread(gpointer user_data) {
+    ImageBatch *batch = user_data;
+    
+    for (;;) {
+        BatchJob *job = g_async_queue_pop(batch->encode_queue);
+        if (job == &stop_job) {
+            break;
+        }
+        
+        GError *error = NULL;
+        const gchar *output = batch->outputs->pdata[job->index];
+        
+        gdk_pixbuf_save(job->result, output, batch->options->format, &error, NULL);
+        
+        // Unreferenced before the slot frees, so the buffer is back in the
+        // processor's pool when the next result needs one
+        g_object_unref(job->result);
+        finish_image(batch, job->index, error);
+        
+        g_clear_error(&error);
+        g_free(job);
+    }
+    
+    return NULL;
+}
+
+static gboolean validate_options(const ImageBatchOptions *options, GError **error) {
+    if (!options->stages) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "No stages to run");
+        return FALSE;
+    }
+    
+    if ((options->stages & BLUR_STAGE_BLUR) &&
+        (options->intensity <= 0.0 || !blur_validate_intensity(options->intensity))) {
+        g_set_error(error, BLUR_ERROR, BLUR_ERROR_INVALID_INTENSITY,
+                    "Blur intensity must be above 0.0 and at most 10.0");
+        return FALSE;
+    }
+    
+    if (!options->output_dir || !g_file_test(options->output_dir, G_FILE_TEST_IS_DIR)) {
+        g_set_error(error, G_FILE_ERROR, G_FILE_ERROR_NOTDIR,
+                    "%s: Not a directory", options->output_dir ? options->output_dir : "(null)");
+        return FALSE;
+    }
+    
+    if (!options->format || !find_writer(options->format)) {
+        g_set_error(error, GDK_PIXBUF_ERROR, GDK_PIXBUF_ERROR_UNKNOWN_TYPE,
+                    "No gdk-pixbuf writer for format \"%s\"",
+                    options->format ? options->format : "(null)");
+        return FALSE;
+    }
+    
+    if (options->decoders < 1 || options->encoders < 1 || options->max_in_flight < 1) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+                    "Decoders, encoders and images in flight must be at least 1");
+        return FALSE;
+    }
+    
+    return TRUE;
+}
+
+gboolean image_batch_run(BlurProcessor *processor,
+                         const ImageBatchOptions *options,
+                         GPtrArray *inputs,
+                         ImageBatchResult *result,
+                         GError **error) {
+    g_return_val_if_fail(processor != NULL, FALSE);
+    g_return_val_if_fail(options != NULL, FALSE);
+    g_return_val_if_fail(inputs != NULL, FALSE);
+    g_return_val_if_fail(result != NULL, FALSE);
+    
+    memset(result, 0, sizeof(*result));
+    if (!validate_options(options, error)) {
+        return FALSE;
+    }
+    
+    ImageBatch batch = {
+        .options = options,
+        .processor = processor,
+        .inputs = inputs,
+        .outputs = image_batch_plan_outputs(options, inputs),
+        .errors = g_ptr_array_new_with_free_func(g_free),
+        .encode_queue = g_async_queue_new(),
+    };
+    gint64 start = g_get_monotonic_time();
+    GThread **decoders = g_new(GThread *, options->decoders);
+    GThread **encoders = g_new(GThread *, options->encoders);
+    
+    g_mutex_init(&batch.mutex);
+    g_cond_init(&batch.slot_cond);
+    g_cond_init(&batch.done_cond);
+    
+    for (guint i = 0; i < options->encoders; i++) {
+        encoders[i] = g_thread_new("image-encode", encoder_thread, &batch);
+    }
+    for (guint i = 0; i < options->decoders; i++) {
+        decoders[i] = g_thread_new("image-decode", decoder_thread, &batch);
+    }
+    
+    g_mutex_lock(&batch.mutex);
+    while (batch.finished < inputs->len) {
+        g_cond_wait(&batch.done_cond, &batch.mutex);
+    }
+    g_mutex_unlock(&batch.mutex);
+    
+    for (guint i = 0; i < options->decoders; i++) {
+        g_thread_join(decoders[i]);
+    }
+    for (guint i = 0; i < options->encoders; i++) {
+        g_async_queue_push(batch.encode_queue, &stop_job);
+    }
+    for (guint i = 0; i < options->encoders; i++) {
+        g_thread_join(encoders[i]);
+    }
+    
+    result->succeeded = batch.succeeded;
+    result->failed = batch.errors->len;
+    result->errors = batch.errors;
+    result->peak_in_flight = batch.peak_in_flight;
+    result->elapsed_us = g_get_monotonic_time() - start;
+    
+    g_free(decoders);
+    g_free(encoders);
+    g_ptr_array_unref(batch.outputs);
+    g_async_queue_unref(batch.encode_queue);
+    g_cond_clear(&batch.slot_cond);
+    g_cond_clear(&batch.done_cond);
+    g_mutex_clear(&batch.mutex);
+    return TRUE;
+}
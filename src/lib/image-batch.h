@@ -0,0 +1,134 @@
+/* image-batch.h - Headless blur and grayscale of many image files
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include "blur-processor.h"
+
+G_BEGIN_DECLS
+
+/**
+ * ImageBatchOptions:
+ * @stages: Stages run on every image, at least one
+ * @intensity: Blur intensity 0.0-10.0, unused without %BLUR_STAGE_BLUR
+ * @output_dir: Existing directory receiving the results
+ * @format: gdk-pixbuf writer of the results, such as "png" or "jpeg"
+ * @decoders: Decoder threads, at least 1
+ * @encoders: Encoder threads, at least 1
+ * @max_in_flight: Images held at once between decode and encode, at least 1
+ *
+ * What image_batch_run() does to its inputs and how wide it runs
+ */
+typedef struct {
+    BlurStages stages;
+    gdouble intensity;
+    const gchar *output_dir;
+    const gchar *format;
+    guint decoders;
+    guint encoders;
+    guint max_in_flight;
+} ImageBatchOptions;
+
+/**
+ * ImageBatchResult:
+ * @succeeded: Images written to the output directory
+ * @failed: Images that could not be decoded, processed or written
+ * @errors: One "path: message" string per failed image
+ * @peak_in_flight: Most images held between decode and encode at once
+ * @elapsed_us: Wall clock time of the whole batch
+ *
+ * Outcome of image_batch_run(); free @errors with g_ptr_array_unref()
+ */
+typedef struct {
+    guint succeeded;
+    guint failed;
+    GPtrArray *errors;
+    guint peak_in_flight;
+    gint64 elapsed_us;
+} ImageBatchResult;
+
+/**
+ * image_batch_collect_inputs:
+ * @inputs: Array of paths receiving the images found, freed with g_free()
+ * @pattern: Image file, directory, or glob such as "photos/IMG_*.jpg"
+ * @recursive: TRUE to also search subdirectories of a directory
+ * @error: Return location for error, or NULL
+ *
+ * Adds the images @pattern names to @inputs. Directories and globs only
+ * contribute files with an extension a gdk-pixbuf loader knows, sorted by
+ * name; a file given by name is added as is.
+ *
+ * Returns: TRUE on success, FALSE if @pattern names nothing readable
+ */
+gboolean image_batch_collect_inputs(GPtrArray *inputs,
+                                    const gchar *pattern,
+                                    gboolean recursive,
+                                    GError **error);
+
+/**
+ * image_batch_output_path:
+ * @options: Batch options
+ * @input: Path of an input image
+ *
+ * Returns: The path @input is written to unless another input of its batch
+ *   claims it first: the basename of @input in the output directory with
+ *   the extension of the output format. Free with g_free().
+ */
+gchar* image_batch_output_path(const ImageBatchOptions *options, const gchar *input);
+
+/**
+ * image_batch_plan_outputs:
+ * @options: Batch options
+ * @inputs: Paths of the images of the batch
+ *
+ * Names the output of every input as image_batch_run() does. Inputs from
+ * different directories may share a basename, as with a recursive search;
+ * the first keeps image_batch_output_path() and later ones get a "-2",
+ * "-3", ... suffix, so no two images write the same file. An input whose
+ * output would be the input file itself, through any spelling of its
+ * path or a link, gets NULL and is not processed.
+ *
+ * Returns: (transfer full): One path or NULL per input, in order. Free
+ *   with g_ptr_array_unref().
+ */
+GPtrArray* image_batch_plan_outputs(const ImageBatchOptions *options, GPtrArray *inputs);
+
+/**
+ * image_batch_run:
+ * @processor: Processor whose worker pool runs the stages
+ * @options: What to do and how wide to run
+ * @inputs: Paths of the images to process
+ * @result: Output structure receiving the outcome
+ * @error: Return location for error, or NULL
+ *
+ * Decodes, processes and encodes every image of @inputs in a pipeline:
+ * @options->decoders threads decode, @processor's pool runs the stages
+ * and @options->encoders threads encode. Decoders wait while
+ * @options->max_in_flight images are between decode and encode, so memory
+ * stays bounded by that many images however long @inputs is, and result
+ * buffers return to the processor's pool as soon as they are written.
+ *
+ * Blocks until every image is done. Results are delivered on the
+ * workers (%BLUR_DELIVERY_WORKER), so no main loop is needed or iterated.
+ * A failed image does not stop the others. Outputs are named by
+ * image_batch_plan_outputs(); images that would overwrite themselves fail
+ * with %G_FILE_ERROR_EXIST.
+ *
+ * Returns: TRUE if the batch ran, FALSE if @options are invalid
+ */
+gboolean image_batch_run(BlurProcessor *processor,
+                         const ImageBatchOptions *options,
+                         GPtrArray *inputs,
+                         ImageBatchResult *result,
+                         GError **error);
+
+G_END_DECLS
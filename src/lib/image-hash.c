@@ -0,0 +1,217 @@
+/* image-hash.c - Full-content hashing of decoded images
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include "image-hash.h"
+#include <string.h>
+
+/* XXH64: four independent 64-bit lanes consume 32-byte stripes, which
+ * keeps the multiplier pipelines busy and runs at memory bandwidth on
+ * large images without any intrinsics. */
+#define PRIME64_1 G_GUINT64_CONSTANT(0x9E3779B185EBCA87)
+#define PRIME64_2 G_GUINT64_CONSTANT(0xC2B2AE3D27D4EB4F)
+#define PRIME64_3 G_GUINT64_CONSTANT(0x165667B19E3779F9)
+#define PRIME64_4 G_GUINT64_CONSTANT(0x85EBCA77C2B2AE63)
+#define PRIME64_5 G_GUINT64_CONSTANT(0x27D4EB2F165667C5)
+
+#define STRIPE_SIZE 32
+
+typedef struct {
+    guint64 lanes[4];
+    guint8 buffer[STRIPE_SIZE];
+    gsize buffered;
+    guint64 total_length;
+    guint64 seed;
+} HashState;
+
+static inline guint64 rotl64(guint64 value, guint bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline guint64 read_u64(const guint8 *p)
+{
+    guint64 value;
+    memcpy(&value, p, sizeof(value));
+    return GUINT64_FROM_LE(value);
+}
+
+static inline guint32 read_u32(const guint8 *p)
+{
+    guint32 value;
+    memcpy(&value, p, sizeof(value));
+    return GUINT32_FROM_LE(value);
+}
+
+static inline guint64 hash_round(guint64 lane, guint64 input)
+{
+    lane += input * PRIME64_2;
+    lane = rotl64(lane, 31);
+    return lane * PRIME64_1;
+}
+
+static inline guint64 hash_merge_round(guint64 hash, guint64 lane)
+{
+    hash ^= hash_round(0, lane);
+    return hash * PRIME64_1 + PRIME64_4;
+}
+
+static inline void hash_stripe(HashState *state, const guint8 *p)
+{
+    state->lanes[0] = hash_round(state->lanes[0], read_u64(p));
+    state->lanes[1] = hash_round(state->lanes[1], read_u64(p + 8));
+    state->lanes[2] = hash_round(state->lanes[2], read_u64(p + 16));
+    state->lanes[3] = hash_round(state->lanes[3], read_u64(p + 24));
+}
+
+static void hash_init(HashState *state, guint64 seed)
+{
+    memset(state, 0, sizeof(*state));
+    state->seed = seed;
+    state->lanes[0] = seed + PRIME64_1 + PRIME64_2;
+    state->lanes[1] = seed + PRIME64_2;
+    state->lanes[2] = seed;
+    state->lanes[3] = seed - PRIME64_1;
+}
+
+static void hash_update(HashState *state, const guint8 *data, gsize length)
+{
+    state->total_length += length;
+    
+    // Top up a partial stripe left by the previous call
+    if (state->buffered > 0) {
+        gsize needed = STRIPE_SIZE - state->buffered;
+        
+        if (length < needed) {
+            memcpy(state->buffer + state->buffered, data, length);
+            state->buffered += length;
+            return;
+        }
+        
+        memcpy(state->buffer + state->buffered, data, needed);
+        hash_stripe(state, state->buffer);
+        state->buffered = 0;
+        data += needed;
+        length -= needed;
+    }
+    
+    while (length >= STRIPE_SIZE) {
+        hash_stripe(state, data);
+        data += STRIPE_SIZE;
+        length -= STRIPE_SIZE;
+    }
+    
+    if (length > 0) {
+        memcpy(state->buffer, data, length);
+        state->buffered = length;
+    }
+}
+
+static guint64 hash_digest(const HashState *state)
+{
+    guint64 hash;
+    
+    if (state->total_length >= STRIPE_SIZE) {
+        hash = rotl64(state->lanes[0], 1) + rotl64(state->lanes[1], 7) +
+               rotl64(state->lanes[2], 12) + rotl64(state->lanes[3], 18);
+        for (int i = 0; i < 4; i++) {
+            hash = hash_merge_round(hash, state->lanes[i]);
+        }
+    } else {
+        hash = state->seed + PRIME64_5;
+    }
+    
+    hash += state->total_length;
+    
+    // Fold in the tail that did not fill a whole stripe
+    const guint8 *p = state->buffer;
+    gsize remaining = state->buffered;
+    
+    while (remaining >= 8) {
+        hash ^= hash_round(0, read_u64(p));
+        hash = rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+        remaining -= 8;
+    }
+    
+    if (remaining >= 4) {
+        hash ^= (guint64)read_u32(p) * PRIME64_1;
+        hash = rotl64(hash, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+        remaining -= 4;
+    }
+    
+    while (remaining > 0) {
+        hash ^= (*p) * PRIME64_5;
+        hash = rotl64(hash, 11) * PRIME64_1;
+        p++;
+        remaining--;
+    }
+    
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    
+    return hash;
+}
+
+guint64 image_hash_bytes(gconstpointer data, gsize length, guint64 seed)
+{
+    HashState state;
+    
+    g_return_val_if_fail(data != NULL || length == 0, 0);
+    
+    hash_init(&state, seed);
+    hash_update(&state, data, length);
+    return hash_digest(&state);
+}
+
+guint64 image_hash_pixbuf(GdkPixbuf *pixbuf)
+{
+    HashState state;
+    
+    g_return_val_if_fail(GDK_IS_PIXBUF(pixbuf), 0);
+    
+    int width = gdk_pixbuf_get_width(pixbuf);
+    int height = gdk_pixbuf_get_height(pixbuf);
+    int channels = gdk_pixbuf_get_n_channels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    const guint8 *pixels = gdk_pixbuf_read_pixels(pixbuf);
+    gsize row_bytes = (gsize)width * channels;
+    
+    // Geometry goes first so a 100x200 and a 200x100 image with the same
+    // bytes do not collide
+    guint32 geometry[3] = {
+        GUINT32_TO_LE((guint32)width),
+        GUINT32_TO_LE((guint32)height),
+        GUINT32_TO_LE((guint32)channels)
+    };
+    
+    hash_init(&state, 0);
+    hash_update(&state, (const guint8 *)geometry, sizeof(geometry));
+    
+    if ((gsize)rowstride == row_bytes) {
+        // Tightly packed rows hash as one contiguous run
+        hash_update(&state, pixels, row_bytes * height);
+    } else {
+        for (int y = 0; y < height; y++) {
+            hash_update(&state, pixels + (gsize)y * rowstride, row_bytes);
+        }
+    }
+    
+    return hash_digest(&state);
+}
+
+gchar* image_hash_to_string(guint64 hash)
+{
+    return g_strdup_printf("img_%016" G_GINT64_MODIFIER "x", hash);
+}
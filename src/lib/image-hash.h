@@ -0,0 +1,53 @@
+/* image-hash.h - Full-content hashing of decoded images
+ *
+ * Copyright (C) 2026 Image Viewer Contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+G_BEGIN_DECLS
+
+/**
+ * image_hash_bytes:
+ * @data: Bytes to hash
+ * @length: Number of bytes in @data
+ * @seed: Hash seed
+ *
+ * Computes the 64-bit XXH64 hash of @data. The result matches the
+ * reference xxHash implementation for the same input and seed.
+ *
+ * Returns: 64-bit hash of @data
+ */
+guint64 image_hash_bytes(gconstpointer data, gsize length, guint64 seed);
+
+/**
+ * image_hash_pixbuf:
+ * @pixbuf: Image to hash
+ *
+ * Hashes the geometry and every pixel of @pixbuf. Rowstride padding is
+ * skipped, so equal images hash equally whatever their row alignment.
+ * Only reads pixels, so it is safe to call from a worker thread.
+ *
+ * Returns: 64-bit content hash
+ */
+guint64 image_hash_pixbuf(GdkPixbuf *pixbuf);
+
+/**
+ * image_hash_to_string:
+ * @hash: Value from image_hash_pixbuf()
+ *
+ * Formats @hash as the key string used by the blur and disk caches.
+ *
+ * Returns: (transfer full): String of the form `img_<16 hex digits>`
+ */
+gchar* image_hash_to_string(guint64 hash);
+
+G_END_DECLS
@@ -1,6 +1,13 @@
 #include "image-processing.h"
 #include <math.h>
 
+/* Q15 luminance weights summing to exactly 1 << 15, so gray input maps
+ * to itself; must match the kernels in blur-kernels.c */
+#define GRAY_WEIGHT_R 9798
+#define GRAY_WEIGHT_G 19235
+#define GRAY_WEIGHT_B 3735
+#define GRAY_SHIFT 15
+
 /**
  * Error domain implementation for image processing
  */
@@ -35,15 +42,12 @@ image_processor_validate_pixbuf(GdkPixbuf *pixbuf)
     }
     
     /* Check if pixbuf has pixel data */
-    if (gdk_pixbuf_get_pixels(pixbuf) == NULL) {
-        return FALSE;
-    }
-    
-    /* Check for reasonable size limits (e.g., not larger than 100MP) */
-    if (width > 10000 || height > 10000) {
+    if (gdk_pixbuf_read_pixels(pixbuf) == NULL) {
         return FALSE;
     }
     
+    /* No upper size limit: the conversion is pointwise and needs no
+     * memory beyond the output, whose allocation failure is reported */
     return TRUE;
 }
 
@@ -74,6 +78,44 @@ image_processor_estimate_memory_usage(gint width, gint height)
     return original_size + converted_size + overhead;
 }
 
+/**
+ * image_processor_fit_size:
+ * @width: Source width in pixels
+ * @height: Source height in pixels
+ * @max_width: Width of the bounding box
+ * @max_height: Height of the bounding box
+ * @fitted_width: Location for the fitted width
+ * @fitted_height: Location for the fitted height
+ * 
+ * Scales the source size down uniformly until it fits the box.
+ * 
+ * Returns: TRUE if the source had to be scaled down
+ */
+gboolean
+image_processor_fit_size(gint width, gint height,
+                         gint max_width, gint max_height,
+                         gint *fitted_width, gint *fitted_height)
+{
+    g_return_val_if_fail(fitted_width != NULL && fitted_height != NULL, FALSE);
+    
+    *fitted_width = width;
+    *fitted_height = height;
+    
+    if (width <= 0 || height <= 0 || max_width <= 0 || max_height <= 0)
+        return FALSE;
+    
+    if (width <= max_width && height <= max_height)
+        return FALSE;
+    
+    /* The tighter of the two limits decides the scale */
+    gdouble scale = MIN((gdouble)max_width / width, (gdouble)max_height / height);
+    
+    *fitted_width = CLAMP((gint)(width * scale + 0.5), 1, max_width);
+    *fitted_height = CLAMP((gint)(height * scale + 0.5), 1, max_height);
+    
+    return TRUE;
+}
+
 /**
  * image_processor_convert_to_grayscale:
  * @original: Source color image
@@ -83,7 +125,9 @@ image_processor_estimate_memory_usage(gint width, gint height)
  * This provides perceptually accurate grayscale conversion by weighting
  * RGB channels according to human eye sensitivity.
  * 
- * Formula: Y = 0.299*R + 0.587*G + 0.114*B
+ * Formula: Y = 0.299*R + 0.587*G + 0.114*B, evaluated with the same Q15
+ * integer weights as blur_processor_grayscale_async() so both give
+ * identical pixels.
  * 
  * Returns: New grayscale GdkPixbuf or NULL on error
  */
@@ -113,16 +157,6 @@ image_processor_convert_to_grayscale(GdkPixbuf *original, GError **error)
     gint rowstride = gdk_pixbuf_get_rowstride(original);
     gboolean has_alpha = gdk_pixbuf_get_has_alpha(original);
     
-    /* Check memory requirements */
-    gsize estimated_memory = image_processor_estimate_memory_usage(width, height);
-    if (estimated_memory > 500 * 1024 * 1024) { /* 500MB limit */
-        g_set_error(error, IMAGE_PROCESSOR_ERROR,
-                   IMAGE_PROCESSOR_ERROR_MEMORY_ALLOCATION,
-                   "Image too large for processing (estimated %lu MB)",
-                   estimated_memory / (1024 * 1024));
-        return NULL;
-    }
-    
     /* Create new grayscale pixbuf with same dimensions and alpha channel */
     GdkPixbuf *grayscale = gdk_pixbuf_new(GDK_COLORSPACE_RGB,
                                          has_alpha,
@@ -138,17 +172,17 @@ image_processor_convert_to_grayscale(GdkPixbuf *original, GError **error)
     }
     
     /* Get pixel data pointers */
-    guchar *src_pixels = gdk_pixbuf_get_pixels(original);
+    const guchar *src_pixels = gdk_pixbuf_read_pixels(original);
     guchar *dst_pixels = gdk_pixbuf_get_pixels(grayscale);
     gint dst_rowstride = gdk_pixbuf_get_rowstride(grayscale);
     
     /* Convert pixel by pixel using ITU-R BT.709 luminance formula */
     for (gint y = 0; y < height; y++) {
-        guchar *src_row = src_pixels + y * rowstride;
-        guchar *dst_row = dst_pixels + y * dst_rowstride;
+        const guchar *src_row = src_pixels + (gsize)y * rowstride;
+        guchar *dst_row = dst_pixels + (gsize)y * dst_rowstride;
         
         for (gint x = 0; x < width; x++) {
-            guchar *src_pixel = src_row + x * n_channels;
+            const guchar *src_pixel = src_row + x * n_channels;
             guchar *dst_pixel = dst_row + x * (has_alpha ? 4 : 3);
             
             /* Extract RGB values */
@@ -157,8 +191,9 @@ image_processor_convert_to_grayscale(GdkPixbuf *original, GError **error)
             guchar blue = src_pixel[2];
             
             /* Calculate grayscale value using ITU-R BT.709 formula */
-            gdouble luminance = 0.299 * red + 0.587 * green + 0.114 * blue;
-            guchar gray_value = (guchar)CLAMP(luminance, 0, 255);
+            guint luminance = red * GRAY_WEIGHT_R + green * GRAY_WEIGHT_G +
+                              blue * GRAY_WEIGHT_B;
+            guchar gray_value = (guchar)(luminance >> GRAY_SHIFT);
             
             /* Set RGB channels to grayscale value */
             dst_pixel[0] = gray_value; /* Red */
@@ -50,7 +50,7 @@ GdkPixbuf* image_processor_convert_to_grayscale(GdkPixbuf *original, GError **er
  * @pixbuf: (nullable): GdkPixbuf to validate
  * 
  * Validates pixbuf for conversion compatibility.
- * Checks format support, dimensions, and memory requirements.
+ * Checks format support and dimensions; there is no upper size limit.
  * 
  * Returns: TRUE if pixbuf can be safely converted
  */
@@ -68,6 +68,25 @@ gboolean image_processor_validate_pixbuf(GdkPixbuf *pixbuf);
  */
 gsize image_processor_estimate_memory_usage(gint width, gint height);
 
+/**
+ * image_processor_fit_size:
+ * @width: Source width in pixels
+ * @height: Source height in pixels
+ * @max_width: Width of the bounding box
+ * @max_height: Height of the bounding box
+ * @fitted_width: (out): Width of the fitted image
+ * @fitted_height: (out): Height of the fitted image
+ * 
+ * Computes the largest size with the aspect ratio of @width x @height
+ * that fits in @max_width x @max_height. Images that already fit keep
+ * their size; nothing is ever scaled up.
+ * 
+ * Returns: TRUE if the fitted size is smaller than the source
+ */
+gboolean image_processor_fit_size(gint width, gint height,
+                                  gint max_width, gint max_height,
+                                  gint *fitted_width, gint *fitted_height);
+
 G_END_DECLS
 
 #endif /* IMAGE_PROCESSING_H */
\ No newline at end of file
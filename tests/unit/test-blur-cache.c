@@ -252,10 +252,446 @@ START_TEST(test_cache_statistics) {
 }
 END_TEST
 
+/* Test: Contains checks without touching LRU order or statistics */
+START_TEST(test_cache_contains_is_silent) {
+    GdkPixbuf *pixbuf = create_test_pixbuf(30, 30, 10, 20, 30);
+    
+    blur_cache_put(test_cache, "contains_test", 2.0, pixbuf);
+    
+    ck_assert(blur_cache_contains(test_cache, "contains_test", 2.0));
+    ck_assert(blur_cache_contains(test_cache, "contains_test", 2.04)); // Same 0.1 bucket
+    ck_assert(!blur_cache_contains(test_cache, "contains_test", 2.1));
+    ck_assert(!blur_cache_contains(test_cache, "other_hash", 2.0));
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(test_cache, &stats);
+    ck_assert_int_eq(stats.hit_count, 0);
+    ck_assert_int_eq(stats.miss_count, 0);
+    
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Room check matches the eviction limits */
+START_TEST(test_cache_has_room) {
+    BlurCache *cache = blur_cache_create(2, 1024 * 1024);
+    GdkPixbuf *pixbuf = create_test_pixbuf(100, 100, 0, 0, 0);
+    gsize entry_size = blur_cache_calculate_pixbuf_size(pixbuf);
+    
+    ck_assert(blur_cache_has_room(cache, entry_size));
+    ck_assert(!blur_cache_has_room(cache, 2 * 1024 * 1024)); // Over the memory limit
+    
+    blur_cache_put(cache, "room_test", 1.0, pixbuf);
+    ck_assert(blur_cache_has_room(cache, entry_size));
+    
+    blur_cache_put(cache, "room_test", 2.0, pixbuf);
+    ck_assert(!blur_cache_has_room(cache, entry_size)); // Entry limit reached
+    
+    blur_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Nearest lower lookup picks the closest intensity below the target */
+START_TEST(test_cache_nearest_lower) {
+    GdkPixbuf *low = create_test_pixbuf(20, 20, 1, 1, 1);
+    GdkPixbuf *high = create_test_pixbuf(20, 20, 2, 2, 2);
+    gdouble found = 0.0;
+    
+    blur_cache_put(test_cache, "nearest_test", 1.0, low);
+    blur_cache_put(test_cache, "nearest_test", 3.5, high);
+    
+    GdkPixbuf *result = blur_cache_get_nearest_lower(test_cache, "nearest_test", 4.0, &found);
+    ck_assert_ptr_eq(result, high);
+    ck_assert_double_eq_tol(found, 3.5, 1e-9);
+    g_object_unref(result);
+    
+    result = blur_cache_get_nearest_lower(test_cache, "nearest_test", 3.5, &found);
+    ck_assert_ptr_eq(result, low);
+    ck_assert_double_eq_tol(found, 1.0, 1e-9);
+    g_object_unref(result);
+    
+    ck_assert_ptr_null(blur_cache_get_nearest_lower(test_cache, "nearest_test", 1.0, &found));
+    ck_assert_ptr_null(blur_cache_get_nearest_lower(test_cache, "other_hash", 4.0, &found));
+    
+    g_object_unref(low);
+    g_object_unref(high);
+}
+END_TEST
+
+/* Test: LRU order holds across thousands of thumbnail-sized entries */
+START_TEST(test_lru_many_entries) {
+    BlurCache *cache = blur_cache_create(1000, 8 * 1024 * 1024);
+    GdkPixbuf *thumbnail = create_test_pixbuf(4, 4, 9, 9, 9);
+    gchar hash[32];
+    
+    for (int i = 0; i < 1500; i++) {
+        g_snprintf(hash, sizeof(hash), "thumb_%d", i);
+        ck_assert(blur_cache_put(cache, hash, 1.0, thumbnail));
+    }
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_int_eq(stats.current_entries, 1000);
+    ck_assert_uint_eq(stats.eviction_count, 500);
+    ck_assert(!blur_cache_contains(cache, "thumb_499", 1.0));
+    ck_assert(blur_cache_contains(cache, "thumb_500", 1.0));
+    
+    /* Touching the oldest entry saves it from the next eviction */
+    GdkPixbuf *hit = blur_cache_get(cache, "thumb_500", 1.0);
+    ck_assert_ptr_nonnull(hit);
+    g_object_unref(hit);
+    
+    ck_assert(blur_cache_put(cache, "thumb_new", 1.0, thumbnail));
+    ck_assert(blur_cache_contains(cache, "thumb_500", 1.0));
+    ck_assert(!blur_cache_contains(cache, "thumb_501", 1.0));
+    
+    /* Removing one image leaves the list consistent for later evictions */
+    blur_cache_remove(cache, "thumb_502");
+    ck_assert_uint_eq(blur_cache_evict_lru(cache, 2), 2);
+    ck_assert(!blur_cache_contains(cache, "thumb_504", 1.0));
+    ck_assert(blur_cache_contains(cache, "thumb_505", 1.0));
+    
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+/* Test: Struct keys bucket intensities and tell images apart */
+START_TEST(test_struct_key_init) {
+    BlurCacheKey a, b;
+    
+    blur_cache_key_init(&a, "img_0001", 2.5);
+    blur_cache_key_init(&b, "img_0001", 2.54);
+    ck_assert(a.image_hash == b.image_hash);
+    ck_assert_int_eq(a.intensity_step, 25);
+    ck_assert_int_eq(b.intensity_step, 25);
+    
+    blur_cache_key_init(&b, "img_00010", 2.5);
+    ck_assert(a.image_hash != b.image_hash);
+    
+    /* Prefixes of another hash are separate images */
+    GdkPixbuf *pixbuf = create_test_pixbuf(10, 10, 0, 0, 0);
+    blur_cache_put(test_cache, "img_0001", 2.5, pixbuf);
+    blur_cache_put(test_cache, "img_00010", 2.5, pixbuf);
+    blur_cache_remove(test_cache, "img_0001");
+    ck_assert(!blur_cache_contains(test_cache, "img_0001", 2.5));
+    ck_assert(blur_cache_contains(test_cache, "img_00010", 2.5));
+    
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Removing one image touches only its variants */
+START_TEST(test_remove_image_variants) {
+    BlurCache *cache = blur_cache_create(4000, 8 * 1024 * 1024);
+    GdkPixbuf *thumbnail = create_test_pixbuf(4, 4, 9, 9, 9);
+    gchar hash[32];
+    
+    for (int i = 0; i < 1000; i++) {
+        g_snprintf(hash, sizeof(hash), "image_%d", i);
+        for (int v = 1; v <= 3; v++) {
+            blur_cache_put(cache, hash, v, thumbnail);
+        }
+    }
+    
+    /* An image can be removed, cached again and removed once more */
+    blur_cache_remove(cache, "image_500");
+    ck_assert(blur_cache_put(cache, "image_500", 2.0, thumbnail));
+    blur_cache_remove(cache, "image_500");
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_int_eq(stats.current_entries, 2997);
+    ck_assert(!blur_cache_contains(cache, "image_500", 1.0));
+    ck_assert(blur_cache_contains(cache, "image_499", 3.0));
+    ck_assert(blur_cache_contains(cache, "image_501", 1.0));
+    
+    /* The oldest image's variants go one by one under eviction */
+    ck_assert_uint_eq(blur_cache_evict_lru(cache, 2), 2);
+    gdouble found = 0.0;
+    GdkPixbuf *lower = blur_cache_get_nearest_lower(cache, "image_0", 5.0, &found);
+    ck_assert_ptr_nonnull(lower);
+    ck_assert_double_eq_tol(found, 3.0, 1e-9);
+    g_object_unref(lower);
+    ck_assert_ptr_null(blur_cache_get_nearest_lower(cache, "image_0", 3.0, &found));
+    
+    blur_cache_remove(cache, "image_0");
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_int_eq(stats.current_entries, 2994);
+    
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+/* Test: Sharded caches enforce global limits and aggregate statistics */
+START_TEST(test_sharded_limits) {
+    BlurCache *cache = blur_cache_create_sharded(100, 8 * 1024 * 1024, 8);
+    ck_assert_ptr_nonnull(cache);
+    ck_assert_ptr_null(blur_cache_create_sharded(100, 8 * 1024 * 1024, 0));
+    ck_assert_ptr_null(blur_cache_create_sharded(100, 8 * 1024 * 1024, BLUR_CACHE_MAX_SHARDS + 1));
+    
+    GdkPixbuf *thumbnail = create_test_pixbuf(8, 8, 1, 2, 3);
+    gchar hash[32];
+    
+    for (int i = 0; i < 500; i++) {
+        g_snprintf(hash, sizeof(hash), "sharded_%d", i);
+        ck_assert(blur_cache_put(cache, hash, 1.0, thumbnail));
+    }
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_int_eq(stats.current_entries, 100);
+    ck_assert_uint_eq(stats.eviction_count, 400);
+    ck_assert_uint_eq(stats.current_memory, 100 * blur_cache_calculate_pixbuf_size(thumbnail));
+    ck_assert_uint_eq(stats.current_memory, blur_cache_get_memory_usage(cache));
+    
+    /* Eviction follows age across shards: the newest images survive */
+    for (int i = 400; i < 500; i++) {
+        g_snprintf(hash, sizeof(hash), "sharded_%d", i);
+        GdkPixbuf *hit = blur_cache_get(cache, hash, 1.0);
+        ck_assert_ptr_nonnull(hit);
+        g_object_unref(hit);
+    }
+    ck_assert_ptr_null(blur_cache_get(cache, "sharded_0", 1.0));
+    
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.hit_count, 100);
+    ck_assert_uint_eq(stats.miss_count, 1);
+    
+    blur_cache_clear(cache);
+    ck_assert_uint_eq(blur_cache_get_memory_usage(cache), 0);
+    ck_assert(blur_cache_has_room(cache, blur_cache_calculate_pixbuf_size(thumbnail)));
+    
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+typedef struct {
+    BlurCache *cache;
+    GdkPixbuf *pixbuf;
+    int producer;
+    guint64 gets;
+} ShardedProducer;
+
+static gpointer sharded_producer_thread(gpointer data) {
+    ShardedProducer *producer = data;
+    gchar hash[32];
+    
+    for (int i = 0; i < 2000; i++) {
+        g_snprintf(hash, sizeof(hash), "producer_%d_%d", producer->producer, i % 300);
+        blur_cache_put(producer->cache, hash, (i % 7) * 0.5, producer->pixbuf);
+        
+        GdkPixbuf *hit = blur_cache_get(producer->cache, hash, (i % 5) * 0.5);
+        producer->gets++;
+        if (hit) {
+            g_object_unref(hit);
+        }
+        
+        if (i % 97 == 0) {
+            blur_cache_remove(producer->cache, hash);
+        }
+    }
+    
+    return NULL;
+}
+
+/* Test: Concurrent producers keep the shared totals consistent */
+START_TEST(test_sharded_concurrent_producers) {
+    BlurCache *cache = blur_cache_create_sharded(400, 2 * 1024 * 1024, 8);
+    GdkPixbuf *pixbuf = create_test_pixbuf(16, 16, 7, 7, 7);
+    ShardedProducer producers[4];
+    GThread *threads[4];
+    
+    for (int i = 0; i < 4; i++) {
+        producers[i] = (ShardedProducer){ cache, pixbuf, i, 0 };
+        threads[i] = g_thread_new("cache-producer", sharded_producer_thread, &producers[i]);
+    }
+    
+    guint64 total_gets = 0;
+    for (int i = 0; i < 4; i++) {
+        g_thread_join(threads[i]);
+        total_gets += producers[i].gets;
+    }
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.hit_count + stats.miss_count, total_gets);
+    ck_assert_int_le(stats.current_entries, 400);
+    ck_assert_uint_le(stats.current_memory, 2 * 1024 * 1024);
+    ck_assert_uint_eq(stats.current_memory, blur_cache_get_memory_usage(cache));
+    ck_assert_uint_eq(stats.current_memory, stats.current_entries * blur_cache_calculate_pixbuf_size(pixbuf));
+    
+    blur_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+START_TEST(test_owner_fair_share) {
+    GdkPixbuf *thumbnail = create_test_pixbuf(512, 512, 4, 5, 6);
+    gsize entry_size = blur_cache_calculate_pixbuf_size(thumbnail);
+    BlurCache *cache = blur_cache_create_sharded(100, 10 * entry_size, 4);
+    gchar hash[32];
+    
+    guint first = blur_cache_register_owner(cache);
+    guint second = blur_cache_register_owner(cache);
+    ck_assert_uint_gt(first, 0);
+    ck_assert_uint_ne(first, second);
+    
+    /* The first window fills the whole budget while the second is idle */
+    for (int i = 0; i < 10; i++) {
+        g_snprintf(hash, sizeof(hash), "first_%d", i);
+        ck_assert(blur_cache_put_owned(cache, first, hash, 1.0, thumbnail));
+    }
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, first), 10 * entry_size);
+    
+    /* New results of the second window push the first back to its share */
+    for (int i = 0; i < 8; i++) {
+        g_snprintf(hash, sizeof(hash), "second_%d", i);
+        ck_assert(blur_cache_put_owned(cache, second, hash, 1.0, thumbnail));
+    }
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, first), 5 * entry_size);
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, second), 5 * entry_size);
+    ck_assert_uint_eq(blur_cache_get_memory_usage(cache), 10 * entry_size);
+    
+    /* Each window kept its most recent results */
+    ck_assert(blur_cache_contains(cache, "first_9", 1.0));
+    ck_assert(!blur_cache_contains(cache, "first_4", 1.0));
+    ck_assert(blur_cache_contains(cache, "second_7", 1.0));
+    ck_assert(!blur_cache_contains(cache, "second_2", 1.0));
+    
+    /* Closing a window releases everything charged to it */
+    blur_cache_unregister_owner(cache, second);
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, second), 0);
+    ck_assert_uint_eq(blur_cache_get_memory_usage(cache), 5 * entry_size);
+    ck_assert(!blur_cache_contains(cache, "second_7", 1.0));
+    
+    blur_cache_clear(cache);
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, first), 0);
+    
+    blur_cache_unregister_owner(cache, first);
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+START_TEST(test_shared_entries_follow_lru) {
+    GdkPixbuf *thumbnail = create_test_pixbuf(512, 512, 4, 5, 6);
+    gsize entry_size = blur_cache_calculate_pixbuf_size(thumbnail);
+    BlurCache *cache = blur_cache_create_sharded(100, 4 * entry_size, 2);
+    
+    /* A lone owner is never over its share, so eviction stays plain LRU */
+    guint owner = blur_cache_register_owner(cache);
+    ck_assert(blur_cache_put(cache, "shared_0", 1.0, thumbnail));
+    ck_assert(blur_cache_put_owned(cache, owner, "owned_0", 1.0, thumbnail));
+    ck_assert(blur_cache_put_owned(cache, owner, "owned_1", 1.0, thumbnail));
+    ck_assert(blur_cache_put(cache, "shared_1", 1.0, thumbnail));
+    ck_assert(blur_cache_put_owned(cache, owner, "owned_2", 1.0, thumbnail));
+    
+    ck_assert(!blur_cache_contains(cache, "shared_0", 1.0));
+    ck_assert(blur_cache_contains(cache, "owned_0", 1.0));
+    ck_assert_uint_eq(blur_cache_get_owner_memory(cache, owner), 3 * entry_size);
+    
+    blur_cache_unregister_owner(cache, owner);
+    ck_assert_uint_eq(blur_cache_get_memory_usage(cache), entry_size);
+    ck_assert(blur_cache_contains(cache, "shared_1", 1.0));
+    
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+/* Helper: entries currently held by @cache */
+static guint cache_entries(BlurCache *cache) {
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    return stats.current_entries;
+}
+
+START_TEST(test_drop_speculative) {
+    GdkPixbuf *thumbnail = create_test_pixbuf(64, 64, 7, 8, 9);
+    BlurCache *cache = blur_cache_create(10, 8 * 1024 * 1024);
+    guint owner = blur_cache_register_owner(cache);
+    
+    ck_assert(blur_cache_put_owned(cache, owner, "shown", 1.0, thumbnail));
+    ck_assert(blur_cache_put_speculative(cache, owner, "prefetched", 1.0, thumbnail));
+    ck_assert(blur_cache_put_speculative(cache, owner, "prefetched", 2.0, thumbnail));
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.speculative_entries, 2);
+    
+    /* Reading a prefetched result makes it an ordinary entry */
+    GdkPixbuf *hit = blur_cache_get(cache, "prefetched", 2.0);
+    ck_assert_ptr_nonnull(hit);
+    g_object_unref(hit);
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.speculative_entries, 1);
+    
+    ck_assert_uint_eq(blur_cache_drop_speculative(cache), 1);
+    ck_assert(blur_cache_contains(cache, "shown", 1.0));
+    ck_assert(!blur_cache_contains(cache, "prefetched", 1.0));
+    ck_assert(blur_cache_contains(cache, "prefetched", 2.0));
+    ck_assert_uint_eq(blur_cache_drop_speculative(cache), 0);
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.speculative_entries, 0);
+    
+    blur_cache_unregister_owner(cache, owner);
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+START_TEST(test_set_limits) {
+    GdkPixbuf *thumbnail = create_test_pixbuf(64, 64, 1, 1, 1);
+    BlurCache *cache = blur_cache_create_sharded(20, 8 * 1024 * 1024, 2);
+    
+    for (int i = 0; i < 10; i++) {
+        gchar *hash = g_strdup_printf("image_%d", i);
+        ck_assert(blur_cache_put(cache, hash, 1.0, thumbnail));
+        g_free(hash);
+    }
+    
+    ck_assert(!blur_cache_set_limits(cache, 0, 8 * 1024 * 1024));
+    ck_assert(!blur_cache_set_limits(cache, 4, 1024));
+    ck_assert_uint_eq(cache_entries(cache), 10);
+    
+    /* Shrinking evicts right away, growing back keeps what is left */
+    ck_assert(blur_cache_set_limits(cache, 4, 8 * 1024 * 1024));
+    ck_assert_uint_le(cache_entries(cache), 4);
+    ck_assert(blur_cache_contains(cache, "image_9", 1.0));
+    ck_assert(blur_cache_set_limits(cache, 20, 8 * 1024 * 1024));
+    ck_assert_uint_le(cache_entries(cache), 4);
+    ck_assert(blur_cache_put(cache, "image_10", 1.0, thumbnail));
+    
+    blur_cache_destroy(cache);
+    g_object_unref(thumbnail);
+}
+END_TEST
+
+START_TEST(test_scale_to_ram) {
+    const gsize budget = 256 * 1024 * 1024;
+    
+    ck_assert_uint_eq(blur_cache_scale_to_ram(budget, BLUR_CACHE_REFERENCE_RAM), budget);
+    ck_assert_uint_eq(blur_cache_scale_to_ram(budget, BLUR_CACHE_REFERENCE_RAM * 2), budget * 2);
+    ck_assert_uint_eq(blur_cache_scale_to_ram(budget, BLUR_CACHE_REFERENCE_RAM / 2), budget / 2);
+    
+    /* Clamped to a quarter and four times the reference budget */
+    ck_assert_uint_eq(blur_cache_scale_to_ram(budget, BLUR_CACHE_REFERENCE_RAM / 64), budget / 4);
+    ck_assert_uint_eq(blur_cache_scale_to_ram(budget, BLUR_CACHE_REFERENCE_RAM * 64), budget * 4);
+    ck_assert_uint_eq(blur_cache_scale_to_ram(1024, BLUR_CACHE_REFERENCE_RAM), 1024 * 1024);
+    
+    /* Detecting the installed memory still gives a usable budget */
+    ck_assert_uint_ge(blur_cache_scale_to_ram(budget, 0), budget / 4);
+}
+END_TEST
+
 /* Test suite creation */
 Suite *blur_cache_suite(void) {
     Suite *s;
-    TCase *tc_core, *tc_operations, *tc_lru, *tc_stats;
+    TCase *tc_core, *tc_operations, *tc_lru, *tc_stats, *tc_sharded, *tc_owners;
     
     s = suite_create("BlurCache");
     
@@ -270,6 +706,10 @@ Suite *blur_cache_suite(void) {
     tcase_add_test(tc_operations, test_cache_get_operations);
     tcase_add_test(tc_operations, test_cache_miss_behavior);
     tcase_add_test(tc_operations, test_cache_clearing);
+    tcase_add_test(tc_operations, test_cache_contains_is_silent);
+    tcase_add_test(tc_operations, test_cache_has_room);
+    tcase_add_test(tc_operations, test_cache_nearest_lower);
+    tcase_add_test(tc_operations, test_remove_image_variants);
     tcase_add_checked_fixture(tc_operations, setup_blur_cache, teardown_blur_cache);
     suite_add_tcase(s, tc_operations);
     
@@ -277,6 +717,8 @@ Suite *blur_cache_suite(void) {
     tc_lru = tcase_create("LRU");
     tcase_add_test(tc_lru, test_lru_eviction_policy);
     tcase_add_test(tc_lru, test_key_generation_consistency);
+    tcase_add_test(tc_lru, test_lru_many_entries);
+    tcase_add_test(tc_lru, test_struct_key_init);
     tcase_add_checked_fixture(tc_lru, setup_blur_cache, teardown_blur_cache);
     suite_add_tcase(s, tc_lru);
     
@@ -286,6 +728,21 @@ Suite *blur_cache_suite(void) {
     tcase_add_checked_fixture(tc_stats, setup_blur_cache, teardown_blur_cache);
     suite_add_tcase(s, tc_stats);
     
+    /* Sharded mode */
+    tc_sharded = tcase_create("Sharded");
+    tcase_add_test(tc_sharded, test_sharded_limits);
+    tcase_add_test(tc_sharded, test_sharded_concurrent_producers);
+    suite_add_tcase(s, tc_sharded);
+    
+    /* Fair share between windows */
+    tc_owners = tcase_create("Owners");
+    tcase_add_test(tc_owners, test_owner_fair_share);
+    tcase_add_test(tc_owners, test_shared_entries_follow_lru);
+    tcase_add_test(tc_owners, test_drop_speculative);
+    tcase_add_test(tc_owners, test_set_limits);
+    tcase_add_test(tc_owners, test_scale_to_ram);
+    suite_add_tcase(s, tc_owners);
+    
     return s;
 }
 
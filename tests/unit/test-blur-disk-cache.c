@@ -0,0 +1,367 @@
+#include <check.h>
+#include <gtk/gtk.h>
+#include <glib/gstdio.h>
+#include <utime.h>
+#include "src/lib/blur-disk-cache.h"
+#include "src/lib/blur-cache.h"
+
+/* Test fixtures */
+static gchar *test_directory = NULL;
+
+/* Setup function: every test gets an empty cache directory */
+static void setup_disk_cache(void) {
+    test_directory = g_dir_make_tmp("blur-disk-cache-XXXXXX", NULL);
+    ck_assert_ptr_nonnull(test_directory);
+}
+
+/* Teardown function: removes the cache directory and its files */
+static void teardown_disk_cache(void) {
+    const gchar *name;
+    GDir *dir = g_dir_open(test_directory, 0, NULL);
+    
+    while (dir && (name = g_dir_read_name(dir)) != NULL) {
+        gchar *path = g_build_filename(test_directory, name, NULL);
+        g_unlink(path);
+        g_free(path);
+    }
+    if (dir) {
+        g_dir_close(dir);
+    }
+    
+    g_rmdir(test_directory);
+    g_clear_pointer(&test_directory, g_free);
+}
+
+/* Helper function to create test pixbuf with a per-pixel pattern */
+static GdkPixbuf* create_test_pixbuf(int width, int height, gboolean has_alpha, guchar seed) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, has_alpha, 8, width, height);
+    ck_assert_ptr_nonnull(pixbuf);
+    
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    int n_channels = gdk_pixbuf_get_n_channels(pixbuf);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width * n_channels; x++) {
+            pixels[y * rowstride + x] = (guchar)(seed + x * 7 + y * 13);
+        }
+    }
+    
+    return pixbuf;
+}
+
+static gboolean pixbufs_equal(GdkPixbuf *a, GdkPixbuf *b) {
+    int width = gdk_pixbuf_get_width(a);
+    int height = gdk_pixbuf_get_height(a);
+    int n_channels = gdk_pixbuf_get_n_channels(a);
+    
+    if (width != gdk_pixbuf_get_width(b) || height != gdk_pixbuf_get_height(b) ||
+        n_channels != gdk_pixbuf_get_n_channels(b)) {
+        return FALSE;
+    }
+    
+    const guint8 *pixels_a = gdk_pixbuf_read_pixels(a);
+    const guint8 *pixels_b = gdk_pixbuf_read_pixels(b);
+    for (int y = 0; y < height; y++) {
+        if (memcmp(pixels_a + y * gdk_pixbuf_get_rowstride(a),
+                   pixels_b + y * gdk_pixbuf_get_rowstride(b), width * n_channels) != 0) {
+            return FALSE;
+        }
+    }
+    
+    return TRUE;
+}
+
+/* Moves the modification time of every stored file into the past */
+static void age_all_files(gint64 seconds) {
+    const gchar *name;
+    GDir *dir = g_dir_open(test_directory, 0, NULL);
+    ck_assert_ptr_nonnull(dir);
+    
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        gchar *path = g_build_filename(test_directory, name, NULL);
+        GStatBuf st;
+        ck_assert_int_eq(g_stat(path, &st), 0);
+        
+        struct utimbuf times = { st.st_mtime - seconds, st.st_mtime - seconds };
+        ck_assert_int_eq(g_utime(path, &times), 0);
+        g_free(path);
+    }
+    g_dir_close(dir);
+}
+
+static guint count_files(void) {
+    guint count = 0;
+    GDir *dir = g_dir_open(test_directory, 0, NULL);
+    
+    while (dir && g_dir_read_name(dir) != NULL) {
+        count++;
+    }
+    if (dir) {
+        g_dir_close(dir);
+    }
+    
+    return count;
+}
+
+/* Test: Stored results come back pixel for pixel, also after a restart */
+START_TEST(test_store_and_lookup) {
+    BlurDiskCache *cache = blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 0, NULL);
+    ck_assert_ptr_nonnull(cache);
+    
+    GdkPixbuf *rgb = create_test_pixbuf(37, 21, FALSE, 3);
+    GdkPixbuf *rgba = create_test_pixbuf(16, 9, TRUE, 90);
+    
+    ck_assert_ptr_null(blur_disk_cache_lookup(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 25));
+    
+    blur_disk_cache_store(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 25, rgb);
+    blur_disk_cache_store(cache, "img_a", BLUR_DISK_CACHE_OP_GRAYSCALE, 0, rgba);
+    blur_disk_cache_flush(cache);
+    
+    ck_assert(blur_disk_cache_contains(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 25));
+    ck_assert(!blur_disk_cache_contains(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 26));
+    ck_assert(!blur_disk_cache_contains(cache, "img_b", BLUR_DISK_CACHE_OP_BLUR, 25));
+    
+    GdkPixbuf *loaded = blur_disk_cache_lookup(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 25);
+    ck_assert_ptr_nonnull(loaded);
+    ck_assert(pixbufs_equal(loaded, rgb));
+    g_object_unref(loaded);
+    
+    BlurDiskCacheStats stats;
+    blur_disk_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.writes, 2);
+    ck_assert_uint_eq(stats.hits, 1);
+    ck_assert_uint_eq(stats.misses, 1);
+    ck_assert_uint_gt(stats.current_bytes, gdk_pixbuf_get_byte_length(rgb));
+    
+    /* Storing the same key again is a no-op */
+    blur_disk_cache_store(cache, "img_a", BLUR_DISK_CACHE_OP_BLUR, 25, rgb);
+    blur_disk_cache_destroy(cache);
+    
+    /* A new instance, as after restarting, sees the earlier results */
+    cache = blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 0, NULL);
+    ck_assert_ptr_nonnull(cache);
+    blur_disk_cache_flush(cache);
+    blur_disk_cache_get_stats(cache, &stats);
+    ck_assert_uint_gt(stats.current_bytes, 0);
+    
+    loaded = blur_disk_cache_lookup(cache, "img_a", BLUR_DISK_CACHE_OP_GRAYSCALE, 0);
+    ck_assert_ptr_nonnull(loaded);
+    ck_assert(gdk_pixbuf_get_has_alpha(loaded));
+    ck_assert(pixbufs_equal(loaded, rgba));
+    
+    /* The mapping outlives the file */
+    blur_disk_cache_clear(cache);
+    ck_assert_uint_eq(count_files(), 0);
+    ck_assert(pixbufs_equal(loaded, rgba));
+    g_object_unref(loaded);
+    
+    blur_disk_cache_destroy(cache);
+    g_object_unref(rgb);
+    g_object_unref(rgba);
+}
+END_TEST
+
+/* Test: Truncated files are rejected and deleted */
+START_TEST(test_corrupt_file_rejected) {
+    BlurDiskCache *cache = blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 0, NULL);
+    GdkPixbuf *pixbuf = create_test_pixbuf(32, 32, FALSE, 1);
+    
+    blur_disk_cache_store(cache, "img_c", BLUR_DISK_CACHE_OP_BLUR, 10, pixbuf);
+    blur_disk_cache_flush(cache);
+    ck_assert_uint_eq(count_files(), 1);
+    
+    /* Cut the stored file in half */
+    const gchar *name;
+    GDir *dir = g_dir_open(test_directory, 0, NULL);
+    while ((name = g_dir_read_name(dir)) != NULL) {
+        gchar *path = g_build_filename(test_directory, name, NULL);
+        gchar *contents;
+        gsize length;
+        ck_assert(g_file_get_contents(path, &contents, &length, NULL));
+        ck_assert(g_file_set_contents(path, contents, length / 2, NULL));
+        g_free(contents);
+        g_free(path);
+    }
+    g_dir_close(dir);
+    
+    ck_assert_ptr_null(blur_disk_cache_lookup(cache, "img_c", BLUR_DISK_CACHE_OP_BLUR, 10));
+    ck_assert_uint_eq(count_files(), 0);
+    
+    blur_disk_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Writes beyond the size limit evict the least recently used files */
+START_TEST(test_size_eviction) {
+    GdkPixbuf *pixbuf = create_test_pixbuf(64, 64, FALSE, 5);
+    gsize file_size = 64 + gdk_pixbuf_get_byte_length(pixbuf);
+    BlurDiskCache *cache = blur_disk_cache_create(test_directory, 4 * file_size, 0, NULL);
+    
+    blur_disk_cache_store(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 1, pixbuf);
+    blur_disk_cache_store(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 2, pixbuf);
+    blur_disk_cache_store(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 3, pixbuf);
+    blur_disk_cache_flush(cache);
+    age_all_files(300);
+    
+    /* A lookup counts as a use and protects the file */
+    GdkPixbuf *used = blur_disk_cache_lookup(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 2);
+    ck_assert_ptr_nonnull(used);
+    g_object_unref(used);
+    
+    blur_disk_cache_store(cache, "new", BLUR_DISK_CACHE_OP_BLUR, 1, pixbuf);
+    blur_disk_cache_store(cache, "new", BLUR_DISK_CACHE_OP_BLUR, 2, pixbuf);
+    blur_disk_cache_flush(cache);
+    
+    BlurDiskCacheStats stats;
+    blur_disk_cache_get_stats(cache, &stats);
+    ck_assert_uint_le(stats.current_bytes, 4 * file_size);
+    ck_assert_uint_eq(stats.evictions, 2);
+    
+    ck_assert(!blur_disk_cache_contains(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 1));
+    ck_assert(blur_disk_cache_contains(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 2));
+    ck_assert(!blur_disk_cache_contains(cache, "old", BLUR_DISK_CACHE_OP_BLUR, 3));
+    ck_assert(blur_disk_cache_contains(cache, "new", BLUR_DISK_CACHE_OP_BLUR, 1));
+    ck_assert(blur_disk_cache_contains(cache, "new", BLUR_DISK_CACHE_OP_BLUR, 2));
+    
+    blur_disk_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Files unused for longer than the age limit go at startup */
+START_TEST(test_age_eviction) {
+    BlurDiskCache *cache = blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 3600, NULL);
+    GdkPixbuf *pixbuf = create_test_pixbuf(16, 16, FALSE, 8);
+    
+    blur_disk_cache_store(cache, "stale", BLUR_DISK_CACHE_OP_BLUR, 5, pixbuf);
+    blur_disk_cache_flush(cache);
+    blur_disk_cache_destroy(cache);
+    age_all_files(2 * 3600);
+    
+    cache = blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 3600, NULL);
+    blur_disk_cache_flush(cache);
+    ck_assert(!blur_disk_cache_contains(cache, "stale", BLUR_DISK_CACHE_OP_BLUR, 5));
+    
+    BlurDiskCacheStats stats;
+    blur_disk_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.evictions, 1);
+    ck_assert_uint_eq(stats.current_bytes, 0);
+    
+    blur_disk_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Unusable directories are reported through GError */
+START_TEST(test_unusable_directory) {
+    GError *error = NULL;
+    gchar *file_path = g_build_filename(test_directory, "not-a-directory", NULL);
+    ck_assert(g_file_set_contents(file_path, "x", 1, NULL));
+    
+    gchar *below_file = g_build_filename(file_path, "cache", NULL);
+    BlurDiskCache *cache = blur_disk_cache_create(below_file, 1024 * 1024, 0, &error);
+    ck_assert_ptr_null(cache);
+    ck_assert_ptr_nonnull(error);
+    ck_assert_int_eq(error->domain, G_FILE_ERROR);
+    
+    g_error_free(error);
+    g_free(below_file);
+    g_free(file_path);
+}
+END_TEST
+
+/* Test: BlurCache promotes disk results on a memory miss - cold start */
+START_TEST(test_blur_cache_disk_tier) {
+    GdkPixbuf *pixbuf = create_test_pixbuf(40, 30, FALSE, 77);
+    
+    BlurCache *cache = blur_cache_create(5, 10 * 1024 * 1024);
+    blur_cache_set_disk_tier(cache, blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 0, NULL));
+    ck_assert_ptr_nonnull(blur_cache_get_disk_tier(cache));
+    
+    ck_assert(blur_cache_put(cache, "img_warm", 2.5, pixbuf));
+    blur_cache_destroy(cache);
+    
+    /* Next session: memory is empty, the disk still has the blur */
+    cache = blur_cache_create(5, 10 * 1024 * 1024);
+    blur_cache_set_disk_tier(cache, blur_disk_cache_create(test_directory, 64 * 1024 * 1024, 0, NULL));
+    
+    ck_assert(blur_cache_contains(cache, "img_warm", 2.5));
+    GdkPixbuf *loaded = blur_cache_get(cache, "img_warm", 2.5);
+    ck_assert_ptr_nonnull(loaded);
+    ck_assert(pixbufs_equal(loaded, pixbuf));
+    g_object_unref(loaded);
+    
+    /* Promoted: the second lookup is served from memory */
+    loaded = blur_cache_get(cache, "img_warm", 2.5);
+    ck_assert_ptr_nonnull(loaded);
+    g_object_unref(loaded);
+    
+    BlurCacheStats stats;
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.disk_hit_count, 1);
+    ck_assert_uint_eq(stats.hit_count, 1);
+    ck_assert_uint_eq(stats.current_entries, 1);
+    
+    /* Promotion does not write the same result again */
+    BlurDiskCacheStats disk_stats;
+    blur_disk_cache_get_stats(blur_cache_get_disk_tier(cache), &disk_stats);
+    ck_assert_uint_eq(disk_stats.writes, 0);
+    
+    blur_cache_destroy(cache);
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test suite creation */
+Suite *blur_disk_cache_suite(void) {
+    Suite *s;
+    TCase *tc_storage, *tc_eviction, *tc_tier;
+    
+    s = suite_create("BlurDiskCache");
+    
+    /* Storage format */
+    tc_storage = tcase_create("Storage");
+    tcase_add_test(tc_storage, test_store_and_lookup);
+    tcase_add_test(tc_storage, test_corrupt_file_rejected);
+    tcase_add_test(tc_storage, test_unusable_directory);
+    tcase_add_checked_fixture(tc_storage, setup_disk_cache, teardown_disk_cache);
+    suite_add_tcase(s, tc_storage);
+    
+    /* Size and age limits */
+    tc_eviction = tcase_create("Eviction");
+    tcase_add_test(tc_eviction, test_size_eviction);
+    tcase_add_test(tc_eviction, test_age_eviction);
+    tcase_add_checked_fixture(tc_eviction, setup_disk_cache, teardown_disk_cache);
+    suite_add_tcase(s, tc_eviction);
+    
+    /* Tier behind BlurCache */
+    tc_tier = tcase_create("BlurCacheTier");
+    tcase_add_test(tc_tier, test_blur_cache_disk_tier);
+    tcase_add_checked_fixture(tc_tier, setup_disk_cache, teardown_disk_cache);
+    suite_add_tcase(s, tc_tier);
+    
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+    
+    /* Try to initialize GTK, skip tests if not available */
+    if (!gtk_init_check()) {
+        g_print("GTK initialization failed - skipping all tests\n");
+        return 77; /* Skip code for meson test */
+    }
+    
+    s = blur_disk_cache_suite();
+    sr = srunner_create(s);
+    
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
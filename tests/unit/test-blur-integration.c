@@ -2,6 +2,7 @@
 #include <gtk/gtk.h>
 #include "src/lib/blur-processor.h"
 #include "src/lib/blur-cache.h"
+#include "src/lib/blur-prefetch.h"
 
 /* Test fixtures */
 static BlurProcessor *test_processor = NULL;
@@ -204,10 +205,189 @@ START_TEST(test_resource_cleanup) {
 }
 END_TEST
 
+/* Helper: iterate the main loop until @count prefetches completed or ~5s passed */
+static void wait_for_prefetches(BlurPrefetcher *prefetcher, guint64 count) {
+    gint64 deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    BlurPrefetchStats stats;
+    
+    do {
+        g_main_context_iteration(NULL, FALSE);
+        g_usleep(1000);
+        blur_prefetcher_get_stats(prefetcher, &stats);
+    } while (stats.completed < count && g_get_monotonic_time() < deadline);
+}
+
+/* Test: Neighbors in the direction of movement land in the cache */
+START_TEST(test_prefetch_fills_neighbors) {
+    BlurCache *cache = blur_cache_create(8, 5 * 1024 * 1024);
+    BlurPrefetcher *prefetcher = blur_prefetcher_create(test_processor, cache);
+    GdkPixbuf *source = create_test_pixbuf(64, 64);
+    
+    /* Moving up from the initial zero */
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_up", 2.0);
+    wait_for_prefetches(prefetcher, 2);
+    
+    ck_assert(blur_cache_contains(cache, "prefetch_up", 2.1));
+    ck_assert(blur_cache_contains(cache, "prefetch_up", 2.5));
+    ck_assert(!blur_cache_contains(cache, "prefetch_up", 1.9));
+    
+    /* Moving down now, 2.1 is behind us */
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_up", 1.5);
+    wait_for_prefetches(prefetcher, 4);
+    
+    ck_assert(blur_cache_contains(cache, "prefetch_up", 1.4));
+    ck_assert(blur_cache_contains(cache, "prefetch_up", 1.0));
+    
+    /* A prefetched neighbor is served like any other result */
+    GdkPixbuf *hit = blur_cache_get(cache, "prefetch_up", 1.4);
+    ck_assert_ptr_nonnull(hit);
+    ck_assert_int_eq(gdk_pixbuf_get_width(hit), 64);
+    g_object_unref(hit);
+    
+    BlurPrefetchStats stats;
+    blur_prefetcher_get_stats(prefetcher, &stats);
+    ck_assert_uint_eq(stats.started, 4);
+    ck_assert_uint_eq(stats.completed, 4);
+    ck_assert_uint_eq(stats.cancelled, 0);
+    
+    blur_prefetcher_destroy(prefetcher);
+    blur_cache_destroy(cache);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Cached neighbors and a full cache are skipped without blurring */
+START_TEST(test_prefetch_respects_cache) {
+    BlurCache *cache = blur_cache_create(2, 5 * 1024 * 1024);
+    BlurPrefetcher *prefetcher = blur_prefetcher_create(test_processor, cache);
+    GdkPixbuf *source = create_test_pixbuf(64, 64);
+    
+    /* 3.1 is already cached; 3.5 would need the last slot, which is free */
+    blur_cache_put(cache, "prefetch_budget", 3.1, source);
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_budget", 3.0);
+    wait_for_prefetches(prefetcher, 1);
+    
+    BlurPrefetchStats stats;
+    blur_prefetcher_get_stats(prefetcher, &stats);
+    ck_assert_uint_eq(stats.skipped_cached, 1);
+    ck_assert_uint_eq(stats.started, 1);
+    ck_assert(blur_cache_contains(cache, "prefetch_budget", 3.5));
+    
+    /* Cache is full now: prefetching must not evict what we have */
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_budget", 4.0);
+    for (int i = 0; i < 10; i++) {
+        g_main_context_iteration(NULL, FALSE);
+    }
+    
+    blur_prefetcher_get_stats(prefetcher, &stats);
+    ck_assert_uint_eq(stats.skipped_budget, 2);
+    ck_assert_uint_eq(stats.started, 1);
+    ck_assert(blur_cache_contains(cache, "prefetch_budget", 3.1));
+    ck_assert(blur_cache_contains(cache, "prefetch_budget", 3.5));
+    
+    blur_prefetcher_destroy(prefetcher);
+    blur_cache_destroy(cache);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Helper: sum of horizontal neighbor differences, lower for stronger blur */
+static guint64 high_frequency_energy(GdkPixbuf *pixbuf) {
+    const guchar *pixels = gdk_pixbuf_read_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    int n_channels = gdk_pixbuf_get_n_channels(pixbuf);
+    int row_bytes = gdk_pixbuf_get_width(pixbuf) * n_channels;
+    guint64 energy = 0;
+    
+    for (int y = 0; y < gdk_pixbuf_get_height(pixbuf); y++) {
+        const guchar *row = pixels + y * rowstride;
+        for (int x = n_channels; x < row_bytes; x++) {
+            energy += ABS(row[x] - row[x - n_channels]);
+        }
+    }
+    
+    return energy;
+}
+
+/* Test: A proxy prefetcher blurs at the scaled intensity under the unscaled key */
+START_TEST(test_prefetch_intensity_scale) {
+    BlurCache *cache = blur_cache_create(8, 5 * 1024 * 1024);
+    BlurPrefetcher *full = blur_prefetcher_create(test_processor, cache);
+    BlurPrefetcher *proxy = blur_prefetcher_create(test_processor, cache);
+    GdkPixbuf *source = create_test_pixbuf(64, 64);
+    
+    blur_prefetcher_set_intensity_scale(proxy, 0.25);
+    
+    blur_prefetcher_schedule(full, source, "prefetch_full", 4.0);
+    wait_for_prefetches(full, 2);
+    blur_prefetcher_schedule(proxy, source, "prefetch_proxy", 4.0);
+    wait_for_prefetches(proxy, 2);
+    
+    GdkPixbuf *full_result = blur_cache_get(cache, "prefetch_full", 4.5);
+    GdkPixbuf *proxy_result = blur_cache_get(cache, "prefetch_proxy", 4.5);
+    ck_assert_ptr_nonnull(full_result);
+    ck_assert_ptr_nonnull(proxy_result);
+    
+    /* A quarter of the sigma leaves much more detail */
+    ck_assert_uint_gt(high_frequency_energy(proxy_result),
+                      high_frequency_energy(full_result));
+    
+    g_object_unref(full_result);
+    g_object_unref(proxy_result);
+    blur_prefetcher_destroy(full);
+    blur_prefetcher_destroy(proxy);
+    blur_cache_destroy(cache);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Cancelling yields at once and nothing lands in the cache afterwards */
+START_TEST(test_prefetch_yields_to_foreground) {
+    BlurCache *cache = blur_cache_create(8, 50 * 1024 * 1024);
+    BlurPrefetcher *prefetcher = blur_prefetcher_create(test_processor, cache);
+    GdkPixbuf *source = create_test_pixbuf(1920, 1080);
+    BlurPrefetchStats stats;
+    
+    /* Cancelled before the idle source ran: nothing is submitted */
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_yield", 5.0);
+    blur_prefetcher_cancel(prefetcher);
+    for (int i = 0; i < 10; i++) {
+        g_main_context_iteration(NULL, FALSE);
+    }
+    
+    blur_prefetcher_get_stats(prefetcher, &stats);
+    ck_assert_uint_eq(stats.started, 0);
+    
+    /* Cancelled while blurring: the result never reaches the cache */
+    blur_prefetcher_schedule(prefetcher, source, "prefetch_yield", 6.0);
+    do {
+        g_main_context_iteration(NULL, FALSE);
+        blur_prefetcher_get_stats(prefetcher, &stats);
+    } while (stats.started == 0);
+    blur_prefetcher_cancel(prefetcher);
+    
+    gint64 deadline = g_get_monotonic_time() + G_USEC_PER_SEC;
+    while (g_get_monotonic_time() < deadline) {
+        g_main_context_iteration(NULL, FALSE);
+        g_usleep(1000);
+    }
+    
+    blur_prefetcher_get_stats(prefetcher, &stats);
+    ck_assert_uint_eq(stats.started, 1);
+    ck_assert_uint_eq(stats.cancelled, 1);
+    ck_assert_uint_eq(stats.completed, 0);
+    ck_assert(!blur_cache_contains(cache, "prefetch_yield", 6.1));
+    
+    blur_prefetcher_destroy(prefetcher);
+    blur_cache_destroy(cache);
+    g_object_unref(source);
+}
+END_TEST
+
 /* Test suite creation */
 Suite *blur_integration_suite(void) {
     Suite *s;
-    TCase *tc_integration, *tc_memory, *tc_lifecycle;
+    TCase *tc_integration, *tc_prefetch, *tc_memory, *tc_lifecycle;
     
     s = suite_create("BlurIntegration");
     
@@ -218,6 +398,15 @@ Suite *blur_integration_suite(void) {
     tcase_add_checked_fixture(tc_integration, setup_integration, teardown_integration);
     suite_add_tcase(s, tc_integration);
     
+    /* Prefetch tests */
+    tc_prefetch = tcase_create("Prefetch");
+    tcase_add_test(tc_prefetch, test_prefetch_fills_neighbors);
+    tcase_add_test(tc_prefetch, test_prefetch_respects_cache);
+    tcase_add_test(tc_prefetch, test_prefetch_yields_to_foreground);
+    tcase_add_test(tc_prefetch, test_prefetch_intensity_scale);
+    tcase_add_checked_fixture(tc_prefetch, setup_integration, teardown_integration);
+    suite_add_tcase(s, tc_prefetch);
+    
     /* Memory management tests */
     tc_memory = tcase_create("Memory");
     tcase_add_test(tc_memory, test_memory_management);
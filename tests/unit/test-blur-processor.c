@@ -1,6 +1,8 @@
 #include <check.h>
 #include <gtk/gtk.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "src/lib/blur-processor.h"
 
 /* Test fixtures */
@@ -51,6 +53,86 @@ static GdkPixbuf* create_test_pixbuf(int width, int height) {
     return pixbuf;
 }
 
+/* Helper: RGBA variant of the test pattern with a varying alpha channel */
+static GdkPixbuf* create_test_pixbuf_rgba(int width, int height) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, width, height);
+    ck_assert_ptr_nonnull(pixbuf);
+    
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            guchar *pixel = pixels + y * rowstride + x * 4;
+            pixel[0] = (x * 255) / width;
+            pixel[1] = (y * 255) / height;
+            pixel[2] = ((x ^ y) & 1) ? 255 : 0;  // Checkerboard stresses the kernel
+            pixel[3] = ((x + y) * 255) / (width + height);
+        }
+    }
+    
+    return pixbuf;
+}
+
+/* Helper: state shared with the completion callback */
+typedef struct {
+    GdkPixbuf *result;
+    gboolean completed;
+} BlurWaitData;
+
+static void on_blur_completed(GdkPixbuf *result, const GError *error, gpointer user_data) {
+    BlurWaitData *wait = user_data;
+    
+    ck_assert_ptr_null(error);
+    wait->result = g_object_ref(result);  // Processor drops its ref after we return
+    wait->completed = TRUE;
+}
+
+/* Helper: run main loop until every request in @waits has completed */
+static void wait_for_blurs(BlurWaitData *waits, int count) {
+    gint64 deadline = g_get_monotonic_time() + 10 * G_USEC_PER_SEC;
+    
+    for (int i = 0; i < count; i++) {
+        while (!waits[i].completed) {
+            ck_assert_msg(g_get_monotonic_time() < deadline, "blur request timed out");
+            g_main_context_iteration(NULL, TRUE);
+        }
+    }
+}
+
+static GdkPixbuf* blur_and_wait_mode(BlurProcessor *processor, GdkPixbuf *source,
+                                     gdouble intensity, gboolean is_progressive) {
+    BlurWaitData wait = { NULL, FALSE };
+    
+    guint request_id = blur_processor_apply_async(processor, source, intensity, is_progressive,
+                                                  on_blur_completed, &wait);
+    ck_assert_uint_ne(request_id, 0);
+    wait_for_blurs(&wait, 1);
+    ck_assert_ptr_nonnull(wait.result);
+    
+    return wait.result;
+}
+
+static GdkPixbuf* blur_and_wait(BlurProcessor *processor, GdkPixbuf *source, gdouble intensity) {
+    return blur_and_wait_mode(processor, source, intensity, FALSE);
+}
+
+static void assert_pixbufs_equal(GdkPixbuf *a, GdkPixbuf *b) {
+    int width = gdk_pixbuf_get_width(a);
+    int height = gdk_pixbuf_get_height(a);
+    int row_bytes = width * gdk_pixbuf_get_n_channels(a);
+    
+    ck_assert_int_eq(width, gdk_pixbuf_get_width(b));
+    ck_assert_int_eq(height, gdk_pixbuf_get_height(b));
+    ck_assert_int_eq(gdk_pixbuf_get_n_channels(a), gdk_pixbuf_get_n_channels(b));
+    
+    for (int y = 0; y < height; y++) {
+        const guchar *row_a = gdk_pixbuf_get_pixels(a) + y * gdk_pixbuf_get_rowstride(a);
+        const guchar *row_b = gdk_pixbuf_get_pixels(b) + y * gdk_pixbuf_get_rowstride(b);
+        ck_assert_msg(memcmp(row_a, row_b, row_bytes) == 0, "row %d differs", y);
+    }
+}
+
 /* Test: Processor creation and destruction */
 START_TEST(test_processor_creation) {
     BlurProcessor *processor = blur_processor_create(640, 480, 1);
@@ -136,6 +218,1479 @@ START_TEST(test_thread_safety_basic) {
 }
 END_TEST
 
+/* Test: Band-parallel blur is identical to the single-threaded result */
+START_TEST(test_band_parallel_matches_single_thread) {
+    BlurProcessor *single = blur_processor_create(640, 480, 1);
+    BlurProcessor *parallel = blur_processor_create(640, 480, 8);
+    ck_assert_ptr_nonnull(single);
+    ck_assert_ptr_nonnull(parallel);
+    
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(640, 480),
+        create_test_pixbuf_rgba(333, 257),  // Odd sizes leave uneven bands
+    };
+    
+    for (int i = 0; i < 2; i++) {
+        GdkPixbuf *reference = blur_and_wait(single, sources[i], 3.0);
+        GdkPixbuf *banded = blur_and_wait(parallel, sources[i], 3.0);
+        
+        assert_pixbufs_equal(reference, banded);
+        
+        g_object_unref(reference);
+        g_object_unref(banded);
+        g_object_unref(sources[i]);
+    }
+    
+    blur_processor_destroy(single);
+    blur_processor_destroy(parallel);
+}
+END_TEST
+
+/* Test: Tiled blur of an image beyond the arena matches the whole-image blur */
+START_TEST(test_tiled_matches_whole_image) {
+    BlurProcessor *whole = blur_processor_create(4096, 2048, 4);
+    BlurProcessor *tiled = blur_processor_create(256, 256, 4);
+    ck_assert_ptr_nonnull(whole);
+    ck_assert_ptr_nonnull(tiled);
+    
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf_rgba(2100, 1100),  // Three by two tiles, ragged edges
+        create_test_pixbuf(1500, 300),
+    };
+    double intensities[] = {1.0, 10.0};  // Gaussian kernel and box engine
+    
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            GdkPixbuf *reference = blur_and_wait(whole, sources[i], intensities[j]);
+            GdkPixbuf *result = blur_and_wait(tiled, sources[i], intensities[j]);
+            
+            assert_pixbufs_equal(reference, result);
+            
+            g_object_unref(reference);
+            g_object_unref(result);
+        }
+        g_object_unref(sources[i]);
+    }
+    
+    BlurProcessorStats stats;
+    blur_processor_get_stats(whole, &stats);
+    ck_assert_uint_eq(stats.tiled_requests, 0);
+    blur_processor_get_stats(tiled, &stats);
+    ck_assert_uint_eq(stats.tiled_requests, 4);
+    
+    blur_processor_destroy(whole);
+    blur_processor_destroy(tiled);
+}
+END_TEST
+
+/* Test: Images beyond the maximum processor size are accepted and tiled */
+START_TEST(test_tiled_beyond_max_dimension) {
+    GdkPixbuf *source = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 9000, 40);
+    gdk_pixbuf_fill(source, 0x4080c000);
+    ck_assert(blur_validate_pixbuf(source));
+    
+    GdkPixbuf *result = blur_and_wait(test_processor, source, 4.0);
+    ck_assert_int_eq(gdk_pixbuf_get_width(result), 9000);
+    ck_assert_int_eq(gdk_pixbuf_get_height(result), 40);
+    
+    /* Flat input stays flat across every tile seam */
+    for (int y = 0; y < 40; y++) {
+        const guchar *row = gdk_pixbuf_get_pixels(result) + y * gdk_pixbuf_get_rowstride(result);
+        for (int x = 0; x < 9000; x++) {
+            ck_assert_int_eq(row[x * 3 + 0], 0x40);
+            ck_assert_int_eq(row[x * 3 + 1], 0x80);
+            ck_assert_int_eq(row[x * 3 + 2], 0xc0);
+        }
+    }
+    
+    BlurProcessorStats stats;
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.tiled_requests, 1);
+    
+    g_object_unref(result);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Helper: copy of @source whose rows are @padding bytes longer than packed */
+static GdkPixbuf* create_padded_copy(GdkPixbuf *source, int padding) {
+    int width = gdk_pixbuf_get_width(source);
+    int height = gdk_pixbuf_get_height(source);
+    int channels = gdk_pixbuf_get_n_channels(source);
+    int rowstride = width * channels + padding;
+    guchar *pixels = g_malloc0((gsize)rowstride * height);
+    
+    for (int y = 0; y < height; y++) {
+        memcpy(pixels + (gsize)y * rowstride,
+               gdk_pixbuf_read_pixels(source) + (gsize)y * gdk_pixbuf_get_rowstride(source),
+               (gsize)width * channels);
+    }
+    
+    return gdk_pixbuf_new_from_data(pixels, GDK_COLORSPACE_RGB, channels == 4, 8,
+                                    width, height, rowstride,
+                                    (GdkPixbufDestroyNotify)g_free, NULL);
+}
+
+/* Test: Sources are read in place whatever their rowstride */
+START_TEST(test_padded_rowstride_matches_packed) {
+    BlurProcessor *tiled = blur_processor_create(256, 256, 2);
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf_rgba(333, 257),
+        create_test_pixbuf(301, 199),  // Packed rows of 903 bytes, padded to 904
+    };
+    double intensities[] = {1.0, 10.0};  // Gaussian kernel and box engine
+    
+    for (int i = 0; i < 2; i++) {
+        GdkPixbuf *padded = create_padded_copy(sources[i], 13);
+        ck_assert_int_ne(gdk_pixbuf_get_rowstride(padded), gdk_pixbuf_get_rowstride(sources[i]));
+        
+        for (int j = 0; j < 2; j++) {
+            for (int progressive = 0; progressive < 2; progressive++) {
+                GdkPixbuf *reference = blur_and_wait_mode(test_processor, sources[i],
+                                                          intensities[j], progressive);
+                GdkPixbuf *result = blur_and_wait_mode(test_processor, padded,
+                                                       intensities[j], progressive);
+                assert_pixbufs_equal(reference, result);
+                g_object_unref(result);
+                
+                /* The tiled engine reads the padded source region directly */
+                if (!progressive) {
+                    result = blur_and_wait(tiled, padded, intensities[j]);
+                    assert_pixbufs_equal(reference, result);
+                    g_object_unref(result);
+                }
+                g_object_unref(reference);
+            }
+        }
+        
+        g_object_unref(padded);
+        g_object_unref(sources[i]);
+    }
+    
+    blur_processor_destroy(tiled);
+}
+END_TEST
+
+/* Test: A freed result's pixels are reused by the next result of its size */
+START_TEST(test_result_buffers_recycled) {
+    GdkPixbuf *source = create_test_pixbuf(320, 240);
+    BlurProcessorStats stats;
+    
+    GdkPixbuf *first = blur_and_wait(test_processor, source, 2.0);
+    GdkPixbuf *reference = gdk_pixbuf_copy(first);
+    const guchar *first_pixels = gdk_pixbuf_read_pixels(first);
+    g_object_unref(first);
+    
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.result_buffers_reused, 0);
+    
+    GdkPixbuf *second = blur_and_wait(test_processor, source, 2.0);
+    ck_assert(gdk_pixbuf_read_pixels(second) == first_pixels);
+    assert_pixbufs_equal(reference, second);
+    
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.result_buffers_reused, 1);
+    
+    /* Results stay valid after the processor is gone */
+    blur_processor_destroy(test_processor);
+    test_processor = NULL;
+    assert_pixbufs_equal(reference, second);
+    g_object_unref(second);
+    
+    g_object_unref(reference);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Concurrent requests use separate scratch buffers - T027 */
+START_TEST(test_concurrent_requests) {
+    const gdouble intensities[] = { 0.5, 2.0, 4.0, 6.5 };
+    const int count = G_N_ELEMENTS(intensities);
+    BlurWaitData waits[G_N_ELEMENTS(intensities)] = { { NULL, FALSE } };
+    
+    GdkPixbuf *source = create_test_pixbuf_rgba(400, 300);
+    
+    /* Submit everything before waiting so the requests overlap */
+    for (int i = 0; i < count; i++) {
+        guint request_id = blur_processor_apply_async(test_processor, source, intensities[i],
+                                                      FALSE, on_blur_completed, &waits[i]);
+        ck_assert_uint_ne(request_id, 0);
+    }
+    wait_for_blurs(waits, count);
+    
+    /* Each result must match the same blur computed in isolation */
+    BlurProcessor *reference_processor = blur_processor_create(400, 300, 1);
+    for (int i = 0; i < count; i++) {
+        GdkPixbuf *reference = blur_and_wait(reference_processor, source, intensities[i]);
+        assert_pixbufs_equal(reference, waits[i].result);
+        g_object_unref(reference);
+        g_object_unref(waits[i].result);
+    }
+    
+    blur_processor_destroy(reference_processor);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Helper: plain two-pass Gaussian with the library kernel, used as the
+ * reference the faster engines are compared against */
+static guchar* reference_gaussian_blur(GdkPixbuf *source, double sigma) {
+    int width = gdk_pixbuf_get_width(source);
+    int height = gdk_pixbuf_get_height(source);
+    int channels = gdk_pixbuf_get_n_channels(source);
+    int rowstride = gdk_pixbuf_get_rowstride(source);
+    const guchar *pixels = gdk_pixbuf_get_pixels(source);
+    
+    int kernel_size = blur_calculate_kernel_size(sigma);
+    gfloat *kernel = blur_generate_kernel(sigma, kernel_size);
+    int half = kernel_size / 2;
+    
+    float *horizontal = g_new(float, (gsize)width * height * channels);
+    guchar *output = g_malloc((gsize)width * height * channels);
+    
+    /* Symmetric reflection, matching the box engine edges */
+    #define REFLECT(v, n) ((v) < 0 ? -(v) - 1 : ((v) >= (n) ? 2 * (n) - (v) - 1 : (v)))
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < channels; c++) {
+                float sum = 0.0f;
+                for (int k = 0; k < kernel_size; k++) {
+                    int sx = REFLECT(x + k - half, width);
+                    sum += pixels[y * rowstride + sx * channels + c] * kernel[k];
+                }
+                horizontal[((gsize)y * width + x) * channels + c] = sum;
+            }
+        }
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < channels; c++) {
+                float sum = 0.0f;
+                for (int k = 0; k < kernel_size; k++) {
+                    int sy = REFLECT(y + k - half, height);
+                    sum += horizontal[((gsize)sy * width + x) * channels + c] * kernel[k];
+                }
+                output[((gsize)y * width + x) * channels + c] = (guchar)CLAMP(sum + 0.5f, 0, 255);
+            }
+        }
+    }
+    #undef REFLECT
+    
+    g_free(kernel);
+    g_free(horizontal);
+    return output;
+}
+
+/* Test: Box widths reproduce the requested Gaussian variance */
+START_TEST(test_box_sizes_match_sigma) {
+    double test_sigmas[] = {3.0, 4.5, 8.0, 13.7, 20.0};
+    
+    for (int i = 0; i < (int)G_N_ELEMENTS(test_sigmas); i++) {
+        gint sizes[3];
+        ck_assert(blur_calculate_box_sizes(test_sigmas[i], sizes, 3));
+        
+        double variance = 0.0;
+        for (int j = 0; j < 3; j++) {
+            ck_assert_int_eq(sizes[j] % 2, 1);
+            variance += (sizes[j] * sizes[j] - 1) / 12.0;
+        }
+        
+        /* Odd widths step the variance by about one box width */
+        double sigma_sq = test_sigmas[i] * test_sigmas[i];
+        ck_assert_msg(fabs(variance - sigma_sq) <= sizes[2],
+                      "sigma %.1f: box variance %.2f", test_sigmas[i], variance);
+    }
+    
+    gint sizes[3];
+    ck_assert(!blur_calculate_box_sizes(0.0, sizes, 3));
+    ck_assert(!blur_calculate_box_sizes(2.0, NULL, 3));
+}
+END_TEST
+
+/* Test: Large-sigma box engine stays close to a true Gaussian */
+START_TEST(test_box_engine_approximates_gaussian) {
+    GdkPixbuf *source = create_test_pixbuf_rgba(160, 120);
+    double intensities[] = {2.0, 5.0, 10.0};  // sigma 4, 10, 20: all above the threshold
+    
+    for (int i = 0; i < (int)G_N_ELEMENTS(intensities); i++) {
+        double sigma = blur_calculate_sigma(intensities[i]);
+        ck_assert(sigma >= BLUR_BOX_SIGMA_THRESHOLD);
+        
+        GdkPixbuf *result = blur_and_wait(test_processor, source, intensities[i]);
+        guchar *reference = reference_gaussian_blur(source, sigma);
+        
+        int width = gdk_pixbuf_get_width(result);
+        int height = gdk_pixbuf_get_height(result);
+        int row_bytes = width * 4;
+        double total_error = 0.0;
+        int max_error = 0;
+        
+        for (int y = 0; y < height; y++) {
+            const guchar *row = gdk_pixbuf_get_pixels(result) + y * gdk_pixbuf_get_rowstride(result);
+            for (int j = 0; j < row_bytes; j++) {
+                int diff = abs(row[j] - reference[y * row_bytes + j]);
+                total_error += diff;
+                max_error = MAX(max_error, diff);
+            }
+        }
+        
+        double mean_error = total_error / ((double)row_bytes * height);
+        ck_assert_msg(mean_error < 1.0, "intensity %.1f: mean error %.2f", intensities[i], mean_error);
+        ck_assert_msg(max_error <= 4, "intensity %.1f: max error %d", intensities[i], max_error);
+        
+        g_free(reference);
+        g_object_unref(result);
+    }
+    
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Box engine preserves flat regions exactly */
+START_TEST(test_box_engine_flat_image) {
+    GdkPixbuf *source = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 97, 41);
+    gdk_pixbuf_fill(source, 0xc8643200);
+    
+    GdkPixbuf *result = blur_and_wait(test_processor, source, 10.0);
+    
+    for (int y = 0; y < 41; y++) {
+        const guchar *row = gdk_pixbuf_get_pixels(result) + y * gdk_pixbuf_get_rowstride(result);
+        for (int x = 0; x < 97; x++) {
+            ck_assert_int_eq(row[x * 3 + 0], 0xc8);
+            ck_assert_int_eq(row[x * 3 + 1], 0x64);
+            ck_assert_int_eq(row[x * 3 + 2], 0x32);
+        }
+    }
+    
+    g_object_unref(result);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Helper: processor forced onto one kernel implementation */
+static BlurProcessor* create_processor_with_kernels(const char *name, int thread_count) {
+    g_setenv("BLUR_PROCESSOR_SIMD", name, TRUE);
+    BlurProcessor *processor = blur_processor_create(640, 480, thread_count);
+    g_unsetenv("BLUR_PROCESSOR_SIMD");
+    ck_assert_ptr_nonnull(processor);
+    return processor;
+}
+
+/* Test: Every vector kernel reproduces the scalar reference */
+START_TEST(test_simd_kernels_match_scalar) {
+    const char *variants[] = {"sse4.1", "avx2", "neon"};
+    double intensities[] = {0.3, 0.8, 1.45};  // Gaussian kernel range, below the box threshold
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(97, 61),
+        create_test_pixbuf_rgba(333, 257),
+        create_test_pixbuf_rgba(5, 3),  // Narrower than the kernel radius
+    };
+    
+    BlurProcessor *scalar = create_processor_with_kernels("scalar", 2);
+    ck_assert_str_eq(blur_processor_get_kernel_name(scalar), "scalar");
+    
+    for (int v = 0; v < (int)G_N_ELEMENTS(variants); v++) {
+        BlurProcessor *vector = create_processor_with_kernels(variants[v], 2);
+        
+        /* Unsupported here: selection falls back to another implementation */
+        if (g_strcmp0(blur_processor_get_kernel_name(vector), variants[v]) != 0) {
+            blur_processor_destroy(vector);
+            continue;
+        }
+        
+        for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+            for (int i = 0; i < (int)G_N_ELEMENTS(intensities); i++) {
+                /* Full quality runs the float passes, progressive the integer ones */
+                for (int progressive = 0; progressive <= 1; progressive++) {
+                    GdkPixbuf *reference = blur_and_wait_mode(scalar, sources[s], intensities[i], progressive);
+                    GdkPixbuf *result = blur_and_wait_mode(vector, sources[s], intensities[i], progressive);
+                    
+                    assert_pixbufs_equal(reference, result);
+                    
+                    g_object_unref(reference);
+                    g_object_unref(result);
+                }
+            }
+        }
+        
+        blur_processor_destroy(vector);
+    }
+    
+    blur_processor_destroy(scalar);
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        g_object_unref(sources[s]);
+    }
+}
+END_TEST
+
+/* Test: Q14 kernel sums to exactly one and tracks the float weights */
+START_TEST(test_fixed_kernel_generation) {
+    double sigmas[] = {0.6, 1.0, 2.9, 20.0};
+    
+    for (int i = 0; i < (int)G_N_ELEMENTS(sigmas); i++) {
+        gint size = blur_calculate_kernel_size(sigmas[i]);
+        gfloat *kernel = blur_generate_kernel(sigmas[i], size);
+        gint16 *kernel_fixed = blur_generate_kernel_fixed(sigmas[i], size);
+        ck_assert_ptr_nonnull(kernel_fixed);
+        
+        int sum = 0;
+        for (int k = 0; k < size; k++) {
+            sum += kernel_fixed[k];
+            ck_assert_int_ge(kernel_fixed[k], 0);
+            ck_assert_int_eq(kernel_fixed[k], kernel_fixed[size - 1 - k]);
+            ck_assert(fabs(kernel_fixed[k] - kernel[k] * BLUR_FIXED_POINT_ONE) <= size);
+        }
+        ck_assert_int_eq(sum, BLUR_FIXED_POINT_ONE);
+        
+        g_free(kernel);
+        g_free(kernel_fixed);
+    }
+    
+    ck_assert_ptr_null(blur_generate_kernel_fixed(1.0, 4));
+    ck_assert_ptr_null(blur_generate_kernel_fixed(0.0, 5));
+}
+END_TEST
+
+/* Test: progressive (integer) blur stays within the documented error */
+START_TEST(test_fixed_point_matches_float) {
+    /* Sources below BLUR_PREVIEW_MAX_SIZE are not downscaled */
+    double intensities[] = {0.4, 1.0, 1.45};
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(101, 67),
+        create_test_pixbuf_rgba(160, 90),
+    };
+    
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        int width = gdk_pixbuf_get_width(sources[s]);
+        int height = gdk_pixbuf_get_height(sources[s]);
+        int row_bytes = width * gdk_pixbuf_get_n_channels(sources[s]);
+        
+        for (int i = 0; i < (int)G_N_ELEMENTS(intensities); i++) {
+            GdkPixbuf *exact = blur_and_wait_mode(test_processor, sources[s], intensities[i], FALSE);
+            GdkPixbuf *fixed = blur_and_wait_mode(test_processor, sources[s], intensities[i], TRUE);
+            int max_error = 0;
+            
+            for (int y = 0; y < height; y++) {
+                const guchar *row_a = gdk_pixbuf_get_pixels(exact) + y * gdk_pixbuf_get_rowstride(exact);
+                const guchar *row_b = gdk_pixbuf_get_pixels(fixed) + y * gdk_pixbuf_get_rowstride(fixed);
+                for (int x = 0; x < row_bytes; x++) {
+                    max_error = MAX(max_error, abs(row_a[x] - row_b[x]));
+                }
+            }
+            ck_assert_int_le(max_error, 2);
+            
+            g_object_unref(exact);
+            g_object_unref(fixed);
+        }
+        
+        g_object_unref(sources[s]);
+    }
+}
+END_TEST
+
+/* Test: integer path reproduces flat images exactly */
+START_TEST(test_fixed_point_flat_image) {
+    GdkPixbuf *flat = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, 64, 48);
+    gdk_pixbuf_fill(flat, 0xff8001c8);
+    
+    GdkPixbuf *result = blur_and_wait_mode(test_processor, flat, 2.5, TRUE);
+    assert_pixbufs_equal(flat, result);
+    
+    g_object_unref(result);
+    g_object_unref(flat);
+}
+END_TEST
+
+/* Test: preview factor brings the longest edge under the preview size */
+START_TEST(test_preview_factor) {
+    ck_assert_int_eq(blur_calculate_preview_factor(640, 480), 1);
+    ck_assert_int_eq(blur_calculate_preview_factor(1024, 1024), 1);
+    ck_assert_int_eq(blur_calculate_preview_factor(1920, 1080), 2);
+    ck_assert_int_eq(blur_calculate_preview_factor(1080, 1920), 2);
+    ck_assert_int_eq(blur_calculate_preview_factor(3840, 2160), 4);
+    ck_assert_int_eq(blur_calculate_preview_factor(7680, 4320), 8);
+    ck_assert_int_eq(blur_calculate_preview_factor(30000, 100), BLUR_PREVIEW_MAX_FACTOR);
+}
+END_TEST
+
+/* Test: progressive requests return a downscaled, blurred preview */
+START_TEST(test_progressive_preview_downscaled) {
+    GdkPixbuf *source = create_test_pixbuf_rgba(2050, 1101);  // Factor 4, partial edge blocks
+    
+    GdkPixbuf *first = blur_and_wait_mode(test_processor, source, 3.0, TRUE);
+    ck_assert_int_eq(gdk_pixbuf_get_width(first), 513);
+    ck_assert_int_eq(gdk_pixbuf_get_height(first), 276);
+    ck_assert_int_eq(gdk_pixbuf_get_n_channels(first), 4);
+    
+    /* The second request reuses the cached downsample */
+    GdkPixbuf *second = blur_and_wait_mode(test_processor, source, 3.0, TRUE);
+    assert_pixbufs_equal(first, second);
+    
+    /* Full quality keeps the source size */
+    GdkPixbuf *full = blur_and_wait_mode(test_processor, source, 3.0, FALSE);
+    ck_assert_int_eq(gdk_pixbuf_get_width(full), 2050);
+    ck_assert_int_eq(gdk_pixbuf_get_height(full), 1101);
+    
+    g_object_unref(first);
+    g_object_unref(second);
+    g_object_unref(full);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: the downsample averages, so flat images stay flat */
+START_TEST(test_progressive_preview_flat_image) {
+    GdkPixbuf *flat = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 1500, 999);
+    gdk_pixbuf_fill(flat, 0x3c9de100);
+    
+    GdkPixbuf *preview = blur_and_wait_mode(test_processor, flat, 5.0, TRUE);
+    ck_assert_int_eq(gdk_pixbuf_get_width(preview), 750);
+    ck_assert_int_eq(gdk_pixbuf_get_height(preview), 500);
+    
+    for (int y = 0; y < gdk_pixbuf_get_height(preview); y++) {
+        const guchar *row = gdk_pixbuf_get_pixels(preview) + y * gdk_pixbuf_get_rowstride(preview);
+        for (int x = 0; x < gdk_pixbuf_get_width(preview); x++) {
+            ck_assert_int_eq(row[x * 3 + 0], 0x3c);
+            ck_assert_int_eq(row[x * 3 + 1], 0x9d);
+            ck_assert_int_eq(row[x * 3 + 2], 0xe1);
+        }
+    }
+    
+    g_object_unref(preview);
+    g_object_unref(flat);
+}
+END_TEST
+
+/* Helper: blur @source at @intensity starting from @base and wait */
+static GdkPixbuf* blur_from_base_and_wait(BlurProcessor *processor, GdkPixbuf *source,
+                                          GdkPixbuf *base, gdouble base_intensity,
+                                          gdouble intensity) {
+    BlurWaitData wait = { NULL, FALSE };
+    
+    guint request_id = blur_processor_apply_async_from_base(processor, source, base,
+                                                            base_intensity, intensity,
+                                                            BLUR_PRIORITY_NORMAL,
+                                                            on_blur_completed, &wait);
+    ck_assert_uint_ne(request_id, 0);
+    wait_for_blurs(&wait, 1);
+    ck_assert_ptr_nonnull(wait.result);
+    
+    return wait.result;
+}
+
+/* Test: residual sigma follows sigma_target^2 = sigma_base^2 + sigma_residual^2 */
+START_TEST(test_residual_sigma) {
+    ck_assert_double_eq_tol(blur_calculate_residual_sigma(4.0, 5.0), 6.0, 1e-9);
+    ck_assert_double_eq_tol(blur_calculate_residual_sigma(0.0, 1.0), 2.0, 1e-9);
+    ck_assert_double_eq_tol(blur_calculate_residual_sigma(1.0, 1.0), 0.0, 1e-9);
+    ck_assert_double_eq_tol(blur_calculate_residual_sigma(2.0, 1.0), 0.0, 1e-9);
+}
+END_TEST
+
+/* Test: blurring a lower intensity result matches a direct blur */
+START_TEST(test_incremental_matches_direct) {
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(101, 67),
+        create_test_pixbuf_rgba(160, 90),
+    };
+    BlurProcessorStats stats;
+    
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        int width = gdk_pixbuf_get_width(sources[s]);
+        int height = gdk_pixbuf_get_height(sources[s]);
+        int row_bytes = width * gdk_pixbuf_get_n_channels(sources[s]);
+        
+        GdkPixbuf *base = blur_and_wait(test_processor, sources[s], 0.8);
+        GdkPixbuf *direct = blur_and_wait(test_processor, sources[s], 1.2);
+        GdkPixbuf *incremental = blur_from_base_and_wait(test_processor, sources[s], base, 0.8, 1.2);
+        int max_error = 0;
+        
+        for (int y = 0; y < height; y++) {
+            const guchar *row_a = gdk_pixbuf_get_pixels(direct) + y * gdk_pixbuf_get_rowstride(direct);
+            const guchar *row_b = gdk_pixbuf_get_pixels(incremental) + y * gdk_pixbuf_get_rowstride(incremental);
+            for (int x = 0; x < row_bytes; x++) {
+                max_error = MAX(max_error, abs(row_a[x] - row_b[x]));
+            }
+        }
+        ck_assert_int_le(max_error, 2);
+        
+        g_object_unref(base);
+        g_object_unref(direct);
+        g_object_unref(incremental);
+        g_object_unref(sources[s]);
+    }
+    
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.incremental_requests, 2);
+}
+END_TEST
+
+/* Test: bases that would not save work are ignored */
+START_TEST(test_incremental_falls_back_to_source) {
+    GdkPixbuf *source = create_test_pixbuf(120, 80);
+    GdkPixbuf *other_size = create_test_pixbuf(60, 40);
+    BlurProcessorStats stats;
+    
+    /* Box engine target: cost does not depend on sigma */
+    GdkPixbuf *base = blur_and_wait(test_processor, source, 4.0);
+    GdkPixbuf *direct = blur_and_wait(test_processor, source, 4.5);
+    GdkPixbuf *result = blur_from_base_and_wait(test_processor, source, base, 4.0, 4.5);
+    assert_pixbufs_equal(direct, result);
+    g_object_unref(result);
+    
+    /* Base not below the target, and base of another size */
+    result = blur_from_base_and_wait(test_processor, source, base, 4.0, 1.0);
+    g_object_unref(result);
+    result = blur_from_base_and_wait(test_processor, source, other_size, 0.5, 1.0);
+    g_object_unref(result);
+    
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.incremental_requests, 0);
+    
+    g_object_unref(base);
+    g_object_unref(direct);
+    g_object_unref(other_size);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Helper: callback that must never run */
+static void on_cancelled_blur_completed(GdkPixbuf *result, const GError *error, gpointer user_data) {
+    ck_abort_msg("cancelled request invoked its callback");
+}
+
+/* Helper: iterate the main loop until the processor has seen @count cancellations */
+static void wait_for_cancelled(BlurProcessor *processor, guint64 count, BlurProcessorStats *stats) {
+    gint64 deadline = g_get_monotonic_time() + 10 * G_USEC_PER_SEC;
+    
+    for (;;) {
+        blur_processor_get_stats(processor, stats);
+        if (stats->cancelled_before_start + stats->cancelled_in_flight >= count) {
+            break;
+        }
+        ck_assert_msg(g_get_monotonic_time() < deadline, "cancelled requests never reached a worker");
+        g_main_context_iteration(NULL, FALSE);
+        g_usleep(1000);
+    }
+    
+    /* Flush idle callbacks; a cancelled request must not have queued one */
+    while (g_main_context_iteration(NULL, FALSE)) {
+    }
+}
+
+/* Test: queued requests cancelled before they start are dropped */
+START_TEST(test_cancel_drops_queued_requests) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *source = create_test_pixbuf_rgba(640, 480);
+    BlurWaitData running = { NULL, FALSE };
+    BlurProcessorStats stats;
+    
+    /* A single worker is busy with the first request while the others wait */
+    guint first = blur_processor_apply_async(processor, source, 1.4, FALSE, on_blur_completed, &running);
+    guint queued[3];
+    for (int i = 0; i < 3; i++) {
+        queued[i] = blur_processor_apply_async(processor, source, 1.4, FALSE,
+                                               on_cancelled_blur_completed, NULL);
+        ck_assert_uint_ne(queued[i], 0);
+    }
+    for (int i = 0; i < 3; i++) {
+        ck_assert(blur_processor_cancel(processor, queued[i]));
+        ck_assert(!blur_processor_cancel(processor, queued[i]));
+    }
+    
+    wait_for_blurs(&running, 1);
+    ck_assert_uint_ne(first, 0);
+    wait_for_cancelled(processor, 3, &stats);
+    
+    ck_assert_uint_eq(stats.cancelled_requests, 3);
+    ck_assert_uint_eq(stats.completed_requests, 1);
+    ck_assert_uint_eq(stats.cancelled_before_start + stats.cancelled_in_flight, 3);
+    ck_assert_uint_ge(stats.cancelled_before_start, 2);
+    ck_assert_int_gt(stats.time_saved_us, 0);
+    
+    g_object_unref(running.result);
+    g_object_unref(source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Test: a running request stops part way through when cancelled */
+START_TEST(test_cancel_stops_running_request) {
+    BlurProcessor *processor = create_processor_with_kernels("scalar", 1);
+    GdkPixbuf *small = create_test_pixbuf_rgba(200, 150);
+    GdkPixbuf *large = create_test_pixbuf_rgba(3000, 2000);
+    BlurProcessorStats stats;
+    
+    /* Warm up the cost model used for the time saved estimate */
+    GdkPixbuf *warmup = blur_and_wait(processor, small, 1.45);
+    g_object_unref(warmup);
+    
+    guint request_id = blur_processor_apply_async(processor, large, 1.45, FALSE,
+                                                  on_cancelled_blur_completed, NULL);
+    ck_assert_uint_ne(request_id, 0);
+    g_usleep(20 * 1000);  // Let the worker get into the first pass
+    ck_assert(blur_processor_cancel(processor, request_id));
+    
+    wait_for_cancelled(processor, 1, &stats);
+    ck_assert_uint_eq(stats.cancelled_in_flight, 1);
+    ck_assert_uint_eq(stats.completed_requests, 1);
+    ck_assert_int_gt(stats.time_saved_us, 0);
+    
+    /* The processor keeps serving requests afterwards */
+    GdkPixbuf *after = blur_and_wait(processor, small, 1.45);
+    g_object_unref(after);
+    
+    g_object_unref(small);
+    g_object_unref(large);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Helper: latency percentiles are ordered and cover @samples requests */
+static void assert_latency_valid(const BlurLatencyStats *latency, guint samples) {
+    ck_assert_uint_eq(latency->samples, samples);
+    ck_assert_int_ge(latency->p50_us, 0);
+    ck_assert_int_le(latency->p50_us, latency->p99_us);
+    ck_assert_int_le(latency->p99_us, latency->max_us);
+}
+
+/* Test: Timing probes fill the latency stats of completed requests only */
+START_TEST(test_latency_stats) {
+    BlurProcessor *processor = blur_processor_create(512, 512, 2);
+    GdkPixbuf *source = create_test_pixbuf_rgba(400, 300);
+    BlurProcessorStats stats;
+    
+    blur_processor_get_stats(processor, &stats);
+    assert_latency_valid(&stats.total, 0);
+    ck_assert_int_eq(stats.total.max_us, 0);
+    ck_assert(stats.throughput_mpixels == 0.0);
+    
+    for (int i = 0; i < 5; i++) {
+        GdkPixbuf *result = blur_and_wait(processor, source, 1.0 + i);
+        g_object_unref(result);
+    }
+    
+    /* A cancelled request is counted but adds no latency sample */
+    guint request_id = blur_processor_apply_async(processor, source, 2.0, FALSE,
+                                                  on_cancelled_blur_completed, NULL);
+    ck_assert(blur_processor_cancel(processor, request_id));
+    wait_for_cancelled(processor, 1, &stats);
+    
+    assert_latency_valid(&stats.queue_wait, 5);
+    assert_latency_valid(&stats.horizontal_pass, 5);
+    assert_latency_valid(&stats.vertical_pass, 5);
+    assert_latency_valid(&stats.compute, 5);
+    assert_latency_valid(&stats.delivery, 5);
+    assert_latency_valid(&stats.total, 5);
+    ck_assert_int_gt(stats.compute.max_us, 0);
+    ck_assert_int_ge(stats.total.max_us, stats.compute.p50_us);
+    ck_assert(stats.throughput_mpixels > 0.0);
+    
+    /* Grayscale conversions are timed but leave the blur rate alone */
+    gdouble throughput = stats.throughput_mpixels;
+    GdkPixbuf *gray = NULL;
+    BlurWaitData wait = { NULL, FALSE };
+    blur_processor_grayscale_async(processor, source, BLUR_PRIORITY_VISIBLE, on_blur_completed, &wait);
+    wait_for_blurs(&wait, 1);
+    gray = wait.result;
+    blur_processor_get_stats(processor, &stats);
+    assert_latency_valid(&stats.compute, 6);
+    ck_assert(stats.throughput_mpixels == throughput);
+    
+    /* The window keeps only the most recent requests */
+    GdkPixbuf *small = create_test_pixbuf(32, 32);
+    for (int i = 0; i < BLUR_LATENCY_WINDOW; i++) {
+        GdkPixbuf *result = blur_and_wait(processor, small, 2.0);
+        g_object_unref(result);
+    }
+    blur_processor_get_stats(processor, &stats);
+    assert_latency_valid(&stats.total, BLUR_LATENCY_WINDOW);
+    
+    g_object_unref(small);
+    g_object_unref(gray);
+    g_object_unref(source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Helper: convert on @processor and wait for the result */
+static GdkPixbuf* grayscale_and_wait(BlurProcessor *processor, GdkPixbuf *source) {
+    BlurWaitData wait = { NULL, FALSE };
+    
+    guint request_id = blur_processor_grayscale_async(processor, source, BLUR_PRIORITY_VISIBLE,
+                                                      on_blur_completed, &wait);
+    ck_assert_uint_ne(request_id, 0);
+    wait_for_blurs(&wait, 1);
+    ck_assert_ptr_nonnull(wait.result);
+    
+    return wait.result;
+}
+
+/* Test: Async grayscale produces the Q15 luminance and keeps alpha */
+START_TEST(test_grayscale_async_luminance) {
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(641, 479),
+        create_test_pixbuf_rgba(333, 257),
+    };
+    
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        GdkPixbuf *result = grayscale_and_wait(test_processor, sources[s]);
+        int width = gdk_pixbuf_get_width(sources[s]);
+        int height = gdk_pixbuf_get_height(sources[s]);
+        int channels = gdk_pixbuf_get_n_channels(sources[s]);
+        
+        ck_assert_int_eq(gdk_pixbuf_get_width(result), width);
+        ck_assert_int_eq(gdk_pixbuf_get_height(result), height);
+        ck_assert_int_eq(gdk_pixbuf_get_n_channels(result), channels);
+        
+        for (int y = 0; y < height; y++) {
+            const guchar *src = gdk_pixbuf_get_pixels(sources[s]) + y * gdk_pixbuf_get_rowstride(sources[s]);
+            const guchar *dst = gdk_pixbuf_get_pixels(result) + y * gdk_pixbuf_get_rowstride(result);
+            for (int x = 0; x < width; x++) {
+                const guchar *in = src + x * channels;
+                const guchar *out = dst + x * channels;
+                int expected = (in[0] * 9798 + in[1] * 19235 + in[2] * 3735) >> 15;
+                
+                ck_assert_int_eq(out[0], expected);
+                ck_assert_int_eq(out[1], expected);
+                ck_assert_int_eq(out[2], expected);
+                if (channels == 4) {
+                    ck_assert_int_eq(out[3], in[3]);
+                }
+            }
+        }
+        
+        g_object_unref(result);
+        g_object_unref(sources[s]);
+    }
+    
+    /* Gray input maps to itself, white stays white */
+    GdkPixbuf *gray = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 256, 1);
+    guchar *pixels = gdk_pixbuf_get_pixels(gray);
+    for (int x = 0; x < 256; x++) {
+        pixels[x * 3 + 0] = pixels[x * 3 + 1] = pixels[x * 3 + 2] = (guchar)x;
+    }
+    GdkPixbuf *result = grayscale_and_wait(test_processor, gray);
+    ck_assert(memcmp(gdk_pixbuf_get_pixels(result), pixels, 256 * 3) == 0);
+    
+    BlurProcessorStats stats;
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.grayscale_requests, 3);
+    
+    g_object_unref(result);
+    g_object_unref(gray);
+}
+END_TEST
+
+/* Test: Every vector grayscale kernel reproduces the scalar reference */
+START_TEST(test_grayscale_kernels_match_scalar) {
+    const char *variants[] = {"sse4.1", "avx2", "neon"};
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(97, 61),
+        create_test_pixbuf_rgba(333, 257),
+        create_test_pixbuf(5, 3),  // Narrower than one vector
+        create_test_pixbuf_rgba(3, 2),
+    };
+    
+    BlurProcessor *scalar = create_processor_with_kernels("scalar", 2);
+    
+    for (int v = 0; v < (int)G_N_ELEMENTS(variants); v++) {
+        BlurProcessor *vector = create_processor_with_kernels(variants[v], 4);
+        
+        if (g_strcmp0(blur_processor_get_kernel_name(vector), variants[v]) != 0) {
+            blur_processor_destroy(vector);
+            continue;
+        }
+        
+        for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+            GdkPixbuf *reference = grayscale_and_wait(scalar, sources[s]);
+            GdkPixbuf *result = grayscale_and_wait(vector, sources[s]);
+            
+            assert_pixbufs_equal(reference, result);
+            
+            g_object_unref(reference);
+            g_object_unref(result);
+        }
+        
+        blur_processor_destroy(vector);
+    }
+    
+    blur_processor_destroy(scalar);
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        g_object_unref(sources[s]);
+    }
+}
+END_TEST
+
+/* Test: A cancelled conversion never calls back and frees its worker */
+START_TEST(test_grayscale_cancel) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *source = create_test_pixbuf_rgba(640, 480);
+    BlurWaitData running = { NULL, FALSE };
+    BlurProcessorStats stats;
+    
+    /* The worker is busy with a blur while the conversion waits */
+    blur_processor_apply_async(processor, source, 1.4, FALSE, on_blur_completed, &running);
+    guint request_id = blur_processor_grayscale_async(processor, source, BLUR_PRIORITY_NORMAL,
+                                                      on_cancelled_blur_completed, NULL);
+    ck_assert_uint_ne(request_id, 0);
+    ck_assert(blur_processor_cancel(processor, request_id));
+    
+    wait_for_blurs(&running, 1);
+    wait_for_cancelled(processor, 1, &stats);
+    ck_assert_uint_eq(stats.grayscale_requests, 0);
+    
+    /* A conversion does not supersede a queued blur of the same source */
+    blur_processor_set_schedule_mode(processor, BLUR_SCHEDULE_LATEST_WINS);
+    BlurWaitData waits[2] = { { NULL, FALSE }, { NULL, FALSE } };
+    blur_processor_apply_async(processor, source, 1.4, FALSE, on_blur_completed, &waits[0]);
+    blur_processor_grayscale_async(processor, source, BLUR_PRIORITY_NORMAL, on_blur_completed, &waits[1]);
+    wait_for_blurs(waits, 2);
+    
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.superseded_requests, 0);
+    ck_assert_uint_eq(stats.grayscale_requests, 1);
+    
+    for (int i = 0; i < 2; i++) {
+        g_object_unref(waits[i].result);
+    }
+    g_object_unref(running.result);
+    g_object_unref(source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+static GdkPixbuf* stages_and_wait(BlurProcessor *processor, GdkPixbuf *source,
+                                  BlurStages stages, gdouble intensity) {
+    BlurWaitData wait = { NULL, FALSE };
+    
+    guint request_id = blur_processor_apply_stages_async(processor, source, stages, intensity, FALSE,
+                                                         BLUR_PRIORITY_VISIBLE, on_blur_completed, &wait);
+    ck_assert_uint_ne(request_id, 0);
+    wait_for_blurs(&wait, 1);
+    ck_assert_ptr_nonnull(wait.result);
+    
+    return wait.result;
+}
+
+/* Test: Gray content is blurred as one plane with the colour result */
+START_TEST(test_single_channel_matches_colour) {
+    BlurProcessor *processors[] = { test_processor, create_processor_with_kernels("scalar", 2) };
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(301, 199),
+        create_test_pixbuf_rgba(333, 257),
+        create_test_pixbuf_rgba(7, 6),  // Partial last row group
+    };
+    double intensities[] = {1.0, 10.0};  // Gaussian kernel and box engine
+    BlurProcessorStats stats;
+    guint64 expected_single = 0;
+    
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        GdkPixbuf *gray = grayscale_and_wait(test_processor, sources[s]);
+        int channels = gdk_pixbuf_get_n_channels(gray);
+        
+        /* One changed blue byte keeps the colour path; red is unaffected */
+        GdkPixbuf *marked = gdk_pixbuf_copy(gray);
+        gdk_pixbuf_get_pixels(marked)[2] ^= 1;
+        ck_assert(blur_pixbuf_is_grayscale(gray));
+        ck_assert(!blur_pixbuf_is_grayscale(marked));
+        ck_assert(!blur_pixbuf_is_grayscale(sources[s]));
+        
+        for (int p = 0; p < (int)G_N_ELEMENTS(processors); p++) {
+            for (int i = 0; i < (int)G_N_ELEMENTS(intensities); i++) {
+                for (int progressive = 0; progressive < 2; progressive++) {
+                    GdkPixbuf *reference = blur_and_wait_mode(processors[p], marked,
+                                                              intensities[i], progressive);
+                    GdkPixbuf *result = blur_and_wait_mode(processors[p], gray,
+                                                           intensities[i], progressive);
+                    int result_width = gdk_pixbuf_get_width(result);
+                    int result_height = gdk_pixbuf_get_height(result);
+                    
+                    ck_assert_int_eq(result_width, gdk_pixbuf_get_width(reference));
+                    ck_assert_int_eq(result_height, gdk_pixbuf_get_height(reference));
+                    for (int y = 0; y < result_height; y++) {
+                        const guchar *expected = gdk_pixbuf_read_pixels(reference) +
+                                                 y * gdk_pixbuf_get_rowstride(reference);
+                        const guchar *actual = gdk_pixbuf_read_pixels(result) +
+                                               y * gdk_pixbuf_get_rowstride(result);
+                        for (int x = 0; x < result_width; x++) {
+                            const guchar *e = expected + x * channels;
+                            const guchar *a = actual + x * channels;
+                            ck_assert_int_eq(a[0], e[0]);
+                            ck_assert_int_eq(a[1], e[0]);
+                            ck_assert_int_eq(a[2], e[0]);
+                            if (channels == 4) {
+                                ck_assert_int_eq(a[3], e[3]);
+                            }
+                        }
+                    }
+                    
+                    g_object_unref(reference);
+                    g_object_unref(result);
+                    if (p == 0) {
+                        expected_single++;
+                    }
+                }
+            }
+        }
+        
+        g_object_unref(marked);
+        g_object_unref(gray);
+        g_object_unref(sources[s]);
+    }
+    
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.single_channel_requests, expected_single);
+    
+    blur_processor_destroy(processors[1]);
+}
+END_TEST
+
+/* Test: The fused grayscale+blur pipeline matches the two separate steps */
+START_TEST(test_grayscale_blur_pipeline) {
+    BlurProcessor *tiled = blur_processor_create(256, 256, 2);
+    GdkPixbuf *sources[] = {
+        create_test_pixbuf(641, 479),
+        create_test_pixbuf_rgba(600, 300),
+    };
+    double intensities[] = {1.0, 10.0};
+    BlurStages both = BLUR_STAGE_GRAYSCALE | BLUR_STAGE_BLUR;
+    BlurProcessorStats stats;
+    
+    ck_assert_uint_eq(blur_processor_apply_stages_async(test_processor, sources[0], 0, 1.0, FALSE,
+                                                        BLUR_PRIORITY_NORMAL, on_blur_completed, NULL), 0);
+    
+    for (int s = 0; s < (int)G_N_ELEMENTS(sources); s++) {
+        GdkPixbuf *gray = grayscale_and_wait(test_processor, sources[s]);
+        
+        for (int i = 0; i < (int)G_N_ELEMENTS(intensities); i++) {
+            GdkPixbuf *expected = blur_and_wait(test_processor, gray, intensities[i]);
+            GdkPixbuf *fused = stages_and_wait(test_processor, sources[s], both, intensities[i]);
+            assert_pixbufs_equal(expected, fused);
+            g_object_unref(fused);
+            
+            /* Beyond the arena each tile is converted, then blurred in colour */
+            GdkPixbuf *tiles = stages_and_wait(tiled, sources[s], both, intensities[i]);
+            assert_pixbufs_equal(expected, tiles);
+            g_object_unref(tiles);
+            g_object_unref(expected);
+        }
+        
+        /* No blur leaves only the conversion */
+        GdkPixbuf *converted = stages_and_wait(test_processor, sources[s], both, 0.0);
+        assert_pixbufs_equal(gray, converted);
+        g_object_unref(converted);
+        converted = stages_and_wait(test_processor, sources[s], BLUR_STAGE_GRAYSCALE, 5.0);
+        assert_pixbufs_equal(gray, converted);
+        g_object_unref(converted);
+        
+        g_object_unref(gray);
+        g_object_unref(sources[s]);
+    }
+    
+    /* Per source: two plain gray blurs, two fused blurs */
+    blur_processor_get_stats(test_processor, &stats);
+    ck_assert_uint_eq(stats.single_channel_requests, 8);
+    blur_processor_get_stats(tiled, &stats);
+    ck_assert_uint_eq(stats.single_channel_requests, 0);
+    ck_assert_uint_eq(stats.tiled_requests, 4);
+    
+    blur_processor_destroy(tiled);
+}
+END_TEST
+
+/* Helper: records the order in which requests complete */
+typedef struct {
+    int tag;
+    int *log;
+    int *log_length;
+    gboolean superseded;
+    BlurWaitData wait;
+} OrderedBlur;
+
+static void on_ordered_blur_completed(GdkPixbuf *result, const GError *error, gpointer user_data) {
+    OrderedBlur *blur = user_data;
+    
+    if (error) {
+        ck_assert(g_error_matches(error, BLUR_ERROR, BLUR_ERROR_CANCELLED));
+        ck_assert_ptr_null(result);
+        blur->superseded = TRUE;
+    } else {
+        blur->wait.result = g_object_ref(result);
+        blur->log[(*blur->log_length)++] = blur->tag;
+    }
+    blur->wait.completed = TRUE;
+}
+
+/* Test: queued requests start in priority order */
+START_TEST(test_priority_ordering) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *blocker_source = create_test_pixbuf_rgba(640, 480);
+    GdkPixbuf *source = create_test_pixbuf(64, 48);
+    BlurPriority priorities[] = {BLUR_PRIORITY_BACKGROUND, BLUR_PRIORITY_NORMAL, BLUR_PRIORITY_VISIBLE};
+    int log[4];
+    int log_length = 0;
+    OrderedBlur blurs[4];
+    
+    /* The first request keeps the only worker busy while the rest queue up */
+    for (int i = 0; i < 4; i++) {
+        blurs[i] = (OrderedBlur){ i, log, &log_length, FALSE, { NULL, FALSE } };
+    }
+    blur_processor_apply_async_with_priority(processor, blocker_source, 1.4, FALSE, BLUR_PRIORITY_VISIBLE,
+                                             on_ordered_blur_completed, &blurs[3]);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_uint_ne(blur_processor_apply_async_with_priority(processor, source, 1.0, FALSE, priorities[i],
+                                                                   on_ordered_blur_completed, &blurs[i]), 0);
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        wait_for_blurs(&blurs[i].wait, 1);
+        g_object_unref(blurs[i].wait.result);
+    }
+    
+    ck_assert_int_eq(log_length, 4);
+    ck_assert_int_eq(log[0], 3);
+    ck_assert_int_eq(log[1], 2);  // Visible
+    ck_assert_int_eq(log[2], 1);  // Normal
+    ck_assert_int_eq(log[3], 0);  // Background
+    
+    g_object_unref(source);
+    g_object_unref(blocker_source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Test: latest-wins keeps one queued request per source, quality and priority */
+START_TEST(test_latest_wins_scheduling) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *blocker_source = create_test_pixbuf_rgba(640, 480);
+    GdkPixbuf *source = create_test_pixbuf(64, 48);
+    int log[8];
+    int log_length = 0;
+    OrderedBlur blurs[8];
+    BlurProcessorStats stats;
+    
+    blur_processor_set_schedule_mode(processor, BLUR_SCHEDULE_LATEST_WINS);
+    for (int i = 0; i < 8; i++) {
+        blurs[i] = (OrderedBlur){ i, log, &log_length, FALSE, { NULL, FALSE } };
+    }
+    
+    blur_processor_apply_async(processor, blocker_source, 1.4, FALSE, on_ordered_blur_completed, &blurs[0]);
+    
+    /* A slider drag: each request replaces the previous queued one */
+    for (int i = 1; i <= 5; i++) {
+        blur_processor_apply_async(processor, source, i * 0.2, FALSE, on_ordered_blur_completed, &blurs[i]);
+    }
+    
+    /* Different quality and priority are kept */
+    blur_processor_apply_async(processor, source, 1.0, TRUE, on_ordered_blur_completed, &blurs[6]);
+    blur_processor_apply_async_with_priority(processor, source, 1.0, FALSE, BLUR_PRIORITY_BACKGROUND,
+                                             on_ordered_blur_completed, &blurs[7]);
+    
+    for (int i = 0; i < 8; i++) {
+        wait_for_blurs(&blurs[i].wait, 1);
+    }
+    
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.superseded_requests, 4);
+    for (int i = 0; i < 8; i++) {
+        gboolean replaced = (i >= 1 && i <= 4);
+        ck_assert_int_eq(blurs[i].superseded, replaced);
+        ck_assert(replaced == (blurs[i].wait.result == NULL));
+        g_clear_object(&blurs[i].wait.result);
+    }
+    ck_assert_int_eq(log_length, 4);
+    
+    g_object_unref(source);
+    g_object_unref(blocker_source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Test: blocking calls return the async result without a main loop */
+START_TEST(test_sync_matches_async) {
+    GdkPixbuf *source = create_test_pixbuf(128, 96);
+    GdkPixbuf *expected = blur_and_wait(test_processor, source, 2.0);
+    GError *error = NULL;
+    
+    GdkPixbuf *result = blur_processor_apply_sync(test_processor, source, 2.0, &error);
+    ck_assert_ptr_null(error);
+    ck_assert_ptr_nonnull(result);
+    assert_pixbufs_equal(result, expected);
+    ck_assert(!g_main_context_pending(NULL));
+    g_object_unref(result);
+    
+    /* Zero intensity is the source itself */
+    result = blur_processor_apply_sync(test_processor, source, 0.0, &error);
+    ck_assert_ptr_eq(result, source);
+    g_object_unref(result);
+    
+    result = blur_processor_apply_stages_sync(test_processor, source, BLUR_STAGE_GRAYSCALE, 0.0, &error);
+    ck_assert_ptr_nonnull(result);
+    ck_assert(blur_pixbuf_is_grayscale(result));
+    g_object_unref(result);
+    
+    result = blur_processor_apply_sync(test_processor, source, 11.0, &error);
+    ck_assert_ptr_null(result);
+    ck_assert(g_error_matches(error, BLUR_ERROR, BLUR_ERROR_INVALID_INTENSITY));
+    g_clear_error(&error);
+    
+    g_object_unref(expected);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: a batch reports every item, failures included, at once */
+START_TEST(test_batch_sync) {
+    GdkPixbuf *source = create_test_pixbuf(96, 64);
+    GdkPixbuf *sources[3] = { source, create_test_pixbuf_rgba(80, 40), source };
+    gdouble intensities[4] = { 1.0, 2.0, 12.0, 4.0 };
+    BlurBatchItem items[4];
+    
+    for (int i = 0; i < 4; i++) {
+        items[i] = (BlurBatchItem){ i < 3 ? sources[i] : source, intensities[i], NULL, NULL };
+    }
+    
+    ck_assert_uint_eq(blur_processor_apply_batch_sync(test_processor, items, 4, BLUR_STAGE_BLUR), 1);
+    ck_assert(!g_main_context_pending(NULL));
+    
+    for (int i = 0; i < 4; i++) {
+        if (i == 2) {
+            ck_assert_ptr_null(items[i].result);
+            ck_assert(g_error_matches(items[i].error, BLUR_ERROR, BLUR_ERROR_INVALID_INTENSITY));
+            g_clear_error(&items[i].error);
+            continue;
+        }
+        
+        GdkPixbuf *expected = blur_and_wait(test_processor, items[i].pixbuf, items[i].intensity);
+        ck_assert_ptr_null(items[i].error);
+        assert_pixbufs_equal(items[i].result, expected);
+        g_object_unref(expected);
+        g_clear_object(&items[i].result);
+    }
+    
+    ck_assert_uint_eq(blur_processor_apply_batch_sync(test_processor, NULL, 0, BLUR_STAGE_BLUR), 0);
+    
+    g_object_unref(sources[1]);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: latest-wins never replaces the items of a batch */
+START_TEST(test_batch_latest_wins) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *blocker_source = create_test_pixbuf_rgba(640, 480);
+    GdkPixbuf *source = create_test_pixbuf(64, 48);
+    BlurWaitData blocker = { NULL, FALSE };
+    BlurBatchItem items[5];
+    BlurProcessorStats stats;
+    
+    blur_processor_set_schedule_mode(processor, BLUR_SCHEDULE_LATEST_WINS);
+    
+    /* Keeps the only worker busy so the items queue up behind it */
+    blur_processor_apply_async(processor, blocker_source, 1.4, FALSE, on_blur_completed, &blocker);
+    
+    for (int i = 0; i < 5; i++) {
+        items[i] = (BlurBatchItem){ source, (i + 1) * 0.5, NULL, NULL };
+    }
+    ck_assert_uint_eq(blur_processor_apply_batch_sync(processor, items, 5, BLUR_STAGE_BLUR), 0);
+    
+    for (int i = 0; i < 5; i++) {
+        ck_assert_ptr_null(items[i].error);
+        ck_assert_ptr_nonnull(items[i].result);
+        g_clear_object(&items[i].result);
+    }
+    
+    wait_for_blurs(&blocker, 1);
+    g_clear_object(&blocker.result);
+    
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.superseded_requests, 0);
+    
+    g_object_unref(source);
+    g_object_unref(blocker_source);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+static void on_batch_drained(BlurBatchItem *items, guint n_items, gpointer user_data) {
+    for (guint i = 0; i < n_items; i++) {
+        ck_assert((items[i].result == NULL) != (items[i].error == NULL));
+        ck_assert(!items[i].error ||
+                  g_error_matches(items[i].error, BLUR_ERROR, BLUR_ERROR_CANCELLED));
+    }
+    g_atomic_int_set((gint *)user_data, TRUE);
+}
+
+/* Test: destroying the processor completes queued worker deliveries */
+START_TEST(test_destroy_completes_waiters) {
+    BlurProcessor *processor = blur_processor_create(640, 480, 1);
+    GdkPixbuf *source = create_test_pixbuf_rgba(640, 480);
+    BlurBatchItem items[6];
+    gint completed = FALSE;
+    
+    for (int i = 0; i < 6; i++) {
+        items[i] = (BlurBatchItem){ source, 1.0 + i, NULL, NULL };
+    }
+    blur_processor_apply_batch_async(processor, items, 6, BLUR_STAGE_BLUR, BLUR_PRIORITY_NORMAL,
+                                     BLUR_DELIVERY_WORKER, NULL, on_batch_drained, &completed);
+    blur_processor_destroy(processor);
+    
+    /* Whatever had not run yet was cancelled rather than forgotten */
+    ck_assert(g_atomic_int_get(&completed));
+    for (int i = 0; i < 6; i++) {
+        g_clear_object(&items[i].result);
+        g_clear_error(&items[i].error);
+    }
+    
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Released memory is allocated again on demand */
+START_TEST(test_release_memory) {
+    GdkPixbuf *source = create_test_pixbuf(96, 64);
+    GdkPixbuf *before = blur_processor_apply_sync(test_processor, source, 2.0, NULL);
+    ck_assert_ptr_nonnull(before);
+    
+    /* The result goes back to the pool, so there is always something idle */
+    GdkPixbuf *pooled = blur_processor_apply_sync(test_processor, source, 3.0, NULL);
+    g_object_unref(pooled);
+    ck_assert_uint_gt(blur_processor_release_memory(test_processor), 0);
+    ck_assert_uint_eq(blur_processor_release_memory(test_processor), 0);
+    
+    GdkPixbuf *after = blur_processor_apply_sync(test_processor, source, 2.0, NULL);
+    ck_assert_ptr_nonnull(after);
+    assert_pixbufs_equal(after, before);
+    
+    g_object_unref(after);
+    g_object_unref(before);
+    g_object_unref(source);
+}
+END_TEST
+
+/* Test: Scratch memory is only allocated for, and grows to, real images */
+START_TEST(test_lazy_scratch) {
+    BlurProcessor *processor = blur_processor_create(3840, 2160, 2);
+    GdkPixbuf *small = create_test_pixbuf(64, 48);
+    GdkPixbuf *large = create_test_pixbuf(640, 480);
+    BlurProcessorStats stats;
+    
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.scratch_bytes, 0);
+    ck_assert_uint_eq(blur_processor_release_memory(processor), 0);
+    
+    GdkPixbuf *result = blur_processor_apply_sync(processor, small, 2.0, NULL);
+    g_object_unref(result);
+    blur_processor_get_stats(processor, &stats);
+    gsize small_bytes = stats.scratch_bytes;
+    ck_assert_uint_gt(small_bytes, 0);
+    ck_assert_uint_lt(small_bytes, 3840 * 2160 * 4 / 16);
+    
+    /* The arena grows for the larger image and then serves both */
+    result = blur_processor_apply_sync(processor, large, 2.0, NULL);
+    g_object_unref(result);
+    blur_processor_get_stats(processor, &stats);
+    gsize large_bytes = stats.scratch_bytes;
+    ck_assert_uint_gt(large_bytes, small_bytes);
+    
+    result = blur_processor_apply_sync(processor, small, 2.0, NULL);
+    g_object_unref(result);
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.scratch_bytes, large_bytes);
+    
+    blur_processor_release_memory(processor);
+    blur_processor_get_stats(processor, &stats);
+    ck_assert_uint_eq(stats.scratch_bytes, 0);
+    
+    g_object_unref(large);
+    g_object_unref(small);
+    blur_processor_destroy(processor);
+}
+END_TEST
+
+/* Helper: notes the thread a completion ran on */
+typedef struct {
+    GdkPixbuf *result;
+    GThread *thread;
+    guint batches;
+    gint completed;     // Set last, atomically; callbacks may run on a worker
+} DeliveryData;
+
+static void on_delivered(GdkPixbuf *result, const GError *error, gpointer user_data) {
+    DeliveryData *delivery = user_data;
+    
+    ck_assert_ptr_null(error);
+    delivery->result = g_object_ref(result);
+    delivery->thread = g_thread_self();
+    g_atomic_int_set(&delivery->completed, TRUE);
+}
+
+static void on_batch_delivered(BlurBatchItem *items, guint n_items, gpointer user_data) {
+    DeliveryData *delivery = user_data;
+    
+    delivery->thread = g_thread_self();
+    delivery->batches++;
+    for (guint i = 0; i < n_items; i++) {
+        ck_assert_ptr_nonnull(items[i].result);
+    }
+    g_atomic_int_set(&delivery->completed, TRUE);
+}
+
+/* Test: results arrive in the caller's context or on the worker */
+START_TEST(test_delivery_modes) {
+    GdkPixbuf *source = create_test_pixbuf(64, 48);
+    GMainContext *context = g_main_context_new();
+    DeliveryData delivery = { NULL, NULL, 0, FALSE };
+    gint64 deadline = g_get_monotonic_time() + 10 * G_USEC_PER_SEC;
+    
+    /* An idle in @context; the default context never sees it */
+    ck_assert_uint_ne(blur_processor_apply_stages_full(test_processor, source, BLUR_STAGE_BLUR, 1.0,
+                                                       FALSE, BLUR_PRIORITY_NORMAL,
+                                                       BLUR_DELIVERY_IDLE, context,
+                                                       on_delivered, &delivery), 0);
+    while (!g_atomic_int_get(&delivery.completed)) {
+        ck_assert(g_get_monotonic_time() < deadline);
+        ck_assert(!g_main_context_iteration(NULL, FALSE));
+        g_main_context_iteration(context, FALSE);
+    }
+    ck_assert_ptr_eq(delivery.thread, g_thread_self());
+    g_clear_object(&delivery.result);
+    
+    /* Straight from the worker, with no context iterated at all */
+    delivery.completed = FALSE;
+    blur_processor_apply_stages_full(test_processor, source, BLUR_STAGE_BLUR, 1.0, FALSE,
+                                     BLUR_PRIORITY_NORMAL, BLUR_DELIVERY_WORKER, NULL,
+                                     on_delivered, &delivery);
+    while (!g_atomic_int_get(&delivery.completed)) {
+        ck_assert(g_get_monotonic_time() < deadline);
+        g_usleep(1000);
+    }
+    ck_assert_ptr_ne(delivery.thread, g_thread_self());
+    g_clear_object(&delivery.result);
+    
+    /* A batch costs one idle in its context */
+    BlurBatchItem items[3] = {
+        { source, 1.0, NULL, NULL }, { source, 2.0, NULL, NULL }, { source, 3.0, NULL, NULL }
+    };
+    delivery.completed = FALSE;
+    blur_processor_apply_batch_async(test_processor, items, 3, BLUR_STAGE_BLUR, BLUR_PRIORITY_NORMAL,
+                                     BLUR_DELIVERY_IDLE, context, on_batch_delivered, &delivery);
+    while (!g_atomic_int_get(&delivery.completed)) {
+        ck_assert(g_get_monotonic_time() < deadline);
+        g_main_context_iteration(context, TRUE);
+    }
+    ck_assert_uint_eq(delivery.batches, 1);
+    ck_assert(!g_main_context_pending(context));
+    for (int i = 0; i < 3; i++) {
+        g_clear_object(&items[i].result);
+    }
+    
+    g_main_context_unref(context);
+    g_object_unref(source);
+}
+END_TEST
+
 /* Test suite creation */
 Suite *blur_processor_suite(void) {
     Suite *s;
@@ -152,6 +1707,28 @@ Suite *blur_processor_suite(void) {
     /* Algorithm tests */
     tc_algorithms = tcase_create("Algorithms");
     tcase_add_test(tc_algorithms, test_gaussian_kernel_generation);
+    tcase_add_test(tc_algorithms, test_band_parallel_matches_single_thread);
+    tcase_add_test(tc_algorithms, test_tiled_matches_whole_image);
+    tcase_add_test(tc_algorithms, test_tiled_beyond_max_dimension);
+    tcase_add_test(tc_algorithms, test_padded_rowstride_matches_packed);
+    tcase_add_test(tc_algorithms, test_result_buffers_recycled);
+    tcase_add_test(tc_algorithms, test_box_sizes_match_sigma);
+    tcase_add_test(tc_algorithms, test_box_engine_approximates_gaussian);
+    tcase_add_test(tc_algorithms, test_box_engine_flat_image);
+    tcase_add_test(tc_algorithms, test_simd_kernels_match_scalar);
+    tcase_add_test(tc_algorithms, test_fixed_kernel_generation);
+    tcase_add_test(tc_algorithms, test_fixed_point_matches_float);
+    tcase_add_test(tc_algorithms, test_fixed_point_flat_image);
+    tcase_add_test(tc_algorithms, test_preview_factor);
+    tcase_add_test(tc_algorithms, test_progressive_preview_downscaled);
+    tcase_add_test(tc_algorithms, test_progressive_preview_flat_image);
+    tcase_add_test(tc_algorithms, test_residual_sigma);
+    tcase_add_test(tc_algorithms, test_incremental_matches_direct);
+    tcase_add_test(tc_algorithms, test_incremental_falls_back_to_source);
+    tcase_add_test(tc_algorithms, test_grayscale_async_luminance);
+    tcase_add_test(tc_algorithms, test_grayscale_kernels_match_scalar);
+    tcase_add_test(tc_algorithms, test_single_channel_matches_colour);
+    tcase_add_test(tc_algorithms, test_grayscale_blur_pipeline);
     tcase_add_checked_fixture(tc_algorithms, setup_blur_processor, teardown_blur_processor);
     suite_add_tcase(s, tc_algorithms);
     
@@ -160,6 +1737,20 @@ Suite *blur_processor_suite(void) {
     tcase_add_test(tc_validation, test_parameter_validation);
     tcase_add_test(tc_validation, test_image_size_handling);
     tcase_add_test(tc_validation, test_thread_safety_basic);
+    tcase_add_test(tc_validation, test_concurrent_requests);
+    tcase_add_test(tc_validation, test_cancel_drops_queued_requests);
+    tcase_add_test(tc_validation, test_cancel_stops_running_request);
+    tcase_add_test(tc_validation, test_latency_stats);
+    tcase_add_test(tc_validation, test_grayscale_cancel);
+    tcase_add_test(tc_validation, test_priority_ordering);
+    tcase_add_test(tc_validation, test_latest_wins_scheduling);
+    tcase_add_test(tc_validation, test_sync_matches_async);
+    tcase_add_test(tc_validation, test_batch_sync);
+    tcase_add_test(tc_validation, test_batch_latest_wins);
+    tcase_add_test(tc_validation, test_destroy_completes_waiters);
+    tcase_add_test(tc_validation, test_delivery_modes);
+    tcase_add_test(tc_validation, test_release_memory);
+    tcase_add_test(tc_validation, test_lazy_scratch);
     tcase_add_checked_fixture(tc_validation, setup_blur_processor, teardown_blur_processor);
     suite_add_tcase(s, tc_validation);
     
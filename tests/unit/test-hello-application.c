@@ -73,6 +73,58 @@ START_TEST(test_hello_application_main_window)
 }
 END_TEST
 
+START_TEST(test_hello_application_shared_blur_resources)
+{
+    HelloApplication *app;
+    BlurProcessor *processor;
+    BlurCache *cache;
+    
+    app = hello_application_new();
+    ck_assert_ptr_nonnull(app);
+    
+    /* Created once, then handed out to every window */
+    processor = hello_application_get_blur_processor(app);
+    cache = hello_application_get_blur_cache(app);
+    ck_assert_ptr_nonnull(processor);
+    ck_assert_ptr_nonnull(cache);
+    ck_assert_ptr_eq(hello_application_get_blur_processor(app), processor);
+    ck_assert_ptr_eq(hello_application_get_blur_cache(app), cache);
+    
+    g_object_unref(app);
+}
+END_TEST
+
+START_TEST(test_hello_application_low_memory)
+{
+    HelloApplication *app;
+    BlurCache *cache;
+    BlurCacheStats stats;
+    guint full_entries;
+    
+    app = hello_application_new();
+    cache = hello_application_get_blur_cache(app);
+    ck_assert_ptr_nonnull(cache);
+    blur_cache_get_stats(cache, &stats);
+    full_entries = stats.max_entries;
+    
+    /* The budget shrinks with the severity and never grows back early */
+    hello_application_handle_low_memory(app, G_MEMORY_MONITOR_WARNING_LEVEL_MEDIUM);
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.max_entries, MAX(1, full_entries / 4));
+    
+    hello_application_handle_low_memory(app, G_MEMORY_MONITOR_WARNING_LEVEL_LOW);
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.max_entries, MAX(1, full_entries / 4));
+    
+    hello_application_handle_low_memory(app, G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL);
+    blur_cache_get_stats(cache, &stats);
+    ck_assert_uint_eq(stats.max_entries, MAX(1, full_entries / 8));
+    ck_assert_uint_eq(stats.current_entries, 0);
+    
+    g_object_unref(app);
+}
+END_TEST
+
 /* Test suite creation */
 Suite *
 hello_application_suite(void)
@@ -88,6 +140,8 @@ hello_application_suite(void)
     tcase_add_test(tc_core, test_hello_application_creation);
     tcase_add_test(tc_core, test_hello_application_properties);
     tcase_add_test(tc_core, test_hello_application_main_window);
+    tcase_add_test(tc_core, test_hello_application_shared_blur_resources);
+    tcase_add_test(tc_core, test_hello_application_low_memory);
     suite_add_tcase(s, tc_core);
 
     return s;
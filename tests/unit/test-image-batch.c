@@ -0,0 +1,388 @@
+#include <check.h>
+#include <gtk/gtk.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include "src/lib/image-batch.h"
+
+#define BATCH_IMAGES 12
+
+/* Test fixtures */
+static gchar *test_directory = NULL;
+static gchar *output_directory = NULL;
+static BlurProcessor *test_processor = NULL;
+
+/* Helper: removes @path and everything below it */
+static void remove_tree(const gchar *path) {
+    GDir *dir = g_dir_open(path, 0, NULL);
+    const gchar *name;
+    
+    while (dir && (name = g_dir_read_name(dir)) != NULL) {
+        gchar *child = g_build_filename(path, name, NULL);
+        if (g_file_test(child, G_FILE_TEST_IS_DIR)) {
+            remove_tree(child);
+        } else {
+            g_unlink(child);
+        }
+        g_free(child);
+    }
+    if (dir) {
+        g_dir_close(dir);
+    }
+    
+    g_rmdir(path);
+}
+
+/* Setup function: an empty input and output directory per test */
+static void setup_batch(void) {
+    test_directory = g_dir_make_tmp("image-batch-XXXXXX", NULL);
+    ck_assert_ptr_nonnull(test_directory);
+    output_directory = g_build_filename(test_directory, "out", NULL);
+    ck_assert_int_eq(g_mkdir(output_directory, 0700), 0);
+    test_processor = blur_processor_create(256, 256, 2);
+    ck_assert_ptr_nonnull(test_processor);
+}
+
+/* Teardown function */
+static void teardown_batch(void) {
+    blur_processor_destroy(test_processor);
+    test_processor = NULL;
+    remove_tree(test_directory);
+    g_clear_pointer(&output_directory, g_free);
+    g_clear_pointer(&test_directory, g_free);
+}
+
+/* Helper: writes a colourful PNG of @width x @height as @name */
+static gchar* write_image(const gchar *directory, const gchar *name, int width, int height) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, width, height);
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    gchar *path = g_build_filename(directory, name, NULL);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width * 3; x++) {
+            pixels[y * rowstride + x] = (guchar)(x * 7 + y * 13);
+        }
+    }
+    
+    ck_assert(gdk_pixbuf_save(pixbuf, path, "png", NULL, NULL));
+    g_object_unref(pixbuf);
+    return path;
+}
+
+static ImageBatchOptions default_options(void) {
+    ImageBatchOptions options = {
+        .stages = BLUR_STAGE_GRAYSCALE | BLUR_STAGE_BLUR,
+        .intensity = 1.0,
+        .output_dir = output_directory,
+        .format = "png",
+        .decoders = 2,
+        .encoders = 2,
+        .max_in_flight = 3,
+    };
+    return options;
+}
+
+/* Test: Directories and globs contribute loadable files in name order */
+START_TEST(test_collect_inputs)
+{
+    GPtrArray *inputs = g_ptr_array_new_with_free_func(g_free);
+    gchar *subdirectory = g_build_filename(test_directory, "nested", NULL);
+    gchar *text = g_build_filename(test_directory, "notes.txt", NULL);
+    gchar *glob = g_build_filename(test_directory, "b*", NULL);
+    gchar *missing = g_build_filename(test_directory, "missing.png", NULL);
+    GError *error = NULL;
+    
+    g_free(write_image(test_directory, "b.png", 4, 4));
+    g_free(write_image(test_directory, "a.png", 4, 4));
+    ck_assert(g_file_set_contents(text, "not an image", -1, NULL));
+    ck_assert_int_eq(g_mkdir(subdirectory, 0700), 0);
+    g_free(write_image(subdirectory, "c.png", 4, 4));
+    
+    ck_assert(image_batch_collect_inputs(inputs, test_directory, FALSE, &error));
+    ck_assert_uint_eq(inputs->len, 2);
+    ck_assert(g_str_has_suffix(inputs->pdata[0], "a.png"));
+    ck_assert(g_str_has_suffix(inputs->pdata[1], "b.png"));
+    
+    g_ptr_array_set_size(inputs, 0);
+    ck_assert(image_batch_collect_inputs(inputs, test_directory, TRUE, &error));
+    ck_assert_uint_eq(inputs->len, 3);
+    
+    g_ptr_array_set_size(inputs, 0);
+    ck_assert(image_batch_collect_inputs(inputs, glob, FALSE, &error));
+    ck_assert_uint_eq(inputs->len, 1);
+    ck_assert(g_str_has_suffix(inputs->pdata[0], "b.png"));
+    
+    /* A file given by name is taken as is */
+    ck_assert(image_batch_collect_inputs(inputs, text, FALSE, &error));
+    ck_assert_uint_eq(inputs->len, 2);
+    
+    ck_assert(!image_batch_collect_inputs(inputs, missing, FALSE, &error));
+    ck_assert(g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT));
+    g_clear_error(&error);
+    ck_assert_uint_eq(inputs->len, 2);
+    
+    g_ptr_array_unref(inputs);
+    g_free(missing);
+    g_free(glob);
+    g_free(text);
+    g_free(subdirectory);
+}
+END_TEST
+
+/* Test: Results are named after their input in the output format */
+START_TEST(test_output_path)
+{
+    ImageBatchOptions options = default_options();
+    gchar *expected = g_build_filename(output_directory, "photo.jpg", NULL);
+    
+    options.format = "jpeg";
+    gchar *path = image_batch_output_path(&options, "/data/photo.tiff");
+    ck_assert_str_eq(path, expected);
+    
+    g_free(path);
+    g_free(expected);
+}
+END_TEST
+
+/* Test: Every image is processed with at most max_in_flight held at once */
+START_TEST(test_batch_run)
+{
+    ImageBatchOptions options = default_options();
+    GPtrArray *inputs = g_ptr_array_new_with_free_func(g_free);
+    ImageBatchResult result;
+    GError *error = NULL;
+    
+    for (int i = 0; i < BATCH_IMAGES; i++) {
+        gchar *name = g_strdup_printf("image-%02d.png", i);
+        g_ptr_array_add(inputs, write_image(test_directory, name, 40 + i, 30));
+        g_free(name);
+    }
+    
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, &error));
+    ck_assert_ptr_null(error);
+    ck_assert_uint_eq(result.succeeded, BATCH_IMAGES);
+    ck_assert_uint_eq(result.failed, 0);
+    ck_assert_uint_eq(result.errors->len, 0);
+    ck_assert_uint_ge(result.peak_in_flight, 1);
+    ck_assert_uint_le(result.peak_in_flight, options.max_in_flight);
+    
+    /* Each output keeps its input's size and is gray */
+    for (int i = 0; i < BATCH_IMAGES; i++) {
+        gchar *output = image_batch_output_path(&options, inputs->pdata[i]);
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file(output, &error);
+        
+        ck_assert_ptr_nonnull(pixbuf);
+        ck_assert_int_eq(gdk_pixbuf_get_width(pixbuf), 40 + i);
+        ck_assert_int_eq(gdk_pixbuf_get_height(pixbuf), 30);
+        ck_assert(blur_pixbuf_is_grayscale(pixbuf));
+        
+        g_object_unref(pixbuf);
+        g_free(output);
+    }
+    
+    g_ptr_array_unref(result.errors);
+    g_ptr_array_unref(inputs);
+}
+END_TEST
+
+/* Test: An unreadable image is reported without stopping the others */
+START_TEST(test_batch_failures)
+{
+    ImageBatchOptions options = default_options();
+    GPtrArray *inputs = g_ptr_array_new_with_free_func(g_free);
+    gchar *broken = g_build_filename(test_directory, "broken.png", NULL);
+    ImageBatchResult result;
+    
+    ck_assert(g_file_set_contents(broken, "not an image", -1, NULL));
+    g_ptr_array_add(inputs, write_image(test_directory, "first.png", 16, 16));
+    g_ptr_array_add(inputs, g_strdup(broken));
+    g_ptr_array_add(inputs, write_image(test_directory, "last.png", 16, 16));
+    
+    options.stages = BLUR_STAGE_BLUR;
+    options.decoders = 1;
+    options.encoders = 1;
+    options.max_in_flight = 1;
+    
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, NULL));
+    ck_assert_uint_eq(result.succeeded, 2);
+    ck_assert_uint_eq(result.failed, 1);
+    ck_assert(g_str_has_prefix(result.errors->pdata[0], broken));
+    ck_assert_uint_eq(result.peak_in_flight, 1);
+    
+    g_ptr_array_unref(result.errors);
+    g_ptr_array_unref(inputs);
+    g_free(broken);
+}
+END_TEST
+
+/* Test: Same-named images from different directories get their own outputs */
+START_TEST(test_output_collisions)
+{
+    ImageBatchOptions options = default_options();
+    GPtrArray *inputs = g_ptr_array_new_with_free_func(g_free);
+    gchar *first = g_build_filename(test_directory, "a", NULL);
+    gchar *second = g_build_filename(test_directory, "b", NULL);
+    gchar *expected = g_build_filename(output_directory, "x-2.png", NULL);
+    ImageBatchResult result;
+    
+    ck_assert_int_eq(g_mkdir(first, 0700), 0);
+    ck_assert_int_eq(g_mkdir(second, 0700), 0);
+    g_ptr_array_add(inputs, write_image(first, "x.png", 16, 16));
+    g_ptr_array_add(inputs, write_image(second, "x.png", 24, 16));
+    
+    GPtrArray *outputs = image_batch_plan_outputs(&options, inputs);
+    gchar *plain = image_batch_output_path(&options, inputs->pdata[0]);
+    ck_assert_str_eq(outputs->pdata[0], plain);
+    ck_assert_str_eq(outputs->pdata[1], expected);
+    g_free(plain);
+    
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, NULL));
+    ck_assert_uint_eq(result.succeeded, 2);
+    ck_assert_uint_eq(result.failed, 0);
+    
+    /* Both results survive, each with its own input's size */
+    for (guint i = 0; i < 2; i++) {
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file(outputs->pdata[i], NULL);
+        ck_assert_ptr_nonnull(pixbuf);
+        ck_assert_int_eq(gdk_pixbuf_get_width(pixbuf), i == 0 ? 16 : 24);
+        g_object_unref(pixbuf);
+    }
+    
+    g_ptr_array_unref(result.errors);
+    g_ptr_array_unref(outputs);
+    g_ptr_array_unref(inputs);
+    g_free(expected);
+    g_free(second);
+    g_free(first);
+}
+END_TEST
+
+/* Test: An output that is the input file itself is refused */
+START_TEST(test_output_overwrites_input)
+{
+    ImageBatchOptions options = default_options();
+    GPtrArray *inputs = g_ptr_array_new_with_free_func(g_free);
+    gchar *input = write_image(test_directory, "self.png", 16, 16);
+    ImageBatchResult result;
+    
+    /* Spelled differently from the output path, which must not matter */
+    g_ptr_array_add(inputs, g_build_filename(test_directory, ".", "self.png", NULL));
+    options.output_dir = test_directory;
+    
+    GPtrArray *outputs = image_batch_plan_outputs(&options, inputs);
+    ck_assert_ptr_null(outputs->pdata[0]);
+    g_ptr_array_unref(outputs);
+    
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, NULL));
+    ck_assert_uint_eq(result.succeeded, 0);
+    ck_assert_uint_eq(result.failed, 1);
+    
+    /* The input is still the colourful original */
+    GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file(input, NULL);
+    ck_assert_ptr_nonnull(pixbuf);
+    ck_assert(!blur_pixbuf_is_grayscale(pixbuf));
+    g_object_unref(pixbuf);
+    
+    /* Another format writes next to it */
+    options.format = "jpeg";
+    g_ptr_array_unref(result.errors);
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, NULL));
+    ck_assert_uint_eq(result.succeeded, 1);
+    
+    g_ptr_array_unref(result.errors);
+    g_ptr_array_unref(inputs);
+    g_free(input);
+}
+END_TEST
+
+/* Test: Invalid options are rejected before any thread starts */
+START_TEST(test_invalid_options)
+{
+    GPtrArray *inputs = g_ptr_array_new();
+    ImageBatchResult result;
+    ImageBatchOptions options;
+    GError *error = NULL;
+    
+    options = default_options();
+    options.stages = 0;
+    ck_assert(!image_batch_run(test_processor, &options, inputs, &result, &error));
+    g_clear_error(&error);
+    
+    options = default_options();
+    options.stages = BLUR_STAGE_BLUR;
+    options.intensity = 0.0;
+    ck_assert(!image_batch_run(test_processor, &options, inputs, &result, &error));
+    ck_assert(g_error_matches(error, BLUR_ERROR, BLUR_ERROR_INVALID_INTENSITY));
+    g_clear_error(&error);
+    
+    options = default_options();
+    options.format = "no-such-format";
+    ck_assert(!image_batch_run(test_processor, &options, inputs, &result, &error));
+    g_clear_error(&error);
+    
+    options = default_options();
+    options.output_dir = "/nonexistent/image-batch";
+    ck_assert(!image_batch_run(test_processor, &options, inputs, &result, &error));
+    g_clear_error(&error);
+    
+    options = default_options();
+    options.max_in_flight = 0;
+    ck_assert(!image_batch_run(test_processor, &options, inputs, &result, &error));
+    g_clear_error(&error);
+    
+    /* An empty batch is not an error */
+    options = default_options();
+    ck_assert(image_batch_run(test_processor, &options, inputs, &result, &error));
+    ck_assert_uint_eq(result.succeeded, 0);
+    g_ptr_array_unref(result.errors);
+    
+    g_ptr_array_unref(inputs);
+}
+END_TEST
+
+Suite *image_batch_suite(void) {
+    Suite *s;
+    TCase *tc_inputs, *tc_pipeline;
+    
+    s = suite_create("ImageBatch");
+    
+    /* Input discovery and output naming */
+    tc_inputs = tcase_create("Inputs");
+    tcase_add_checked_fixture(tc_inputs, setup_batch, teardown_batch);
+    tcase_add_test(tc_inputs, test_collect_inputs);
+    tcase_add_test(tc_inputs, test_output_path);
+    suite_add_tcase(s, tc_inputs);
+    
+    /* Decode, process and encode */
+    tc_pipeline = tcase_create("Pipeline");
+    tcase_add_checked_fixture(tc_pipeline, setup_batch, teardown_batch);
+    tcase_add_test(tc_pipeline, test_batch_run);
+    tcase_add_test(tc_pipeline, test_batch_failures);
+    tcase_add_test(tc_pipeline, test_output_collisions);
+    tcase_add_test(tc_pipeline, test_output_overwrites_input);
+    tcase_add_test(tc_pipeline, test_invalid_options);
+    suite_add_tcase(s, tc_pipeline);
+    
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+    
+    /* Try to initialize GTK, skip tests if not available */
+    if (!gtk_init_check()) {
+        g_print("GTK initialization failed - skipping all tests\n");
+        return 77; /* Skip code for meson test */
+    }
+    
+    s = image_batch_suite();
+    sr = srunner_create(s);
+    
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,154 @@
+#include <check.h>
+#include <gtk/gtk.h>
+#include <string.h>
+#include "src/lib/image-hash.h"
+
+/* Helper function to create test pixbuf with a per-pixel pattern */
+static GdkPixbuf* create_test_pixbuf(int width, int height, gboolean has_alpha) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, has_alpha, 8, width, height);
+    ck_assert_ptr_nonnull(pixbuf);
+    
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    int n_channels = gdk_pixbuf_get_n_channels(pixbuf);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width * n_channels; x++) {
+            pixels[y * rowstride + x] = (guchar)(x * 7 + y * 13);
+        }
+    }
+    
+    return pixbuf;
+}
+
+/* Test: Byte hashing matches the reference XXH64 values */
+START_TEST(test_reference_vectors)
+{
+    const gchar *sentence = "Nobody inspects the spammish repetition";
+    
+    ck_assert_uint_eq(image_hash_bytes("", 0, 0), G_GUINT64_CONSTANT(0xEF46DB3751D8E999));
+    ck_assert_uint_eq(image_hash_bytes("a", 1, 0), G_GUINT64_CONSTANT(0xD24EC4F1A98C6E5B));
+    ck_assert_uint_eq(image_hash_bytes("abc", 3, 0), G_GUINT64_CONSTANT(0x44BC2CF5AD770999));
+    ck_assert_uint_eq(image_hash_bytes(sentence, strlen(sentence), 0),
+                      G_GUINT64_CONSTANT(0xFBCEA83C8A378BF1));
+    
+    // The seed changes the result
+    ck_assert_uint_ne(image_hash_bytes("abc", 3, 1), image_hash_bytes("abc", 3, 0));
+}
+END_TEST
+
+/* Test: Rowstride padding does not affect the hash */
+START_TEST(test_rowstride_ignored)
+{
+    // 33 RGB pixels is 99 bytes per row; GdkPixbuf pads the rowstride to 100
+    GdkPixbuf *padded = create_test_pixbuf(33, 9, FALSE);
+    ck_assert_int_gt(gdk_pixbuf_get_rowstride(padded), 33 * 3);
+    
+    guchar *packed_pixels = g_malloc(33 * 3 * 9);
+    for (int y = 0; y < 9; y++) {
+        memcpy(packed_pixels + y * 33 * 3,
+               gdk_pixbuf_read_pixels(padded) + y * gdk_pixbuf_get_rowstride(padded),
+               33 * 3);
+    }
+    GdkPixbuf *packed = gdk_pixbuf_new_from_data(packed_pixels, GDK_COLORSPACE_RGB, FALSE, 8,
+                                                 33, 9, 33 * 3,
+                                                 (GdkPixbufDestroyNotify)g_free, NULL);
+    
+    // Garbage in the padding must not leak into the hash
+    gdk_pixbuf_get_pixels(padded)[33 * 3] = 0xAB;
+    
+    ck_assert_uint_eq(image_hash_pixbuf(padded), image_hash_pixbuf(packed));
+    
+    g_object_unref(padded);
+    g_object_unref(packed);
+}
+END_TEST
+
+/* Test: Every pixel contributes, including the last one */
+START_TEST(test_full_content_hashed)
+{
+    GdkPixbuf *pixbuf = create_test_pixbuf(64, 48, TRUE);
+    guint64 before = image_hash_pixbuf(pixbuf);
+    
+    // Same image hashes the same
+    ck_assert_uint_eq(image_hash_pixbuf(pixbuf), before);
+    
+    guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
+    int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
+    pixels[47 * rowstride + 63 * 4 + 3] ^= 0x01;
+    
+    ck_assert_uint_ne(image_hash_pixbuf(pixbuf), before);
+    
+    g_object_unref(pixbuf);
+}
+END_TEST
+
+/* Test: Geometry is part of the hash */
+START_TEST(test_geometry_hashed)
+{
+    // 8x4 and 4x8 RGBA images have identical packed bytes when all zero
+    GdkPixbuf *wide = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, 8, 4);
+    GdkPixbuf *tall = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, 4, 8);
+    gdk_pixbuf_fill(wide, 0);
+    gdk_pixbuf_fill(tall, 0);
+    
+    ck_assert_uint_ne(image_hash_pixbuf(wide), image_hash_pixbuf(tall));
+    
+    g_object_unref(wide);
+    g_object_unref(tall);
+}
+END_TEST
+
+/* Test: String form used as cache key */
+START_TEST(test_hash_to_string)
+{
+    gchar *key = image_hash_to_string(G_GUINT64_CONSTANT(0x00000000DEADBEEF));
+    
+    ck_assert_str_eq(key, "img_00000000deadbeef");
+    
+    g_free(key);
+}
+END_TEST
+
+Suite *image_hash_suite(void) {
+    Suite *s;
+    TCase *tc_bytes, *tc_pixbuf;
+    
+    s = suite_create("ImageHash");
+    
+    /* Raw XXH64 */
+    tc_bytes = tcase_create("Bytes");
+    tcase_add_test(tc_bytes, test_reference_vectors);
+    tcase_add_test(tc_bytes, test_hash_to_string);
+    suite_add_tcase(s, tc_bytes);
+    
+    /* Pixbuf content hashing */
+    tc_pixbuf = tcase_create("Pixbuf");
+    tcase_add_test(tc_pixbuf, test_rowstride_ignored);
+    tcase_add_test(tc_pixbuf, test_full_content_hashed);
+    tcase_add_test(tc_pixbuf, test_geometry_hashed);
+    suite_add_tcase(s, tc_pixbuf);
+    
+    return s;
+}
+
+int main(void) {
+    int number_failed;
+    Suite *s;
+    SRunner *sr;
+    
+    /* Try to initialize GTK, skip tests if not available */
+    if (!gtk_init_check()) {
+        g_print("GTK initialization failed - skipping all tests\n");
+        return 77; /* Skip code for meson test */
+    }
+    
+    s = image_hash_suite();
+    sr = srunner_create(s);
+    
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    
+    return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -117,6 +117,38 @@ START_TEST(test_estimate_memory_usage_large)
 }
 END_TEST
 
+/* Test cases for image_processor_fit_size */
+
+START_TEST(test_fit_size_downscales)
+{
+    gint width, height;
+    
+    /* 8000x6000 into a 1920x1080 box is limited by the height */
+    ck_assert(image_processor_fit_size(8000, 6000, 1920, 1080, &width, &height));
+    ck_assert_int_eq(width, 1440);
+    ck_assert_int_eq(height, 1080);
+    
+    /* Extreme aspect ratios never collapse to zero */
+    ck_assert(image_processor_fit_size(20000, 10, 1000, 1000, &width, &height));
+    ck_assert_int_eq(width, 1000);
+    ck_assert_int_eq(height, 1);
+}
+END_TEST
+
+START_TEST(test_fit_size_never_upscales)
+{
+    gint width, height;
+    
+    ck_assert(!image_processor_fit_size(800, 600, 1920, 1080, &width, &height));
+    ck_assert_int_eq(width, 800);
+    ck_assert_int_eq(height, 600);
+    
+    ck_assert(!image_processor_fit_size(1920, 1080, 1920, 1080, &width, &height));
+    ck_assert_int_eq(width, 1920);
+    ck_assert_int_eq(height, 1080);
+}
+END_TEST
+
 /* Test cases for image_processor_convert_to_grayscale */
 
 START_TEST(test_convert_to_grayscale_null_input)
@@ -216,7 +248,7 @@ static Suite*
 image_processing_suite(void)
 {
     Suite *s;
-    TCase *tc_validate, *tc_memory, *tc_convert;
+    TCase *tc_validate, *tc_memory, *tc_sizing, *tc_convert;
     
     s = suite_create("ImageProcessing");
     
@@ -235,6 +267,13 @@ image_processing_suite(void)
     tcase_add_test(tc_memory, test_estimate_memory_usage_large);
     suite_add_tcase(s, tc_memory);
     
+    /* Display size fitting test cases */
+    tc_sizing = tcase_create("Sizing");
+    tcase_set_timeout(tc_sizing, 5);  /* 5 second timeout */
+    tcase_add_test(tc_sizing, test_fit_size_downscales);
+    tcase_add_test(tc_sizing, test_fit_size_never_upscales);
+    suite_add_tcase(s, tc_sizing);
+    
     /* Conversion test cases */
     tc_convert = tcase_create("Conversion");
     tcase_set_timeout(tc_convert, 10);  /* 10 second timeout for conversion tests */
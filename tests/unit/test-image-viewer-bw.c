@@ -5,8 +5,12 @@
 
 #include <glib.h>
 #include <gtk/gtk.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
 #include "src/hello-app/hello-image-viewer.h"
 #include "src/lib/image-processing.h"
+#include "src/lib/gtk-utils.h"
 
 /* Test fixtures */
 static GtkApplication *app = NULL;
@@ -42,6 +46,75 @@ teardown_test_fixtures(void)
     test_image_path = NULL;
 }
 
+/**
+ * Helper: toggle conversion and let a background conversion finish
+ */
+static gboolean
+toggle_conversion_and_wait(HelloImageViewer *viewer)
+{
+    gboolean toggled = hello_image_viewer_toggle_conversion(viewer);
+    gint64 deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    
+    while (hello_image_viewer_is_converting(viewer) && g_get_monotonic_time() < deadline) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    g_assert_false(hello_image_viewer_is_converting(viewer));
+    
+    return toggled;
+}
+
+/**
+ * Helper: set the blur intensity and let the full quality blur finish
+ */
+static void
+blur_and_wait(HelloImageViewer *viewer, gdouble intensity)
+{
+    gint64 deadline = g_get_monotonic_time() + 10 * G_USEC_PER_SEC;
+    
+    g_assert_true(hello_image_viewer_set_blur_intensity(viewer, intensity, FALSE));
+    while (hello_image_viewer_is_blurring(viewer) && g_get_monotonic_time() < deadline) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    g_assert_false(hello_image_viewer_is_blurring(viewer));
+}
+
+/**
+ * Helper: save a solid colour PNG in a new temporary directory
+ * Returns the file path; free it with remove_test_image_file()
+ */
+static gchar *
+create_test_image_file(const gchar *name, gint width, gint height, guint32 pixel)
+{
+    GdkPixbuf *pixbuf;
+    gchar *directory, *path;
+    
+    directory = g_dir_make_tmp("image-viewer-XXXXXX", NULL);
+    g_assert_nonnull(directory);
+    path = g_build_filename(directory, name, NULL);
+    
+    pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, width, height);
+    gdk_pixbuf_fill(pixbuf, pixel);
+    g_assert_true(gdk_pixbuf_save(pixbuf, path, "png", NULL, NULL));
+    g_object_unref(pixbuf);
+    
+    g_free(directory);
+    return path;
+}
+
+/**
+ * Helper: delete a file from create_test_image_file() and its directory
+ */
+static void
+remove_test_image_file(gchar *path)
+{
+    gchar *directory = g_path_get_dirname(path);
+    
+    g_unlink(path);
+    g_rmdir(directory);
+    g_free(directory);
+    g_free(path);
+}
+
 /**
  * Test: Multiple window instance isolation
  * Verifies that each HelloImageViewer window maintains independent state
@@ -75,14 +148,14 @@ test_multiple_window_isolation(void)
     g_assert_false(hello_image_viewer_get_conversion_state(viewer2));
     
     /* Convert first window to B&W */
-    g_assert_true(hello_image_viewer_toggle_conversion(viewer1));
+    g_assert_true(toggle_conversion_and_wait(viewer1));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer1));
     
     /* Verify second window remains unchanged */
     g_assert_false(hello_image_viewer_get_conversion_state(viewer2));
     
     /* Convert second window to B&W */
-    g_assert_true(hello_image_viewer_toggle_conversion(viewer2));
+    g_assert_true(toggle_conversion_and_wait(viewer2));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer2));
     
     /* Both windows now converted independently */
@@ -90,7 +163,7 @@ test_multiple_window_isolation(void)
     g_assert_true(hello_image_viewer_get_conversion_state(viewer2));
     
     /* Restore first window only */
-    g_assert_true(hello_image_viewer_toggle_conversion(viewer1));
+    g_assert_true(toggle_conversion_and_wait(viewer1));
     g_assert_false(hello_image_viewer_get_conversion_state(viewer1));
     
     /* Second window still converted */
@@ -124,7 +197,7 @@ test_per_window_state_persistence(void)
     g_assert_false(hello_image_viewer_get_conversion_state(viewer));
     
     /* Convert and verify state persists */
-    g_assert_true(hello_image_viewer_toggle_conversion(viewer));
+    g_assert_true(toggle_conversion_and_wait(viewer));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer));
     
     /* State should persist across multiple operations */
@@ -136,7 +209,7 @@ test_per_window_state_persistence(void)
     }
     
     /* Restore and verify */
-    g_assert_true(hello_image_viewer_toggle_conversion(viewer));
+    g_assert_true(toggle_conversion_and_wait(viewer));
     g_assert_false(hello_image_viewer_get_conversion_state(viewer));
     
     /* Clean up */
@@ -170,13 +243,13 @@ test_memory_management_multiple_conversions(void)
     
     /* Convert all to B&W */
     for (int i = 0; i < num_viewers; i++) {
-        g_assert_true(hello_image_viewer_toggle_conversion(viewers[i]));
+        g_assert_true(toggle_conversion_and_wait(viewers[i]));
         g_assert_true(hello_image_viewer_get_conversion_state(viewers[i]));
     }
     
     /* Restore some back to color */
     for (int i = 0; i < num_viewers / 2; i++) {
-        g_assert_true(hello_image_viewer_toggle_conversion(viewers[i]));
+        g_assert_true(toggle_conversion_and_wait(viewers[i]));
         g_assert_false(hello_image_viewer_get_conversion_state(viewers[i]));
     }
     
@@ -221,20 +294,20 @@ test_independent_window_behavior(void)
     /* Test different conversion patterns */
     
     /* Pattern 1: A=B&W, B=Color, C=Color */
-    hello_image_viewer_toggle_conversion(viewer_a);
+    toggle_conversion_and_wait(viewer_a);
     g_assert_true(hello_image_viewer_get_conversion_state(viewer_a));
     g_assert_false(hello_image_viewer_get_conversion_state(viewer_b));
     g_assert_false(hello_image_viewer_get_conversion_state(viewer_c));
     
     /* Pattern 2: A=B&W, B=B&W, C=Color */
-    hello_image_viewer_toggle_conversion(viewer_b);
+    toggle_conversion_and_wait(viewer_b);
     g_assert_true(hello_image_viewer_get_conversion_state(viewer_a));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer_b));
     g_assert_false(hello_image_viewer_get_conversion_state(viewer_c));
     
     /* Pattern 3: A=Color, B=B&W, C=B&W */
-    hello_image_viewer_toggle_conversion(viewer_a);
-    hello_image_viewer_toggle_conversion(viewer_c);
+    toggle_conversion_and_wait(viewer_a);
+    toggle_conversion_and_wait(viewer_c);
     g_assert_false(hello_image_viewer_get_conversion_state(viewer_a));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer_b));
     g_assert_true(hello_image_viewer_get_conversion_state(viewer_c));
@@ -253,6 +326,293 @@ test_independent_window_behavior(void)
     gtk_window_destroy(GTK_WINDOW(viewer_c));
 }
 
+/**
+ * Test: Streaming load enables conversion once the image is complete
+ * Uses a generated image, so it needs no test file
+ */
+static void
+test_streaming_load(void)
+{
+    HelloImageViewer *viewer;
+    gchar *path;
+    GFile *file;
+    gint64 deadline;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("streamed.png", 640, 480, 0x3366ccff);
+    
+    file = g_file_new_for_path(path);
+    viewer = hello_image_viewer_new_for_file(app, file);
+    g_assert_nonnull(viewer);
+    
+    /* The window exists before the image has been read */
+    g_assert_true(hello_image_viewer_is_loading(viewer));
+    
+    deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    while (hello_image_viewer_is_loading(viewer) && g_get_monotonic_time() < deadline) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    g_assert_false(hello_image_viewer_is_loading(viewer));
+    
+    /* Controls work on the complete image */
+    g_assert_true(toggle_conversion_and_wait(viewer));
+    g_assert_true(hello_image_viewer_get_conversion_state(viewer));
+    
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    g_object_unref(file);
+    remove_test_image_file(path);
+}
+
+/* Completion of hello_image_viewer_render_full_resolution_async() */
+static void
+on_full_resolution_ready(GObject *source_object, GAsyncResult *result, gpointer user_data)
+{
+    GdkPixbuf **rendered = user_data;
+    GError *error = NULL;
+    
+    *rendered = hello_image_viewer_render_full_resolution_finish(HELLO_IMAGE_VIEWER(source_object),
+                                                                 result, &error);
+    g_assert_no_error(error);
+}
+
+/**
+ * Test: Proxy loading keeps the source size for full resolution renders
+ * Uses a generated image wider than any monitor
+ */
+static void
+test_proxy_load(void)
+{
+    HelloImageViewer *viewer;
+    GdkPixbuf *rendered = NULL;
+    gchar *path;
+    gint width = 0, height = 0;
+    gint64 deadline;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("panorama.png", 9000, 60, 0x808080ff);
+    
+    viewer = hello_image_viewer_new(app, path);
+    g_assert_nonnull(viewer);
+    
+    g_assert_true(hello_image_viewer_get_source_size(viewer, &width, &height));
+    g_assert_cmpint(width, ==, 9000);
+    g_assert_cmpint(height, ==, 60);
+    
+    /* Export path decodes the file again at its full size */
+    hello_image_viewer_render_full_resolution_async(viewer, NULL, on_full_resolution_ready, &rendered);
+    deadline = g_get_monotonic_time() + 5 * G_USEC_PER_SEC;
+    while (rendered == NULL && g_get_monotonic_time() < deadline) {
+        g_main_context_iteration(NULL, TRUE);
+    }
+    g_assert_nonnull(rendered);
+    g_assert_cmpint(gdk_pixbuf_get_width(rendered), ==, 9000);
+    g_assert_cmpint(gdk_pixbuf_get_height(rendered), ==, 60);
+    
+    g_object_unref(rendered);
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    remove_test_image_file(path);
+}
+
+/**
+ * Test: Switching to B&W returns at once and completes in the background
+ * Uses a generated image, so it needs no test file
+ */
+static void
+test_async_conversion(void)
+{
+    HelloImageViewer *viewer;
+    gchar *path;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("convert.png", 1600, 1200, 0xff8040ff);
+    
+    viewer = hello_image_viewer_new(app, path);
+    g_assert_nonnull(viewer);
+    
+    /* The toggle only queues the conversion */
+    g_assert_true(hello_image_viewer_toggle_conversion(viewer));
+    g_assert_true(hello_image_viewer_is_converting(viewer));
+    g_assert_false(hello_image_viewer_get_conversion_state(viewer));
+    
+    /* Closing mid-conversion drops it without a callback */
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    
+    viewer = hello_image_viewer_new(app, path);
+    g_assert_nonnull(viewer);
+    g_assert_true(toggle_conversion_and_wait(viewer));
+    g_assert_true(hello_image_viewer_get_conversion_state(viewer));
+    
+    /* Switching back and forth reuses the converted image */
+    g_assert_true(toggle_conversion_and_wait(viewer));
+    g_assert_false(hello_image_viewer_get_conversion_state(viewer));
+    g_assert_true(hello_image_viewer_toggle_conversion(viewer));
+    g_assert_false(hello_image_viewer_is_converting(viewer));
+    g_assert_true(hello_image_viewer_get_conversion_state(viewer));
+    
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    remove_test_image_file(path);
+}
+
+/**
+ * Test: Blurs stay on the CPU engine without a GPU renderer
+ * An unrealized window has no renderer, like a Cairo-only system
+ */
+static void
+test_gpu_blur_fallback(void)
+{
+    HelloImageViewer *viewer;
+    GdkPaintable *paintable;
+    GdkPixbuf *pixbuf;
+    gchar *path;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("gpu.png", 320, 200, 0x4080c0ff);
+    pixbuf = gdk_pixbuf_new_from_file(path, NULL);
+    g_assert_nonnull(pixbuf);
+    
+    /* The paintable keeps the image size and a non-negative sigma */
+    paintable = gtk_utils_blur_paintable_new(pixbuf);
+    g_assert_cmpint(gdk_paintable_get_intrinsic_width(paintable), ==, 320);
+    g_assert_cmpint(gdk_paintable_get_intrinsic_height(paintable), ==, 200);
+    g_assert_cmpfloat(gtk_utils_blur_paintable_get_sigma(paintable), ==, 0.0);
+    gtk_utils_blur_paintable_set_sigma(paintable, 6.0);
+    g_assert_cmpfloat(gtk_utils_blur_paintable_get_sigma(paintable), ==, 6.0);
+    gtk_utils_blur_paintable_set_sigma(paintable, -1.0);
+    g_assert_cmpfloat(gtk_utils_blur_paintable_get_sigma(paintable), ==, 0.0);
+    g_object_unref(paintable);
+    g_object_unref(pixbuf);
+    
+    viewer = hello_image_viewer_new(app, path);
+    g_assert_nonnull(viewer);
+    
+    g_assert_true(hello_image_viewer_set_blur_intensity(viewer, 3.0, FALSE));
+    g_assert_false(hello_image_viewer_is_gpu_blur_active(viewer));
+    
+    /* Toggling the path keeps the intensity and the CPU display */
+    hello_image_viewer_set_gpu_blur(viewer, FALSE);
+    hello_image_viewer_set_gpu_blur(viewer, TRUE);
+    g_assert_false(hello_image_viewer_is_gpu_blur_active(viewer));
+    g_assert_cmpfloat(hello_image_viewer_get_blur_intensity(viewer), ==, 3.0);
+    
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    remove_test_image_file(path);
+}
+
+/**
+ * Test: The debug overlay shows render and cache figures of a finished blur
+ * and toggles without touching the blur state
+ */
+static void
+test_debug_overlay(void)
+{
+    HelloImageViewer *viewer;
+    GtkWidget *overlay;
+    const gchar *text, *line;
+    gchar *path;
+    gdouble total_p50 = 0.0;
+    guint64 completed = 0;
+    guint entries = 0, max_entries = 0;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("overlay.png", 320, 200, 0x4080c0ff);
+    
+    viewer = hello_image_viewer_new(app, path);
+    g_assert_nonnull(viewer);
+    hello_image_viewer_set_gpu_blur(viewer, FALSE);
+    overlay = GTK_WIDGET(gtk_widget_get_template_child(GTK_WIDGET(viewer),
+                                                       HELLO_TYPE_IMAGE_VIEWER,
+                                                       "debug_overlay"));
+    g_assert_true(GTK_IS_LABEL(overlay));
+    g_assert_false(hello_image_viewer_get_debug_overlay(viewer));
+    g_assert_false(gtk_widget_get_visible(overlay));
+    
+    /* Shown after a full quality blur, it reports that blur */
+    blur_and_wait(viewer, 2.0);
+    hello_image_viewer_set_debug_overlay(viewer, TRUE);
+    g_assert_true(hello_image_viewer_get_debug_overlay(viewer));
+    g_assert_true(gtk_widget_get_visible(overlay));
+    text = gtk_label_get_text(GTK_LABEL(overlay));
+    
+    line = strstr(text, "\nTotal");
+    g_assert_nonnull(line);
+    g_assert_cmpint(sscanf(line, " Total p50 %lf ms", &total_p50), ==, 1);
+    g_assert_cmpfloat(total_p50, >, 0.0);
+    
+    line = strstr(text, "\nRequests");
+    g_assert_nonnull(line);
+    g_assert_cmpint(sscanf(line, " Requests %" G_GUINT64_FORMAT " done", &completed), ==, 1);
+    g_assert_cmpuint(completed, >=, 1);
+    
+    line = strstr(text, "\nCache");
+    g_assert_nonnull(line);
+    g_assert_cmpint(sscanf(line, " Cache %u/%u entries", &entries, &max_entries), ==, 2);
+    g_assert_cmpuint(entries, >=, 1);
+    g_assert_cmpuint(entries, <=, max_entries);
+    
+    /* Enabling again keeps it shown */
+    hello_image_viewer_set_debug_overlay(viewer, TRUE);
+    g_assert_true(gtk_widget_get_visible(overlay));
+    
+    hello_image_viewer_set_debug_overlay(viewer, FALSE);
+    g_assert_false(hello_image_viewer_get_debug_overlay(viewer));
+    g_assert_false(gtk_widget_get_visible(overlay));
+    g_assert_cmpfloat(hello_image_viewer_get_blur_intensity(viewer), ==, 2.0);
+    
+    /* Destroying with the overlay shown stops its refresh */
+    hello_image_viewer_set_debug_overlay(viewer, TRUE);
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    remove_test_image_file(path);
+}
+
+/**
+ * Test: The debounce follows the measured cost of the image's blurs
+ * Every blur is recorded as taking 40 ms, whatever the machine
+ */
+static void
+test_adaptive_debounce(void)
+{
+    HelloImageViewer *viewer;
+    gchar *path;
+    gint debounce;
+    
+    setup_test_fixtures();
+    
+    path = create_test_image_file("debounce.png", 320, 200, 0x4080c0ff);
+    
+    g_setenv("HELLO_IMAGE_VIEWER_BLUR_COST_MS", "40", TRUE);
+    viewer = hello_image_viewer_new(app, path);
+    g_unsetenv("HELLO_IMAGE_VIEWER_BLUR_COST_MS");
+    g_assert_nonnull(viewer);
+    hello_image_viewer_set_gpu_blur(viewer, FALSE);
+    
+    /* Nothing measured yet: the fixed default */
+    g_assert_cmpint(hello_image_viewer_get_blur_debounce(viewer), ==, 100);
+    
+    /* The first full quality blur sets the policy, within the clamp */
+    blur_and_wait(viewer, 1.0);
+    debounce = hello_image_viewer_get_blur_debounce(viewer);
+    g_assert_cmpint(debounce, >=, 16);
+    g_assert_cmpint(debounce, <=, 250);
+    g_assert_cmpint(debounce, ==, 40);
+    
+    /* The same cost again keeps the average where it is */
+    blur_and_wait(viewer, 1.25);
+    g_assert_cmpint(hello_image_viewer_get_blur_debounce(viewer), ==, 40);
+    
+    /* A new base image starts over */
+    g_assert_true(hello_image_viewer_set_blur_intensity(viewer, 0.0, FALSE));
+    g_assert_true(toggle_conversion_and_wait(viewer));
+    g_assert_cmpint(hello_image_viewer_get_blur_debounce(viewer), ==, 100);
+    
+    gtk_window_destroy(GTK_WINDOW(viewer));
+    remove_test_image_file(path);
+}
+
 /**
  * Main test runner
  */
@@ -276,6 +636,18 @@ main(int argc, char *argv[])
                     test_memory_management_multiple_conversions);
     g_test_add_func("/image-viewer-bw/independent-window-behavior", 
                     test_independent_window_behavior);
+    g_test_add_func("/image-viewer-bw/streaming-load", 
+                    test_streaming_load);
+    g_test_add_func("/image-viewer-bw/proxy-load", 
+                    test_proxy_load);
+    g_test_add_func("/image-viewer-bw/async-conversion", 
+                    test_async_conversion);
+    g_test_add_func("/image-viewer-bw/gpu-blur-fallback", 
+                    test_gpu_blur_fallback);
+    g_test_add_func("/image-viewer-bw/debug-overlay", 
+                    test_debug_overlay);
+    g_test_add_func("/image-viewer-bw/adaptive-debounce", 
+                    test_adaptive_debounce);
     
     return g_test_run();
 }
\ No newline at end of file